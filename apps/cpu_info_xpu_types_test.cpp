@@ -0,0 +1,157 @@
+/**
+ * \file apps/cpu_info_xpu_types_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check cpu_info_xpu_types on fake /proc/cpuinfo and midr_el1 trees
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <stdio.h>
+#include <map>
+#include <string>
+#include "mperf/cpu_info.h"
+#include "utils/utils.h"
+
+using mperf::MPFXPUType;
+
+namespace {
+int g_failures = 0;
+
+void check_types(const char* what, const std::map<int, MPFXPUType>& types,
+                 const std::map<int, MPFXPUType>& expected) {
+    if (types == expected) {
+        printf("ok   %s\n", what);
+        return;
+    }
+    ++g_failures;
+    printf("FAIL %s:", what);
+    for (auto& it : types) {
+        printf(" cpu%d=%d", it.first, it.second);
+    }
+    printf("\n");
+}
+
+// a core of an arm /proc/cpuinfo
+std::string arm_core(int processor, const char* part) {
+    return "processor\t: " + std::to_string(processor) +
+           "\nBogoMIPS\t: 38.40\nCPU implementer\t: 0x41\n"
+           "CPU architecture: 8\nCPU variant\t: 0x1\nCPU part\t: " +
+           part + "\nCPU revision\t: 0\n\n";
+}
+
+// a core of an x86 /proc/cpuinfo
+std::string x86_core(int processor, int model, int stepping) {
+    return "processor\t: " + std::to_string(processor) +
+           "\nvendor_id\t: GenuineIntel\ncpu family\t: 6\nmodel\t\t: " +
+           std::to_string(model) +
+           "\nmodel name\t: Intel(R) Xeon(R) CPU\nstepping\t: " +
+           std::to_string(stepping) + "\n\n";
+}
+
+void write_midr(const std::string& root, int cpu, const char* midr) {
+    write_fake_file(root,
+                    "/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                            "/regs/identification/midr_el1",
+                    std::string(midr) + "\n");
+}
+
+// a55 + a76 big.LITTLE: the midr_el1 files win over /proc/cpuinfo
+void test_midr() {
+    std::string root = make_fake_root();
+    for (int cpu = 0; cpu < 6; ++cpu) {
+        write_midr(root, cpu, "0x00000000411fd050");
+    }
+    for (int cpu = 6; cpu < 8; ++cpu) {
+        write_midr(root, cpu, "0x00000000414fd0b0");
+    }
+    // a stale cpuinfo, which must not be read
+    write_fake_file(root, "/proc/cpuinfo", arm_core(0, "0xd46"));
+    std::map<int, MPFXPUType> expected;
+    for (int cpu = 0; cpu < 8; ++cpu) {
+        expected[cpu] = cpu < 6 ? mperf::A55 : mperf::DEFAULT;
+    }
+    check_types("a55+a76 midr_el1", mperf::cpu_info_xpu_types(root),
+                expected);
+    remove_fake_root(root);
+}
+
+// a510 + a55 of /proc/cpuinfo only, e.g. the midr_el1 files not readable
+void test_arm_cpuinfo() {
+    std::string root = make_fake_root();
+    write_fake_file(root, "/sys/devices/system/cpu/cpu0/online", "1\n");
+    std::string cpuinfo;
+    for (int cpu = 0; cpu < 4; ++cpu) {
+        cpuinfo += arm_core(cpu, cpu < 2 ? "0xd46" : "0xd05");
+    }
+    write_fake_file(root, "/proc/cpuinfo", cpuinfo);
+    check_types("a510+a55 cpuinfo", mperf::cpu_info_xpu_types(root),
+                {{0, mperf::A510},
+                 {1, mperf::A510},
+                 {2, mperf::A55},
+                 {3, mperf::A55}});
+    remove_fake_root(root);
+}
+
+// the old arm kernels print the cpu part once after all the cores
+void test_arm_cpuinfo_shared() {
+    std::string root = make_fake_root();
+    write_fake_file(root, "/proc/cpuinfo",
+                    "processor\t: 0\nBogoMIPS\t: 38.40\n\n"
+                    "processor\t: 1\nBogoMIPS\t: 38.40\n\n"
+                    "CPU implementer\t: 0x41\nCPU part\t: 0xd05\n");
+    check_types("a55 shared cpuinfo", mperf::cpu_info_xpu_types(root),
+                {{0, mperf::A55}, {1, mperf::A55}});
+    remove_fake_root(root);
+}
+
+// the family 6 models, cascade lake by the stepping of skylake-sp
+void test_x86_cpuinfo() {
+    std::string root = make_fake_root();
+    write_fake_file(root, "/proc/cpuinfo",
+                    x86_core(0, 85, 7) + x86_core(1, 85, 7));
+    check_types("x86 clx cpuinfo", mperf::cpu_info_xpu_types(root),
+                {{0, mperf::CLX_SERVER}, {1, mperf::CLX_SERVER}});
+    write_fake_file(root, "/proc/cpuinfo", x86_core(0, 85, 4));
+    check_types("x86 skx cpuinfo", mperf::cpu_info_xpu_types(root),
+                {{0, mperf::SKX_SERVER}});
+    write_fake_file(root, "/proc/cpuinfo", x86_core(0, 63, 2));
+    check_types("x86 hsx cpuinfo", mperf::cpu_info_xpu_types(root),
+                {{0, mperf::HSX_SERVER}});
+    remove_fake_root(root);
+}
+
+// the atom cores of alder lake report the model of the core ones
+void test_x86_hybrid() {
+    std::string root = make_fake_root();
+    std::string cpuinfo;
+    for (int cpu = 0; cpu < 4; ++cpu) {
+        cpuinfo += x86_core(cpu, 151, 2);
+    }
+    write_fake_file(root, "/proc/cpuinfo", cpuinfo);
+    const std::string pmus = "/sys/bus/event_source/devices";
+    write_fake_file(root, pmus + "/cpu_core/type", "4\n");
+    write_fake_file(root, pmus + "/cpu_core/cpus", "0-1\n");
+    write_fake_file(root, pmus + "/cpu_atom/type", "10\n");
+    write_fake_file(root, pmus + "/cpu_atom/cpus", "2-3\n");
+    check_types("x86 adl hybrid", mperf::cpu_info_xpu_types(root),
+                {{0, mperf::ADL_GLC},
+                 {1, mperf::ADL_GLC},
+                 {2, mperf::ADL_GRT},
+                 {3, mperf::ADL_GRT}});
+    remove_fake_root(root);
+}
+}  // namespace
+
+int main() {
+    test_midr();
+    test_arm_cpuinfo();
+    test_arm_cpuinfo_shared();
+    test_x86_cpuinfo();
+    test_x86_hybrid();
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
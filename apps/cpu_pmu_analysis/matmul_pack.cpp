@@ -684,8 +684,8 @@ void gettma(int m, int n, int k) {
         mpf_tma.sample_and_stop(iter_num);
     }
 
-    for (size_t i = 0; i < uncore_evt_num; ++i) {
-        mpf_tma.start_uncore(i);
+    if (uncore_evt_num > 0) {
+        mpf_tma.start_uncore();
 #endif
         for (size_t j = 0; j < iter_num; ++j) {
             my_matmul_pack(m, n, k, a, k, b, n, c, n);
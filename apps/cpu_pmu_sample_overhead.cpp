@@ -0,0 +1,127 @@
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "mperf/cpu_affinity.h"
+#include "mperf/exception.h"
+#include "mperf/timer.h"
+#include "mperf/xpmu/xpmu.h"
+
+namespace {
+// return the average cost of one call of f in nanoseconds
+template <typename F>
+double bench(mperf::XPMU& xpmu, int iter_num, F f) {
+    xpmu.run();
+    // warmup
+    for (int i = 0; i < 100; i++) {
+        f();
+    }
+    mperf::Timer t;
+    for (int i = 0; i < iter_num; i++) {
+        f();
+    }
+    double ns = t.get_nsecs() / iter_num;
+    xpmu.stop();
+    return ns;
+}
+
+double bench_sample(mperf::XPMU& xpmu, int iter_num) {
+    return bench(xpmu, iter_num, [&] { xpmu.sample(); });
+}
+
+// the fast path of the events resolved to ids once
+double bench_sample_values(mperf::XPMU& xpmu, int iter_num) {
+    int cycles = xpmu.cpu_event_id("CPU_CYCLES");
+    volatile uint64_t sink = 0;
+    double ns = bench(xpmu, iter_num, [&] {
+        sink = sink + xpmu.sample_cpu_values()[cycles];
+    });
+    return ns;
+}
+
+// sample() as it used to be, building the measurements from scratch with
+// the names copied on every call
+double bench_sample_copy_names(mperf::XPMU& xpmu, int iter_num,
+                               const mperf::CpuCounterSet2& events) {
+    mperf::CpuMeasurements results;
+    return bench(xpmu, iter_num, [&] {
+        mperf::CpuValues values = xpmu.sample_cpu_values();
+        results.clear();
+        for (size_t i = 0; i < values.size; ++i) {
+            results.push_back({events[i].name, values[i]});
+        }
+    });
+}
+
+void bench_all(mperf::XPMU& xpmu, int iter_num,
+               const mperf::CpuCounterSet2& events, const char* mode) {
+    double copy_ns = bench_sample_copy_names(xpmu, iter_num, events);
+    double sample_ns = bench_sample(xpmu, iter_num);
+    double values_ns = bench_sample_values(xpmu, iter_num);
+    printf("%s:\n", mode);
+    printf("  sample() copying the names: %.1f ns\n", copy_ns);
+    printf("  sample():                   %.1f ns\n", sample_ns);
+    printf("  sample_cpu_values():        %.1f ns(%.2fx)\n", values_ns,
+           copy_ns / values_ns);
+}
+
+void bench_xpmu(int iter_num) {
+    mperf::CpuCounterSet2 events = {
+            {"CPU_CYCLES", PERF_COUNT_HW_CPU_CYCLES, PERF_TYPE_HARDWARE},
+            {"INST_RETIRED", PERF_COUNT_HW_INSTRUCTIONS, PERF_TYPE_HARDWARE}};
+    mperf::XPMU xpmu(events);
+
+    double read_ns = bench_sample(xpmu, iter_num);
+    printf("sample() with read() syscall: %.1f ns\n", read_ns);
+
+    xpmu.set_cpu_user_read_enabled(true);
+    bool user_read = xpmu.cpu_profiler()->is_user_read();
+    if (!user_read) {
+        printf("user space counter read is not allowed, check "
+               "/sys/bus/event_source/devices/cpu/rdpmc(x86) or "
+               "/proc/sys/kernel/perf_user_access(aarch64)\n");
+    } else {
+        double user_ns = bench_sample(xpmu, iter_num);
+        printf("sample() with user space read: %.1f ns\n", user_ns);
+        printf("speedup: %.2fx\n", read_ns / user_ns);
+    }
+
+    // the names beyond the small string buffer are allocated when copied
+    mperf::CpuCounterSet2 long_events = {
+            {"CPU_CYCLES", PERF_COUNT_HW_CPU_CYCLES, PERF_TYPE_HARDWARE},
+            {"INST_RETIRED", PERF_COUNT_HW_INSTRUCTIONS, PERF_TYPE_HARDWARE},
+            {"BRANCH_MISPRED_RETIRED", PERF_COUNT_HW_BRANCH_MISSES,
+             PERF_TYPE_HARDWARE},
+            {"LL_CACHE_MISS_RETIRED", PERF_COUNT_HW_CACHE_MISSES,
+             PERF_TYPE_HARDWARE}};
+    xpmu.set_cpu_user_read_enabled(false);
+    xpmu.set_cpu_counter_group_size(long_events.size());
+    xpmu.set_enabled_cpu_counters(long_events);
+    bench_all(xpmu, iter_num, long_events, "4 events, read() syscall");
+    if (user_read) {
+        xpmu.set_cpu_user_read_enabled(true);
+        bench_all(xpmu, iter_num, long_events, "4 events, user space read");
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "sample usage:\n");
+        fprintf(stderr, "./cpu_pmu_sample_overhead core_id iter_num\n");
+        return -1;
+    }
+    const int dev_id = atoi(argv[1]);
+    const int iter_num = atoi(argv[2]);
+    if (set_cpu_thread_affinity_spec_core(dev_id)) {
+        return -1;
+    }
+
+    try {
+        bench_xpmu(iter_num);
+    } catch (const mperf::MperfError& e) {
+        fprintf(stderr, "cpu_pmu_sample_overhead: %s", e.what());
+        return 1;
+    }
+    return 0;
+}
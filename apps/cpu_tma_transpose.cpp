@@ -944,8 +944,8 @@ int main() {
     // FIXME(hc): when the iter_numm greater than 5, we have ran into that
     // uncore event value became too big, so we call `sample(1)` very iter in
     // uncore event sample to walk around it
-    for (size_t i = 0; i < uncore_evt_num; ++i) {
-        mpf_tma.start_uncore(i);
+    if (uncore_evt_num > 0) {
+        mpf_tma.start_uncore();
 #endif
         for (size_t j = 0; j < iter_num; ++j) {
 #if MEMCPY
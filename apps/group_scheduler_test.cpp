@@ -0,0 +1,206 @@
+/**
+ * \file apps/group_scheduler_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check the groups GroupScheduler packs for the counters of the cpus
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <stdio.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "arch_ratios/arch_ratios.h"
+#include "group_scheduler.h"
+#include "mperf/exception.h"
+
+using mperf::EventAttr;
+using mperf::tma::CounterConstraints;
+using mperf::tma::GroupScheduler;
+
+namespace {
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what.c_str());
+    g_failures += !ok;
+}
+
+bool has_config(const std::vector<EventAttr>& events, const EventAttr& ev) {
+    for (auto& e : events) {
+        if (e.config == ev.config) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// the gp counters the group takes, counted apart from the scheduler: a fixed
+// counter holds one event, the free events take none
+size_t gp_used(const CounterConstraints& cons,
+               const std::vector<EventAttr>& group) {
+    size_t used = 0;
+    std::set<uint64_t> fixed;
+    for (auto& ev : group) {
+        if (has_config(cons.free_events, ev)) {
+            continue;
+        }
+        bool is_fixed = false;
+        for (auto& fev : cons.fixed_events) {
+            is_fixed = is_fixed || (fev.config == ev.config &&
+                                    fev.type == ev.type);
+        }
+        if (is_fixed && fixed.insert(ev.config).second) {
+            continue;
+        }
+        ++used;
+    }
+    return used;
+}
+
+// the events of a restricted counter in the group, which have to be one
+bool restricted_ok(const CounterConstraints& cons,
+                   const std::vector<EventAttr>& group) {
+    std::set<int> counters;
+    for (auto& ev : group) {
+        auto it = cons.restricted_events.find(ev.config & 0xffff);
+        if (it != cons.restricted_events.end() &&
+            !counters.insert(it->second).second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void check_schedule(const char* cpu, mperf::MPFXPUType t,
+                    const std::vector<std::set<EventAttr>>& metric_events,
+                    size_t expected_groups) {
+    std::unique_ptr<mperf::tma::ArchRatioSetup> setup;
+    try {
+        setup.reset(new mperf::tma::ArchRatioSetup(t));
+    } catch (const mperf::MperfError&) {
+        printf("skip %s, its ratio tables are not built\n", cpu);
+        return;
+    }
+    const CounterConstraints& cons = setup->constraints();
+    std::vector<std::string> names;
+    for (size_t i = 0; i < metric_events.size(); ++i) {
+        names.push_back("metric" + std::to_string(i));
+    }
+    std::vector<size_t> metric_groups;
+    GroupScheduler scheduler(cons);
+    auto groups = scheduler.schedule(names, metric_events, metric_groups);
+    const std::string prefix = std::string(cpu) + ": ";
+    check(groups.size() == expected_groups,
+          prefix + std::to_string(groups.size()) + " groups, " +
+                  std::to_string(expected_groups) + " expected");
+    bool fit = true, restricted = true, anchored = true, led = true;
+    for (auto& group : groups) {
+        fit = fit && gp_used(cons, group) <= cons.gp_num;
+        restricted = restricted && restricted_ok(cons, group);
+        anchored = anchored && (cons.anchor.name.empty() ||
+                                has_config(group, cons.anchor));
+        bool has_free = false;
+        for (auto& ev : group) {
+            has_free = has_free || has_config(cons.free_events, ev);
+        }
+        led = led && (!has_free || group[0].name == cons.leader.name);
+    }
+    check(fit, prefix + "no group takes more than " +
+                       std::to_string(cons.gp_num) + " gp counters");
+    check(restricted, prefix + "a restricted counter holds one event");
+    check(anchored, prefix + "every group counts the anchor");
+    check(led, prefix + "the free events are led by " +
+                       (cons.leader.name.empty() ? "none" : cons.leader.name));
+    bool single = metric_groups.size() == metric_events.size();
+    for (size_t i = 0; single && i < metric_events.size(); ++i) {
+        const auto& group = groups.at(metric_groups[i]);
+        for (auto& ev : metric_events[i]) {
+            single = single && has_config(group, ev);
+        }
+    }
+    check(single, prefix + "the events of every metric are in its group");
+}
+
+EventAttr raw(const char* name, uint64_t config) {
+    return EventAttr(name, config, 4, 0);
+}
+
+// 4 gp counters and the fixed ones, 8 gp events take two groups
+void test_skl() {
+    EventAttr inst = raw("INST_RETIRED.ANY", 0xc0);
+    EventAttr cycles = raw("CPU_CLK_UNHALTED.THREAD", 0x3c);
+    EventAttr slots = raw("UOPS_RETIRED.RETIRE_SLOTS", 0x2c2);
+    check_schedule(
+            "skl", mperf::SKL_CLIENT,
+            {{inst, cycles},
+             {raw("IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c), cycles},
+             {raw("UOPS_ISSUED.ANY", 0x10e), slots,
+              raw("INT_MISC.RECOVERY_CYCLES", 0x10d), cycles},
+             {slots, cycles},
+             {raw("CYCLE_ACTIVITY.STALLS_MEM_ANY", 0x140014a3),
+              raw("EXE_ACTIVITY.BOUND_ON_STORES", 0x40a6),
+              raw("CYCLE_ACTIVITY.STALLS_TOTAL", 0x40004a3),
+              raw("EXE_ACTIVITY.1_PORTS_UTIL", 0x2a6), cycles}},
+            2);
+    // the cycles with a cmask are not the fixed counter one, so the cycles
+    // metric takes a gp counter of its own
+    check_schedule("skl cmask", mperf::SKL_CLIENT,
+                   {{raw("CPU_CLK_UNHALTED.THREAD:c1", 0x100003c), cycles},
+                    {raw("UOPS_ISSUED.ANY", 0x10e), slots,
+                     raw("INT_MISC.RECOVERY_CYCLES", 0x10d),
+                     raw("IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c)}},
+                   2);
+}
+
+// the pending events share counter 2 before skylake
+void test_hsw() {
+    check_schedule("hsw", mperf::HSW_CLIENT,
+                   {{raw("L1D_PEND_MISS.PENDING", 0x148)},
+                    {raw("CYCLE_ACTIVITY.CYCLES_L1D_PENDING", 0x80008a3)}},
+                   2);
+}
+
+// the PERF_METRICS events take no counter and go with TOPDOWN.SLOTS
+void test_icl() {
+    std::set<EventAttr> wide1, wide2;
+    for (uint64_t i = 0; i < 5; ++i) {
+        wide1.insert(raw(("EV1_" + std::to_string(i)).c_str(), 0x100 + i));
+        wide2.insert(raw(("EV2_" + std::to_string(i)).c_str(), 0x200 + i));
+    }
+    check_schedule("icl", mperf::ICL_CLIENT,
+                   {{raw("PERF_METRICS.FRONTEND_BOUND", 0x8200),
+                     raw("TOPDOWN.SLOTS", 0x400)},
+                    wide1,
+                    wide2,
+                    {raw("PERF_METRICS.BACKEND_BOUND", 0x8300),
+                     raw("PERF_METRICS.MEMORY_BOUND", 0x8700)}},
+                   2);
+}
+
+// 3 gp counters and the cycle counter
+void test_a55() {
+    EventAttr cycles = raw("CPU_CYCLES", 0x11);
+    check_schedule("a55", mperf::A55,
+                   {{raw("STALL_FRONTEND", 0x23), cycles},
+                    {raw("STALL_BACKEND", 0x24), cycles},
+                    {raw("INST_RETIRED", 0x8), raw("L1D_CACHE_REFILL", 0x3),
+                     raw("L1D_CACHE", 0x4)},
+                    {raw("BR_MIS_PRED", 0x10), raw("BR_PRED", 0x12)}},
+                   3);
+}
+}  // namespace
+
+int main() {
+    test_skl();
+    test_hsw();
+    test_icl();
+    test_a55();
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,726 @@
+/**
+ * \file apps/mperf_stat.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// Count the cpu events(or compute the TMA metrics) of an unmodified command
+// or of a running process, like `perf stat`:
+//     mperf-stat -e cycles,instructions -r 5 -- ./infer model.bin
+//     mperf-stat -m Backend_Bound,Frontend_Bound -I 1000 -p 1234
+//     mperf-stat -b -- ./cl_infer model.bin
+// and record the counts of every interval to a trace with -o, or the TMA
+// counts to a record with -R for mperf-tma-eval. -b tells whether the time
+// goes to the compute, the memory or the os
+#include <errno.h>
+#include <getopt.h>
+#include <linux/perf_event.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mperf/cpu_info.h"
+#include "mperf/exception.h"
+#include "mperf/pmu_events.h"
+#include "mperf/repeat.h"
+#include "mperf/tma/event_catalog.h"
+#include "mperf/tma/tma.h"
+#include "mperf/trace.h"
+#include "mperf/utils.h"
+#include "mperf/xpmu/xpmu.h"
+
+namespace {
+using clock = std::chrono::steady_clock;
+
+volatile sig_atomic_t g_interrupted = 0;
+
+void on_interrupt(int) {
+    g_interrupted = 1;
+}
+
+struct Options {
+    std::vector<mperf::EventAttr> events;
+    std::vector<std::string> metrics;
+    size_t interval_ms{0};
+    size_t repeats{1};
+    pid_t pid{0};
+    char** command{nullptr};
+    std::string trace_path;
+    std::string record_path;
+    bool breakdown{false};
+};
+
+// the trace of -o, created with the first counts
+std::unique_ptr<mperf::TraceWriter> g_trace;
+uint32_t g_traced_runs = 0;
+// the timestamps of the trace start with the counting of the first run, not
+// with the trace, which is created at the end of its first interval
+clock::time_point g_trace_start;
+clock::time_point g_run_start;
+
+// the counts and the elapsed seconds of a run
+struct RunResult {
+    std::vector<std::pair<std::string, uint64_t>> counts;
+    std::vector<float> metrics;
+    double seconds{0};
+    int status{0};
+};
+
+void usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s [options] -- command [args...]\n"
+            "       %s [options] -p pid\n"
+            "  -e events   comma separated cpu events, each [name=]spec with "
+            "spec one of\n"
+            "              cycles, instructions, cache-references, "
+            "cache-misses, branches,\n"
+            "              branch-misses, rNNNN(a raw event in hex), "
+            "type:config[:config1]\n"
+            "              pmu/terms/ of the sysfs(e.g. "
+            "armv8_pmuv3_0/event=0x24/) or an\n"
+            "              event of the TMA tables of the cpu(e.g. "
+            "STALL_BACKEND), the\n"
+            "              software events task-clock, context-switches, "
+            "cpu-migrations,\n"
+            "              page-faults, major-faults and minor-faults, a "
+            "trailing :u, :k or\n"
+            "              :uk counts the user space, the kernel or both"
+            "(default :u, both\n"
+            "              for the software events) "
+            "(default cycles,instructions)\n"
+            "  -m metrics  comma separated TMA metrics of the current cpu, "
+            "counted instead\n"
+            "              of the events\n"
+            "  -I ms       print the counts(and the metrics) every ms "
+            "milliseconds\n"
+            "  -r N        run the command N times, print the medians and "
+            "their spread\n"
+            "  -p pid      count a running process until it exits or "
+            "Ctrl-C\n"
+            "  -o file     record the counts of every interval to a binary "
+            "trace, the\n"
+            "              records of the N-th run in the region N\n"
+            "  -R file     save the raw counts of -m(of the last run) to a "
+            "TMA record, to\n"
+            "              evaluate any metrics on the host by "
+            "mperf-tma-eval\n"
+            "  -b          count the cycles of the kernel and the software "
+            "events too, and\n"
+            "              tell whether the time goes to the compute, the "
+            "memory or the os\n",
+            prog, prog);
+}
+
+bool parse_u64(const std::string& str, int base, uint64_t* val) {
+    if (str.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    *val = strtoull(str.c_str(), &end, base);
+    return errno == 0 && *end == '\0';
+}
+
+// the event of a spec without the pmu/terms/ and the modifiers, false if
+// the spec is unknown
+bool parse_spec(const std::string& spec, mperf::EventAttr* attr) {
+    static const struct {
+        const char* name;
+        uint32_t type;
+        uint64_t config;
+    } kGeneric[] = {
+            {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"cache-references", PERF_TYPE_HARDWARE,
+             PERF_COUNT_HW_CACHE_REFERENCES},
+            {"cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {"branches", PERF_TYPE_HARDWARE,
+             PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+            {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {"task-clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+            {"context-switches", PERF_TYPE_SOFTWARE,
+             PERF_COUNT_SW_CONTEXT_SWITCHES},
+            {"cpu-migrations", PERF_TYPE_SOFTWARE,
+             PERF_COUNT_SW_CPU_MIGRATIONS},
+            {"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+            {"major-faults", PERF_TYPE_SOFTWARE,
+             PERF_COUNT_SW_PAGE_FAULTS_MAJ},
+            {"minor-faults", PERF_TYPE_SOFTWARE,
+             PERF_COUNT_SW_PAGE_FAULTS_MIN},
+    };
+    for (auto& g : kGeneric) {
+        if (spec == g.name) {
+            attr->type = g.type;
+            attr->config = g.config;
+            // the software events happen in the kernel on behalf of the task,
+            // e.g. the context switches, they count both modes
+            if (g.type == PERF_TYPE_SOFTWARE) {
+                attr->exclude_user = 0;
+                attr->exclude_kernel = 0;
+            }
+            return true;
+        }
+    }
+    if (spec.size() > 1 && spec[0] == 'r' &&
+        parse_u64(spec.substr(1), 16, &attr->config)) {
+        attr->type = PERF_TYPE_RAW;
+        return true;
+    }
+    std::vector<std::string> fields = mperf::StrSplit(spec, ':');
+    uint64_t type = 0;
+    if ((fields.size() == 2 || fields.size() == 3) &&
+        parse_u64(fields[0], 0, &type) &&
+        parse_u64(fields[1], 0, &attr->config) &&
+        (fields.size() == 2 || parse_u64(fields[2], 0, &attr->config1))) {
+        attr->type = type;
+        return true;
+    }
+    // an encoded event of the TMA tables of the cpu
+    mperf::EventAttr ev;
+    if (mperf::tma::catalog_event(mperf::cpu_info_xpu_type(), spec, ev)) {
+        std::string name = attr->name;
+        *attr = ev;
+        attr->name = name;
+        return true;
+    }
+    return false;
+}
+
+void parse_event(const std::string& token, mperf::EventAttr* attr) {
+    // the = of the terms of pmu/terms/ do not name the event
+    size_t eq = token.substr(0, token.find('/')).find('=');
+    std::string spec = eq == std::string::npos ? token : token.substr(eq + 1);
+    attr->name = eq == std::string::npos ? token : token.substr(0, eq);
+    attr->config1 = 0;
+    if (spec.find('/') != std::string::npos) {
+        std::string name = attr->name;
+        *attr = mperf::parse_pmu_event(spec);
+        // the name= of the terms unless named before them
+        if (eq != std::string::npos) {
+            attr->name = name;
+        }
+        return;
+    }
+    // the modes of the event, e.g. cycles:k or r11:uk
+    std::string modifiers;
+    size_t colon = spec.rfind(':');
+    if (colon != std::string::npos && colon + 1 < spec.size() &&
+        spec.find_first_not_of("uk", colon + 1) == std::string::npos) {
+        modifiers = spec.substr(colon + 1);
+        spec = spec.substr(0, colon);
+    }
+    if (!parse_spec(spec, attr)) {
+        mperf_throw(mperf::MperfError, "unknown event %s\n", token.c_str());
+    }
+    mperf::apply_event_modifiers(modifiers, *attr);
+}
+
+/** The command, forked and held before exec until release(). */
+class Child {
+public:
+    // a child never released(e.g. its counters failed to open) is killed
+    // before it execs
+    ~Child() {
+        if (gate_ >= 0) {
+            kill(pid_, SIGKILL);
+            close(gate_);
+            waitpid(pid_, nullptr, 0);
+        }
+    }
+
+    pid_t launch(char** argv) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            mperf_throw(mperf::MperfError, "pipe failed: %s\n",
+                        strerror(errno));
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            mperf_throw(mperf::MperfError, "fork failed: %s\n",
+                        strerror(errno));
+        }
+        if (pid == 0) {
+            close(fds[1]);
+            // the parent closes its end once the counters are opened
+            char c;
+            while (read(fds[0], &c, 1) < 0 && errno == EINTR) {
+            }
+            close(fds[0]);
+            signal(SIGINT, SIG_DFL);
+            execvp(argv[0], argv);
+            fprintf(stderr, "failed to exec %s: %s\n", argv[0],
+                    strerror(errno));
+            _exit(127);
+        }
+        close(fds[0]);
+        gate_ = fds[1];
+        pid_ = pid;
+        return pid;
+    }
+
+    void release() {
+        close(gate_);
+        gate_ = -1;
+    }
+
+private:
+    int gate_{-1};
+    pid_t pid_{0};
+};
+
+// wait up to ms for the target to end, returns false if it did
+bool wait_target(pid_t pid, bool is_child, size_t ms, int* status) {
+    auto deadline = clock::now() + std::chrono::milliseconds(ms);
+    while (clock::now() < deadline) {
+        if (is_child) {
+            int ret = waitpid(pid, status, WNOHANG);
+            if (ret == pid || (ret < 0 && errno != EINTR)) {
+                return false;
+            }
+        } else if (g_interrupted || (kill(pid, 0) != 0 && errno == ESRCH)) {
+            return false;
+        }
+        struct timespec ts = {0, 5 * 1000 * 1000};
+        nanosleep(&ts, nullptr);
+    }
+    return true;
+}
+
+// wait an interval for the target to end, polled every 100 ms without -I
+bool wait_interval(const Options& opts, pid_t pid, int* status) {
+    return wait_target(pid, opts.pid == 0,
+                       opts.interval_ms ? opts.interval_ms : 100, status);
+}
+
+void print_counts(FILE* fp, double time_s,
+                  const std::vector<std::pair<std::string, uint64_t>>& counts) {
+    for (auto& c : counts) {
+        fprintf(fp, "%14.3f %20lu  %s\n", time_s, (unsigned long)c.second,
+                c.first.c_str());
+    }
+}
+
+// called right before the counting of a run starts
+void start_run_clock() {
+    g_run_start = clock::now();
+    if (g_trace_start == clock::time_point()) {
+        g_trace_start = g_run_start;
+    }
+}
+
+// the timestamp of the trace at run_ms after the start of the run
+uint64_t trace_ns(double run_ms) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            g_run_start - g_trace_start);
+    return ns.count() + static_cast<uint64_t>(run_ms * 1e6);
+}
+
+// append the counts of an interval of a run, which ends at run_ms after the
+// start of the run, to the trace of -o
+void trace_counts(const Options& opts, uint32_t run, double run_ms,
+                  const mperf::CpuMeasurements& counts) {
+    if (opts.trace_path.empty()) {
+        return;
+    }
+    if (!g_trace) {
+        // the events of -m are only known by their names
+        std::vector<mperf::EventAttr> attrs;
+        for (auto& c : counts) {
+            mperf::EventAttr attr(c.first);
+            for (auto& e : opts.events) {
+                if (e.name == c.first) {
+                    attr = e;
+                }
+            }
+            attrs.push_back(attr);
+        }
+        g_trace.reset(new mperf::TraceWriter(opts.trace_path, attrs));
+    }
+    for (; g_traced_runs <= run; ++g_traced_runs) {
+        g_trace->set_region_name(g_traced_runs,
+                                 mperf::ssprintf("run %u", g_traced_runs));
+    }
+    std::vector<uint64_t> values;
+    for (auto& c : counts) {
+        values.push_back(c.second);
+    }
+    g_trace->append(trace_ns(run_ms), run, values.data());
+}
+
+void add_counts(std::vector<std::pair<std::string, uint64_t>>& total,
+                const mperf::CpuMeasurements& counts) {
+    if (total.empty()) {
+        total = counts;
+        return;
+    }
+    for (size_t i = 0; i < counts.size(); ++i) {
+        total[i].second += counts[i].second;
+    }
+}
+
+RunResult run_events(const Options& opts, uint32_t run, mperf::XPMU& xpmu) {
+    RunResult res;
+    Child child;
+    pid_t pid = opts.pid ? opts.pid : child.launch(opts.command);
+    xpmu.set_cpu_target_pid(pid, opts.pid == 0);
+    xpmu.set_enabled_cpu_counters(opts.events);
+    start_run_clock();
+    xpmu.run();
+    auto start = clock::now();
+    if (opts.pid == 0) {
+        child.release();
+    }
+    bool running = true;
+    while (running) {
+        running = wait_interval(opts, pid, &res.status);
+        if (running && opts.interval_ms == 0) {
+            continue;
+        }
+        mperf::Measurements m = xpmu.sample();
+        add_counts(res.counts, *m.cpu);
+        trace_counts(opts, run,
+                     std::chrono::duration<double, std::milli>(
+                             clock::now() - g_run_start)
+                             .count(),
+                     *m.cpu);
+        if (opts.interval_ms) {
+            std::chrono::duration<double> t = clock::now() - start;
+            print_counts(stderr, t.count(), *m.cpu);
+        }
+    }
+    res.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    xpmu.stop();
+    return res;
+}
+
+RunResult run_metrics(const Options& opts, uint32_t run,
+                      mperf::tma::MPFTMA& tma) {
+    RunResult res;
+    Child child;
+    pid_t pid = opts.pid ? opts.pid : child.launch(opts.command);
+    tma.set_target_pid(pid, opts.pid == 0);
+    // a single interval covers the whole run without -I
+    start_run_clock();
+    tma.start_interval(opts.interval_ms ? opts.interval_ms : 24 * 3600 * 1000);
+    auto start = clock::now();
+    if (opts.pid == 0) {
+        child.release();
+    }
+    while (wait_interval(opts, pid, &res.status)) {
+    }
+    const std::vector<mperf::tma::TMAInterval>& intervals =
+            tma.stop_interval();
+    res.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    for (auto& interval : intervals) {
+        add_counts(res.counts, interval.counts);
+        // the intervals of -I are traced as they end, by the callback
+        if (opts.interval_ms == 0) {
+            trace_counts(opts, run, interval.timestamp_ms, interval.counts);
+        }
+    }
+    // the metrics of the whole run are only known without intervals
+    if (intervals.size() == 1) {
+        res.metrics = intervals[0].values;
+    }
+    return res;
+}
+
+// the events -b counts besides those of -e: the cycles of the user space
+// and of the kernel, and the software events of the os
+const char* const kBreakdownEvents[] = {
+        "cycles",         "instructions",     "cache-misses",
+        "cycles:k",       "task-clock",       "context-switches",
+        "cpu-migrations", "major-faults",     "minor-faults",
+};
+// the verdict of -b: the os if the kernel takes this share of the cycles,
+// else the memory from this many cache misses per 1000 instructions
+constexpr double kOsCycleShare = 0.3;
+constexpr double kMemoryMpki = 5;
+// the task is said to wait(e.g. on the gpu) below this share of the time on
+// the cpus
+constexpr double kOnCpuShare = 0.5;
+
+typedef std::function<void(const std::string&,
+                           const std::function<double(const RunResult&)>&,
+                           const char*)>
+        PrintFn;
+typedef std::function<double(const std::function<double(const RunResult&)>&)>
+        MedianFn;
+
+// the count of the event in a run, 0 if it is not counted
+double count_of(const RunResult& run, const char* name) {
+    for (auto& c : run.counts) {
+        if (c.first == name) {
+            return c.second;
+        }
+    }
+    return 0;
+}
+
+double ratio(double num, double den) {
+    return den > 0 ? num / den : 0;
+}
+
+// Tell whether the cpu time of the runs goes to the compute, the memory or
+// the os(the kernel on behalf of the task: the syscalls, the page faults, the
+// driver ioctls under clEnqueue* ...), by the events of kBreakdownEvents.
+void print_breakdown(const PrintFn& print, const MedianFn& median) {
+    auto os_share = [](const RunResult& r) {
+        double kernel = count_of(r, "cycles:k");
+        return ratio(kernel, count_of(r, "cycles") + kernel);
+    };
+    auto ipc = [](const RunResult& r) {
+        return ratio(count_of(r, "instructions"), count_of(r, "cycles"));
+    };
+    auto mpki = [](const RunResult& r) {
+        return 1000 * ratio(count_of(r, "cache-misses"),
+                            count_of(r, "instructions"));
+    };
+    // the task-clock is in ns, and sums the threads
+    auto on_cpu = [](const RunResult& r) {
+        return ratio(count_of(r, "task-clock") / 1e9, r.seconds);
+    };
+    fprintf(stderr, "\n");
+    print("% of the cycles in the kernel",
+          [&](const RunResult& r) { return os_share(r) * 100; }, "%20.2f");
+    print("instructions per user cycle", ipc, "%20.2f");
+    print("cache misses per 1000 instructions", mpki, "%20.2f");
+    print("cpus utilized", on_cpu, "%20.2f");
+    print("context switches per second",
+          [](const RunResult& r) {
+              return ratio(count_of(r, "context-switches"), r.seconds);
+          },
+          "%20.1f");
+    print("major faults per second",
+          [](const RunResult& r) {
+              return ratio(count_of(r, "major-faults"), r.seconds);
+          },
+          "%20.1f");
+    print("minor faults per second",
+          [](const RunResult& r) {
+              return ratio(count_of(r, "minor-faults"), r.seconds);
+          },
+          "%20.1f");
+
+    const double os = median(os_share);
+    const double misses = median(mpki);
+    fprintf(stderr, "\n  the cpu time goes mostly to ");
+    if (os >= kOsCycleShare) {
+        fprintf(stderr, "the os(%.0f%% of the cycles in the kernel)\n",
+                os * 100);
+    } else if (misses >= kMemoryMpki) {
+        fprintf(stderr, "the memory(%.1f cache misses per 1000 "
+                        "instructions)\n",
+                misses);
+    } else {
+        fprintf(stderr, "the compute(%.2f instructions per cycle)\n",
+                median(ipc));
+    }
+    const double cpus = median(on_cpu);
+    if (cpus < kOnCpuShare) {
+        fprintf(stderr, "  the task is off the cpus %.0f%% of the time, e.g. "
+                        "waiting on the gpu or the io\n",
+                (1 - cpus) * 100);
+    }
+}
+
+void print_summary(const Options& opts, const std::vector<RunResult>& runs) {
+    fprintf(stderr, "\n Performance counter stats for ");
+    if (opts.pid) {
+        fprintf(stderr, "process id '%d'", opts.pid);
+    } else {
+        fprintf(stderr, "'");
+        for (char** arg = opts.command; *arg; ++arg) {
+            fprintf(stderr, "%s%s", arg == opts.command ? "" : " ", *arg);
+        }
+        fprintf(stderr, "'");
+    }
+    if (runs.size() > 1) {
+        fprintf(stderr, " (%zu runs)", runs.size());
+    }
+    fprintf(stderr, ":\n\n");
+
+    // the medians of the runs, and the half width of their confidence
+    // interval relative to the medians
+    mperf::RepeatOptions stats_opts;
+    stats_opts.outlier_mads = 0;
+    auto print = [&](const std::string& name,
+                     const std::function<double(const RunResult&)>& value,
+                     const char* format) {
+        std::vector<double> samples;
+        for (auto& run : runs) {
+            samples.push_back(value(run));
+        }
+        mperf::SampleStats s = mperf::compute_sample_stats(samples, stats_opts);
+        fprintf(stderr, format, s.median);
+        if (runs.size() > 1) {
+            fprintf(stderr, "  %-36s ( +- %6.2f%% )\n", name.c_str(),
+                    s.rel_ci() * 100);
+        } else {
+            fprintf(stderr, "  %s\n", name.c_str());
+        }
+    };
+    const RunResult& first = runs.front();
+    for (size_t i = 0; i < first.counts.size(); ++i) {
+        print(first.counts[i].first,
+              [i](const RunResult& r) { return (double)r.counts[i].second; },
+              "%20.0f");
+    }
+    if (!first.metrics.empty()) {
+        fprintf(stderr, "\n");
+        for (size_t i = 0; i < opts.metrics.size(); ++i) {
+            print(opts.metrics[i],
+                  [i](const RunResult& r) { return (double)r.metrics[i]; },
+                  "%20.5f");
+        }
+    }
+    fprintf(stderr, "\n");
+    print("seconds time elapsed",
+          [](const RunResult& r) { return r.seconds; }, "%20.6f");
+    if (opts.breakdown) {
+        print_breakdown(print,
+                        [&](const std::function<double(const RunResult&)>&
+                                    value) {
+                            std::vector<double> samples;
+                            for (auto& run : runs) {
+                                samples.push_back(value(run));
+                            }
+                            return mperf::compute_sample_stats(samples,
+                                                               stats_opts)
+                                    .median;
+                        });
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    std::string events = "cycles,instructions";
+    int opt;
+    // stop at the command
+    while ((opt = getopt(argc, argv, "+e:m:I:r:p:o:R:bh")) != -1) {
+        switch (opt) {
+            case 'e':
+                events = optarg;
+                break;
+            case 'm':
+                opts.metrics = mperf::StrSplit(optarg, ',');
+                break;
+            case 'I':
+                opts.interval_ms = strtoul(optarg, nullptr, 10);
+                break;
+            case 'r':
+                opts.repeats = strtoul(optarg, nullptr, 10);
+                break;
+            case 'p':
+                opts.pid = atoi(optarg);
+                break;
+            case 'o':
+                opts.trace_path = optarg;
+                break;
+            case 'R':
+                opts.record_path = optarg;
+                break;
+            case 'b':
+                opts.breakdown = true;
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind < argc) {
+        opts.command = argv + optind;
+    }
+    if ((opts.pid == 0) == (opts.command == nullptr) || opts.repeats == 0 ||
+        (opts.pid && opts.repeats > 1) ||
+        (opts.metrics.empty() && !opts.record_path.empty()) ||
+        (opts.breakdown && !opts.metrics.empty())) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Ctrl-C ends the command(which gets the signal too), or stops counting
+    // the attached process
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_interrupt;
+    sigaction(SIGINT, &sa, nullptr);
+
+    std::vector<RunResult> runs;
+    uint32_t run = 0;
+    try {
+        for (auto& token : mperf::split_pmu_events(events)) {
+            mperf::EventAttr attr;
+            parse_event(token, &attr);
+            opts.events.push_back(attr);
+        }
+        if (opts.breakdown) {
+            for (const char* token : kBreakdownEvents) {
+                bool counted = false;
+                for (auto& e : opts.events) {
+                    counted = counted || e.name == token;
+                }
+                if (!counted) {
+                    mperf::EventAttr attr;
+                    parse_event(token, &attr);
+                    opts.events.push_back(attr);
+                }
+            }
+        }
+        std::unique_ptr<mperf::tma::MPFTMA> tma;
+        std::unique_ptr<mperf::XPMU> xpmu;
+        if (!opts.metrics.empty()) {
+            tma.reset(new mperf::tma::MPFTMA(mperf::MPFXPUType::DEFAULT));
+            tma->init(opts.metrics);
+            if (opts.interval_ms) {
+                tma->set_interval_callback(
+                        [&opts, &run](const mperf::tma::TMAInterval& interval) {
+                            print_counts(stderr, interval.timestamp_ms / 1000,
+                                         interval.counts);
+                            for (size_t i = 0; i < opts.metrics.size(); ++i) {
+                                fprintf(stderr, "%14.3f %20.5f  %s\n",
+                                        interval.timestamp_ms / 1000,
+                                        interval.values[i],
+                                        opts.metrics[i].c_str());
+                            }
+                            trace_counts(opts, run, interval.timestamp_ms,
+                                         interval.counts);
+                        });
+            }
+        } else {
+            xpmu.reset(new mperf::XPMU(mperf::CpuCounterSet2()));
+        }
+        for (; run < opts.repeats; ++run) {
+            runs.push_back(tma ? run_metrics(opts, run, *tma)
+                               : run_events(opts, run, *xpmu));
+        }
+        if (g_trace) {
+            g_trace->flush();
+        }
+        if (tma && !opts.record_path.empty()) {
+            tma->save_record(opts.record_path);
+        }
+    } catch (const mperf::MperfError& e) {
+        fprintf(stderr, "mperf-stat: %s", e.what());
+        return 1;
+    }
+    print_summary(opts, runs);
+
+    const int status = runs.back().status;
+    if (opts.pid == 0 && WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * \file apps/mperf_tma_eval.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// Evaluate the TMA metrics of a record saved on a device(cf.
+// MPFTMA::save_record, `mperf-stat -m ... -R record`) on the host, with the
+// recorded metrics or any other ones of its cpu:
+//     mperf-tma-eval record.trace
+//     mperf-tma-eval -m Frontend_Bound,Backend_Bound record.trace
+// Build the host with MPERF_ENABLE_TMA_ALL_ARCHS=ON for the records of the
+// other architectures.
+#include <getopt.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "mperf/exception.h"
+#include "mperf/tma/tma.h"
+#include "mperf/utils.h"
+
+int main(int argc, char** argv) {
+    std::vector<std::string> metrics;
+    int opt;
+    while ((opt = getopt(argc, argv, "m:h")) != -1) {
+        switch (opt) {
+            case 'm':
+                metrics = mperf::StrSplit(optarg, ',');
+                break;
+            default:
+                fprintf(stderr,
+                        "usage: %s [-m metrics] record\n"
+                        "  -m metrics  comma separated TMA metrics to "
+                        "evaluate, the recorded ones by\n"
+                        "              default\n",
+                        argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind + 1 != argc) {
+        fprintf(stderr, "usage: %s [-m metrics] record\n", argv[0]);
+        return 1;
+    }
+    const std::string path = argv[optind];
+    try {
+        mperf::tma::MPFTMA tma(mperf::tma::MPFTMA::record_xpu_type(path));
+        tma.load_record(path, metrics);
+        tma.deinit();
+    } catch (const mperf::MperfError& e) {
+        fprintf(stderr, "mperf-tma-eval: %s", e.what());
+        return 1;
+    }
+    return 0;
+}
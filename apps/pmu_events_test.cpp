@@ -0,0 +1,186 @@
+/**
+ * \file apps/pmu_events_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check PmuEventParser on a fake sysfs tree of the pmus
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <stdio.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "mperf/exception.h"
+#include "mperf/pmu_events.h"
+#include "utils/utils.h"
+
+using mperf::EventAttr;
+using mperf::PmuEventParser;
+using mperf::UncoreInstance;
+
+namespace {
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what.c_str());
+    g_failures += !ok;
+}
+
+void check_throws(const std::function<void()>& fn, const std::string& what) {
+    bool thrown = false;
+    try {
+        fn();
+    } catch (const mperf::MperfError&) {
+        thrown = true;
+    }
+    check(thrown, what + " throws");
+}
+
+bool same_attr(const EventAttr& attr, const std::string& name, uint32_t type,
+               uint64_t config, uint64_t config1, bool is_uncore, int eu,
+               int ek) {
+    return attr.name == name && attr.type == type && attr.config == config &&
+           attr.config1 == config1 && attr.is_uncore == is_uncore &&
+           attr.exclude_user == eu && attr.exclude_kernel == ek;
+}
+
+std::string instances_str(const std::vector<UncoreInstance>& instances) {
+    std::string res;
+    for (auto& instance : instances) {
+        res += (res.empty() ? "" : " ") + instance.pmu + "@" +
+               std::to_string(instance.cpu);
+    }
+    return res;
+}
+
+// a core pmu, and two imc channels on two sockets
+std::string make_tree() {
+    std::string root = make_fake_root();
+    const std::string arm = "/sys/bus/event_source/devices/armv8_pmuv3_0";
+    write_fake_file(root, arm + "/type", "8\n");
+    write_fake_file(root, arm + "/cpus", "0-3\n");
+    write_fake_file(root, arm + "/format/event", "config:0-15\n");
+    write_fake_file(root, arm + "/format/long", "config1:0\n");
+    write_fake_file(root, arm + "/events/cpu_cycles", "event=0x0011\n");
+    write_fake_file(root, arm + "/events/inst_retired", "event=0x0008\n");
+    // the attributes of the events are not events
+    write_fake_file(root, arm + "/events/inst_retired.scale", "1\n");
+    for (int i = 0; i < 2; ++i) {
+        const std::string imc = "/sys/bus/event_source/devices/uncore_imc_" +
+                                std::to_string(i);
+        write_fake_file(root, imc + "/type", std::to_string(20 + i) + "\n");
+        write_fake_file(root, imc + "/cpumask", "0,2\n");
+        write_fake_file(root, imc + "/format/event", "config:0-7,32-35\n");
+        write_fake_file(root, imc + "/format/umask", "config:8-15\n");
+        write_fake_file(root, imc + "/format/edge", "config:18\n");
+        write_fake_file(root, imc + "/format/thresh", "config1:0-7\n");
+        write_fake_file(root, imc + "/events/cas_count_read",
+                        "event=0x04,umask=0x03\n");
+    }
+    return root;
+}
+
+void test_pmus(const PmuEventParser& parser) {
+    const mperf::SysfsPmu* arm = parser.pmu("armv8_pmuv3_0");
+    check(arm && arm->type == 8 && !arm->is_uncore &&
+                  arm->cpus == std::vector<int>({0, 1, 2, 3}) &&
+                  arm->events.size() == 2 &&
+                  arm->events.at("cpu_cycles") == "event=0x0011",
+          "armv8_pmuv3_0 is a core pmu of 4 cpus and 2 events");
+    const mperf::SysfsPmu* imc = parser.pmu("uncore_imc_1");
+    check(imc && imc->type == 21 && imc->is_uncore &&
+                  imc->cpus == std::vector<int>({0, 2}) &&
+                  imc->formats.at("event").bits ==
+                          std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 32, 33,
+                                            34, 35}) &&
+                  imc->formats.at("thresh").config == 1,
+          "uncore_imc_1 is an uncore pmu of a split event field");
+    check(parser.pmu("uncore_imc") == nullptr, "no pmu of the family name");
+}
+
+void test_parse(const PmuEventParser& parser) {
+    check(same_attr(parser.parse("armv8_pmuv3_0/event=0x24/"),
+                    "armv8_pmuv3_0/event=0x24/", 8, 0x24, 0, false, 0, 1),
+          "a raw event counts the user space");
+    check(same_attr(parser.parse("armv8_pmuv3_0/cpu_cycles/k"),
+                    "armv8_pmuv3_0/cpu_cycles/k", 8, 0x11, 0, false, 1, 0),
+          "an event alias with the k modifier");
+    check(same_attr(parser.parse("armv8_pmuv3_0/inst_retired/uk"),
+                    "armv8_pmuv3_0/inst_retired/uk", 8, 0x8, 0, false, 0, 0),
+          "an event alias with the uk modifiers");
+    check(same_attr(parser.parse("armv8_pmuv3_0/cpu_cycles,long,name=cyc/"),
+                    "cyc", 8, 0x11, 1, false, 0, 1),
+          "a flag field of config1 and a name");
+    // bit 8 of the value goes to bit 32 of config
+    check(same_attr(parser.parse("uncore_imc_0/event=0x1ff,umask=0x3/"),
+                    "uncore_imc_0/event=0x1ff,umask=0x3/", 20, 0x1000003ff,
+                    0, true, 0, 1),
+          "a split field");
+    check(same_attr(parser.parse("uncore_imc_1/cas_count_read,edge,thresh=5/"),
+                    "uncore_imc_1/cas_count_read,edge,thresh=5/", 21,
+                    0x40304, 5, true, 0, 1),
+          "an uncore alias with a flag and a config1 term");
+    check(parser.parse("uncore_imc_0/event=0x4,event=0x5/").config == 0x5,
+          "the last term of a field wins");
+
+    std::vector<EventAttr> attrs = parser.parse_list(
+            "armv8_pmuv3_0/event=0x11,name=a/,uncore_imc_0/cas_count_read/u");
+    check(attrs.size() == 2 && attrs[0].name == "a" &&
+                  attrs[1].config == 0x304 && attrs[1].exclude_kernel == 1,
+          "a list split at the commas out of the terms");
+
+    check_throws([&] { parser.parse("cycles"); }, "an event without a pmu");
+    check_throws([&] { parser.parse("nopmu/event=1/"); }, "an unknown pmu");
+    check_throws([&] { parser.parse("armv8_pmuv3_0/umask=1/"); },
+                 "an unknown field");
+    check_throws([&] { parser.parse("armv8_pmuv3_0/no_such_event/"); },
+                 "an unknown alias");
+    check_throws([&] { parser.parse("armv8_pmuv3_0/event=0x10000/"); },
+                 "a value wider than its field");
+    check_throws([&] { parser.parse("armv8_pmuv3_0/event=?/"); },
+                 "a parameter term");
+    check_throws([&] { parser.parse("armv8_pmuv3_0/event=0x11/x"); },
+                 "an unknown modifier");
+}
+
+void test_uncore_instances(const PmuEventParser& parser) {
+    auto instances = [&parser](const std::string& event) {
+        EventAttr attr = parser.parse(event);
+        return instances_str(
+                parser.uncore_instances(attr.type, attr.all_instances));
+    };
+    const std::string all =
+            "uncore_imc_0@0 uncore_imc_0@2 uncore_imc_1@0 uncore_imc_1@2";
+    check(instances("uncore_imc/cas_count_read/") == all,
+          "the family counts on all the channels and sockets");
+    check(instances("uncore_imc_*/event=0x4/") == all,
+          "a wildcard counts on all the channels and sockets");
+    check(instances("uncore_imc_1/cas_count_read/") ==
+                  "uncore_imc_1@0 uncore_imc_1@2",
+          "a numbered pmu counts on its own sockets only");
+    check(instances_str(parser.uncore_instances(21)) == all,
+          "a table type counts on the family");
+    check(instances_str(parser.uncore_instances(8)) == "armv8_pmuv3_0@0",
+          "a core pmu has one instance");
+    auto unknown = parser.uncore_instances(99);
+    check(unknown.size() == 1 && unknown[0].type == 99 &&
+                  unknown[0].pmu.empty() && unknown[0].cpu == 0,
+          "an unknown type on cpu 0");
+}
+}  // namespace
+
+int main() {
+    std::string root = make_tree();
+    PmuEventParser parser(root);
+    test_pmus(parser);
+    test_parse(parser);
+    test_uncore_instances(parser);
+    remove_fake_root(root);
+    check(PmuEventParser(root).pmus().empty(), "no pmus without a tree");
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+import argparse
+import mmap
+import struct
+import numpy as np
+
+# the layout is documented in include/mperf/trace.h
+MAGIC = b"MPFTRACE"
+VERSION = 1
+BYTE_ORDER = 0x01020304
+BLOCK_RECORDS = 1
+BLOCK_REGIONS = 2
+
+def pad8(size):
+    return (size + 7) & ~7
+
+class Trace:
+    """A trace of mperf::TraceWriter, the columns are numpy arrays over the
+    mapped file, not copies."""
+
+    def __init__(self, fname):
+        with open(fname, "rb") as f:
+            self.buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        (magic, version, byte_order, header_size, num_counters, _,
+         self.start_realtime_ns) = struct.unpack_from("=8sIIQIIQ", self.buf, 0)
+        if magic != MAGIC or byte_order != BYTE_ORDER:
+            raise ValueError("%s is not a trace of this byte order" % fname)
+        if version > VERSION:
+            raise ValueError("%s is of a newer version %d" % (fname, version))
+
+        self.events = []
+        off = 40
+        for _ in range(num_counters):
+            type_, name_size, config, config1 = struct.unpack_from(
+                "=IIQQ", self.buf, off)
+            off += 24
+            name = bytes(self.buf[off:off + name_size]).decode()
+            off += pad8(name_size)
+            self.events.append((name, type_, config, config1))
+
+        self.regions = {}
+        self.blocks = []
+        off = header_size
+        while off + 16 <= len(self.buf):
+            type_, count, size = struct.unpack_from("=IIQ", self.buf, off)
+            data = off + 16
+            if size > len(self.buf) - data:
+                # the block being written when the trace was cut short
+                break
+            off = data + size
+            if type_ == BLOCK_RECORDS:
+                self.blocks.append(self._columns(data, count))
+            elif type_ == BLOCK_REGIONS:
+                p = data
+                for _ in range(count):
+                    rid, name_size = struct.unpack_from("=II", self.buf, p)
+                    self.regions[rid] = bytes(
+                        self.buf[p + 8:p + 8 + name_size]).decode()
+                    p += pad8(8 + name_size)
+
+    def _columns(self, off, count):
+        ts = np.frombuffer(self.buf, np.uint64, count, off)
+        off += 8 * count
+        region = np.frombuffer(self.buf, np.uint32, count, off)
+        off += pad8(4 * count)
+        counters = np.frombuffer(self.buf, np.uint64, count * len(self.events),
+                                 off).reshape(len(self.events), count)
+        return ts, region, counters
+
+    def names(self):
+        return [e[0] for e in self.events]
+
+    def column(self, name):
+        """The counter column of all the blocks, only copied when the trace
+        has more than one block."""
+        k = self.names().index(name)
+        return self._concat([b[2][k] for b in self.blocks], np.uint64)
+
+    def timestamps(self):
+        return self._concat([b[0] for b in self.blocks], np.uint64)
+
+    def region_ids(self):
+        return self._concat([b[1] for b in self.blocks], np.uint32)
+
+    @staticmethod
+    def _concat(arrays, dtype):
+        if not arrays:
+            return np.zeros(0, dtype)
+        return arrays[0] if len(arrays) == 1 else np.concatenate(arrays)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='print the counter time series of an mperf trace',
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument('-f', '--filename', help='input trace name')
+    args = parser.parse_args()
+
+    trace = Trace(args.filename)
+    names = trace.names()
+    print("%14s %-12s " % ("time(ms)", "region") +
+          " ".join("%20s" % n for n in names))
+    for ts, region, counters in trace.blocks:
+        for i in range(len(ts)):
+            print("%14.3f %-12s " % (ts[i] / 1e6,
+                                     trace.regions.get(int(region[i]), "-")) +
+                  " ".join("%20d" % c for c in counters[:, i]))
+
+if __name__ == '__main__':
+    main()
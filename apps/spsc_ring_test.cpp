@@ -0,0 +1,128 @@
+/**
+ * \file apps/spsc_ring_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check that a full SpscRing refuses the records, and that a producer
+ * and a consumer thread pass every record in order
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include "mperf/xpmu/spsc_ring.h"
+
+using mperf::SpscRing;
+
+namespace {
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what.c_str());
+    g_failures += !ok;
+}
+
+const size_t kWords = 3;
+
+void fill(uint64_t* record, uint64_t seq) {
+    record[0] = seq;
+    record[1] = seq * 7 + 1;
+    record[2] = ~seq;
+}
+
+bool record_ok(const uint64_t* record, uint64_t seq) {
+    return record[0] == seq && record[1] == seq * 7 + 1 && record[2] == ~seq;
+}
+
+void test_full() {
+    // rounded up to a power of 2
+    SpscRing ring(6, kWords);
+    check(ring.capacity() == 8 && ring.record_words() == kWords,
+          "the capacity is rounded up to 8");
+    check(ring.front() == nullptr, "an empty ring has no front");
+    size_t pushed = 0;
+    while (uint64_t* record = ring.acquire()) {
+        fill(record, pushed++);
+        ring.commit();
+        if (pushed > ring.capacity()) {
+            break;
+        }
+    }
+    check(pushed == ring.capacity() && ring.size() == ring.capacity(),
+          "a full ring refuses the record after " + std::to_string(pushed));
+    // one pop makes room for one record, which wraps around
+    const uint64_t* front = ring.front();
+    check(front && record_ok(front, 0), "the front is the first record");
+    ring.pop();
+    uint64_t* record = ring.acquire();
+    check(record != nullptr, "a pop makes room for a record");
+    if (record) {
+        fill(record, pushed++);
+        ring.commit();
+    }
+    check(ring.acquire() == nullptr, "the ring is full again");
+    bool ordered = true;
+    for (uint64_t seq = 1; seq < pushed; ++seq) {
+        front = ring.front();
+        ordered = ordered && front && record_ok(front, seq);
+        if (front) {
+            ring.pop();
+        }
+    }
+    check(ordered && ring.front() == nullptr && ring.size() == 0,
+          "the records are consumed in order");
+}
+
+void test_stress() {
+    const uint64_t kRecords = 1000000;
+    SpscRing ring(64, kWords);
+    size_t refused = 0;
+    std::thread producer([&ring, &refused, kRecords]() {
+        for (uint64_t seq = 0; seq < kRecords;) {
+            uint64_t* record = ring.acquire();
+            if (!record) {
+                ++refused;
+                std::this_thread::yield();
+                continue;
+            }
+            fill(record, seq++);
+            ring.commit();
+        }
+    });
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < kRecords && ordered) {
+        const uint64_t* record = ring.front();
+        if (!record) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = record_ok(record, expected++);
+        ring.pop();
+    }
+    // drain the ring if a record is out of order, so the producer ends
+    while (!ordered && expected++ < kRecords) {
+        while (!ring.front()) {
+            std::this_thread::yield();
+        }
+        ring.pop();
+    }
+    producer.join();
+    check(ordered, "the consumer reads " + std::to_string(kRecords) +
+                           " records in order");
+    check(ring.size() == 0 && ring.front() == nullptr,
+          "the ring is empty at the end");
+    printf("the producer found the ring full %zu times\n", refused);
+}
+}  // namespace
+
+int main() {
+    test_full();
+    test_stress();
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
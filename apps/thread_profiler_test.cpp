@@ -0,0 +1,210 @@
+/**
+ * \file apps/thread_profiler_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check that ThreadPmuProfiler counts a thread created after run() on
+ * its own from the next sample(), and takes its counts off its creator, by
+ * fake counters inherited like the perf ones
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "vendor/cpu/thread_profiler.h"
+
+using mperf::CpuMeasurements;
+using mperf::CpuProfiler;
+using mperf::EventAttr;
+using mperf::ThreadPmuProfiler;
+
+namespace {
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what.c_str());
+    g_failures += !ok;
+}
+
+// the counts of the threads, and the threads they created. A counter counts
+// the threads its thread created after it was opened, as an inherited perf
+// counter does.
+struct World {
+    std::mutex mutex;
+    uint64_t epoch = 0;
+    std::map<pid_t, uint64_t> counts;
+    std::map<pid_t, pid_t> creators;
+    std::map<pid_t, uint64_t> births;
+
+    uint64_t count(pid_t tid) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return counts[tid];
+    }
+    void set(pid_t tid, uint64_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counts[tid] = count;
+    }
+    void create(pid_t tid, pid_t creator) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counts[tid] = 0;
+        creators[tid] = creator;
+        births[tid] = ++epoch;
+    }
+};
+
+World g_world;
+
+class FakeProfiler final : public CpuProfiler {
+public:
+    explicit FakeProfiler(pid_t tid) : tid_(tid) {
+        std::lock_guard<std::mutex> lock(g_world.mutex);
+        epoch_ = ++g_world.epoch;
+    }
+
+#if MPERF_WITH_PFM
+    void set_enabled_counters(const std::vector<std::string>&) override {}
+#endif
+    void set_enabled_counters(const std::vector<EventAttr>&) override {}
+    void set_counter_group_size(size_t) override {}
+    void run() override {
+        std::lock_guard<std::mutex> lock(g_world.mutex);
+        base_ = g_world.counts;
+    }
+    const CpuMeasurements& sample() override {
+        std::lock_guard<std::mutex> lock(g_world.mutex);
+        uint64_t val = g_world.counts[tid_] - base_[tid_];
+        for (auto& it : g_world.creators) {
+            if (it.second == tid_ && g_world.births[it.first] > epoch_) {
+                val += g_world.counts[it.first] - base_[it.first];
+            }
+        }
+        results_ = {{"cycles", val}};
+        ratios_ = {1.f};
+        return results_;
+    }
+    mperf::CpuValues sample_values() override {
+        sample();
+        value_ = results_[0].second;
+        return {&value_, 1};
+    }
+    const mperf::CpuRunningRatios& running_ratios() const override {
+        return ratios_;
+    }
+    const std::vector<CpuMeasurements>& core_pmu_measurements()
+            const override {
+        static const std::vector<CpuMeasurements> none;
+        return none;
+    }
+    const mperf::CpuThreadMeasurements& thread_measurements() const override {
+        static const mperf::CpuThreadMeasurements none;
+        return none;
+    }
+    const mperf::CpuCoreMeasurements& core_measurements() const override {
+        static const mperf::CpuCoreMeasurements none;
+        return none;
+    }
+    const mperf::CpuClusterMeasurements& cluster_measurements()
+            const override {
+        static const mperf::CpuClusterMeasurements none;
+        return none;
+    }
+    const mperf::CpuHotspots& hotspots() const override {
+        static const mperf::CpuHotspots none;
+        return none;
+    }
+    void stop() override {}
+    void set_uncore_event_enabled() override {}
+    void set_user_read_enabled(bool) override {}
+    bool is_user_read() const override { return false; }
+
+private:
+    pid_t tid_;
+    uint64_t epoch_;
+    std::map<pid_t, uint64_t> base_;
+    CpuMeasurements results_;
+    mperf::CpuRunningRatios ratios_;
+    uint64_t value_ = 0;
+};
+
+pid_t gettid_() {
+    return static_cast<pid_t>(syscall(SYS_gettid));
+}
+
+// the count of tid in the last sample, -1 if not counted
+int64_t thread_count(const ThreadPmuProfiler& profiler, pid_t tid) {
+    for (auto& it : profiler.thread_measurements()) {
+        if (it.first == tid) {
+            return static_cast<int64_t>(it.second[0].second);
+        }
+    }
+    return -1;
+}
+}  // namespace
+
+int main() {
+    const pid_t main_tid = gettid_();
+    g_world.set(main_tid, 100);
+    ThreadPmuProfiler profiler(
+            [](const std::vector<EventAttr>&, size_t, pid_t tid) {
+                return std::unique_ptr<CpuProfiler>(new FakeProfiler(tid));
+            },
+            {EventAttr("cycles")});
+    profiler.run();
+
+    // a thread created after run(), living until the end
+    std::atomic<pid_t> worker_tid{0};
+    std::atomic<bool> done{false};
+    std::thread worker([&]() {
+        g_world.create(gettid_(), main_tid);
+        worker_tid = gettid_();
+        while (!done) {
+            std::this_thread::yield();
+        }
+    });
+    while (!worker_tid) {
+        std::this_thread::yield();
+    }
+    const pid_t tid = worker_tid;
+    // counted with the main thread before the sample finds it
+    g_world.set(tid, 30);
+    g_world.set(main_tid, 150);
+    uint64_t total = profiler.sample()[0].second;
+    check(thread_count(profiler, tid) == 0,
+          "the sample opens the counters of the new thread");
+    check(thread_count(profiler, main_tid) == 80 && total == 80,
+          "the counts before the sample stay with the creator");
+
+    g_world.set(tid, 70);
+    g_world.set(main_tid, 170);
+    total = profiler.sample()[0].second;
+    check(thread_count(profiler, tid) == 40,
+          "the new thread is counted on its own");
+    check(thread_count(profiler, main_tid) == 100,
+          "its counts are taken off the creator");
+    check(total == 140, "the total counts the new thread once");
+
+    // the next run counts every thread on its own
+    profiler.run();
+    g_world.set(tid, 80);
+    g_world.set(main_tid, 175);
+    total = profiler.sample()[0].second;
+    check(thread_count(profiler, tid) == 10 &&
+                  thread_count(profiler, main_tid) == 5 && total == 15,
+          "the next run counts every thread on its own");
+
+    done = true;
+    worker.join();
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * \file apps/tma_sessions_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check that the MPFTMA sessions evaluating the records of a55, on two
+ * threads at once or interleaved on one thread, get the results of each
+ * session alone
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "arch_ratios/a55_events.h"
+#include "mperf/exception.h"
+#include "mperf/tma/tma.h"
+#include "mperf/trace.h"
+
+using mperf::EventAttr;
+using mperf::tma::MPFTMA;
+
+namespace {
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what.c_str());
+    g_failures += !ok;
+}
+
+const std::vector<std::string> kMetrics = {
+        "Frontend_Bound", "Fetch_Latency", "Backend_Bound",
+        "Memory_Bound",   "Retiring",      "Bad_Speculation"};
+const size_t kIntervals = 50;
+
+namespace catalog = mperf::tma::a55_events;
+
+double cycles(int seed, size_t interval) {
+    return 1e6 * seed + 1000.0 * interval;
+}
+
+// the count of the k-th event of the catalog, a fraction of the cycles
+double count(int seed, size_t interval, size_t k) {
+    if (k == catalog::find("CPU_CYCLES")) {
+        return cycles(seed, interval);
+    }
+    if (k == catalog::find("time_interval")) {
+        return 10;
+    }
+    return cycles(seed, interval) * ((k * 7 + seed * 3 + interval) % 17 + 1) /
+           40.0;
+}
+
+// a record of a55 of every event of the catalog, the values differ by the
+// seed, an interval record if intervals > 0
+void write_record(const std::string& path, int seed, size_t intervals) {
+    std::vector<EventAttr> counters;
+    for (auto& ev : catalog::kEvents) {
+        counters.push_back(ev);
+    }
+    std::string info = "mperf_tma_record 3\nxpu_type A55\ninterval_ms " +
+                       std::to_string(intervals ? 10 : 0) + "\nmetrics";
+    for (auto& metric : kMetrics) {
+        info += " " + metric;
+    }
+    info += "\n";
+    mperf::TraceWriter trace(path, counters, 16, info);
+    std::vector<uint64_t> bits(counters.size());
+    for (size_t i = 0; i < std::max<size_t>(intervals, 1); ++i) {
+        for (size_t k = 0; k < counters.size(); ++k) {
+            double val = count(seed, i, k);
+            memcpy(&bits[k], &val, sizeof(val));
+        }
+        trace.append((i + 1) * 10000000, mperf::kTraceNoRegion, bits.data());
+    }
+}
+
+bool same(const std::vector<float>& a, const std::vector<float>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!(a[i] == b[i] || (isnan(a[i]) && isnan(b[i])))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the metrics of every interval of a record
+std::vector<std::vector<float>> evaluate_intervals(const std::string& path) {
+    MPFTMA tma(mperf::A55);
+    tma.load_record(path);
+    std::vector<std::vector<float>> res;
+    for (auto& interval : tma.stop_interval()) {
+        res.push_back(interval.values);
+    }
+    return res;
+}
+
+bool same_intervals(const std::vector<std::vector<float>>& a,
+                    const std::vector<std::vector<float>>& b) {
+    bool ok = a.size() == b.size();
+    for (size_t i = 0; ok && i < a.size(); ++i) {
+        ok = same(a[i], b[i]);
+    }
+    return ok;
+}
+
+void test_concurrent(const std::string& dir) {
+    const std::string path_a = dir + "/a.mpt", path_b = dir + "/b.mpt";
+    write_record(path_a, 1, kIntervals);
+    write_record(path_b, 2, kIntervals);
+    auto ref_a = evaluate_intervals(path_a);
+    auto ref_b = evaluate_intervals(path_b);
+    check(ref_a.size() == kIntervals && ref_b.size() == kIntervals,
+          "the intervals of the records are evaluated");
+    if (ref_a.size() != kIntervals || ref_b.size() != kIntervals) {
+        return;
+    }
+    // Frontend_Bound is STALL_FRONTEND / CPU_CYCLES on a55
+    size_t fe = catalog::find("STALL_FRONTEND");
+    float expected = count(1, 3, fe) / cycles(1, 3);
+    check(fabsf(ref_a[3][0] - expected) < 1e-5f,
+          "Frontend_Bound of the record is " + std::to_string(expected));
+    // Bad_Speculation refers to the nodes of the level 1 metrics
+    const auto& r = ref_a[3];
+    check(fabsf(r[5] - (1 - (r[0] + r[2] + r[4]))) < 1e-5f,
+          "Bad_Speculation is computed after the metrics it refers to");
+    check(!same(ref_a[3], ref_b[3]), "the records have different metrics");
+
+    // each thread loads its record over and over, while the other one does
+    const int kRounds = 20;
+    bool ok_a = true, ok_b = true;
+    auto run = [kRounds](const std::string& path,
+                         const std::vector<std::vector<float>>& ref,
+                         bool* ok) {
+        for (int r = 0; r < kRounds && *ok; ++r) {
+            *ok = same_intervals(evaluate_intervals(path), ref);
+        }
+    };
+    std::thread ta(run, path_a, std::cref(ref_a), &ok_a);
+    std::thread tb(run, path_b, std::cref(ref_b), &ok_b);
+    ta.join();
+    tb.join();
+    check(ok_a && ok_b,
+          "two sessions on two threads get the results of each one alone");
+    unlink(path_a.c_str());
+    unlink(path_b.c_str());
+}
+
+void test_interleaved(const std::string& dir) {
+    const std::string path_a = dir + "/a.mpt", path_b = dir + "/b.mpt";
+    write_record(path_a, 3, 0);
+    write_record(path_b, 4, 0);
+    std::vector<float> ref_a, ref_b;
+    {
+        MPFTMA tma(mperf::A55);
+        tma.load_record(path_a);
+        ref_a = tma.metric_values();
+    }
+    {
+        MPFTMA tma(mperf::A55);
+        tma.load_record(path_b);
+        ref_b = tma.metric_values();
+    }
+    check(ref_a.size() == kMetrics.size() && !same(ref_a, ref_b),
+          "the records have different metrics");
+    // the sessions are loaded and evaluated in turn on this thread
+    MPFTMA tma_a(mperf::A55);
+    MPFTMA tma_b(mperf::A55);
+    tma_a.load_record(path_a);
+    bool ok = same(tma_a.metric_values(), ref_a);
+    tma_b.load_record(path_b);
+    for (int r = 0; r < 10; ++r) {
+        ok = ok && same(tma_b.metric_values(), ref_b) &&
+             same(tma_a.metric_values(), ref_a);
+    }
+    check(ok, "two sessions interleaved on one thread get the results of "
+              "each one alone");
+    tma_a.deinit();
+    tma_b.deinit();
+    unlink(path_a.c_str());
+    unlink(path_b.c_str());
+}
+}  // namespace
+
+int main() {
+    try {
+        MPFTMA probe(mperf::A55);
+    } catch (const mperf::MperfError&) {
+        printf("skip, the ratio tables of a55 are not built\n");
+        return 0;
+    }
+    char dir[] = "/tmp/mperf_tma_sessions_testXXXXXX";
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    try {
+        test_concurrent(dir);
+        test_interleaved(dir);
+    } catch (const mperf::MperfError& e) {
+        check(false, e.what());
+    }
+    rmdir(dir);
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
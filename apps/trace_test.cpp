@@ -0,0 +1,178 @@
+/**
+ * \file apps/trace_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check the records and region names a trace reads back, and that a
+ * trace cut short is read up to its last complete block
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "mperf/exception.h"
+#include "mperf/trace.h"
+
+using mperf::EventAttr;
+using mperf::TraceReader;
+using mperf::TraceWriter;
+
+namespace {
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what.c_str());
+    g_failures += !ok;
+}
+
+const size_t kBlockRecords = 64;
+// 5 full blocks, then 10 records written by the flush
+const size_t kRecords = kBlockRecords * 5 + 10;
+const size_t kCounters = 3;
+
+uint64_t counter_value(size_t i, size_t k) {
+    return i * (k + 1) + (uint64_t(k) << 40);
+}
+
+void write_trace(const std::string& path) {
+    std::vector<EventAttr> counters = {
+            EventAttr("cycles", 0x11, 4, 0), EventAttr("instructions", 0x8, 4, 0),
+            EventAttr("l1d_refill", 0x3, 4, 0)};
+    TraceWriter writer(path, counters, kBlockRecords, "the trace test");
+    writer.set_region_name(0, "conv");
+    writer.set_region_name(1, "matmul");
+    writer.flush();
+    uint64_t values[kCounters];
+    for (size_t i = 0; i < kRecords; ++i) {
+        for (size_t k = 0; k < kCounters; ++k) {
+            values[k] = counter_value(i, k);
+        }
+        uint32_t region = i % 3 == 2 ? mperf::kTraceNoRegion : i % 3;
+        writer.append(i * 1000, region, values);
+    }
+    writer.set_region_name(2, "pool");
+    writer.flush();
+}
+
+// the records of the first num_blocks blocks are the ones written
+bool records_ok(const TraceReader& reader) {
+    size_t i = 0;
+    for (size_t b = 0; b < reader.num_blocks(); ++b) {
+        const uint64_t* ts = reader.timestamps(b);
+        const uint32_t* regions = reader.regions(b);
+        for (size_t r = 0; r < reader.block_size(b); ++r, ++i) {
+            uint32_t region = i % 3 == 2 ? mperf::kTraceNoRegion : i % 3;
+            if (ts[r] != i * 1000 || regions[r] != region) {
+                return false;
+            }
+            for (size_t k = 0; k < kCounters; ++k) {
+                if (reader.counter(b, k)[r] != counter_value(i, k)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return i == reader.num_records();
+}
+
+// the offset of the payload of a record block in the file
+size_t block_offset(const TraceReader& reader, size_t block) {
+    return reinterpret_cast<const uint8_t*>(reader.timestamps(block)) -
+           reinterpret_cast<const uint8_t*>(&reader.header());
+}
+
+void test_round_trip(const std::string& path) {
+    write_trace(path);
+    TraceReader reader(path);
+    check(reader.header().num_counters == kCounters &&
+                  reader.events().size() == kCounters &&
+                  reader.events()[1].name == "instructions" &&
+                  reader.events()[1].config == 0x8,
+          "the events read back");
+    check(reader.info() == "the trace test", "the info reads back");
+    check(reader.event_index("l1d_refill") == 2 &&
+                  reader.event_index("branches") == -1,
+          "the events are found by name");
+    check(reader.num_blocks() == 6 && reader.block_size(0) == kBlockRecords &&
+                  reader.block_size(5) == kRecords - 5 * kBlockRecords,
+          "the records are read in 6 blocks");
+    check(reader.num_records() == kRecords && records_ok(reader),
+          "the records read back");
+    check(reader.region_name(0) == "conv" && reader.region_name(1) == "matmul" &&
+                  reader.region_name(2) == "pool" &&
+                  reader.region_name(3).empty(),
+          "the region names read back");
+}
+
+void test_truncated(const std::string& path) {
+    size_t cut_header = 0, cut_payload = 0, cut_last = 0;
+    {
+        TraceReader reader(path);
+        // in the block header of block 3, in the payload of block 4, and in
+        // the region block written after the last record block
+        cut_header = block_offset(reader, 3) - 8;
+        cut_payload = block_offset(reader, 4) + 8 * kBlockRecords + 4;
+        cut_last = block_offset(reader, 4) + 8 * kBlockRecords * (kCounters + 1) +
+                   TraceReader::region_column_size(kBlockRecords) + 8;
+    }
+    struct Case {
+        size_t size;
+        size_t blocks;
+        const char* where;
+    };
+    // the cuts are applied from the longest on, each one shortens the trace
+    Case cases[] = {{cut_last, 5, "in the block after block 4"},
+                    {cut_payload, 4, "in the payload of block 4"},
+                    {cut_header, 3, "in the header of block 3"}};
+    for (auto& c : cases) {
+        if (truncate(path.c_str(), c.size) != 0) {
+            check(false, std::string("truncate the trace ") + c.where);
+            continue;
+        }
+        TraceReader reader(path);
+        check(reader.num_blocks() == c.blocks &&
+                      reader.num_records() == c.blocks * kBlockRecords &&
+                      records_ok(reader),
+              std::string("a trace cut ") + c.where + " reads " +
+                      std::to_string(c.blocks) + " blocks");
+        check(reader.region_name(1) == "matmul" && reader.region_name(2).empty(),
+              std::string("a trace cut ") + c.where +
+                      " keeps the region names before the cut");
+    }
+    // a trace cut in its header is not a trace
+    bool thrown = false;
+    if (truncate(path.c_str(), sizeof(mperf::TraceHeader) - 8) == 0) {
+        try {
+            TraceReader reader(path);
+        } catch (const mperf::MperfError&) {
+            thrown = true;
+        }
+    }
+    check(thrown, "a trace cut in its header throws");
+}
+}  // namespace
+
+int main() {
+    char dir[] = "/tmp/mperf_trace_testXXXXXX";
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    const std::string path = std::string(dir) + "/trace.mpt";
+    try {
+        test_round_trip(path);
+        test_truncated(path);
+    } catch (const mperf::MperfError& e) {
+        check(false, e.what());
+    }
+    unlink(path.c_str());
+    rmdir(dir);
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
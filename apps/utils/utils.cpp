@@ -1,4 +1,7 @@
 #include "utils.h"
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 void mperf_usage(int argc, char* argv[], std::string& usage) {
     fprintf(stderr, "Usage: %s %s", argv[0], usage.c_str());
@@ -23,3 +26,37 @@ uint64 bytes(char* s) {
         n *= (1024 * 1024);
     return (n);
 }
+
+std::string make_fake_root() {
+    char dir[] = "/tmp/mperf_fake_root_XXXXXX";
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        exit(-1);
+    }
+    return dir;
+}
+
+void write_fake_file(const std::string& root, const std::string& path,
+                     const std::string& content) {
+    std::string full = root + path;
+    for (size_t slash = full.find('/', root.size() + 1);
+         slash != std::string::npos; slash = full.find('/', slash + 1)) {
+        mkdir(full.substr(0, slash).c_str(), 0755);
+    }
+    FILE* fp = fopen(full.c_str(), "wb");
+    if (!fp) {
+        perror(full.c_str());
+        exit(-1);
+    }
+    fwrite(content.data(), 1, content.size(), fp);
+    fclose(fp);
+}
+
+static int remove_entry(const char* path, const struct stat*, int,
+                        struct FTW*) {
+    return remove(path);
+}
+
+void remove_fake_root(const std::string& root) {
+    nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+}
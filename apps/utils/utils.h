@@ -12,3 +12,11 @@ typedef unsigned long long uint64;
 void mperf_usage(int argc, char* argv[], std::string& usage);
 
 uint64 bytes(char* s);
+
+// a fake root of /proc and /sys for the tests of the parsers taking a root
+std::string make_fake_root();
+// write the file of path(e.g. "/proc/cpuinfo") under the root, creating its
+// directories
+void write_fake_file(const std::string& root, const std::string& path,
+                     const std::string& content);
+void remove_fake_root(const std::string& root);
@@ -0,0 +1,177 @@
+/**
+ * \file apps/x86_events_test.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \brief check the encodings X86EventMap loads from a toplev raw event map,
+ * by the fields of a fake intel core pmu, and the events the x86 catalogs
+ * leave to it
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+#include <stdio.h>
+#include <set>
+#include <string>
+#include "arch_ratios/snb_client_events.h"
+#include "arch_ratios/jkt_server_events.h"
+#include "arch_ratios/ivb_client_events.h"
+#include "arch_ratios/ivb_server_events.h"
+#include "arch_ratios/hsw_client_events.h"
+#include "arch_ratios/hsx_server_events.h"
+#include "arch_ratios/bdw_client_events.h"
+#include "arch_ratios/bdx_server_events.h"
+#include "arch_ratios/skl_client_events.h"
+#include "arch_ratios/skx_server_events.h"
+#include "arch_ratios/clx_server_events.h"
+#include "arch_ratios/icl_client_events.h"
+#include "arch_ratios/icx_server_events.h"
+#include "arch_ratios/spr_server_events.h"
+#include "arch_ratios/adl_glc_events.h"
+#include "arch_ratios/adl_grt_events.h"
+#include "utils/utils.h"
+#include "x86_events.h"
+
+using mperf::EventAttr;
+using mperf::tma::CatalogEvent;
+using mperf::tma::X86EventMap;
+
+namespace {
+int g_failures = 0;
+
+void check(bool ok, const std::string& what) {
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what.c_str());
+    g_failures += !ok;
+}
+
+// the formats of the core pmu of sapphire rapids, with the extended umask
+std::string make_tree() {
+    std::string root = make_fake_root();
+    const std::string cpu = "/sys/bus/event_source/devices/cpu";
+    write_fake_file(root, cpu + "/type", "4\n");
+    write_fake_file(root, cpu + "/cpus", "0-3\n");
+    write_fake_file(root, cpu + "/format/event", "config:0-7\n");
+    write_fake_file(root, cpu + "/format/umask", "config:8-15,40-47\n");
+    write_fake_file(root, cpu + "/format/edge", "config:18\n");
+    write_fake_file(root, cpu + "/format/any", "config:21\n");
+    write_fake_file(root, cpu + "/format/inv", "config:23\n");
+    write_fake_file(root, cpu + "/format/cmask", "config:24-31\n");
+    write_fake_file(root, cpu + "/format/offcore_rsp", "config1:0-63\n");
+    write_fake_file(root, cpu + "/format/frontend", "config1:0-23\n");
+    write_fake_file(root, "/map.csv",
+                    "# the raw events of toplev\n"
+                    "CYCLE_ACTIVITY.STALLS_L2_MISS,cpu/event=0xa3,umask=0x5,"
+                    "cmask=5/\n"
+                    "INT_MISC.RECOVERY_CYCLES,cpu/event=0xd,umask=0x1/\n"
+                    "UOPS_EXECUTED.CORE,cpu/event=0xb1,umask=0x2,any/uk\n"
+                    "OCR.DEMAND_DATA_RD.L3_MISS,cpu/event=0x2a,umask=0x1,"
+                    "offcore_rsp=0x3fbfc00001/\n"
+                    "MEM_UOP_RETIRED.ANY,cpu/event=0xe5,umask=0x103/\n"
+                    "BAD.EVENT,cpu/event=0x1,bogus=1/\n");
+    return root;
+}
+
+bool encoded(const X86EventMap& map, const std::string& name,
+             uint64_t config, uint64_t config1 = 0) {
+    EventAttr attr(name);
+    return map.resolve(attr) && attr.name == name && attr.config == config &&
+           attr.config1 == config1 && attr.type == 4;
+}
+
+void test_load(const X86EventMap& map) {
+    check(encoded(map, "CYCLE_ACTIVITY.STALLS_L2_MISS", 0x50005a3),
+          "the cmask term");
+    check(encoded(map, "OCR.DEMAND_DATA_RD.L3_MISS", 0x12a, 0x3fbfc00001),
+          "the offcore response in config1");
+    check(encoded(map, "MEM_UOP_RETIRED.ANY", 0x100000003e5ULL),
+          "the extended umask");
+    EventAttr attr("UOPS_EXECUTED.CORE");
+    check(map.resolve(attr) && attr.config == 0x2002b1 && !attr.exclude_user &&
+                  !attr.exclude_kernel,
+          "the any flag and the uk modifiers");
+    EventAttr bad("BAD.EVENT");
+    check(!map.resolve(bad), "an unknown field is not loaded");
+    check(encoded(map, "TOPDOWN.SLOTS", 0x400), "the built-in events");
+}
+
+void test_modifiers(const X86EventMap& map) {
+    check(encoded(map, "INT_MISC.RECOVERY_CYCLES:c1:e1", 0x104010d),
+          "the cmask and edge modifiers");
+    check(encoded(map, "CYCLE_ACTIVITY.STALLS_L2_MISS:c2", 0x20005a3),
+          "a modifier overrides the term of the base event");
+    check(encoded(map, "UOPS_EXECUTED.CORE:i1:c1", 0x1a002b1),
+          "the inv modifier");
+    check(encoded(map, "INT_MISC.RECOVERY_CYCLES:uF", 0xf0d),
+          "the umask modifier is hex");
+    EventAttr percore("UOPS_EXECUTED.CORE:percore");
+    check(!map.resolve(percore), "an unknown modifier is not resolved");
+    EventAttr unknown("UNKNOWN.EVENT:c1");
+    check(!map.resolve(unknown), "an unknown base event is not resolved");
+}
+
+// the events of a catalog the pinned pmu-events json does not encode
+template <size_t N>
+std::set<std::string> unencoded(const CatalogEvent (&events)[N]) {
+    std::set<std::string> names;
+    for (auto& ev : events) {
+        if (!ev.has_encoding) {
+            names.insert(ev.name);
+        }
+    }
+    return names;
+}
+
+void test_catalogs() {
+    namespace tma = mperf::tma;
+    const std::set<std::string> none;
+    const std::set<std::string> skl = {"DSB2MITE_SWITCHES.COUNT",
+                                       "INST_RETIRED.NOP"};
+    const std::set<std::string> icl = {"TOPDOWN.SLOTS:percore"};
+    const std::set<std::string> glc = {"FRONTEND_RETIRED.ANY_DSB_MISS",
+                                       "INT_MISC.UNKNOWN_BRANCH_CYCLES",
+                                       "TOPDOWN.SLOTS:percore"};
+    const std::set<std::string> llc_hitm = {
+            "OFFCORE_RESPONSE.DEMAND_RFO.LLC_MISS.REMOTE_HITM"};
+    check(unencoded(tma::snb_client_events::kEvents) == none &&
+                  unencoded(tma::jkt_server_events::kEvents) == none &&
+                  unencoded(tma::ivb_client_events::kEvents) == none &&
+                  unencoded(tma::hsw_client_events::kEvents) == none &&
+                  unencoded(tma::bdw_client_events::kEvents) == none &&
+                  unencoded(tma::adl_grt_events::kEvents) == none,
+          "the catalogs of the clients and gracemont encode every event");
+    check(unencoded(tma::ivb_server_events::kEvents) == llc_hitm &&
+                  unencoded(tma::hsx_server_events::kEvents) == llc_hitm &&
+                  unencoded(tma::bdx_server_events::kEvents) == llc_hitm,
+          "the server catalogs leave the remote hitm responses");
+    auto skx = skl;
+    skx.insert("OFFCORE_RESPONSE.DEMAND_RFO.L3_MISS.REMOTE_HITM");
+    skx.insert("OFFCORE_RESPONSE.PF_L2_RFO.L3_MISS.REMOTE_HITM");
+    check(unencoded(tma::skl_client_events::kEvents) == skl &&
+                  unencoded(tma::skx_server_events::kEvents) == skx &&
+                  unencoded(tma::clx_server_events::kEvents) == skl,
+          "the skylake catalogs");
+    check(unencoded(tma::icl_client_events::kEvents) == icl &&
+                  unencoded(tma::icx_server_events::kEvents) == icl &&
+                  unencoded(tma::spr_server_events::kEvents) == glc &&
+                  unencoded(tma::adl_glc_events::kEvents) == glc,
+          "the icelake and golden cove catalogs");
+    size_t i = tma::spr_server_events::find("UOPS_ISSUED.ANY");
+    check(i != mperf::tma::kCatalogNpos &&
+                  tma::spr_server_events::kEvents[i].config == 0x1ae,
+          "the golden cove encodings of the json");
+}
+}  // namespace
+
+int main() {
+    std::string root = make_tree();
+    X86EventMap map(root);
+    check(map.load(root + "/map.csv") == 5, "5 events are loaded");
+    test_load(map);
+    test_modifiers(map);
+    test_catalogs();
+    remove_fake_root(root);
+    if (g_failures) {
+        printf("%d failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -76,7 +76,9 @@
 #endif
 
 #include <assert.h>
+#include <dirent.h>
 #include <errno.h>
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -917,6 +919,30 @@ int mperf::cpu_info_get_big_cpu_count() {
     return big_cpu_count ? big_cpu_count : g_cpucount;
 }
 
+std::vector<int> mperf::cpu_info_get_cluster_cpus(int cluster) {
+    std::vector<int> cpus;
+    if (cluster == 0) {
+        for (int i = 0; i < g_cpucount; i++) {
+            cpus.push_back(i);
+        }
+        return cpus;
+    }
+    if (cluster < 0 || cluster > 3) {
+        printf("cluster %d not supported\n", cluster);
+        return cpus;
+    }
+    const CpuSet& mask = get_cpu_thread_affinity_mask(cluster);
+    for (int i = 0; i < g_cpucount; i++) {
+        if (mask.is_enabled(i))
+            cpus.push_back(i);
+    }
+    // the cores of the same frequency are all big, cf.
+    // cpu_info_get_big_cpu_count
+    if (cluster == 3 && cpus.empty())
+        return cpu_info_get_cluster_cpus(0);
+    return cpus;
+}
+
 int mperf::cpu_info_set_cpu_powersave(int powersave) {
 #if defined __ANDROID__ || defined __linux__
     if (powersave < 0 || powersave > 3) {
@@ -1182,3 +1208,317 @@ double mperf::cpu_process_time_ms() {
         return ts.tv_sec * 1e3 + (static_cast<double>(ts.tv_nsec) * 1e-6);
     return 0.0;
 }
+
+mperf::MPFXPUType mperf::cpu_info_xpu_type_from_midr(uint64_t midr) {
+    uint32_t implementer = (midr >> 24) & 0xff;
+    uint32_t part = (midr >> 4) & 0xfff;
+    // ARM Ltd.
+    if (implementer == 0x41) {
+        switch (part) {
+            case 0xd05:
+                return A55;
+            case 0xd46:
+                return A510;
+            default:
+                break;
+        }
+    }
+    return DEFAULT;
+}
+
+mperf::MPFXPUType mperf::cpu_info_xpu_type_from_x86(int family, int model,
+                                                    int stepping) {
+    if (family != 6) {
+        return DEFAULT;
+    }
+    switch (model) {
+        case 0x2a:
+            return SNB_CLIENT;
+        case 0x2d:
+            return JKT_SERVER;
+        case 0x3a:
+            return IVB_CLIENT;
+        case 0x3e:
+            return IVB_SERVER;
+        case 0x3c:
+        case 0x45:
+        case 0x46:
+            return HSW_CLIENT;
+        case 0x3f:
+            return HSX_SERVER;
+        case 0x3d:
+        case 0x47:
+            return BDW_CLIENT;
+        case 0x4f:
+        case 0x56:
+            return BDX_SERVER;
+        case 0x4e:
+        case 0x5e:
+        case 0x8e:
+        case 0x9e:
+        case 0xa5:
+        case 0xa6:
+            return SKL_CLIENT;
+        case 0x55:
+            // cascade lake and cooper lake share the model of skylake-sp
+            return stepping >= 5 ? CLX_SERVER : SKX_SERVER;
+        case 0x7d:
+        case 0x7e:
+            return ICL_CLIENT;
+        case 0x6a:
+        case 0x6c:
+            return ICX_SERVER;
+        // the golden cove cores of the hybrid parts
+        case 0x97:
+        case 0x9a:
+            return ADL_GLC;
+        case 0x8f:
+            return SPR_SERVER;
+        default:
+            return DEFAULT;
+    }
+}
+
+// the value of a "key : value" line of /proc/cpuinfo, nullptr if the line is
+// not the key
+static const char* cpuinfo_value(const char* line, const char* key) {
+    size_t n = strlen(key);
+    if (strncmp(line, key, n) != 0)
+        return nullptr;
+    const char* p = line + n;
+    while (*p == ' ' || *p == '\t')
+        ++p;
+    return *p == ':' ? p + 1 : nullptr;
+}
+
+static std::map<int, mperf::MPFXPUType> xpu_types_from_cpuinfo(
+        const std::string& root) {
+    std::map<int, mperf::MPFXPUType> types;
+    FILE* fp = fopen((root + "/proc/cpuinfo").c_str(), "rb");
+    if (!fp)
+        return types;
+
+    struct CoreId {
+        int processor = -1;
+        long implementer = -1, part = -1;
+        int family = -1, model = -1, stepping = -1;
+    };
+    std::vector<CoreId> cores;
+    // the fields out of the block of a core(e.g. the old arm kernels print
+    // the cpu part once after all the cores) apply to every core.
+    CoreId shared;
+    bool in_block = false;
+    char line[1024];
+    while (fgets(line, sizeof(line), fp)) {
+        const char* v;
+        CoreId* cur = in_block ? &cores.back() : &shared;
+        if ((v = cpuinfo_value(line, "processor"))) {
+            cores.push_back({});
+            cores.back().processor = atoi(v);
+            in_block = true;
+        } else if ((v = cpuinfo_value(line, "CPU implementer"))) {
+            cur->implementer = strtol(v, nullptr, 0);
+        } else if ((v = cpuinfo_value(line, "CPU part"))) {
+            cur->part = strtol(v, nullptr, 0);
+        } else if ((v = cpuinfo_value(line, "cpu family"))) {
+            cur->family = atoi(v);
+        } else if ((v = cpuinfo_value(line, "model"))) {
+            cur->model = atoi(v);
+        } else if ((v = cpuinfo_value(line, "stepping"))) {
+            cur->stepping = atoi(v);
+        } else if (line[0] == '\n') {
+            in_block = false;
+        }
+    }
+    fclose(fp);
+
+    for (auto& core : cores) {
+        long implementer =
+                core.implementer >= 0 ? core.implementer : shared.implementer;
+        long part = core.part >= 0 ? core.part : shared.part;
+        int family = core.family >= 0 ? core.family : shared.family;
+        int model = core.model >= 0 ? core.model : shared.model;
+        int stepping = core.stepping >= 0 ? core.stepping : shared.stepping;
+        if (implementer >= 0 && part >= 0) {
+            types[core.processor] = mperf::cpu_info_xpu_type_from_midr(
+                    (uint64_t)implementer << 24 | (uint64_t)part << 4);
+        } else if (family >= 0 && model >= 0) {
+            types[core.processor] = mperf::cpu_info_xpu_type_from_x86(
+                    family, model, stepping);
+        }
+    }
+    return types;
+}
+
+static std::map<int, mperf::MPFXPUType> xpu_types_from_midr(
+        const std::string& root) {
+    std::map<int, mperf::MPFXPUType> types;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        char path[256];
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/cpu/cpu%d/regs/identification/midr_el1",
+                 cpu);
+        FILE* fp = fopen((root + path).c_str(), "rb");
+        if (!fp) {
+            // the ids of the possible cpus are contiguous
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+            if (access((root + path).c_str(), F_OK) != 0)
+                break;
+            continue;
+        }
+        unsigned long long midr = 0;
+        if (fscanf(fp, "%llx", &midr) == 1) {
+            types[cpu] = mperf::cpu_info_xpu_type_from_midr(midr);
+        }
+        fclose(fp);
+    }
+    return types;
+}
+
+static std::map<int, mperf::MPFXPUType> xpu_types_from_ids(
+        const std::string& root) {
+    using namespace mperf;
+    std::map<int, MPFXPUType> types = xpu_types_from_midr(root);
+    if (!types.empty())
+        return types;
+    types = xpu_types_from_cpuinfo(root);
+    if (!types.empty() || !root.empty())
+        return types;
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
+        defined(_M_X64)
+    unsigned int cpu_info[4] = {0};
+    x86_cpuid(1, cpu_info);
+    int family = (cpu_info[0] >> 8) & 0xf;
+    int model = (cpu_info[0] >> 4) & 0xf;
+    if (family == 6 || family == 15) {
+        model += ((cpu_info[0] >> 16) & 0xf) << 4;
+    }
+    if (family == 15) {
+        family += (cpu_info[0] >> 20) & 0xff;
+    }
+    int stepping = cpu_info[0] & 0xf;
+    MPFXPUType type = cpu_info_xpu_type_from_x86(family, model, stepping);
+    for (int cpu = 0; cpu < g_cpucount; ++cpu) {
+        types[cpu] = type;
+    }
+#endif
+    return types;
+}
+
+std::vector<int> mperf::cpu_info_parse_cpu_list(const char* list) {
+    std::vector<int> cpus;
+    const char* p = list;
+    while (*p) {
+        char* end = nullptr;
+        long first = strtol(p, &end, 10);
+        if (end == p)
+            break;
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        if (*p != ',')
+            break;
+        ++p;
+    }
+    return cpus;
+}
+
+std::vector<int> mperf::cpu_info_online_cpus(const std::string& root) {
+    std::vector<int> cpus;
+    FILE* fp = fopen((root + "/sys/devices/system/cpu/online").c_str(), "rb");
+    if (fp) {
+        char line[1024] = {0};
+        if (fgets(line, sizeof(line), fp))
+            cpus = cpu_info_parse_cpu_list(line);
+        fclose(fp);
+    }
+    if (cpus.empty())
+        cpus = cpu_info_get_cluster_cpus(0);
+    return cpus;
+}
+
+// the core pmus without their micro-architecture
+static std::vector<mperf::CpuCorePmu> read_core_pmus(const std::string& root) {
+    std::vector<mperf::CpuCorePmu> pmus;
+    std::string dir = root + "/sys/bus/event_source/devices";
+    DIR* dp = opendir(dir.c_str());
+    if (!dp)
+        return pmus;
+    while (struct dirent* ent = readdir(dp)) {
+        if (ent->d_name[0] == '.')
+            continue;
+        // the uncore pmus have a cpumask instead
+        std::string path = dir + "/" + ent->d_name;
+        FILE* fp = fopen((path + "/cpus").c_str(), "rb");
+        if (!fp)
+            continue;
+        char line[1024] = {0};
+        bool ok = fgets(line, sizeof(line), fp) != nullptr;
+        fclose(fp);
+        fp = fopen((path + "/type").c_str(), "rb");
+        if (!fp)
+            continue;
+        unsigned int type = 0;
+        ok = fscanf(fp, "%u", &type) == 1 && ok;
+        fclose(fp);
+        std::vector<int> cpus = mperf::cpu_info_parse_cpu_list(line);
+        if (!ok || cpus.empty())
+            continue;
+        pmus.push_back({ent->d_name, type, cpus, mperf::DEFAULT});
+    }
+    closedir(dp);
+    std::sort(pmus.begin(), pmus.end(),
+              [](const mperf::CpuCorePmu& a, const mperf::CpuCorePmu& b) {
+                  return a.cpus[0] < b.cpus[0];
+              });
+    return pmus;
+}
+
+std::map<int, mperf::MPFXPUType> mperf::cpu_info_xpu_types(
+        const std::string& root) {
+    std::map<int, MPFXPUType> types = xpu_types_from_ids(root);
+    // the cores of the hybrid intel parts report the same model, the atom
+    // ones are told apart by their pmu
+    for (auto& pmu : read_core_pmus(root)) {
+        if (pmu.name != "cpu_atom")
+            continue;
+        for (int cpu : pmu.cpus) {
+            auto it = types.find(cpu);
+            if (it != types.end() && it->second == ADL_GLC)
+                it->second = ADL_GRT;
+        }
+    }
+    return types;
+}
+
+std::vector<mperf::CpuCorePmu> mperf::cpu_info_core_pmus(
+        const std::string& root) {
+    std::vector<CpuCorePmu> pmus = read_core_pmus(root);
+    std::map<int, MPFXPUType> types = cpu_info_xpu_types(root);
+    for (auto& pmu : pmus) {
+        auto it = types.find(pmu.cpus[0]);
+        if (it != types.end())
+            pmu.xpu_type = it->second;
+    }
+    return pmus;
+}
+
+mperf::MPFXPUType mperf::cpu_info_xpu_type(int cpuid) {
+    static std::map<int, MPFXPUType> types = cpu_info_xpu_types();
+#if defined __ANDROID__ || defined __linux__
+    if (cpuid < 0)
+        cpuid = sched_getcpu();
+#endif
+    auto it = types.find(cpuid);
+    if (it != types.end())
+        return it->second;
+    // all the cores are the same on most systems
+    return types.empty() ? DEFAULT : types.begin()->second;
+}
@@ -25,6 +25,7 @@
 #include <cstring>
 #include <string>
 #include <vector>
+#include "mperf/repeat.h"
 #include "mperf/utils.h"
 #include "mperf_build_config.h"
 
@@ -928,14 +929,17 @@ void OpenCLEnv::ensure_min_niter(double min_time_us, int& niter,
 float OpenCLEnv::bench_kernel(cl_kernel kern, const NDRange& global_size,
                               const NDRange& local_size, size_t iters) const {
     mperf_assert(global_size.dimension() == local_size.dimension());
-    float used = 0;
     opencl_check(clEnqueueNDRangeKernel(m_queue, kern, global_size.dimension(),
                                         nullptr, global_size.get(),
                                         local_size.get(), 0, nullptr, nullptr));
     clFinish(m_queue);
 
-    cl_event ev;
-    for (size_t i = 0; i < iters; i++) {
+    // at least iters runs, more until the median is stable
+    RepeatOptions opts;
+    opts.min_reps = iters;
+    Repeater rep(opts);
+    while (rep.next()) {
+        cl_event ev;
         opencl_check(clEnqueueNDRangeKernel(
                 m_queue, kern, global_size.dimension(), nullptr,
                 global_size.get(), local_size.get(), 0, nullptr, &ev));
@@ -946,11 +950,11 @@ float OpenCLEnv::bench_kernel(cl_kernel kern, const NDRange& global_size,
                                              nullptr));
         opencl_check(clGetEventProfilingInfo(ev, CL_PROFILING_COMMAND_END,
                                              sizeof(cl_ulong), &end, nullptr));
+        opencl_check(clReleaseEvent(ev));
 
-        used += (end - start) / 1000.0;
+        rep.record("time", (end - start) / 1000.0);
     }
-    opencl_check(clReleaseEvent(ev));
-    return used / iters;
+    return rep.stats("time").median;
 }
 
 float OpenCLEnv::execute_kernel(cl_kernel kern, const NDRange& global_size,
@@ -0,0 +1,396 @@
+/**
+ * \file common/pmu_events.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "mperf/pmu_events.h"
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "mperf/cpu_info.h"
+#include "mperf/exception.h"
+#include "mperf/utils.h"
+
+namespace mperf {
+namespace {
+// the first line of a file without the line break
+bool read_line(const std::string& path, std::string& line) {
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) {
+        return false;
+    }
+    char buf[4096] = {0};
+    bool ok = fgets(buf, sizeof(buf), fp) != nullptr;
+    fclose(fp);
+    buf[strcspn(buf, "\r\n")] = '\0';
+    line = buf;
+    return ok;
+}
+
+// the names of the entries of a directory, empty if it can not be opened
+std::vector<std::string> list_dir(const std::string& path) {
+    std::vector<std::string> names;
+    DIR* dp = opendir(path.c_str());
+    if (!dp) {
+        return names;
+    }
+    while (struct dirent* ent = readdir(dp)) {
+        if (ent->d_name[0] != '.') {
+            names.push_back(ent->d_name);
+        }
+    }
+    closedir(dp);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::string trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+}
+
+bool parse_value(const std::string& str, uint64_t* val) {
+    if (str.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    *val = strtoull(str.c_str(), &end, 0);
+    return errno == 0 && *end == '\0';
+}
+
+// set the bits of a field of the pmu to the value of the term
+void set_field(const SysfsPmu& pmu, const std::string& event,
+               const std::string& field, uint64_t val, uint64_t config[3]) {
+    auto it = pmu.formats.find(field);
+    if (it == pmu.formats.end()) {
+        mperf_throw(MperfError,
+                    "the pmu %s has no field %s, in the event %s.\n",
+                    pmu.name.c_str(), field.c_str(), event.c_str());
+    }
+    const std::vector<int>& bits = it->second.bits;
+    if (bits.size() < 64 && (val >> bits.size()) != 0) {
+        mperf_throw(MperfError,
+                    "the value 0x%llx does not fit in the %zu bits of %s, in "
+                    "the event %s.\n",
+                    (unsigned long long)val, bits.size(), field.c_str(),
+                    event.c_str());
+    }
+    uint64_t& cfg = config[it->second.config];
+    for (size_t i = 0; i < bits.size(); ++i) {
+        uint64_t mask = 1ULL << bits[i];
+        cfg = ((val >> i) & 1) ? (cfg | mask) : (cfg & ~mask);
+    }
+}
+
+// apply the comma separated terms of an event, an event named by the pmu is
+// replaced by its terms
+void apply_terms(const SysfsPmu& pmu, const std::string& event,
+                 const std::string& terms, bool alias, EventAttr& attr,
+                 uint64_t config[3]) {
+    for (auto& t : StrSplit(terms, ',')) {
+        std::string term = trim(t);
+        if (term.empty()) {
+            continue;
+        }
+        size_t eq = term.find('=');
+        if (eq == std::string::npos) {
+            auto it = pmu.events.find(term);
+            if (pmu.formats.count(term)) {
+                set_field(pmu, event, term, 1, config);
+            } else if (it != pmu.events.end() && !alias) {
+                apply_terms(pmu, event, it->second, true, attr, config);
+            } else {
+                mperf_throw(MperfError,
+                            "the pmu %s has no event or field %s, in the "
+                            "event %s.\n",
+                            pmu.name.c_str(), term.c_str(), event.c_str());
+            }
+            continue;
+        }
+        std::string key = trim(term.substr(0, eq));
+        std::string val = trim(term.substr(eq + 1));
+        if (key == "name" && !alias) {
+            attr.name = val;
+            continue;
+        }
+        uint64_t v = 0;
+        if (!parse_value(val, &v)) {
+            // e.g. the "?" of the events taking a parameter
+            mperf_throw(MperfError,
+                        "the term %s needs a number, in the event %s.\n",
+                        term.c_str(), event.c_str());
+        }
+        set_field(pmu, event, key, v, config);
+    }
+}
+// the pmu name without the trailing instance number, e.g. uncore_imc for
+// uncore_imc_3, and the number(-1 if none)
+std::string pmu_family(const std::string& name, long* index) {
+    size_t us = name.rfind('_');
+    char* end = nullptr;
+    *index = -1;
+    if (us != std::string::npos && us + 1 < name.size() &&
+        isdigit(static_cast<unsigned char>(name[us + 1]))) {
+        long n = strtol(name.c_str() + us + 1, &end, 10);
+        if (*end == '\0') {
+            *index = n;
+            return name.substr(0, us);
+        }
+    }
+    return name;
+}
+
+const PmuEventParser& system_parser() {
+    static const PmuEventParser parser;
+    return parser;
+}
+}  // namespace
+
+PmuEventParser::PmuEventParser(const std::string& root) {
+    std::string dir = root + "/sys/bus/event_source/devices";
+    for (auto& name : list_dir(dir)) {
+        std::string path = dir + "/" + name;
+        std::string line;
+        SysfsPmu pmu;
+        pmu.name = name;
+        if (!read_line(path + "/type", line) ||
+            sscanf(line.c_str(), "%u", &pmu.type) != 1) {
+            continue;
+        }
+        // the core pmus list their cpus, the uncore ones the cpus to open
+        // their events on
+        if (read_line(path + "/cpus", line)) {
+            pmu.cpus = cpu_info_parse_cpu_list(line.c_str());
+        } else if (read_line(path + "/cpumask", line)) {
+            pmu.cpus = cpu_info_parse_cpu_list(line.c_str());
+            pmu.is_uncore = true;
+        }
+        for (auto& field : list_dir(path + "/format")) {
+            if (!read_line(path + "/format/" + field, line)) {
+                continue;
+            }
+            size_t colon = line.find(':');
+            std::string config = line.substr(0, colon);
+            SysfsPmu::Field f;
+            if (config == "config") {
+                f.config = 0;
+            } else if (config == "config1") {
+                f.config = 1;
+            } else if (config == "config2") {
+                f.config = 2;
+            } else {
+                mperf_log_warn("skip the field %s of the pmu %s: %s.\n",
+                               field.c_str(), name.c_str(), line.c_str());
+                continue;
+            }
+            if (colon != std::string::npos) {
+                f.bits = cpu_info_parse_cpu_list(line.c_str() + colon + 1);
+            }
+            f.bits.erase(std::remove_if(f.bits.begin(), f.bits.end(),
+                                        [](int b) { return b < 0 || b > 63; }),
+                         f.bits.end());
+            if (!f.bits.empty()) {
+                pmu.formats[field] = f;
+            }
+        }
+        // the .scale, .unit and the like describe the events
+        for (auto& event : list_dir(path + "/events")) {
+            if (event.find('.') == std::string::npos &&
+                read_line(path + "/events/" + event, line)) {
+                pmu.events[event] = trim(line);
+            }
+        }
+        m_pmus.push_back(std::move(pmu));
+    }
+}
+
+const SysfsPmu* PmuEventParser::pmu(const std::string& name) const {
+    for (auto& pmu : m_pmus) {
+        if (pmu.name == name) {
+            return &pmu;
+        }
+    }
+    return nullptr;
+}
+
+const SysfsPmu* PmuEventParser::event_pmu(const std::string& name,
+                                          bool* all_instances) const {
+    long index = 0;
+    std::string family = name;
+    if (!family.empty() && family.back() == '*') {
+        family.pop_back();
+        if (!family.empty() && family.back() == '_') {
+            family.pop_back();
+        }
+    } else if (const SysfsPmu* p = pmu(name)) {
+        // the pmu itself if numbered, its family otherwise
+        *all_instances = pmu_family(name, &index) == name;
+        return p;
+    }
+    *all_instances = true;
+    const SysfsPmu* first = nullptr;
+    long first_index = 0;
+    for (auto& p : m_pmus) {
+        if (p.is_uncore && pmu_family(p.name, &index) == family &&
+            (!first || index < first_index)) {
+            first = &p;
+            first_index = index;
+        }
+    }
+    return first;
+}
+
+std::vector<UncoreInstance> PmuEventParser::uncore_instances(
+        uint32_t type, bool all_instances) const {
+    std::vector<UncoreInstance> res;
+    const SysfsPmu* owner = nullptr;
+    for (auto& pmu : m_pmus) {
+        if (pmu.type == type) {
+            owner = &pmu;
+        }
+    }
+    // e.g. the types hard coded for another system, or a core pmu
+    if (!owner || !owner->is_uncore) {
+        res.push_back({owner ? owner->name : "", type, 0});
+        return res;
+    }
+    long index = 0;
+    const std::string family = pmu_family(owner->name, &index);
+    // the siblings by their numbers, uncore_imc_10 after uncore_imc_9
+    std::vector<std::pair<long, const SysfsPmu*>> siblings;
+    for (auto& pmu : m_pmus) {
+        if (pmu.is_uncore && pmu_family(pmu.name, &index) == family &&
+            (all_instances || &pmu == owner)) {
+            siblings.emplace_back(index, &pmu);
+        }
+    }
+    std::sort(siblings.begin(), siblings.end());
+    for (auto& sibling : siblings) {
+        const SysfsPmu* pmu = sibling.second;
+        if (pmu->cpus.empty()) {
+            res.push_back({pmu->name, pmu->type, 0});
+        }
+        for (int cpu : pmu->cpus) {
+            res.push_back({pmu->name, pmu->type, cpu});
+        }
+    }
+    return res;
+}
+
+EventAttr PmuEventParser::parse(const std::string& event) const {
+    size_t first = event.find('/');
+    size_t last = event.rfind('/');
+    if (first == std::string::npos || first == last) {
+        mperf_throw(MperfError, "%s is not an event like pmu/event=0x11/.\n",
+                    event.c_str());
+    }
+    std::string name = event.substr(0, first);
+    bool all_instances = true;
+    const SysfsPmu* p = event_pmu(name, &all_instances);
+    if (!p) {
+        mperf_throw(MperfError, "unknown pmu %s of the event %s.\n",
+                    name.c_str(), event.c_str());
+    }
+    EventAttr attr(event, 0, p->type, 0, p->is_uncore);
+    attr.all_instances = all_instances;
+    uint64_t config[3] = {0, 0, 0};
+    apply_terms(*p, event, event.substr(first + 1, last - first - 1), false,
+                attr, config);
+    if (config[2] != 0) {
+        mperf_throw(MperfError, "config2 of the event %s is not supported.\n",
+                    event.c_str());
+    }
+    attr.config = config[0];
+    attr.config1 = config[1];
+    if (!apply_event_modifiers(event.substr(last + 1), attr)) {
+        mperf_throw(MperfError, "unknown modifiers %s of the event %s.\n",
+                    event.substr(last + 1).c_str(), event.c_str());
+    }
+    return attr;
+}
+
+std::vector<EventAttr> PmuEventParser::parse_list(
+        const std::string& events) const {
+    std::vector<EventAttr> attrs;
+    for (auto& event : split_pmu_events(events)) {
+        attrs.push_back(parse(event));
+    }
+    return attrs;
+}
+
+EventAttr parse_pmu_event(const std::string& event) {
+    return system_parser().parse(event);
+}
+
+std::vector<UncoreInstance> uncore_pmu_instances(uint32_t type,
+                                                 bool all_instances) {
+    return system_parser().uncore_instances(type, all_instances);
+}
+
+std::string uncore_instance_name(const std::string& event,
+                                 const UncoreInstance& instance) {
+    return event + "[" + instance.pmu + ":cpu" +
+           std::to_string(instance.cpu) + "]";
+}
+
+std::string uncore_event_name(const std::string& counter) {
+    size_t open = counter.rfind('[');
+    if (open == std::string::npos || counter.back() != ']' ||
+        counter.find(":cpu", open) == std::string::npos) {
+        return counter;
+    }
+    return counter.substr(0, open);
+}
+
+bool apply_event_modifiers(const std::string& modifiers, EventAttr& attr) {
+    bool user = false, kernel = false;
+    for (char m : modifiers) {
+        if (m == 'u') {
+            user = true;
+        } else if (m == 'k') {
+            kernel = true;
+        } else {
+            return false;
+        }
+    }
+    if (user || kernel) {
+        attr.exclude_user = !user;
+        attr.exclude_kernel = !kernel;
+    }
+    return true;
+}
+
+std::vector<std::string> split_pmu_events(const std::string& events) {
+    std::vector<std::string> res;
+    std::string event;
+    bool in_terms = false;
+    for (size_t i = 0; i <= events.size(); ++i) {
+        char c = i < events.size() ? events[i] : ',';
+        if (c == ',' && !in_terms) {
+            event = trim(event);
+            if (!event.empty()) {
+                res.push_back(event);
+            }
+            event.clear();
+            continue;
+        }
+        if (c == '/') {
+            in_terms = !in_terms;
+        }
+        event += c;
+    }
+    return res;
+}
+
+}  // namespace mperf
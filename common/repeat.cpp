@@ -0,0 +1,166 @@
+/**
+ * \file common/repeat.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "mperf/repeat.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "mperf/exception.h"
+#include "mperf/utils.h"
+
+namespace mperf {
+namespace {
+// the linearly interpolated percentile of the sorted values, p in [0, 1]
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    double pos = p * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+}
+
+double median_of(std::vector<double>& values) {
+    size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double m = values[mid];
+    if (values.size() % 2 == 0) {
+        m = (m + *std::max_element(values.begin(), values.begin() + mid)) / 2;
+    }
+    return m;
+}
+}  // namespace
+
+double SampleStats::rel_ci() const {
+    double half = (ci_high - ci_low) / 2;
+    if (half == 0) {
+        return 0;
+    }
+    return median == 0 ? std::numeric_limits<double>::infinity()
+                       : half / std::fabs(median);
+}
+
+SampleStats compute_sample_stats(const std::vector<double>& samples,
+                                 const RepeatOptions& opts) {
+    SampleStats s;
+    if (samples.empty()) {
+        return s;
+    }
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    double median = percentile(sorted, 0.5);
+    std::vector<double> dev(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        dev[i] = std::fabs(sorted[i] - median);
+    }
+    double mad = median_of(dev);
+
+    // 1.4826 * MAD estimates the standard deviation of a normal
+    // distribution. The samples are all kept if most of them are equal.
+    std::vector<double> kept;
+    double limit = opts.outlier_mads * 1.4826 * mad;
+    for (double v : sorted) {
+        if (opts.outlier_mads <= 0 || mad == 0 ||
+            std::fabs(v - median) <= limit) {
+            kept.push_back(v);
+        }
+    }
+    if (kept.empty()) {
+        kept = sorted;
+    }
+    s.count = kept.size();
+    s.outliers = sorted.size() - kept.size();
+    double sum = 0;
+    for (double v : kept) {
+        sum += v;
+    }
+    s.mean = sum / kept.size();
+    s.median = percentile(kept, 0.5);
+    for (size_t i = 0; i < kept.size(); ++i) {
+        dev[i] = std::fabs(kept[i] - s.median);
+    }
+    dev.resize(kept.size());
+    s.mad = median_of(dev);
+    s.p5 = percentile(kept, 0.05);
+    s.p95 = percentile(kept, 0.95);
+
+    // the percentile bootstrap of the median, seeded for reproducible
+    // results
+    s.ci_low = s.ci_high = s.median;
+    if (kept.size() > 1 && opts.bootstrap > 0) {
+        std::mt19937 rng(20220801);
+        std::uniform_int_distribution<size_t> pick(0, kept.size() - 1);
+        std::vector<double> medians(opts.bootstrap);
+        std::vector<double> resample(kept.size());
+        for (size_t b = 0; b < opts.bootstrap; ++b) {
+            for (auto& v : resample) {
+                v = kept[pick(rng)];
+            }
+            medians[b] = median_of(resample);
+        }
+        std::sort(medians.begin(), medians.end());
+        double alpha = (1 - opts.confidence) / 2;
+        s.ci_low = percentile(medians, alpha);
+        s.ci_high = percentile(medians, 1 - alpha);
+    }
+    return s;
+}
+
+Repeater::Repeater(const RepeatOptions& opts) : opts_(opts) {
+    opts_.min_reps = std::max<size_t>(opts_.min_reps, 1);
+    opts_.max_reps = std::max(opts_.max_reps, opts_.min_reps);
+}
+
+bool Repeater::next() {
+    if (reps_ == 0) {
+        start_ = std::chrono::steady_clock::now();
+    } else if (reps_ >= opts_.min_reps) {
+        converged_ = true;
+        for (auto& samples : samples_) {
+            if (compute_sample_stats(samples, opts_).rel_ci() >
+                opts_.target_rel_ci) {
+                converged_ = false;
+                break;
+            }
+        }
+        std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start_;
+        if (converged_ || reps_ >= opts_.max_reps ||
+            elapsed.count() >= opts_.time_budget) {
+            return false;
+        }
+    }
+    ++reps_;
+    return true;
+}
+
+void Repeater::record(const std::string& name, double value) {
+    auto it = std::find(names_.begin(), names_.end(), name);
+    if (it == names_.end()) {
+        names_.push_back(name);
+        samples_.emplace_back();
+        it = names_.end() - 1;
+    }
+    samples_[it - names_.begin()].push_back(value);
+}
+
+const std::vector<double>& Repeater::samples(const std::string& name) const {
+    auto it = std::find(names_.begin(), names_.end(), name);
+    if (it == names_.end()) {
+        mperf_throw(MperfError, "%s is not recorded.\n", name.c_str());
+    }
+    return samples_[it - names_.begin()];
+}
+
+SampleStats Repeater::stats(const std::string& name) const {
+    return compute_sample_stats(samples(name), opts_);
+}
+
+}  // namespace mperf
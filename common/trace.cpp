@@ -0,0 +1,291 @@
+/**
+ * \file common/trace.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "mperf/trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+#include "mperf/exception.h"
+
+namespace mperf {
+namespace {
+uint64_t clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+size_t pad8(size_t size) {
+    return (size + 7) & ~size_t(7);
+}
+
+const uint8_t kZeros[8] = {0};
+}  // namespace
+
+TraceWriter::TraceWriter(const std::string& path,
+                         const std::vector<EventAttr>& counters,
+                         size_t block_records, const std::string& info)
+        : num_counters_(counters.size()),
+          block_records_(block_records ? block_records : 1),
+          start_ns_(clock_ns(CLOCK_MONOTONIC)),
+          timestamps_(block_records_),
+          regions_(block_records_),
+          columns_(block_records_ * num_counters_) {
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        mperf_throw(MperfError, "failed to create the trace %s: %s\n",
+                    path.c_str(), strerror(errno));
+    }
+    std::vector<uint8_t> meta;
+    auto put = [&meta](const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        meta.insert(meta.end(), p, p + size);
+    };
+    TraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+    header.version = kTraceVersion;
+    header.byte_order = kTraceByteOrder;
+    header.num_counters = num_counters_;
+    header.info_size = info.size();
+    header.start_realtime_ns = clock_ns(CLOCK_REALTIME);
+    put(&header, sizeof(header));
+    for (auto& attr : counters) {
+        TraceEventEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.type = attr.type;
+        entry.name_size = attr.name.size();
+        entry.config = attr.config;
+        entry.config1 = attr.config1;
+        put(&entry, sizeof(entry));
+        put(attr.name.data(), attr.name.size());
+        put(kZeros, pad8(attr.name.size()) - attr.name.size());
+    }
+    put(info.data(), info.size());
+    put(kZeros, pad8(info.size()) - info.size());
+    reinterpret_cast<TraceHeader*>(meta.data())->header_size = meta.size();
+    write(meta.data(), meta.size());
+}
+
+TraceWriter::~TraceWriter() {
+    try {
+        flush();
+    } catch (const MperfError& e) {
+        mperf_log_warn("the trace is cut short: %s", e.what());
+    }
+    close(fd_);
+}
+
+uint64_t TraceWriter::now_ns() const {
+    return clock_ns(CLOCK_MONOTONIC) - start_ns_;
+}
+
+void TraceWriter::set_region_name(uint32_t region, const std::string& name) {
+    pending_regions_.emplace_back(region, name);
+}
+
+void TraceWriter::flush() {
+    if (!pending_regions_.empty()) {
+        std::vector<uint8_t> payload;
+        for (auto& it : pending_regions_) {
+            uint32_t entry[2] = {it.first, (uint32_t)it.second.size()};
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(entry);
+            payload.insert(payload.end(), p, p + sizeof(entry));
+            payload.insert(payload.end(), it.second.begin(), it.second.end());
+            payload.resize(pad8(payload.size()), 0);
+        }
+        TraceBlockHeader block = {TRACE_BLOCK_REGIONS,
+                                  (uint32_t)pending_regions_.size(),
+                                  payload.size()};
+        write(&block, sizeof(block));
+        write(payload.data(), payload.size());
+        pending_regions_.clear();
+    }
+    if (count_ > 0) {
+        write_records();
+    }
+}
+
+void TraceWriter::write(const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = ::write(fd_, p, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            mperf_throw(MperfError, "failed to write the trace: %s\n",
+                        strerror(errno));
+        }
+        p += n;
+        size -= n;
+    }
+}
+
+void TraceWriter::write_records() {
+    const size_t count = count_;
+    // reset first, so a failed write drops the block instead of retrying it
+    count_ = 0;
+    const size_t region_size = TraceReader::region_column_size(count);
+    TraceBlockHeader block = {TRACE_BLOCK_RECORDS, (uint32_t)count,
+                              8 * count + region_size +
+                                      8 * count * num_counters_};
+    // the header and the columns in one syscall, as long as they fit
+    std::vector<struct iovec> iov;
+    iov.reserve(4 + num_counters_);
+    iov.push_back({&block, sizeof(block)});
+    iov.push_back({timestamps_.data(), 8 * count});
+    iov.push_back({regions_.data(), 4 * count});
+    if (region_size != 4 * count) {
+        iov.push_back({const_cast<uint8_t*>(kZeros), region_size - 4 * count});
+    }
+    for (size_t k = 0; k < num_counters_; ++k) {
+        iov.push_back({&columns_[k * block_records_], 8 * count});
+    }
+    size_t total = sizeof(block) + block.size;
+    ssize_t n = iov.size() <= IOV_MAX ? writev(fd_, iov.data(), iov.size())
+                                      : -1;
+    if (n == (ssize_t)total) {
+        return;
+    }
+    // a short or failed writev, write the rest one by one
+    size_t done = n > 0 ? n : 0;
+    for (auto& v : iov) {
+        if (done >= v.iov_len) {
+            done -= v.iov_len;
+            continue;
+        }
+        write(static_cast<uint8_t*>(v.iov_base) + done, v.iov_len - done);
+        done = 0;
+    }
+}
+
+TraceReader::TraceReader(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        mperf_throw(MperfError, "failed to open the trace %s: %s\n",
+                    path.c_str(), strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(TraceHeader)) {
+        close(fd);
+        mperf_throw(MperfError, "%s is not a trace.\n", path.c_str());
+    }
+    size_ = st.st_size;
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        mperf_throw(MperfError, "failed to map the trace %s: %s\n",
+                    path.c_str(), strerror(errno));
+    }
+    base_ = static_cast<const uint8_t*>(addr);
+    header_ = reinterpret_cast<const TraceHeader*>(base_);
+    if (memcmp(header_->magic, kTraceMagic, sizeof(kTraceMagic)) != 0 ||
+        header_->byte_order != kTraceByteOrder ||
+        header_->header_size > size_) {
+        munmap(addr, size_);
+        mperf_throw(MperfError, "%s is not a trace of this machine.\n",
+                    path.c_str());
+    }
+    if (header_->version > kTraceVersion) {
+        munmap(addr, size_);
+        mperf_throw(MperfError, "the trace %s is of a newer version %u.\n",
+                    path.c_str(), header_->version);
+    }
+
+    size_t off = sizeof(TraceHeader);
+    for (uint32_t k = 0; k < header_->num_counters; ++k) {
+        auto entry = reinterpret_cast<const TraceEventEntry*>(base_ + off);
+        if (off + sizeof(*entry) > header_->header_size ||
+            off + sizeof(*entry) + entry->name_size > header_->header_size) {
+            munmap(addr, size_);
+            mperf_throw(MperfError, "the counters of %s are corrupted.\n",
+                        path.c_str());
+        }
+        off += sizeof(*entry);
+        events_.push_back({std::string(reinterpret_cast<const char*>(base_) +
+                                               off,
+                                       entry->name_size),
+                           entry->type, entry->config, entry->config1});
+        off += pad8(entry->name_size);
+    }
+    if (off > header_->header_size ||
+        header_->info_size > header_->header_size - off) {
+        munmap(addr, size_);
+        mperf_throw(MperfError, "the info of %s is corrupted.\n", path.c_str());
+    }
+    info_.assign(reinterpret_cast<const char*>(base_) + off,
+                 header_->info_size);
+
+    const size_t num_counters = header_->num_counters;
+    for (off = header_->header_size; off + sizeof(TraceBlockHeader) <= size_;) {
+        auto block = reinterpret_cast<const TraceBlockHeader*>(base_ + off);
+        const uint8_t* data = base_ + off + sizeof(*block);
+        if (block->size > size_ - off - sizeof(*block)) {
+            // the block being written when the trace was cut short
+            break;
+        }
+        off += sizeof(*block) + block->size;
+        if (block->type == TRACE_BLOCK_RECORDS) {
+            size_t count = block->count;
+            if (block->size != 8 * count + region_column_size(count) +
+                                       8 * count * num_counters) {
+                break;
+            }
+            blocks_.push_back({data, count});
+            num_records_ += count;
+        } else if (block->type == TRACE_BLOCK_REGIONS) {
+            const uint8_t* p = data;
+            const uint8_t* end = data + block->size;
+            for (uint32_t i = 0; i < block->count && p + 8 <= end; ++i) {
+                uint32_t entry[2];
+                memcpy(entry, p, sizeof(entry));
+                if (entry[1] > end - p - 8) {
+                    break;
+                }
+                region_names_.emplace_back(
+                        entry[0],
+                        std::string(reinterpret_cast<const char*>(p) + 8,
+                                    entry[1]));
+                p += pad8(8 + entry[1]);
+            }
+        }
+        // the blocks of the newer types are skipped
+    }
+}
+
+TraceReader::~TraceReader() {
+    munmap(const_cast<uint8_t*>(base_), size_);
+}
+
+int TraceReader::event_index(const std::string& name) const {
+    for (size_t k = 0; k < events_.size(); ++k) {
+        if (events_[k].name == name) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+std::string TraceReader::region_name(uint32_t region) const {
+    // the latest name wins
+    for (auto it = region_names_.rbegin(); it != region_names_.rend(); ++it) {
+        if (it->first == region) {
+            return it->second;
+        }
+    }
+    return "";
+}
+
+}  // namespace mperf
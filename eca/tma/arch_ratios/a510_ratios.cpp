@@ -7,6 +7,9 @@
  */
 
 #include "arch_ratios.h"
+#include "a510_events.h"
+
+#define CEV(NAME) TMA_CATALOG_EV(a510_events, NAME)
 
 namespace mperf {
 namespace tma {
@@ -1065,378 +1068,455 @@ public:
 };
 
 float Frontend_Bound::compute(FEV EV) {
-    val = Pipeline_Width * EV({"STALL_FRONTEND", 0x23, 4, 0}, 1) /
+    TMA_MEMOIZE();
+    val = Pipeline_Width * EV(CEV("STALL_FRONTEND"), 1) /
           SLOTS(EV, 1, thresh);
     thresh = (val > 0.15);
     return val;
 }
 float Fetch_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Pipeline_Width * Frontend_Latency_Cycles(EV, 2, thresh) /
           SLOTS(EV, 2, thresh);
-    thresh = (val > 0.10) && Frontend_Bound::thresh;
+    thresh = (val > 0.10) && TMA_THRESH(Frontend_Bound);
     return val;
 }
 float ICache_Misses::compute(FEV EV) {
-    val = EV({"STALL_FRONTEND_CACHE", 0xE1, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_FRONTEND_CACHE"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float ITLB_Misses::compute(FEV EV) {
-    val = EV({"STALL_FRONTEND_TLB", 0xE2, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_FRONTEND_TLB"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Predecode_Error::compute(FEV EV) {
-    val = EV({"STALL_FRONTEND_PDERR", 0xE3, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_FRONTEND_PDERR"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Fetch_Bandwidth::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Frontend_Bound::compute(EV) - Fetch_Latency::compute(EV);
-    thresh = (val > 0.1) && Frontend_Bound::thresh && HighIPC(EV, 2, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Frontend_Bound) &&
+             HighIPC(EV, 2, thresh);
     return val;
 }
 float Bad_Speculation::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = 1 - (Frontend_Bound::compute(EV) + Backend_Bound::compute(EV) +
                Retiring::compute(EV));
     thresh = (val > 0.15);
     return val;
 }
 float Branch_Mispredicts::compute(FEV EV) {
-    val = EV({"BR_MIS_PRED_RETIRED", 0x22, 4, 0}, 2);
-    thresh = (val > 0.1) && Bad_Speculation::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("BR_MIS_PRED_RETIRED"), 2);
+    thresh = (val > 0.1) && TMA_THRESH(Bad_Speculation);
     return val;
 }
 float Backend_Bound::compute(FEV EV) {
-    val = Pipeline_Width * EV({"STALL_BACKEND", 0x24, 4, 0}, 1) /
+    TMA_MEMOIZE();
+    val = Pipeline_Width * EV(CEV("STALL_BACKEND"), 1) /
           SLOTS(EV, 1, thresh);
     thresh = (val > 0.2);
     return val;
 }
 float Memory_Bound::compute(FEV EV) {
-    val = (EV({"STALL_BACKEND_LD", 0xE7, 4, 0}, 2) +
-           EV({"STALL_BACKEND_ST", 0xE8, 4, 0}, 2)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("STALL_BACKEND_LD"), 2) +
+           EV(CEV("STALL_BACKEND_ST"), 2)) /
           CLKS(EV, 2, thresh);
-    thresh = (val > 0.2) && Backend_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Backend_Bound);
     return val;
 }
 float Load_Bound::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_LD", 0xE7, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_LD"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Load_DTLB::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_LD_TLB", 0xEA, 4, 0}, 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Load_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_LD_TLB"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Load_Bound);
     return val;
 }
 float Load_Cache::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_LD_CACHE", 0xE9, 4, 0}, 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Load_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_LD_CACHE"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Load_Bound);
     return val;
 }
 float Store_Bound::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_ST", 0xE8, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_ST"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Store_TLB::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_ST_TLB", 0xEC, 4, 0}, 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Store_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_ST_TLB"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Store_Bound);
     return val;
 }
 float Store_Buffer::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_ST_STB", 0xEB, 4, 0}, 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Store_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_ST_STB"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Store_Bound);
     return val;
 }
 float Core_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Backend_Bound::compute(EV) - Memory_Bound::compute(EV);
-    thresh = (val > 0.1) && Backend_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Backend_Bound);
     return val;
 }
 float Interlock_Bound::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_ILOCK", 0xE4, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_ILOCK"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Interlock_AGU::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_ILOCK_AGU", 0xE5, 4, 0}, 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_ILOCK_AGU"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Interlock_FPU::compute(FEV EV) {
-    val = EV({"STALL_BACKEND_ILOCK_FPU", 0xE6, 4, 0}, 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("STALL_BACKEND_ILOCK_FPU"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Core_Bound_Others::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Core_Bound::compute(EV) - Interlock_Bound::compute(EV);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Retiring::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Retired_Slots(EV, 1, thresh) / SLOTS(EV, 1, thresh);
     thresh = true;
     return val;
 }
 float LD_Retiring::compute(FEV EV) {
-    val = EV({"LD_SPEC", 0x70, 4, 0}, 2) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("LD_SPEC"), 2) / SLOTS(EV, 1, thresh);
     return val;
 }
 float ST_Retiring::compute(FEV EV) {
-    val = EV({"ST_SPEC", 0x71, 4, 0}, 2) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("ST_SPEC"), 2) / SLOTS(EV, 1, thresh);
     return val;
 }
 float DP_Retiring::compute(FEV EV) {
-    val = EV({"DP_SPEC", 0x73, 4, 0}, 2) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("DP_SPEC"), 2) / SLOTS(EV, 1, thresh);
     return val;
 }
 float ASE_Retiring::compute(FEV EV) {
-    val = EV({"ASE_SPEC", 0x74, 4, 0}, 2) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("ASE_SPEC"), 2) / SLOTS(EV, 1, thresh);
     return val;
 }
 float VFP_Retiring::compute(FEV EV) {
-    val = EV({"VFP_SPEC", 0x75, 4, 0}, 2) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("VFP_SPEC"), 2) / SLOTS(EV, 1, thresh);
     return val;
 }
 float PC_Write_Retiring::compute(FEV EV) {
-    val = EV({"PC_WRITE_SPEC", 0x76, 4, 0}, 2) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("PC_WRITE_SPEC"), 2) / SLOTS(EV, 1, thresh);
     return val;
 }
 float BR_IMMED_Retiring::compute(FEV EV) {
-    val = EV({"BR_IMMED_SPEC", 0x78, 4, 0}, 3) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("BR_IMMED_SPEC"), 3) / SLOTS(EV, 1, thresh);
     return val;
 }
 float BR_RETURN_Retiring::compute(FEV EV) {
-    val = EV({"BR_RETURN_SPEC", 0x79, 4, 0}, 3) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("BR_RETURN_SPEC"), 3) / SLOTS(EV, 1, thresh);
     return val;
 }
 float BR_INDIRECT_Retiring::compute(FEV EV) {
-    val = EV({"BR_INDIRECT_SPEC", 0x7a, 4, 0}, 3) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("BR_INDIRECT_SPEC"), 3) / SLOTS(EV, 1, thresh);
     return val;
 }
 float Metric_IPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_UPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = UPI(EV, 0, thresh);
     thresh = (val > 1.05);
     return val;
 }
 float Metric_CPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_SLOTS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SLOTS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CoreIPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CoreIPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CORE_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CORE_CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpLoad::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpLoad(EV, 0, thresh);
     thresh = (val < 3);
     return val;
 }
 float Metric_IpStore::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpStore(EV, 0, thresh);
     thresh = (val < 8);
     return val;
 }
 float Metric_IpBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpBranch(EV, 0, thresh);
     thresh = (val < 8);
     return val;
 }
 float Metric_Instructions::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Instructions(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpMispredict::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpMispredict(EV, 0, thresh);
     thresh = (val < 200);
     return val;
 }
 float Metric_L1MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1_BW_Use::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1_BW_Use(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2_BW_Use::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2_BW_Use(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3_BW_Use::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3_BW_Use(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DRAM_BW_Use::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DRAM_BW_Use(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_GFLOPs_Use::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = GFLOPs_Use(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_LD_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = LD_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_ST_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ST_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_ASE_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ASE_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_VFP_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = VFP_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DP_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DP_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_BR_IMMED_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = BR_IMMED_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_BR_RETURN_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = BR_RETURN_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_BR_INDIRECT_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = BR_INDIRECT_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1I_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1I_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1D_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1D_RD_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_RD_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1D_WR_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_WR_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2D_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2D_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2D_RD_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2D_RD_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2D_WR_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2D_WR_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3D_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3D_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3D_RD_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3D_RD_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3D_WR_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3D_WR_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_BR_Mispred_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = BR_Mispred_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1I_TLB_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1I_TLB_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1D_TLB_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_TLB_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2_TLB_Miss_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2_TLB_Miss_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_ITLB_Table_Walk_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ITLB_Table_Walk_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DTLB_Table_Walk_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DTLB_Table_Walk_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Unaligned_LDST_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Unaligned_LDST_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
@@ -1444,8 +1524,8 @@ float Metric_Unaligned_LDST_Ratio::compute(FEV EV) {
 
 float Frontend_Latency_Cycles(FEV EV, int level, bool& thresh) {
     auto func = [&]() -> float {
-        return std::min<float>(EV({"CPU_CYCLES", 0x11, 4, 0}, level),
-                               EV({"STALL_FRONTEND", 0x23, 4, 0}, level));
+        return std::min<float>(EV(CEV("CPU_CYCLES"), level),
+                               EV(CEV("STALL_FRONTEND"), level));
     };
     return g_ev_process(func, level);
 }
@@ -1454,14 +1534,14 @@ float HighIPC(FEV EV, int level, bool& thresh) {
     return val;
 }
 float Retired_Slots(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED", 0x08, 4, 0}, level);
+    return EV(CEV("INST_RETIRED"), level);
 }
 float IPC(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED", 0x08, 4, 0}, level) / CLKS(EV, level, thresh);
+    return EV(CEV("INST_RETIRED"), level) / CLKS(EV, level, thresh);
 }
 float UPI(FEV EV, int level, bool& thresh) {
     float val = Retired_Slots(EV, level, thresh) /
-                EV({"INST_RETIRED", 0x08, 4, 0}, level);
+                EV(CEV("INST_RETIRED"), level);
     thresh = (val > 1.05);
     return val;
 }
@@ -1469,163 +1549,163 @@ float CPI(FEV EV, int level, bool& thresh) {
     return 1 / IPC(EV, level, thresh);
 }
 float CLKS(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CYCLES", 0x11, 4, 0}, level);
+    return EV(CEV("CPU_CYCLES"), level);
 }
 float SLOTS(FEV EV, int level, bool& thresh) {
     return Pipeline_Width * CORE_CLKS(EV, level, thresh);
 }
 float CoreIPC(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED", 0x08, 4, 0}, level) /
+    return EV(CEV("INST_RETIRED"), level) /
            CORE_CLKS(EV, level, thresh);
 }
 float CORE_CLKS(FEV EV, int level, bool& thresh) {
     return CLKS(EV, level, thresh);
 }
 float IpLoad(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED", 0x08, 4, 0}, level) /
-                EV({"LD_RETIRED", 0x06, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED"), level) /
+                EV(CEV("LD_RETIRED"), level);
     thresh = (val < 3);
     return val;
 }
 float IpStore(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED", 0x08, 4, 0}, level) /
-                EV({"ST_RETIRED", 0x07, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED"), level) /
+                EV(CEV("ST_RETIRED"), level);
     thresh = (val < 8);
     return val;
 }
 float IpBranch(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED", 0x08, 4, 0}, level) /
-                EV({"BR_RETIRED", 0x21, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED"), level) /
+                EV(CEV("BR_RETIRED"), level);
     thresh = (val < 8);
     return val;
 }
 float Instructions(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED", 0x08, 4, 0}, level);
+    return EV(CEV("INST_RETIRED"), level);
 }
 float IpMispredict(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED", 0x08, 4, 0}, level) /
-                EV({"BR_MIS_PRED_RETIRED", 0x22, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED"), level) /
+                EV(CEV("BR_MIS_PRED_RETIRED"), level);
     thresh = (val < 200);
     return val;
 }
 float L1MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * EV({"L1D_CACHE_REFILL", 0x03, 4, 0}, level) /
-           EV({"INST_RETIRED", 0x08, 4, 0}, level);
+    return 1000 * EV(CEV("L1D_CACHE_REFILL"), level) /
+           EV(CEV("INST_RETIRED"), level);
 }
 float L2MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * EV({"L2D_CACHE_REFILL", 0x17, 4, 0}, level) /
-           EV({"INST_RETIRED", 0x08, 4, 0}, level);
+    return 1000 * EV(CEV("L2D_CACHE_REFILL"), level) /
+           EV(CEV("INST_RETIRED"), level);
 }
 float L3MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * EV({"L3D_CACHE_REFILL", 0x2A, 4, 0}, level) /
-           EV({"INST_RETIRED", 0x08, 4, 0}, level);
+    return 1000 * EV(CEV("L3D_CACHE_REFILL"), level) /
+           EV(CEV("INST_RETIRED"), level);
 }
 // L1_BW_Use is not precisely, because don't know the accurate granularity for
 // L1D access
 float L1_BW_Use(FEV EV, int level, bool& thresh) {
-    return (LS_rd_bitwidth * EV({"MEM_ACCESS_RD", 0x66, 4, 0}, level) +
-            LS_wr_bitwidth * EV({"MEM_ACCESS_WR", 0x67, 4, 0}, level)) /
+    return (LS_rd_bitwidth * EV(CEV("MEM_ACCESS_RD"), level) +
+            LS_wr_bitwidth * EV(CEV("MEM_ACCESS_WR"), level)) /
            OneBillion / Time(EV, level, thresh);
 }
 float L2_BW_Use(FEV EV, int level, bool& thresh) {
     return (Cacheline_size *
-            (EV({"L1D_CACHE_REFILL", 0x03, 4, 0}, level) +
-             EV({"L1D_CACHE_WB", 0x15, 4, 0}, level) +
-             EV({"L1D_CACHE_REFILL_PREFETCH", 0xC2, 4, 0}, level))) /
+            (EV(CEV("L1D_CACHE_REFILL"), level) +
+             EV(CEV("L1D_CACHE_WB"), level) +
+             EV(CEV("L1D_CACHE_REFILL_PREFETCH"), level))) /
            OneBillion / Time(EV, level, thresh);
 }
 // Note: L2D_CACHE_REFILL_PREFETCH on a510 is not count when the soc is
 // configured with per-core L2 cache
 float L3_BW_Use(FEV EV, int level, bool& thresh) {
-    return (Cacheline_size * (EV({"L2D_CACHE_REFILL", 0x17, 4, 0}, level) +
-                              EV({"L2D_CACHE_WB", 0x18, 4, 0}, level))) /
+    return (Cacheline_size * (EV(CEV("L2D_CACHE_REFILL"), level) +
+                              EV(CEV("L2D_CACHE_WB"), level))) /
            OneBillion / Time(EV, level, thresh);
 }
 #if 0  // another way to measure ddr bandwidth
 float DRAM_BW_Use(FEV EV, int level, bool& thresh) {
     return (ACE_bus_bitwidth *
-            EV({"DSU_BUS_ACCESS", 0x19, 7, 0, true}, level)) /
+            EV(CEV("DSU_BUS_ACCESS"), level)) /
            OneBillion / Time(EV, level, thresh);
 }
 #endif
 float DRAM_BW_Use(FEV EV, int level, bool& thresh) {
     return (Cacheline_size *
-            (EV({"DSU_L3D_CACHE_REFILL", 0x002A, 7, 0, true}, level) +
-             EV({"DSU_L3D_CACHE_WB", 0x002C, 7, 0, true}, level))) /
+            (EV(CEV("DSU_L3D_CACHE_REFILL"), level) +
+             EV(CEV("DSU_L3D_CACHE_WB"), level))) /
            OneBillion / Time(EV, level, thresh);
 }
 float GFLOPs_Use(FEV EV, int level, bool& thresh) {
-    return (op_nums_per_ase_inst * EV({"ASE_SPEC", 0x74, 4, 0}, level) +
-            EV({"VFP_SPEC", 0x75, 4, 0}, level)) /
+    return (op_nums_per_ase_inst * EV(CEV("ASE_SPEC"), level) +
+            EV(CEV("VFP_SPEC"), level)) /
            OneBillion / Time(EV, level, thresh);
 }
 float LD_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"LD_SPEC", 0x70, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("LD_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float ST_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"ST_SPEC", 0x71, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("ST_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float ASE_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"ASE_SPEC", 0x74, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("ASE_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float VFP_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"VFP_SPEC", 0x75, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("VFP_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float DP_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"DP_SPEC", 0x73, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("DP_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float BR_IMMED_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"BR_IMMED_SPEC", 0x78, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("BR_IMMED_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float BR_RETURN_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"BR_RETURN_SPEC", 0x79, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("BR_RETURN_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float BR_INDIRECT_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"BR_INDIRECT_SPEC", 0x7a, 4, 0}, level) /
-           EV({"INST_SPEC", 0x1b, 4, 0}, level);
+    return EV(CEV("BR_INDIRECT_SPEC"), level) /
+           EV(CEV("INST_SPEC"), level);
 }
 float L1I_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L1I_CACHE_REFILL", 0x01, 4, 0}, level) /
-           EV({"L1I_CACHE", 0x14, 4, 0}, level);
+    return EV(CEV("L1I_CACHE_REFILL"), level) /
+           EV(CEV("L1I_CACHE"), level);
 }
 float L1D_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_CACHE_REFILL", 0x03, 4, 0}, level) /
-           EV({"L1D_CACHE", 0x04, 4, 0}, level);
+    return EV(CEV("L1D_CACHE_REFILL"), level) /
+           EV(CEV("L1D_CACHE"), level);
 }
 float L1D_RD_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_CACHE_REFILL_RD", 0x42, 4, 0}, level) /
-           EV({"L1D_CACHE_RD", 0x40, 4, 0}, level);
+    return EV(CEV("L1D_CACHE_REFILL_RD"), level) /
+           EV(CEV("L1D_CACHE_RD"), level);
 }
 float L1D_WR_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_CACHE_REFILL_WR", 0x43, 4, 0}, level) /
-           EV({"L1D_CACHE_WR", 0x41, 4, 0}, level);
+    return EV(CEV("L1D_CACHE_REFILL_WR"), level) /
+           EV(CEV("L1D_CACHE_WR"), level);
 }
 float L2D_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L2D_CACHE_REFILL", 0x17, 4, 0}, level) /
-           EV({"L2D_CACHE", 0x16, 4, 0}, level);
+    return EV(CEV("L2D_CACHE_REFILL"), level) /
+           EV(CEV("L2D_CACHE"), level);
 }
 float L2D_RD_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L2D_CACHE_REFILL_RD", 0x52, 4, 0}, level) /
-           EV({"L2D_CACHE_RD", 0x50, 4, 0}, level);
+    return EV(CEV("L2D_CACHE_REFILL_RD"), level) /
+           EV(CEV("L2D_CACHE_RD"), level);
 }
 float L2D_WR_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L2D_CACHE_REFILL_WR", 0x53, 4, 0}, level) /
-           EV({"L2D_CACHE_WR", 0x51, 4, 0}, level);
+    return EV(CEV("L2D_CACHE_REFILL_WR"), level) /
+           EV(CEV("L2D_CACHE_WR"), level);
 }
 float L3D_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L3D_CACHE_REFILL", 0x2a, 4, 0}, level) /
-           EV({"L3D_CACHE", 0x2b, 4, 0}, level);
+    return EV(CEV("L3D_CACHE_REFILL"), level) /
+           EV(CEV("L3D_CACHE"), level);
 }
 float L3D_RD_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L3D_CACHE_REFILL_RD", 0xa2, 4, 0}, level) /
-           EV({"L3D_CACHE_RD", 0xa0, 4, 0}, level);
+    return EV(CEV("L3D_CACHE_REFILL_RD"), level) /
+           EV(CEV("L3D_CACHE_RD"), level);
 }
 float L3D_WR_Miss_Ratio(FEV EV, int level, bool& thresh) {
     mperf_log_warn(
@@ -1634,39 +1714,40 @@ float L3D_WR_Miss_Ratio(FEV EV, int level, bool& thresh) {
     return 0;
 }
 float BR_Mispred_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"BR_MIS_PRED_RETIRED", 0x22, 4, 0}, level) /
-           EV({"BR_RETIRED", 0x21, 4, 0}, level);
+    return EV(CEV("BR_MIS_PRED_RETIRED"), level) /
+           EV(CEV("BR_RETIRED"), level);
 }
 float L1D_TLB_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_TLB_REFILL", 0x05, 4, 0}, level) /
-           EV({"L1D_TLB", 0x25, 4, 0}, level);
+    return EV(CEV("L1D_TLB_REFILL"), level) /
+           EV(CEV("L1D_TLB"), level);
 }
 float L1I_TLB_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L1I_TLB_REFILL", 0x02, 4, 0}, level) /
-           EV({"L1I_TLB", 0x26, 4, 0}, level);
+    return EV(CEV("L1I_TLB_REFILL"), level) /
+           EV(CEV("L1I_TLB"), level);
 }
 float L2_TLB_Miss_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"L2D_TLB_REFILL", 0x2d, 4, 0}, level) /
-           EV({"L2D_TLB", 0x2f, 4, 0}, level);
+    return EV(CEV("L2D_TLB_REFILL"), level) /
+           EV(CEV("L2D_TLB"), level);
 }
 float DTLB_Table_Walk_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"DTLB_WALK", 0x34, 4, 0}, level) /
-           EV({"L1D_TLB", 0x25, 4, 0}, level);
+    return EV(CEV("DTLB_WALK"), level) /
+           EV(CEV("L1D_TLB"), level);
 }
 float ITLB_Table_Walk_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"ITLB_WALK", 0x35, 4, 0}, level) /
-           EV({"L1I_TLB", 0x26, 4, 0}, level);
+    return EV(CEV("ITLB_WALK"), level) /
+           EV(CEV("L1I_TLB"), level);
 }
 float Unaligned_LDST_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"UNALIGNED_LDST_RETIRED", 0x0f, 4, 0}, level) /
-           EV({"LDST_SPEC", 0x72, 4, 0}, level);
+    return EV(CEV("UNALIGNED_LDST_RETIRED"), level) /
+           EV(CEV("LDST_SPEC"), level);
 }
 float Time(FEV EV, int level, bool& thresh) {
-    return EV({"time_interval", 0x00, 0, 0}, level) * 1e-3;
+    return EV(CEV("time_interval"), level) * 1e-3;
 }
 }  // namespace
 
 A510SetUpImpl::A510SetUpImpl() {
+    set_catalog(a510_events::kEvents);
     m_vmtc_core.push_back(std::make_pair("Frontend_Bound",
                                          (MetricBase*)(new Frontend_Bound())));
     m_vmtc_core.push_back(std::make_pair("Fetch_Latency",
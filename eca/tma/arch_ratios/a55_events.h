@@ -0,0 +1,99 @@
+/**
+ * \file eca/tma/arch_ratios/a55_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// generated by gen_event_catalog.py, do not edit
+#pragma once
+#include "event_catalog.h"
+
+namespace mperf {
+namespace tma {
+namespace a55_events {
+constexpr CatalogEvent kEvents[] = {
+        {"L1D_CACHE_WB", 0x15, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND_ILOCK", 0xe4, 4, 0, false, 0x0, true},
+        {"ASE_SPEC", 0x74, 4, 0, false, 0x0, true},
+        {"L3D_CACHE_REFILL", 0x2a, 4, 0, false, 0x0, true},
+        {"L1I_TLB_REFILL", 0x2, 4, 0, false, 0x0, true},
+        {"L2D_CACHE_REFILL", 0x17, 4, 0, false, 0x0, true},
+        {"LD_RETIRED", 0x6, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND_ST", 0xe8, 4, 0, false, 0x0, true},
+        {"STALL_FRONTEND_CACHE", 0xe1, 4, 0, false, 0x0, true},
+        {"L1I_CACHE_REFILL", 0x1, 4, 0, false, 0x0, true},
+        {"STALL_FRONTEND_TLB", 0xe2, 4, 0, false, 0x0, true},
+        {"L1D_CACHE_REFILL", 0x3, 4, 0, false, 0x0, true},
+        {"LD_SPEC", 0x70, 4, 0, false, 0x0, true},
+        {"L1D_CACHE_WR", 0x41, 4, 0, false, 0x0, true},
+        {"DTLB_WALK", 0x34, 4, 0, false, 0x0, true},
+        {"L2D_TLB", 0x2f, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND_ILOCK_FPU", 0xe6, 4, 0, false, 0x0, true},
+        {"L2D_CACHE_WR", 0x51, 4, 0, false, 0x0, true},
+        {"L2D_TLB_REFILL", 0x2d, 4, 0, false, 0x0, true},
+        {"ITLB_WALK", 0x35, 4, 0, false, 0x0, true},
+        {"L3D_CACHE_RD", 0xa0, 4, 0, false, 0x0, true},
+        {"L1D_TLB_REFILL", 0x5, 4, 0, false, 0x0, true},
+        {"BR_RETIRED", 0x21, 4, 0, false, 0x0, true},
+        {"BR_MIS_PRED_RETIRED", 0x22, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND_LD", 0xe7, 4, 0, false, 0x0, true},
+        {"ST_RETIRED", 0x7, 4, 0, false, 0x0, true},
+        {"L1D_CACHE_RD", 0x40, 4, 0, false, 0x0, true},
+        {"ST_SPEC", 0x71, 4, 0, false, 0x0, true},
+        {"BR_INDIRECT_SPEC", 0x7a, 4, 0, false, 0x0, true},
+        {"PC_WRITE_SPEC", 0x76, 4, 0, false, 0x0, true},
+        {"L2D_CACHE_REFILL_WR", 0x53, 4, 0, false, 0x0, true},
+        {"L1I_TLB", 0x26, 4, 0, false, 0x0, true},
+        {"L2D_CACHE", 0x16, 4, 0, false, 0x0, true},
+        {"L2D_CACHE_WB", 0x18, 4, 0, false, 0x0, true},
+        {"L1D_CACHE", 0x4, 4, 0, false, 0x0, true},
+        {"L2D_CACHE_RD", 0x50, 4, 0, false, 0x0, true},
+        {"DSU_BUS_ACCESS", 0x19, 7, 0, true, 0x0, true},
+        {"DSU_L3D_CACHE_REFILL", 0x2a, 7, 0, true, 0x0, true},
+        {"MEM_ACCESS_WR", 0x67, 4, 0, false, 0x0, true},
+        {"L3D_CACHE_REFILL_RD", 0xa2, 4, 0, false, 0x0, true},
+        {"L1I_CACHE", 0x14, 4, 0, false, 0x0, true},
+        {"DP_SPEC", 0x73, 4, 0, false, 0x0, true},
+        {"time_interval", 0x0, 0, 0, false, 0x0, true},
+        {"STALL_BACKEND_LD_CACHE", 0xe9, 4, 0, false, 0x0, true},
+        {"BR_RETURN_SPEC", 0x79, 4, 0, false, 0x0, true},
+        {"L1D_CACHE_REFILL_WR", 0x43, 4, 0, false, 0x0, true},
+        {"INST_RETIRED", 0x8, 4, 0, false, 0x0, true},
+        {"MEM_ACCESS_RD", 0x66, 4, 0, false, 0x0, true},
+        {"LDST_SPEC", 0x72, 4, 0, false, 0x0, true},
+        {"DSU_L3D_CACHE_WB", 0x2c, 7, 0, true, 0x0, true},
+        {"STALL_BACKEND_ILOCK_AGU", 0xe5, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND_ST_STB", 0xeb, 4, 0, false, 0x0, true},
+        {"BR_IMMED_SPEC", 0x78, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND", 0x24, 4, 0, false, 0x0, true},
+        {"UNALIGNED_LDST_RETIRED", 0xf, 4, 0, false, 0x0, true},
+        {"VFP_SPEC", 0x75, 4, 0, false, 0x0, true},
+        {"INST_SPEC", 0x1b, 4, 0, false, 0x0, true},
+        {"L3D_CACHE", 0x2b, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND_LD_TLB", 0xea, 4, 0, false, 0x0, true},
+        {"L2D_CACHE_REFILL_RD", 0x52, 4, 0, false, 0x0, true},
+        {"STALL_FRONTEND", 0x23, 4, 0, false, 0x0, true},
+        {"L1D_TLB", 0x25, 4, 0, false, 0x0, true},
+        {"STALL_FRONTEND_PDERR", 0xe3, 4, 0, false, 0x0, true},
+        {"L1D_CACHE_REFILL_RD", 0x42, 4, 0, false, 0x0, true},
+        {"CPU_CYCLES", 0x11, 4, 0, false, 0x0, true},
+        {"STALL_BACKEND_ST_TLB", 0xec, 4, 0, false, 0x0, true},
+        {"L1D_CACHE_REFILL_PREFETCH", 0xc2, 4, 0, false, 0x0, true},
+};
+constexpr int32_t kDisp[] = {
+        1, 1, 0, 0, -65, -62, -58, 1, 0, -50,
+        3, 0, -48, -44, -41, -38, 0, 3, 3, 0,
+        -34, 0, 2, 0, 0, 0, 5, 0, 0, -33,
+        -32, -23, 2, -21, 5, 0, 1, 0, 0, 0,
+        3, 0, 5, 0, 0, 1, -17, 0, 3, 0,
+        -16, 0, 1, 0, -11, 0, -4, 2, -1, 4,
+        0, 0, 6, 13, 0, 0, 29,
+};
+constexpr size_t find(const char* name) {
+    return catalog_find(kEvents, kDisp, name);
+}
+}  // namespace a55_events
+}  // namespace tma
+}  // namespace mperf
@@ -1,15 +1,18 @@
 // Automatically generated by the script cvt_from_pmu_tools.sh.
 #include "arch_ratios.h"
+#include "adl_glc_events.h"
+
+#define CEV(NAME) TMA_CATALOG_EV(adl_glc_events, NAME)
 
 namespace mperf {
 namespace tma {
+namespace {
 
 static bool smt_enabled = false;
 static bool ebs_mode = false;
 static std::string version = "4.4-full-perf";
 static float base_frequency = -1.0;
 static float Memory = 0;
-static bool topdown_use_fixed = false;
 static float Mem_L2_Store_Cost = 10;
 static float Pipeline_Width = 6;
 static float Mem_STLB_Hit_Cost = 7;
@@ -19,7 +22,7 @@ static float Avg_Assist_Cost = 100;
 static float OneMillion = 1000000;
 static float OneBillion = 1000000000;
 static float Energy_Unit = 61;
-static float Errata_Whitelist = "KBLR/CFL091";
+static std::string Errata_Whitelist = "KBLR/CFL091";
 
 float Br_DoI_Jumps(FEV EV, int level, bool& thresh);
 float Branching_Retired(FEV EV, int level, bool& thresh);
@@ -2741,124 +2744,137 @@ public:
 };
 
 float Frontend_Bound::compute(FEV EV) {
-    val = (g_ev_error("PERF_METRICS.FRONTEND_BOUND", 1) /
-           g_ev_error("TOPDOWN.SLOTS", 1)) /
-                  PERF_METRICS_SUM(EV, 1, thresh) -
-          g_ev_error("INT_MISC.UOP_DROPPING", 1) /
-                  SLOTS(EV, 1, thresh) if topdown_use_fixed else(
-                          EV({"IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c, 4, 0}, 1) -
-                          g_ev_error("INT_MISC.UOP_DROPPING", 1)) /
-                  SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = TMA_TOPDOWN_FIXED()
+                  ? (EV(CEV("PERF_METRICS.FRONTEND_BOUND"), 1) /
+                     EV(CEV("TOPDOWN.SLOTS"), 1)) /
+                            PERF_METRICS_SUM(EV, 1, thresh) -
+                    EV(CEV("INT_MISC.UOP_DROPPING"), 1) /
+                            SLOTS(EV, 1, thresh)
+                  : (EV(CEV("IDQ_UOPS_NOT_DELIVERED.CORE"), 1) -
+                     EV(CEV("INT_MISC.UOP_DROPPING"), 1)) /
+                    SLOTS(EV, 1, thresh);
     thresh = (val > 0.15);
     return val;
 }
 float Fetch_Latency::compute(FEV EV) {
-    val = ((g_ev_error("PERF_METRICS.FETCH_LATENCY", 2) /
-            g_ev_error("TOPDOWN.SLOTS", 2)) /
-                   PERF_METRICS_SUM(EV, 2, thresh) -
-           g_ev_error("INT_MISC.UOP_DROPPING", 2) /
-                   SLOTS(EV, 2,
-                         thresh)) if topdown_use_fixed else(EV({"IDQ_UOPS_NOT_"
-                                                                "DELIVERED."
-                                                                "CYCLES_0_UOPS_"
-                                                                "DELIV.CORE",
-                                                                0x400019c, 4,
-                                                                0},
-                                                               2) * Pipeline_Width -
-                                                            g_ev_error(
-                                                                    "INT_MISC."
-                                                                    "UOP_"
-                                                                    "DROPPING",
-                                                                    2)) /
-          SLOTS(EV, 2, thresh);
-    thresh = (val > 0.10) && Frontend_Bound::thresh;
+    TMA_MEMOIZE();
+    val = TMA_TOPDOWN_FIXED()
+                  ? ((EV(CEV("PERF_METRICS.FETCH_LATENCY"), 2) /
+                      EV(CEV("TOPDOWN.SLOTS"), 2)) /
+                             PERF_METRICS_SUM(EV, 2, thresh) -
+                     EV(CEV("INT_MISC.UOP_DROPPING"), 2) /
+                             SLOTS(EV, 2, thresh))
+                  : (EV(CEV("IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE"), 2) * Pipeline_Width -
+                     EV(CEV("INT_MISC.UOP_DROPPING"), 2)) /
+                    SLOTS(EV, 2, thresh);
+    thresh = (val > 0.10) && TMA_THRESH(Frontend_Bound);
     return val;
 }
 float ICache_Misses::compute(FEV EV) {
-    val = g_ev_error("ICACHE_DATA.STALLS", 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("ICACHE_DATA.STALLS"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float ITLB_Misses::compute(FEV EV) {
-    val = g_ev_error("ICACHE_TAG.STALLS", 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("ICACHE_TAG.STALLS"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Branch_Resteers::compute(FEV EV) {
-    val = g_ev_error("INT_MISC.CLEAR_RESTEER_CYCLES", 3) / CLKS(EV, 3, thresh) +
-          Unknown_Branches::compute(EV);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("INT_MISC.CLEAR_RESTEER_CYCLES"), 3) /
+                  CLKS(EV, 3, thresh) + Unknown_Branches::compute(EV);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Mispredicts_Resteers::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mispred_Clears_Fraction(EV, 4, thresh) *
-          g_ev_error("INT_MISC.CLEAR_RESTEER_CYCLES", 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.05) && Branch_Resteers::thresh;
+          EV(CEV("INT_MISC.CLEAR_RESTEER_CYCLES"), 4) /
+          CLKS(EV, 4, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Branch_Resteers);
     return val;
 }
 float Clears_Resteers::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (1 - Mispred_Clears_Fraction(EV, 4, thresh)) *
-          g_ev_error("INT_MISC.CLEAR_RESTEER_CYCLES", 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.05) && Branch_Resteers::thresh;
+          EV(CEV("INT_MISC.CLEAR_RESTEER_CYCLES"), 4) /
+          CLKS(EV, 4, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Branch_Resteers);
     return val;
 }
 float Unknown_Branches::compute(FEV EV) {
-    val = g_ev_error("INT_MISC.UNKNOWN_BRANCH_CYCLES", 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.05) && Branch_Resteers::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("INT_MISC.UNKNOWN_BRANCH_CYCLES"), 4) /
+          CLKS(EV, 4, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Branch_Resteers);
     return val;
 }
 float DSB_Switches::compute(FEV EV) {
-    val = EV({"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x2ab, 4, 0}, 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("DSB2MITE_SWITCHES.PENALTY_CYCLES"), 3) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float LCP::compute(FEV EV) {
-    val = g_ev_error("DECODE.LCP", 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("DECODE.LCP"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float MS_Switches::compute(FEV EV) {
-    val = MS_Switches_Cost * EV({"IDQ.MS_SWITCHES", 0, 4, 0}, 3) /
+    TMA_MEMOIZE();
+    val = MS_Switches_Cost * EV(CEV("IDQ.MS_SWITCHES"), 3) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Fetch_Bandwidth::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Frontend_Bound::compute(EV) - Fetch_Latency::compute(EV));
-    thresh = (val > 0.1) && Frontend_Bound::thresh && HighIPC(EV, 2, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Frontend_Bound) &&
+             HighIPC(EV, 2, thresh);
     return val;
 }
 float MITE::compute(FEV EV) {
-    val = (g_ev_error("IDQ.MITE_CYCLES_ANY", 3) -
-           g_ev_error("IDQ.MITE_CYCLES_OK", 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("IDQ.MITE_CYCLES_ANY"), 3) -
+           EV(CEV("IDQ.MITE_CYCLES_OK"), 3)) /
           CORE_CLKS(EV, 3, thresh) / 2;
-    thresh = (val > 0.1) && Fetch_Bandwidth::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Fetch_Bandwidth);
     return val;
 }
 float Decoder0_Alone::compute(FEV EV) {
-    val = (g_ev_error("INST_DECODED.DECODERS:c1", 4) -
-           g_ev_error("INST_DECODED.DECODERS:c2", 4)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("INST_DECODED.DECODERS:c1"), 4) -
+           EV(CEV("INST_DECODED.DECODERS:c2"), 4)) /
           CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && MITE::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(MITE);
     return val;
 }
 float DSB::compute(FEV EV) {
-    val = (g_ev_error("IDQ.DSB_CYCLES_ANY", 3) -
-           g_ev_error("IDQ.DSB_CYCLES_OK", 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("IDQ.DSB_CYCLES_ANY"), 3) -
+           EV(CEV("IDQ.DSB_CYCLES_OK"), 3)) /
           CORE_CLKS(EV, 3, thresh) / 2;
-    thresh = (val > 0.15) && Fetch_Bandwidth::thresh;
+    thresh = (val > 0.15) && TMA_THRESH(Fetch_Bandwidth);
     return val;
 }
 float LSD::compute(FEV EV) {
-    val = (g_ev_error("LSD.CYCLES_ACTIVE", 3) -
-           g_ev_error("LSD.CYCLES_OK", 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("LSD.CYCLES_ACTIVE"), 3) -
+           EV(CEV("LSD.CYCLES_OK"), 3)) /
           CORE_CLKS(EV, 3, thresh) / 2;
-    thresh = (val > 0.15) && Fetch_Bandwidth::thresh;
+    thresh = (val > 0.15) && TMA_THRESH(Fetch_Bandwidth);
     return val;
 }
 float Bad_Speculation::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             1 - (Frontend_Bound::compute(EV) + Backend_Bound::compute(EV) +
                  Retiring::compute(EV)),
@@ -2867,117 +2883,133 @@ float Bad_Speculation::compute(FEV EV) {
     return val;
 }
 float Branch_Mispredicts::compute(FEV EV) {
-    val = (g_ev_error("PERF_METRICS.BRANCH_MISPREDICTS", 2) /
-           g_ev_error("TOPDOWN.SLOTS", 2)) /
-          PERF_METRICS_SUM(EV, 2, thresh) if topdown_use_fixed else g_ev_error(
-                  "TOPDOWN.BR_MISPREDICT_SLOTS", 2) /
-          SLOTS(EV, 2, thresh);
-    thresh = (val > 0.1) && Bad_Speculation::thresh;
+    TMA_MEMOIZE();
+    val = TMA_TOPDOWN_FIXED()
+                  ? (EV(CEV("PERF_METRICS.BRANCH_MISPREDICTS"), 2) /
+                     EV(CEV("TOPDOWN.SLOTS"), 2)) /
+                    PERF_METRICS_SUM(EV, 2, thresh)
+                  : EV(CEV("TOPDOWN.BR_MISPREDICT_SLOTS"), 2) /
+                    SLOTS(EV, 2, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Bad_Speculation);
     return val;
 }
 float Machine_Clears::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Bad_Speculation::compute(EV) - Branch_Mispredicts::compute(EV));
-    thresh = (val > 0.1) && Bad_Speculation::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Bad_Speculation);
     return val;
 }
 float Backend_Bound::compute(FEV EV) {
-    val = (g_ev_error("PERF_METRICS.BACKEND_BOUND", 1) /
-           g_ev_error("TOPDOWN.SLOTS", 1)) /
-          PERF_METRICS_SUM(EV, 1, thresh) if topdown_use_fixed else g_ev_error(
-                  "TOPDOWN.BACKEND_BOUND_SLOTS", 1) /
-          SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = TMA_TOPDOWN_FIXED()
+                  ? (EV(CEV("PERF_METRICS.BACKEND_BOUND"), 1) /
+                     EV(CEV("TOPDOWN.SLOTS"), 1)) /
+                    PERF_METRICS_SUM(EV, 1, thresh)
+                  : EV(CEV("TOPDOWN.BACKEND_BOUND_SLOTS"), 1) /
+                    SLOTS(EV, 1, thresh);
     thresh = (val > 0.2);
     return val;
 }
 float Memory_Bound::compute(FEV EV) {
-    val = (g_ev_error("PERF_METRICS.MEMORY_BOUND", 2) /
-           g_ev_error("TOPDOWN.SLOTS", 2)) /
-          PERF_METRICS_SUM(EV, 2, thresh) if topdown_use_fixed else g_ev_error(
-                  "TOPDOWN.MEMORY_BOUND_SLOTS", 2) /
-          SLOTS(EV, 2, thresh);
-    thresh = (val > 0.2) && Backend_Bound::thresh;
+    TMA_MEMOIZE();
+    val = TMA_TOPDOWN_FIXED()
+                  ? (EV(CEV("PERF_METRICS.MEMORY_BOUND"), 2) /
+                     EV(CEV("TOPDOWN.SLOTS"), 2)) /
+                    PERF_METRICS_SUM(EV, 2, thresh)
+                  : EV(CEV("TOPDOWN.MEMORY_BOUND_SLOTS"), 2) /
+                    SLOTS(EV, 2, thresh);
+    thresh = (val > 0.2) && TMA_THRESH(Backend_Bound);
     return val;
 }
 float L1_Bound::compute(FEV EV) {
-    val = std::max<float>((g_ev_error("EXE_ACTIVITY.BOUND_ON_LOADS", 3) -
-                           g_ev_error("MEMORY_ACTIVITY.STALLS_L1D_MISS", 3)) /
-                                  CLKS(EV, 3, thresh),
-                          0);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = std::max<float>((EV(CEV("EXE_ACTIVITY.BOUND_ON_LOADS"), 3) -
+                           EV(CEV("MEMORY_ACTIVITY.STALLS_L1D_MISS"),
+                              3)) / CLKS(EV, 3, thresh), 0);
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float DTLB_Load::compute(FEV EV) {
-    val = std::min<float>(
-                  Mem_STLB_Hit_Cost * g_ev_error("DTLB_LOAD_MISSES.STLB_HIT:c1",
-                                                 4) +
-                          g_ev_error("DTLB_LOAD_MISSES.WALK_ACTIVE", 4),
-                  std::max<float>(
-                          g_ev_error("CYCLE_ACTIVITY.CYCLES_MEM_ANY", 4) -
-                                  g_ev_error("MEMORY_ACTIVITY.CYCLES_L1D_MISS",
-                                             4),
-                          0)) /
+    TMA_MEMOIZE();
+    val = std::min<float>(Mem_STLB_Hit_Cost *
+                                  EV(CEV("DTLB_LOAD_MISSES.STLB_HIT:c1"),
+                                     4) +
+                          EV(CEV("DTLB_LOAD_MISSES.WALK_ACTIVE"), 4),
+                          std::max<float>(EV(CEV("CYCLE_ACTIVITY.CYCLES_MEM_ANY"), 4) -
+                                          EV(CEV("MEMORY_ACTIVITY.CYCLES_L1D_MISS"), 4), 0)) /
           CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && L1_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(L1_Bound);
     return val;
 }
 float Load_STLB_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DTLB_Load::compute(EV) - Load_STLB_Miss::compute(EV);
-    thresh = (val > 0.05) && DTLB_Load::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(DTLB_Load);
     return val;
 }
 float Load_STLB_Miss::compute(FEV EV) {
-    val = g_ev_error("DTLB_LOAD_MISSES.WALK_ACTIVE", 5) / CLKS(EV, 5, thresh);
-    thresh = (val > 0.05) && DTLB_Load::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("DTLB_LOAD_MISSES.WALK_ACTIVE"), 5) /
+          CLKS(EV, 5, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(DTLB_Load);
     return val;
 }
 float Store_Fwd_Blk::compute(FEV EV) {
-    val = 13 * EV({"LD_BLOCKS.STORE_FORWARD", 0x203, 4, 0}, 4) /
+    TMA_MEMOIZE();
+    val = 13 * EV(CEV("LD_BLOCKS.STORE_FORWARD"), 4) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && L1_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(L1_Bound);
     return val;
 }
 float Lock_Latency::compute(FEV EV) {
-    val = (16 * std::max<float>(0,
-                                g_ev_error("MEM_INST_RETIRED.LOCK_LOADS", 4) -
-                                        g_ev_error("L2_RQSTS.ALL_RFO", 4)) +
+    TMA_MEMOIZE();
+    val = (16 *
+                   std::max<float>(0,
+                                   EV(CEV("MEM_INST_RETIRED.LOCK_LOADS"),
+                                      4) -
+                                   EV(CEV("L2_RQSTS.ALL_RFO"), 4)) +
            Mem_Lock_St_Fraction(EV, 4, thresh) *
                    (Mem_L2_Store_Cost *
-                            EV({"L2_RQSTS.RFO_HIT", 0xc224, 4, 0}, 4) +
-                    ORO_Demand_RFO_C1(EV, 4, thresh))) /
-          CLKS(EV, 4, thresh);
+                            EV(CEV("L2_RQSTS.RFO_HIT"), 4) +
+                    ORO_Demand_RFO_C1(EV, 4, thresh))) / CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.2) && L1_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(L1_Bound);
     return val;
 }
 float Split_Loads::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Load_Miss_Real_Latency(EV, 4, thresh) *
-          EV({"LD_BLOCKS.NO_SR", 0x803, 4, 0}, 4) / CLKS(EV, 4, thresh);
+          EV(CEV("LD_BLOCKS.NO_SR"), 4) / CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.2) && L1_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(L1_Bound);
     return val;
 }
 float FB_Full::compute(FEV EV) {
-    val = g_ev_error("L1D_PEND_MISS.FB_FULL", 4) / CLKS(EV, 4, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("L1D_PEND_MISS.FB_FULL"), 4) / CLKS(EV, 4, thresh);
     thresh = (val > 0.3);
     return val;
 }
 float L2_Bound::compute(FEV EV) {
-    val = (g_ev_error("MEMORY_ACTIVITY.STALLS_L1D_MISS", 3) -
-           g_ev_error("MEMORY_ACTIVITY.STALLS_L2_MISS", 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("MEMORY_ACTIVITY.STALLS_L1D_MISS"), 3) -
+           EV(CEV("MEMORY_ACTIVITY.STALLS_L2_MISS"), 3)) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Memory_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float L3_Bound::compute(FEV EV) {
-    val = (g_ev_error("MEMORY_ACTIVITY.STALLS_L2_MISS", 3) -
-           g_ev_error("MEMORY_ACTIVITY.STALLS_L3_MISS", 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("MEMORY_ACTIVITY.STALLS_L2_MISS"), 3) -
+           EV(CEV("MEMORY_ACTIVITY.STALLS_L3_MISS"), 3)) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Memory_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Contested_Accesses::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ((Mem_XSNP_HitM_Cost(EV, 4, thresh) -
             Mem_L2_Hit_Cost(EV, 4, thresh)) *
                    LOAD_XSNP_HITM(EV, 4, thresh) +
@@ -2985,804 +3017,947 @@ float Contested_Accesses::compute(FEV EV) {
                    LOAD_XSNP_MISS(EV, 4, thresh)) *
           FBHit_Factor(EV, 4, thresh) / CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && L3_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(L3_Bound);
     return val;
 }
 float Data_Sharing::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Mem_XSNP_Hit_Cost(EV, 4, thresh) - Mem_L2_Hit_Cost(EV, 4, thresh)) *
           LOAD_XSNP_HIT(EV, 4, thresh) * FBHit_Factor(EV, 4, thresh) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && L3_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(L3_Bound);
     return val;
 }
 float L3_Hit_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Mem_XSNP_None_Cost(EV, 4, thresh) - Mem_L2_Hit_Cost(EV, 4, thresh)) *
           LOAD_L3_HIT(EV, 4, thresh) * FBHit_Factor(EV, 4, thresh) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && L3_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(L3_Bound);
     return val;
 }
 float SQ_Full::compute(FEV EV) {
-    val = (g_ev_error("XQ.FULL_CYCLES", 4) +
-           g_ev_error("L1D_PEND_MISS.L2_STALLS", 4)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("XQ.FULL_CYCLES"), 4) +
+           EV(CEV("L1D_PEND_MISS.L2_STALLS"), 4)) /
           CLKS(EV, 4, thresh);
-    thresh = (val > 0.3) && L3_Bound::thresh;
+    thresh = (val > 0.3) && TMA_THRESH(L3_Bound);
     return val;
 }
 float DRAM_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MEM_Bound_Ratio(EV, 3, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float MEM_Bandwidth::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ORO_DRD_BW_Cycles(EV, 4, thresh) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && DRAM_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(DRAM_Bound);
     return val;
 }
 float MEM_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ORO_DRD_Any_Cycles(EV, 4, thresh) / CLKS(EV, 4, thresh) -
           MEM_Bandwidth::compute(EV);
-    thresh = (val > 0.1) && DRAM_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(DRAM_Bound);
     return val;
 }
 float Store_Bound::compute(FEV EV) {
-    val = g_ev_error("EXE_ACTIVITY.BOUND_ON_STORES", 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.2) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("EXE_ACTIVITY.BOUND_ON_STORES"), 3) /
+          CLKS(EV, 3, thresh);
+    thresh = (val > 0.2) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Store_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Store_L2_Hit_Cycles(EV, 4, thresh) +
            (1 - Mem_Lock_St_Fraction(EV, 4, thresh)) *
                    ORO_Demand_RFO_C1(EV, 4, thresh)) /
           CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Store_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Store_Bound);
     return val;
 }
 float False_Sharing::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_XSNP_HitM_Cost(EV, 4, thresh) *
-          g_ev_error("OCR.DEMAND_RFO.L3_HIT.SNOOP_HITM", 4) /
+          EV(CEV("OCR.DEMAND_RFO.L3_HIT.SNOOP_HITM"), 4) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && Store_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Store_Bound);
     return val;
 }
 float Split_Stores::compute(FEV EV) {
-    val = g_ev_error("MEM_INST_RETIRED.SPLIT_STORES", 4) /
+    TMA_MEMOIZE();
+    val = EV(CEV("MEM_INST_RETIRED.SPLIT_STORES"), 4) /
           CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && Store_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Store_Bound);
     return val;
 }
 float Streaming_Stores::compute(FEV EV) {
-    val = 9 * g_ev_error("OCR.STREAMING_WR.ANY_RESPONSE", 4) /
+    TMA_MEMOIZE();
+    val = 9 * EV(CEV("OCR.STREAMING_WR.ANY_RESPONSE"), 4) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.2) && Store_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Store_Bound);
     return val;
 }
 float DTLB_Store::compute(FEV EV) {
-    val = (Mem_STLB_Hit_Cost * g_ev_error("DTLB_STORE_MISSES.STLB_HIT:c1", 4) +
-           g_ev_error("DTLB_STORE_MISSES.WALK_ACTIVE", 4)) /
+    TMA_MEMOIZE();
+    val = (Mem_STLB_Hit_Cost *
+                   EV(CEV("DTLB_STORE_MISSES.STLB_HIT:c1"), 4) +
+           EV(CEV("DTLB_STORE_MISSES.WALK_ACTIVE"), 4)) /
           CORE_CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && Store_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Store_Bound);
     return val;
 }
 float Store_STLB_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DTLB_Store::compute(EV) - Store_STLB_Miss::compute(EV);
-    thresh = (val > 0.05) && DTLB_Store::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(DTLB_Store);
     return val;
 }
 float Store_STLB_Miss::compute(FEV EV) {
-    val = g_ev_error("DTLB_STORE_MISSES.WALK_ACTIVE", 5) /
+    TMA_MEMOIZE();
+    val = EV(CEV("DTLB_STORE_MISSES.WALK_ACTIVE"), 5) /
           CORE_CLKS(EV, 5, thresh);
-    thresh = (val > 0.05) && DTLB_Store::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(DTLB_Store);
     return val;
 }
 float Core_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Backend_Bound::compute(EV) - Memory_Bound::compute(EV));
-    thresh = (val > 0.1) && Backend_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Backend_Bound);
     return val;
 }
 float Divider::compute(FEV EV) {
-    val = g_ev_error("ARITH.DIVIDER_ACTIVE", 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.2) && Core_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("ARITH.DIVIDER_ACTIVE"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.2) && TMA_THRESH(Core_Bound);
     return val;
 }
 float Ports_Utilization::compute(FEV EV) {
-    val = Core_Bound_Cycles(EV, 3, thresh) /
-          CLKS(EV, 3, thresh) if (
-                  g_ev_error("ARITH.DIVIDER_ACTIVE", 3) <
-                  (g_ev_error("CYCLE_ACTIVITY.STALLS_TOTAL", 3) -
-                   g_ev_error("EXE_ACTIVITY.BOUND_ON_LOADS",
-                              3))) else Few_Uops_Executed_Threshold(EV, 3,
-                                                                    thresh) /
-          CLKS(EV, 3, thresh);
-    thresh = (val > 0.15) && Core_Bound::thresh;
+    TMA_MEMOIZE();
+    val = (EV(CEV("ARITH.DIVIDER_ACTIVE"), 3) <
+           (EV(CEV("CYCLE_ACTIVITY.STALLS_TOTAL"), 3) -
+            EV(CEV("EXE_ACTIVITY.BOUND_ON_LOADS"), 3)))
+                  ? Core_Bound_Cycles(EV, 3, thresh) / CLKS(EV, 3, thresh)
+                  : Few_Uops_Executed_Threshold(EV, 3, thresh) /
+                    CLKS(EV, 3, thresh);
+    thresh = (val > 0.15) && TMA_THRESH(Core_Bound);
     return val;
 }
 float Ports_Utilized_0::compute(FEV EV) {
-    val = g_ev_error("EXE_ACTIVITY.3_PORTS_UTIL:u0x80", 4) /
+    TMA_MEMOIZE();
+    val = EV(CEV("EXE_ACTIVITY.3_PORTS_UTIL:u0x80"), 4) /
                   CLKS(EV, 4, thresh) +
           Serializing_Operation::compute(EV) *
-                  (g_ev_error("CYCLE_ACTIVITY.STALLS_TOTAL", 4) -
-                   g_ev_error("EXE_ACTIVITY.BOUND_ON_LOADS", 4)) /
+                  (EV(CEV("CYCLE_ACTIVITY.STALLS_TOTAL"), 4) -
+                   EV(CEV("EXE_ACTIVITY.BOUND_ON_LOADS"), 4)) /
                   CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && Ports_Utilization::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float Serializing_Operation::compute(FEV EV) {
-    val = g_ev_error("RESOURCE_STALLS.SCOREBOARD", 5) / CLKS(EV, 5, thresh);
-    thresh = (val > 0.1) && Ports_Utilized_0::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("RESOURCE_STALLS.SCOREBOARD"), 5) / CLKS(EV, 5, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Ports_Utilized_0);
     return val;
 }
 float Slow_Pause::compute(FEV EV) {
-    val = g_ev_error("CPU_CLK_UNHALTED.PAUSE", 6) / CLKS(EV, 6, thresh);
-    thresh = (val > 0.05) && Serializing_Operation::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("CPU_CLK_UNHALTED.PAUSE"), 6) / CLKS(EV, 6, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Serializing_Operation);
     return val;
 }
 float Memory_Fence::compute(FEV EV) {
-    val = 13 * g_ev_error("MISC2_RETIRED.LFENCE", 6) / CLKS(EV, 6, thresh);
+    TMA_MEMOIZE();
+    val = 13 * EV(CEV("MISC2_RETIRED.LFENCE"), 6) / CLKS(EV, 6, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && Serializing_Operation::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Serializing_Operation);
     return val;
 }
 float Mixing_Vectors::compute(FEV EV) {
-    val = 160 * g_ev_error("ASSISTS.SSE_AVX_MIX", 5) / CLKS(EV, 5, thresh);
+    TMA_MEMOIZE();
+    val = 160 * EV(CEV("ASSISTS.SSE_AVX_MIX"), 5) / CLKS(EV, 5, thresh);
     val = std::min<float>(val, 1);
     thresh = (val > 0.05);
     return val;
 }
 float Ports_Utilized_1::compute(FEV EV) {
-    val = g_ev_error("EXE_ACTIVITY.1_PORTS_UTIL", 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && Ports_Utilization::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("EXE_ACTIVITY.1_PORTS_UTIL"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.2) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float Ports_Utilized_2::compute(FEV EV) {
-    val = g_ev_error("EXE_ACTIVITY.2_PORTS_UTIL", 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.15) && Ports_Utilization::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("EXE_ACTIVITY.2_PORTS_UTIL"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.15) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float Ports_Utilized_3m::compute(FEV EV) {
-    val = g_ev_error("UOPS_EXECUTED.CYCLES_GE_3", 4) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.7) && Ports_Utilization::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_EXECUTED.CYCLES_GE_3"), 4) / CLKS(EV, 4, thresh);
+    thresh = (val > 0.7) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float ALU_Op_Utilization::compute(FEV EV) {
-    val = (g_ev_error("UOPS_DISPATCHED.PORT_0", 5) +
-           g_ev_error("UOPS_DISPATCHED.PORT_1", 5) +
-           g_ev_error("UOPS_DISPATCHED.PORT_5_11", 5) +
-           g_ev_error("UOPS_DISPATCHED.PORT_6", 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("UOPS_DISPATCHED.PORT_0"), 5) +
+           EV(CEV("UOPS_DISPATCHED.PORT_1"), 5) +
+           EV(CEV("UOPS_DISPATCHED.PORT_5_11"), 5) +
+           EV(CEV("UOPS_DISPATCHED.PORT_6"), 5)) /
           (5 * CORE_CLKS(EV, 5, thresh));
     thresh = (val > 0.6);
     return val;
 }
 float Port_0::compute(FEV EV) {
-    val = g_ev_error("UOPS_DISPATCHED.PORT_0", 6) / CORE_CLKS(EV, 6, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED.PORT_0"), 6) / CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_1::compute(FEV EV) {
-    val = g_ev_error("UOPS_DISPATCHED.PORT_1", 6) / CORE_CLKS(EV, 6, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED.PORT_1"), 6) / CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_6::compute(FEV EV) {
-    val = g_ev_error("UOPS_DISPATCHED.PORT_6", 6) / CORE_CLKS(EV, 6, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED.PORT_6"), 6) / CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Load_Op_Utilization::compute(FEV EV) {
-    val = g_ev_error("UOPS_DISPATCHED.PORT_2_3_10", 5) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED.PORT_2_3_10"), 5) /
           (3 * CORE_CLKS(EV, 5, thresh));
     thresh = (val > 0.6);
     return val;
 }
 float Store_Op_Utilization::compute(FEV EV) {
-    val = (g_ev_error("UOPS_DISPATCHED.PORT_4_9", 5) +
-           g_ev_error("UOPS_DISPATCHED.PORT_7_8", 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("UOPS_DISPATCHED.PORT_4_9"), 5) +
+           EV(CEV("UOPS_DISPATCHED.PORT_7_8"), 5)) /
           (4 * CORE_CLKS(EV, 5, thresh));
     thresh = (val > 0.6);
     return val;
 }
 float Retiring::compute(FEV EV) {
-    val = (g_ev_error("PERF_METRICS.RETIRING", 1) /
-           g_ev_error("TOPDOWN.SLOTS", 1)) /
-          PERF_METRICS_SUM(EV, 1, thresh) if topdown_use_fixed else g_ev_error(
-                  "UOPS_RETIRED.SLOTS", 1) /
-          SLOTS(EV, 1, thresh);
-    thresh = (val > 0.7) | Heavy_Operations::thresh;
+    TMA_MEMOIZE();
+    val = TMA_TOPDOWN_FIXED()
+                  ? (EV(CEV("PERF_METRICS.RETIRING"), 1) /
+                     EV(CEV("TOPDOWN.SLOTS"), 1)) /
+                    PERF_METRICS_SUM(EV, 1, thresh)
+                  : EV(CEV("UOPS_RETIRED.SLOTS"), 1) /
+                    SLOTS(EV, 1, thresh);
+    thresh = (val > 0.7) | TMA_THRESH(Heavy_Operations);
     return val;
 }
 float Light_Operations::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Retiring::compute(EV) - Heavy_Operations::compute(EV));
     thresh = (val > 0.6);
     return val;
 }
 float FP_Arith::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = X87_Use::compute(EV) + FP_Scalar::compute(EV) +
           FP_Vector::compute(EV);
-    thresh = (val > 0.2) && Light_Operations::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Light_Operations);
     return val;
 }
 float X87_Use::compute(FEV EV) {
-    val = Retiring::compute(EV) * g_ev_error("UOPS_EXECUTED.X87", 4) /
-          g_ev_error("UOPS_EXECUTED.THREAD", 4);
-    thresh = (val > 0.1) && FP_Arith::thresh;
+    TMA_MEMOIZE();
+    val = Retiring::compute(EV) * EV(CEV("UOPS_EXECUTED.X87"), 4) /
+          EV(CEV("UOPS_EXECUTED.THREAD"), 4);
+    thresh = (val > 0.1) && TMA_THRESH(FP_Arith);
     return val;
 }
 float FP_Scalar::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FP_Arith_Scalar(EV, 4, thresh) / Retired_Slots(EV, 4, thresh);
-    thresh = (val > 0.1) && FP_Arith::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Arith);
     return val;
 }
 float FP_Vector::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FP_Arith_Vector(EV, 4, thresh) / Retired_Slots(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && FP_Arith::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Arith);
     return val;
 }
 float FP_Vector_128b::compute(FEV EV) {
-    val = (g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", 5) +
-           g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"), 5) +
+           EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"), 5)) /
           Retired_Slots(EV, 5, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && FP_Vector::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Vector);
     return val;
 }
 float FP_Vector_256b::compute(FEV EV) {
-    val = (g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", 5) +
-           g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"), 5) +
+           EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"), 5)) /
           Retired_Slots(EV, 5, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && FP_Vector::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Vector);
     return val;
 }
 float Int_Operations::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Int_Vector_128b::compute(EV) + Int_Vector_256b::compute(EV) +
           Shuffles::compute(EV);
-    thresh = (val > 0.1) && Light_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Light_Operations);
     return val;
 }
 float Int_Vector_128b::compute(FEV EV) {
-    val = (g_ev_error("INT_VEC_RETIRED.ADD_128", 4) +
-           g_ev_error("INT_VEC_RETIRED.VNNI_128", 4)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("INT_VEC_RETIRED.ADD_128"), 4) +
+           EV(CEV("INT_VEC_RETIRED.VNNI_128"), 4)) /
           Retired_Slots(EV, 4, thresh);
-    thresh = (val > 0.1) && Int_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Int_Operations);
     return val;
 }
 float Int_Vector_256b::compute(FEV EV) {
-    val = (g_ev_error("INT_VEC_RETIRED.ADD_256", 4) +
-           g_ev_error("INT_VEC_RETIRED.MUL_256", 4) +
-           g_ev_error("INT_VEC_RETIRED.VNNI_256", 4)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("INT_VEC_RETIRED.ADD_256"), 4) +
+           EV(CEV("INT_VEC_RETIRED.MUL_256"), 4) +
+           EV(CEV("INT_VEC_RETIRED.VNNI_256"), 4)) /
           Retired_Slots(EV, 4, thresh);
-    thresh = (val > 0.1) && Int_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Int_Operations);
     return val;
 }
 float Shuffles::compute(FEV EV) {
-    val = g_ev_error("INT_VEC_RETIRED.SHUFFLES", 4) /
+    TMA_MEMOIZE();
+    val = EV(CEV("INT_VEC_RETIRED.SHUFFLES"), 4) /
           Retired_Slots(EV, 4, thresh);
-    thresh = (val > 0.1) && Int_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Int_Operations);
     return val;
 }
 float Memory_Operations::compute(FEV EV) {
-    val = Light_Operations::compute(EV) * g_ev_error("MEM_UOP_RETIRED.ANY", 3) /
+    TMA_MEMOIZE();
+    val = Light_Operations::compute(EV) *
+          EV(CEV("MEM_UOP_RETIRED.ANY"), 3) /
           Retired_Slots(EV, 3, thresh);
-    thresh = (val > 0.1) && Light_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Light_Operations);
     return val;
 }
 float Fused_Instructions::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Light_Operations::compute(EV) *
-          g_ev_error("INST_RETIRED.MACRO_FUSED", 3) /
+          EV(CEV("INST_RETIRED.MACRO_FUSED"), 3) /
           Retired_Slots(EV, 3, thresh);
-    thresh = (val > 0.1) && Light_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Light_Operations);
     return val;
 }
 float Non_Fused_Branches::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Light_Operations::compute(EV) *
-          (EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, 3) -
-           g_ev_error("INST_RETIRED.MACRO_FUSED", 3)) /
+          (EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), 3) -
+           EV(CEV("INST_RETIRED.MACRO_FUSED"), 3)) /
           Retired_Slots(EV, 3, thresh);
-    thresh = (val > 0.1) && Light_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Light_Operations);
     return val;
 }
 float Nop_Instructions::compute(FEV EV) {
-    val = Light_Operations::compute(EV) * g_ev_error("INST_RETIRED.NOP", 3) /
+    TMA_MEMOIZE();
+    val = Light_Operations::compute(EV) * EV(CEV("INST_RETIRED.NOP"), 3) /
           Retired_Slots(EV, 3, thresh);
-    thresh = (val > 0.1) && Light_Operations::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Light_Operations);
     return val;
 }
 float Other_Light_Ops::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Light_Operations::compute(EV) - Light_Ops_Sum(EV, 3, thresh));
-    thresh = (val > 0.3) && Light_Operations::thresh;
+    thresh = (val > 0.3) && TMA_THRESH(Light_Operations);
     return val;
 }
 float Heavy_Operations::compute(FEV EV) {
-    val = (g_ev_error("PERF_METRICS.HEAVY_OPERATIONS", 2) /
-           g_ev_error("TOPDOWN.SLOTS", 2)) /
-          PERF_METRICS_SUM(EV, 2, thresh) if topdown_use_fixed else g_ev_error(
-                  "UOPS_RETIRED.HEAVY", 2) /
-          SLOTS(EV, 2, thresh);
+    TMA_MEMOIZE();
+    val = TMA_TOPDOWN_FIXED()
+                  ? (EV(CEV("PERF_METRICS.HEAVY_OPERATIONS"), 2) /
+                     EV(CEV("TOPDOWN.SLOTS"), 2)) /
+                    PERF_METRICS_SUM(EV, 2, thresh)
+                  : EV(CEV("UOPS_RETIRED.HEAVY"), 2) /
+                    SLOTS(EV, 2, thresh);
     thresh = (val > 0.1);
     return val;
 }
 float Few_Uops_Instructions::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Heavy_Operations::compute(EV) - Microcode_Sequencer::compute(EV);
-    thresh = (val > 0.05) && Heavy_Operations::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Heavy_Operations);
     return val;
 }
 float Microcode_Sequencer::compute(FEV EV) {
-    val = g_ev_error("UOPS_RETIRED.MS", 3) / SLOTS(EV, 3, thresh);
-    thresh = (val > 0.05) && Heavy_Operations::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_RETIRED.MS"), 3) / SLOTS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Heavy_Operations);
     return val;
 }
 float Assists::compute(FEV EV) {
-    val = Avg_Assist_Cost * g_ev_error("ASSISTS.ANY:u0x1B", 4) /
+    TMA_MEMOIZE();
+    val = Avg_Assist_Cost * EV(CEV("ASSISTS.ANY:u0x1B"), 4) /
           SLOTS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && Microcode_Sequencer::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Microcode_Sequencer);
     return val;
 }
 float Page_Faults::compute(FEV EV) {
-    val = 99 * g_ev_error("ASSISTS.PAGE_FAULT", 5) / SLOTS(EV, 5, thresh);
+    TMA_MEMOIZE();
+    val = 99 * EV(CEV("ASSISTS.PAGE_FAULT"), 5) / SLOTS(EV, 5, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float FP_Assists::compute(FEV EV) {
-    val = 30 * g_ev_error("ASSISTS.FP", 5) / SLOTS(EV, 5, thresh);
+    TMA_MEMOIZE();
+    val = 30 * EV(CEV("ASSISTS.FP"), 5) / SLOTS(EV, 5, thresh);
     thresh = (val > 0.1);
     return val;
 }
 float AVX_Assists::compute(FEV EV) {
-    val = 63 * g_ev_error("ASSISTS.SSE_AVX_MIX", 5) / SLOTS(EV, 5, thresh);
+    TMA_MEMOIZE();
+    val = 63 * EV(CEV("ASSISTS.SSE_AVX_MIX"), 5) / SLOTS(EV, 5, thresh);
     thresh = (val > 0.1);
     return val;
 }
 float CISC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Microcode_Sequencer::compute(EV) - Assists::compute(EV));
-    thresh = (val > 0.1) && Microcode_Sequencer::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Microcode_Sequencer);
     return val;
 }
 float Metric_Mispredictions::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mispredictions(EV, 0, thresh);
     thresh = (val > 20);
     return val;
 }
 float Metric_Memory_Bandwidth::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Memory_Bandwidth(EV, 0, thresh);
     thresh = (val > 20);
     return val;
 }
 float Metric_Memory_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Memory_Latency(EV, 0, thresh);
     thresh = (val > 20);
     return val;
 }
 float Metric_Memory_Data_TLBs::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Memory_Data_TLBs(EV, 0, thresh);
     thresh = (val > 20);
     return val;
 }
 float Metric_Branching_Overhead::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branching_Overhead(EV, 0, thresh);
     thresh = (val > 10);
     return val;
 }
 float Metric_Big_Code::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Big_Code(EV, 0, thresh);
     thresh = (val > 20);
     return val;
 }
 float Metric_Instruction_Fetch_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Instruction_Fetch_BW(EV, 0, thresh);
     thresh = (val > 20);
     return val;
 }
 float Metric_IPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_UPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = UPI(EV, 0, thresh);
     thresh = (val > 1.05);
     return val;
 }
 float Metric_UpTB::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = UpTB(EV, 0, thresh);
     thresh = val < Pipeline_Width * 1.5;
     return val;
 }
 float Metric_CPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_SLOTS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SLOTS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Slots_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Slots_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Execute_per_Issue::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Execute_per_Issue(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CoreIPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CoreIPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_FLOPc::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FLOPc(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_FP_Arith_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FP_Arith_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_ILP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ILP(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Core_Bound_Likely::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Core_Bound_Likely(EV, 0, thresh);
     thresh = (val > 0.5);
     return val;
 }
 float Metric_CORE_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CORE_CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpLoad::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpLoad(EV, 0, thresh);
     thresh = (val < 3);
     return val;
 }
 float Metric_IpStore::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpStore(EV, 0, thresh);
     thresh = (val < 8);
     return val;
 }
 float Metric_IpBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpBranch(EV, 0, thresh);
     thresh = (val < 8);
     return val;
 }
 float Metric_IpCall::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpCall(EV, 0, thresh);
     thresh = (val < 200);
     return val;
 }
 float Metric_IpTB::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpTB(EV, 0, thresh);
     thresh = val < Pipeline_Width * 2;
     return val;
 }
 float Metric_BpTkBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = BpTkBranch(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpFLOP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpFLOP(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_Scalar_SP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_Scalar_SP(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_Scalar_DP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_Scalar_DP(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_AVX128::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_AVX128(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_AVX256::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_AVX256(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpSWPF::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpSWPF(EV, 0, thresh);
     thresh = (val < 100);
     return val;
 }
 float Metric_Instructions::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Instructions(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Retire::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Retire(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Strings_Cycles::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Strings_Cycles(EV, 0, thresh);
     thresh = (val > 0.1);
     return val;
 }
 float Metric_IpAssist::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpAssist(EV, 0, thresh);
     thresh = (val < 100000);
     return val;
 }
 float Metric_Execute::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Execute(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Fetch_UpC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Fetch_UpC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_LSD_Coverage::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = LSD_Coverage(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DSB_Coverage::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DSB_Coverage(EV, 0, thresh);
     thresh = (val < 0.7) && HighIPC(EV, 1, thresh);
     return val;
 }
 float Metric_DSB_Switch_Cost::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DSB_Switch_Cost(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DSB_Misses::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DSB_Misses(EV, 0, thresh);
     thresh = (val > 0.1);
     return val;
 }
 float Metric_IpDSB_Miss_Ret::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpDSB_Miss_Ret(EV, 0, thresh);
     thresh = (val < 50);
     return val;
 }
 float Metric_IpMispredict::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpMispredict(EV, 0, thresh);
     thresh = (val < 200);
     return val;
 }
 float Metric_Branch_Misprediction_Cost::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branch_Misprediction_Cost(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cond_NT::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cond_NT(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cond_TK::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cond_TK(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CallRet::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CallRet(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Jump::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Jump(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Other_Branches::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Other_Branches(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Load_Miss_Real_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Load_Miss_Real_Latency(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_MLP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MLP(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1MPKI_Load::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1MPKI_Load(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2MPKI_All::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2MPKI_All(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2MPKI_Load::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2MPKI_Load(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2HPKI_All::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2HPKI_All(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2HPKI_Load::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2HPKI_Load(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_FB_HPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FB_HPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Page_Walks_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Page_Walks_Utilization(EV, 0, thresh);
     thresh = (val > 0.5);
     return val;
 }
 float Metric_L1D_Cache_Fill_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_Cache_Fill_BW(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2_Cache_Fill_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2_Cache_Fill_BW(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3_Cache_Fill_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3_Cache_Fill_BW(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3_Cache_Access_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3_Cache_Access_BW(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1D_Cache_Fill_BW_1T::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_Cache_Fill_BW_1T(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2_Cache_Fill_BW_1T::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2_Cache_Fill_BW_1T(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3_Cache_Fill_BW_1T::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3_Cache_Fill_BW_1T(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3_Cache_Access_BW_1T::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3_Cache_Access_BW_1T(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CPU_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPU_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Average_Frequency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Average_Frequency(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_GFLOPs::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = GFLOPs(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Turbo_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Turbo_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_SMT_2T_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SMT_2T_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Kernel_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Kernel_Utilization(EV, 0, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Metric_Kernel_CPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Kernel_CPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DRAM_BW_Use::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DRAM_BW_Use(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_MEM_Parallel_Requests::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MEM_Parallel_Requests(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Time::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Time(EV, 0, thresh);
     thresh = (val < 1);
     return val;
 }
 float Metric_Socket_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Socket_CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpFarBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpFarBranch(EV, 0, thresh);
     thresh = (val < 1000000);
     return val;
 }
 
 float Br_DoI_Jumps(FEV EV, int level, bool& thresh) {
-    return EV({"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0}, level) -
-           g_ev_error("BR_INST_RETIRED.COND_TAKEN", level) -
-           2 * EV({"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0}, level);
+    return EV(CEV("BR_INST_RETIRED.NEAR_TAKEN"), level) -
+           EV(CEV("BR_INST_RETIRED.COND_TAKEN"), level) -
+           2 * EV(CEV("BR_INST_RETIRED.NEAR_CALL"), level);
 }
 float Branching_Retired(FEV EV, int level, bool& thresh) {
-    return (g_ev_error("BR_INST_RETIRED.COND", level) +
-            3 * EV({"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0}, level) +
+    return (EV(CEV("BR_INST_RETIRED.COND"), level) +
+            3 * EV(CEV("BR_INST_RETIRED.NEAR_CALL"), level) +
             Br_DoI_Jumps(EV, level, thresh)) /
            SLOTS(EV, level, thresh);
 }
 float Core_Bound_Cycles(FEV EV, int level, bool& thresh) {
-    return g_ev_error("EXE_ACTIVITY.3_PORTS_UTIL:u0x80", level) +
+    return EV(CEV("EXE_ACTIVITY.3_PORTS_UTIL:u0x80"), level) +
            Few_Uops_Executed_Threshold(EV, level, thresh);
 }
 float DurationTimeInSeconds(FEV EV, int level, bool& thresh) {
@@ -3793,47 +3968,52 @@ float Exe_Ports(FEV EV, int level, bool& thresh) {
 }
 float Execute_Cycles(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (g_ev_error("UOPS_EXECUTED.CORE_CYCLES_GE_1", level) / 2);
+        return (EV(CEV("UOPS_EXECUTED.CORE_CYCLES_GE_1"), level) / 2);
     } else {
-        return g_ev_error("UOPS_EXECUTED.CORE_CYCLES_GE_1", level);
+        return EV(CEV("UOPS_EXECUTED.CORE_CYCLES_GE_1"), level);
     }
 }
 float FBHit_Factor(FEV EV, int level, bool& thresh) {
     return 1 + FBHit_per_L1Miss(EV, level, thresh) / 2;
 }
 float FBHit_per_L1Miss(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_LOAD_RETIRED.FB_HIT", level) /
+    return EV(CEV("MEM_LOAD_RETIRED.FB_HIT"), level) /
            LOAD_L1_MISS_NET(EV, level, thresh);
 }
 float Fetched_Uops(FEV EV, int level, bool& thresh) {
-    return EV({"IDQ.DSB_UOPS", 0x879, 4, 0}, level) +
-           EV({"LSD.UOPS", 0x1a8, 4, 0}, level) +
-           EV({"IDQ.MITE_UOPS", 0x479, 4, 0}, level) +
-           EV({"IDQ.MS_UOPS", 0x3079, 4, 0}, level);
+    return EV(CEV("IDQ.DSB_UOPS"), level) +
+           EV(CEV("LSD.UOPS"), level) +
+           EV(CEV("IDQ.MITE_UOPS"), level) +
+           EV(CEV("IDQ.MS_UOPS"), level);
 }
 float Few_Uops_Executed_Threshold(FEV EV, int level, bool& thresh) {
-    return g_ev_error("EXE_ACTIVITY.1_PORTS_UTIL", level) +
+    return EV(CEV("EXE_ACTIVITY.1_PORTS_UTIL"), level) +
            Retiring::compute(EV) *
-                   g_ev_error("EXE_ACTIVITY.2_PORTS_UTIL:u0xc", level);
+                   EV(CEV("EXE_ACTIVITY.2_PORTS_UTIL:u0xc"), level);
 }
 float FLOP_Count(FEV EV, int level, bool& thresh) {
-    return (1 * (g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_SINGLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", level)) +
-            2 * g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", level) +
-            4 * (g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE",
-                            level)) +
-            8 * g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", level));
+    return (1 * (EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_SINGLE"), level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE"), level)) +
+            2 *
+                    EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"),
+                       level) +
+            4 * (EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"),
+                    level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"),
+                    level)) +
+            8 *
+                    EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"),
+                       level));
 }
 float FP_Arith_Scalar(FEV EV, int level, bool& thresh) {
-    return g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_SINGLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", level);
+    return EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_SINGLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE"), level);
 }
 float FP_Arith_Vector(FEV EV, int level, bool& thresh) {
-    return g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", level);
+    return EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"), level);
 }
 float HighIPC(FEV EV, int level, bool& thresh) {
     float val = IPC(EV, level, thresh) / Pipeline_Width;
@@ -3845,30 +4025,30 @@ float Light_Ops_Sum(FEV EV, int level, bool& thresh) {
            Non_Fused_Branches::compute(EV) + Nop_Instructions::compute(EV);
 }
 float LOAD_L1_MISS_NET(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_LOAD_RETIRED.L1_MISS", level);
+    return EV(CEV("MEM_LOAD_RETIRED.L1_MISS"), level);
 }
 float LOAD_L3_HIT(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_LOAD_RETIRED.L3_HIT", level);
+    return EV(CEV("MEM_LOAD_RETIRED.L3_HIT"), level);
 }
 float LOAD_XSNP_HIT(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_LOAD_L3_HIT_RETIRED.XSNP_NO_FWD", level) +
-           g_ev_error("MEM_LOAD_L3_HIT_RETIRED.XSNP_FWD", level) *
-                   (1 - true_XSNP_HitM_Fraction(EV, level, thresh));
+    return EV(CEV("MEM_LOAD_L3_HIT_RETIRED.XSNP_NO_FWD"), level) +
+           EV(CEV("MEM_LOAD_L3_HIT_RETIRED.XSNP_FWD"), level) *
+                   (1 - True_XSNP_HitM_Fraction(EV, level, thresh));
 }
 float LOAD_XSNP_HITM(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_LOAD_L3_HIT_RETIRED.XSNP_FWD", level) *
-           true_XSNP_HitM_Fraction(EV, level, thresh);
+    return EV(CEV("MEM_LOAD_L3_HIT_RETIRED.XSNP_FWD"), level) *
+           True_XSNP_HitM_Fraction(EV, level, thresh);
 }
 float LOAD_XSNP_MISS(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_LOAD_L3_HIT_RETIRED.XSNP_MISS", level);
+    return EV(CEV("MEM_LOAD_L3_HIT_RETIRED.XSNP_MISS"), level);
 }
 float MEM_Bound_Ratio(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEMORY_ACTIVITY.STALLS_L3_MISS", level) /
+    return EV(CEV("MEMORY_ACTIVITY.STALLS_L3_MISS"), level) /
            CLKS(EV, level, thresh);
 }
 float Mem_Lock_St_Fraction(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_INST_RETIRED.LOCK_LOADS", level) /
-           g_ev_error("MEM_INST_RETIRED.ALL_STORES", level);
+    return EV(CEV("MEM_INST_RETIRED.LOCK_LOADS"), level) /
+           EV(CEV("MEM_INST_RETIRED.ALL_STORES"), level);
 }
 float Mispred_Clears_Fraction(FEV EV, int level, bool& thresh) {
     return Branch_Mispredicts::compute(EV) / Bad_Speculation::compute(EV);
@@ -3876,9 +4056,8 @@ float Mispred_Clears_Fraction(FEV EV, int level, bool& thresh) {
 float ORO_Demand_RFO_C1(FEV EV, int level, bool& thresh) {
     auto func = [&]() -> float {
         return std::min<float>(
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level),
-                EV({"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO",
-                    0x1000460, 4, 0},
+                EV(CEV("CPU_CLK_UNHALTED.THREAD"), level),
+                EV(CEV("OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO"),
                    level));
     };
     return g_ev_process(func, level);
@@ -3886,32 +4065,30 @@ float ORO_Demand_RFO_C1(FEV EV, int level, bool& thresh) {
 float ORO_DRD_Any_Cycles(FEV EV, int level, bool& thresh) {
     auto func = [&]() -> float {
         return std::min<float>(
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level),
-                EV({"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD",
-                    0x1000860, 4, 0},
+                EV(CEV("CPU_CLK_UNHALTED.THREAD"), level),
+                EV(CEV("OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD"),
                    level));
     };
     return g_ev_process(func, level);
 }
 float ORO_DRD_BW_Cycles(FEV EV, int level, bool& thresh) {
     auto func = [&]() -> float {
-        return std::min<float>(
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level),
-                g_ev_error("OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c4",
-                           level));
+        return std::min<float>(EV(CEV("CPU_CLK_UNHALTED.THREAD"),
+                                  level),
+                               EV(CEV("OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c4"), level));
     };
     return g_ev_process(func, level);
 }
 float PERF_METRICS_SUM(FEV EV, int level, bool& thresh) {
-    if (topdown_use_fixed) {
-        return ((g_ev_error("PERF_METRICS.FRONTEND_BOUND", level) /
-                 g_ev_error("TOPDOWN.SLOTS", level)) +
-                (g_ev_error("PERF_METRICS.BAD_SPECULATION", level) /
-                 g_ev_error("TOPDOWN.SLOTS", level)) +
-                (g_ev_error("PERF_METRICS.RETIRING", level) /
-                 g_ev_error("TOPDOWN.SLOTS", level)) +
-                (g_ev_error("PERF_METRICS.BACKEND_BOUND", level) /
-                 g_ev_error("TOPDOWN.SLOTS", level)));
+    if (TMA_TOPDOWN_FIXED()) {
+        return ((EV(CEV("PERF_METRICS.FRONTEND_BOUND"), level) /
+                 EV(CEV("TOPDOWN.SLOTS"), level)) +
+                (EV(CEV("PERF_METRICS.BAD_SPECULATION"), level) /
+                 EV(CEV("TOPDOWN.SLOTS"), level)) +
+                (EV(CEV("PERF_METRICS.RETIRING"), level) /
+                 EV(CEV("TOPDOWN.SLOTS"), level)) +
+                (EV(CEV("PERF_METRICS.BACKEND_BOUND"), level) /
+                 EV(CEV("TOPDOWN.SLOTS"), level)));
     } else {
         return 0;
     }
@@ -3920,13 +4097,14 @@ float Retired_Slots(FEV EV, int level, bool& thresh) {
     return Retiring::compute(EV) * SLOTS(EV, level, thresh);
 }
 float Store_L2_Hit_Cycles(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_STORE_RETIRED.L2_HIT", level) * Mem_L2_Store_Cost *
-           (1 - Mem_Lock_St_Fraction(EV, level, thresh));
+    return EV(CEV("MEM_STORE_RETIRED.L2_HIT"), level) *
+           Mem_L2_Store_Cost * (1 - Mem_Lock_St_Fraction(EV, level, thresh));
 }
-float true_XSNP_HitM_Fraction(FEV EV, int level, bool& thresh) {
-    return g_ev_error("OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HITM", level) /
-           (g_ev_error("OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HITM", level) +
-            g_ev_error("OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HIT_WITH_FWD", level));
+float True_XSNP_HitM_Fraction(FEV EV, int level, bool& thresh) {
+    return EV(CEV("OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HITM"), level) /
+           (EV(CEV("OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HITM"), level) +
+            EV(CEV("OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HIT_WITH_FWD"),
+               level));
 }
 float Mem_XSNP_HitM_Cost(FEV EV, int level, bool& thresh) {
     return 28 * Average_Frequency(EV, level, thresh);
@@ -4027,7 +4205,7 @@ float Memory_Data_TLBs(FEV EV, int level, bool& thresh) {
                           (Split_Stores::compute(EV) + DTLB_Store::compute(EV) +
                            Streaming_Stores::compute(EV) +
                            Store_Latency::compute(EV) +
-                           false_Sharing::compute(EV))));
+                           False_Sharing::compute(EV))));
     thresh = (val > 20);
     return val;
 }
@@ -4060,18 +4238,18 @@ float Instruction_Fetch_BW(FEV EV, int level, bool& thresh) {
     return val;
 }
 float IPC(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    return EV(CEV("INST_RETIRED.ANY"), level) /
            CLKS(EV, level, thresh);
 }
 float UPI(FEV EV, int level, bool& thresh) {
     float val = Retired_Slots(EV, level, thresh) /
-                EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+                EV(CEV("INST_RETIRED.ANY"), level);
     thresh = (val > 1.05);
     return val;
 }
 float UpTB(FEV EV, int level, bool& thresh) {
     float val = Retired_Slots(EV, level, thresh) /
-                EV({"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0}, level);
+                EV(CEV("BR_INST_RETIRED.NEAR_TAKEN"), level);
     thresh = val < Pipeline_Width * 1.5;
     return val;
 }
@@ -4079,179 +4257,182 @@ float CPI(FEV EV, int level, bool& thresh) {
     return 1 / IPC(EV, level, thresh);
 }
 float CLKS(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level);
+    return EV(CEV("CPU_CLK_UNHALTED.THREAD"), level);
 }
 float SLOTS(FEV EV, int level, bool& thresh) {
-    if (topdown_use_fixed) {
-        return g_ev_error("TOPDOWN.SLOTS", level);
+    if (TMA_TOPDOWN_FIXED()) {
+        return EV(CEV("TOPDOWN.SLOTS"), level);
     } else {
-        return g_ev_error("TOPDOWN.SLOTS", level);
+        return EV(CEV("TOPDOWN.SLOTS"), level);
     }
 }
 float Slots_Utilization(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
         return SLOTS(EV, level, thresh) /
-               (g_ev_error("TOPDOWN.SLOTS:percore", level) / 2);
+               (EV(CEV("TOPDOWN.SLOTS:percore"), level) / 2);
     } else {
         return 1;
     }
 }
 float Execute_per_Issue(FEV EV, int level, bool& thresh) {
-    return g_ev_error("UOPS_EXECUTED.THREAD", level) /
-           EV({"UOPS_ISSUED.ANY", 0x10e, 4, 0}, level);
+    return EV(CEV("UOPS_EXECUTED.THREAD"), level) /
+           EV(CEV("UOPS_ISSUED.ANY"), level);
 }
 float CoreIPC(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    return EV(CEV("INST_RETIRED.ANY"), level) /
            CORE_CLKS(EV, level, thresh);
 }
 float FLOPc(FEV EV, int level, bool& thresh) {
     return FLOP_Count(EV, level, thresh) / CORE_CLKS(EV, level, thresh);
 }
 float FP_Arith_Utilization(FEV EV, int level, bool& thresh) {
-    return (g_ev_error("FP_ARITH_DISPATCHED.PORT_0", level) +
-            g_ev_error("FP_ARITH_DISPATCHED.PORT_1", level) +
-            g_ev_error("FP_ARITH_DISPATCHED.PORT_5", level)) /
+    return (EV(CEV("FP_ARITH_DISPATCHED.PORT_0"), level) +
+            EV(CEV("FP_ARITH_DISPATCHED.PORT_1"), level) +
+            EV(CEV("FP_ARITH_DISPATCHED.PORT_5"), level)) /
            (2 * CORE_CLKS(EV, level, thresh));
 }
 float ILP(FEV EV, int level, bool& thresh) {
-    return g_ev_error("UOPS_EXECUTED.THREAD", level) /
+    return EV(CEV("UOPS_EXECUTED.THREAD"), level) /
            Execute_Cycles(EV, level, thresh);
 }
 float Core_Bound_Likely(FEV EV, int level, bool& thresh) {
-    if (Core_Bound::compute(EV) < Ports_Utilization::compute(EV)) {
-return val = (1 - Core_Bound::compute(EV) / Ports_Utilization::compute(EV) ;
-    } else {
-        if (SMT_2T_Utilization(EV, level, thresh) > 0.5) {
-return  1) ;
-        } else {
-            return 0;
-        }
-    }
+    float val = SMT_2T_Utilization(EV, level, thresh) > 0.5
+                        ? (Core_Bound::compute(EV) <
+                           Ports_Utilization::compute(EV)
+                                   ? 1 -
+                                     Core_Bound::compute(EV) /
+                                             Ports_Utilization::compute(EV)
+                                   : 1)
+                        : 0;
     thresh = (val > 0.5);
     return val;
 }
 float CORE_CLKS(FEV EV, int level, bool& thresh) {
-    return g_ev_error("CPU_CLK_UNHALTED.DISTRIBUTED", level);
+    return EV(CEV("CPU_CLK_UNHALTED.DISTRIBUTED"), level);
 }
 float IpLoad(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("MEM_INST_RETIRED.ALL_LOADS", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("MEM_INST_RETIRED.ALL_LOADS"), level);
     thresh = (val < 3);
     return val;
 }
 float IpStore(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("MEM_INST_RETIRED.ALL_STORES", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("MEM_INST_RETIRED.ALL_STORES"), level);
     thresh = (val < 8);
     return val;
 }
 float IpBranch(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
     thresh = (val < 8);
     return val;
 }
 float IpCall(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.NEAR_CALL"), level);
     thresh = (val < 200);
     return val;
 }
 float IpTB(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.NEAR_TAKEN"), level);
     thresh = val < Pipeline_Width * 2;
     return val;
 }
 float BpTkBranch(FEV EV, int level, bool& thresh) {
-    return EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level) /
-           EV({"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0}, level);
+    return EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level) /
+           EV(CEV("BR_INST_RETIRED.NEAR_TAKEN"), level);
 }
 float IpFLOP(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
                 FLOP_Count(EV, level, thresh);
     thresh = (val < 10);
     return val;
 }
 float IpArith(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
                 (FP_Arith_Scalar(EV, level, thresh) +
                  FP_Arith_Vector(EV, level, thresh));
     thresh = (val < 10);
     return val;
 }
 float IpArith_Scalar_SP(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_SINGLE", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_SINGLE"), level);
     thresh = (val < 10);
     return val;
 }
 float IpArith_Scalar_DP(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE"), level);
     thresh = (val < 10);
     return val;
 }
 float IpArith_AVX128(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                (g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", level));
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                (EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"),
+                    level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"),
+                    level));
     thresh = (val < 10);
     return val;
 }
 float IpArith_AVX256(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                (g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", level));
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                (EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"),
+                    level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"),
+                    level));
     thresh = (val < 10);
     return val;
 }
 float IpSWPF(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("SW_PREFETCH_ACCESS.T0:uF", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("SW_PREFETCH_ACCESS.T0:uF"), level);
     thresh = (val < 100);
     return val;
 }
 float Instructions(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return EV(CEV("INST_RETIRED.ANY"), level);
 }
 float Retire(FEV EV, int level, bool& thresh) {
     return Retired_Slots(EV, level, thresh) /
-           g_ev_error("UOPS_RETIRED.SLOTS:c1", level);
+           EV(CEV("UOPS_RETIRED.SLOTS:c1"), level);
 }
 float Strings_Cycles(FEV EV, int level, bool& thresh) {
-    float val = g_ev_error("INST_RETIRED.REP_ITERATION", level) /
-                g_ev_error("UOPS_RETIRED.SLOTS:c1", level);
+    float val = EV(CEV("INST_RETIRED.REP_ITERATION"), level) /
+                EV(CEV("UOPS_RETIRED.SLOTS:c1"), level);
     thresh = (val > 0.1);
     return val;
 }
 float IpAssist(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("ASSISTS.ANY:u0x1B", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("ASSISTS.ANY:u0x1B"), level);
     thresh = (val < 100000);
     return val;
 }
 float Execute(FEV EV, int level, bool& thresh) {
-    return g_ev_error("UOPS_EXECUTED.THREAD", level) /
-           g_ev_error("UOPS_EXECUTED.THREAD:c1", level);
+    return EV(CEV("UOPS_EXECUTED.THREAD"), level) /
+           EV(CEV("UOPS_EXECUTED.THREAD:c1"), level);
 }
 float Fetch_UpC(FEV EV, int level, bool& thresh) {
-    return EV({"UOPS_ISSUED.ANY", 0x10e, 4, 0}, level) /
-           g_ev_error("UOPS_ISSUED.ANY:c1", level);
+    return EV(CEV("UOPS_ISSUED.ANY"), level) /
+           EV(CEV("UOPS_ISSUED.ANY:c1"), level);
 }
 float LSD_Coverage(FEV EV, int level, bool& thresh) {
-    return EV({"LSD.UOPS", 0x1a8, 4, 0}, level) /
+    return EV(CEV("LSD.UOPS"), level) /
            Fetched_Uops(EV, level, thresh);
 }
 float DSB_Coverage(FEV EV, int level, bool& thresh) {
-    float val = EV({"IDQ.DSB_UOPS", 0x879, 4, 0}, level) /
+    float val = EV(CEV("IDQ.DSB_UOPS"), level) /
                 Fetched_Uops(EV, level, thresh);
     thresh = (val < 0.7) && HighIPC(EV, 1, thresh);
     return val;
 }
 float DSB_Switch_Cost(FEV EV, int level, bool& thresh) {
-    return EV({"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x2ab, 4, 0}, level) /
-           g_ev_error("DSB2MITE_SWITCHES.PENALTY_CYCLES:c1:e1", level);
+    return EV(CEV("DSB2MITE_SWITCHES.PENALTY_CYCLES"), level) /
+           EV(CEV("DSB2MITE_SWITCHES.PENALTY_CYCLES:c1:e1"), level);
 }
 float DSB_Misses(FEV EV, int level, bool& thresh) {
     float val =
@@ -4266,14 +4447,14 @@ float DSB_Misses(FEV EV, int level, bool& thresh) {
     return val;
 }
 float IpDSB_Miss_Ret(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("FRONTEND_RETIRED.ANY_DSB_MISS", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("FRONTEND_RETIRED.ANY_DSB_MISS"), level);
     thresh = (val < 50);
     return val;
 }
 float IpMispredict(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level);
     thresh = (val < 200);
     return val;
 }
@@ -4284,97 +4465,97 @@ float Branch_Misprediction_Cost(FEV EV, int level, bool& thresh) {
                      DSB_Switches::compute(EV) + Branch_Resteers::compute(EV) +
                      MS_Switches::compute(EV) + ITLB_Misses::compute(EV))) *
            SLOTS(EV, level, thresh) /
-           EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level);
+           EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level);
 }
 float Cond_NT(FEV EV, int level, bool& thresh) {
-    return g_ev_error("BR_INST_RETIRED.COND_NTAKEN", level) /
-           EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+    return EV(CEV("BR_INST_RETIRED.COND_NTAKEN"), level) /
+           EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
 }
 float Cond_TK(FEV EV, int level, bool& thresh) {
-    return g_ev_error("BR_INST_RETIRED.COND_TAKEN", level) /
-           EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+    return EV(CEV("BR_INST_RETIRED.COND_TAKEN"), level) /
+           EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
 }
 float CallRet(FEV EV, int level, bool& thresh) {
-    return (EV({"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0}, level) +
-            g_ev_error("BR_INST_RETIRED.NEAR_RETURN", level)) /
-           EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+    return (EV(CEV("BR_INST_RETIRED.NEAR_CALL"), level) +
+            EV(CEV("BR_INST_RETIRED.NEAR_RETURN"), level)) /
+           EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
 }
 float Jump(FEV EV, int level, bool& thresh) {
     return Br_DoI_Jumps(EV, level, thresh) /
-           EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+           EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
 }
 float Other_Branches(FEV EV, int level, bool& thresh) {
     return 1 - (Cond_NT(EV, level, thresh) + Cond_TK(EV, level, thresh) +
                 CallRet(EV, level, thresh) + Jump(EV, level, thresh));
 }
 float Load_Miss_Real_Latency(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_PEND_MISS.PENDING", 0x148, 4, 0}, level) /
-           g_ev_error("MEM_LOAD_COMPLETED.L1_MISS_ANY", level);
+    return EV(CEV("L1D_PEND_MISS.PENDING"), level) /
+           EV(CEV("MEM_LOAD_COMPLETED.L1_MISS_ANY"), level);
 }
 float MLP(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_PEND_MISS.PENDING", 0x148, 4, 0}, level) /
-           EV({"L1D_PEND_MISS.PENDING_CYCLES", 0x1000148, 4, 0}, level);
+    return EV(CEV("L1D_PEND_MISS.PENDING"), level) /
+           EV(CEV("L1D_PEND_MISS.PENDING_CYCLES"), level);
 }
 float L1MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("MEM_LOAD_RETIRED.L1_MISS", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_LOAD_RETIRED.L1_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L1MPKI_Load(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("L2_RQSTS.ALL_DEMAND_DATA_RD", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("L2_RQSTS.ALL_DEMAND_DATA_RD"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("MEM_LOAD_RETIRED.L2_MISS", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_LOAD_RETIRED.L2_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2MPKI_All(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("L2_RQSTS.MISS", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("L2_RQSTS.MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2MPKI_Load(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("L2_RQSTS.DEMAND_DATA_RD_MISS", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("L2_RQSTS.DEMAND_DATA_RD_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2HPKI_All(FEV EV, int level, bool& thresh) {
     return 1000 *
-           (g_ev_error("L2_RQSTS.REFERENCES", level) -
-            g_ev_error("L2_RQSTS.MISS", level)) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+           (EV(CEV("L2_RQSTS.REFERENCES"), level) -
+            EV(CEV("L2_RQSTS.MISS"), level)) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2HPKI_Load(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("L2_RQSTS.DEMAND_DATA_RD_HIT", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("L2_RQSTS.DEMAND_DATA_RD_HIT"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L3MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("MEM_LOAD_RETIRED.L3_MISS", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_LOAD_RETIRED.L3_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float FB_HPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("MEM_LOAD_RETIRED.FB_HIT", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_LOAD_RETIRED.FB_HIT"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float Page_Walks_Utilization(FEV EV, int level, bool& thresh) {
-    float val = (g_ev_error("ITLB_MISSES.WALK_PENDING", level) +
-                 g_ev_error("DTLB_LOAD_MISSES.WALK_PENDING", level) +
-                 g_ev_error("DTLB_STORE_MISSES.WALK_PENDING", level)) /
+    float val = (EV(CEV("ITLB_MISSES.WALK_PENDING"), level) +
+                 EV(CEV("DTLB_LOAD_MISSES.WALK_PENDING"), level) +
+                 EV(CEV("DTLB_STORE_MISSES.WALK_PENDING"), level)) /
                 (4 * CORE_CLKS(EV, level, thresh));
     thresh = (val > 0.5);
     return val;
 }
 float L1D_Cache_Fill_BW(FEV EV, int level, bool& thresh) {
-    return 64 * EV({"L1D.REPLACEMENT", 0x151, 4, 0}, level) / OneBillion /
+    return 64 * EV(CEV("L1D.REPLACEMENT"), level) / OneBillion /
            Time(EV, level, thresh);
 }
 float L2_Cache_Fill_BW(FEV EV, int level, bool& thresh) {
-    return 64 * EV({"L2_LINES_IN.ALL", 0x7f1, 4, 0}, level) / OneBillion /
+    return 64 * EV(CEV("L2_LINES_IN.ALL"), level) / OneBillion /
            Time(EV, level, thresh);
 }
 float L3_Cache_Fill_BW(FEV EV, int level, bool& thresh) {
-    return 64 * EV({"LONGEST_LAT_CACHE.MISS", 0x412e, 4, 0}, level) /
+    return 64 * EV(CEV("LONGEST_LAT_CACHE.MISS"), level) /
            OneBillion / Time(EV, level, thresh);
 }
 float L3_Cache_Access_BW(FEV EV, int level, bool& thresh) {
-    return 64 * g_ev_error("OFFCORE_REQUESTS.ALL_REQUESTS", level) /
+    return 64 * EV(CEV("OFFCORE_REQUESTS.ALL_REQUESTS"), level) /
            OneBillion / Time(EV, level, thresh);
 }
 float L1D_Cache_Fill_BW_1T(FEV EV, int level, bool& thresh) {
@@ -4390,11 +4571,11 @@ float L3_Cache_Access_BW_1T(FEV EV, int level, bool& thresh) {
     return L3_Cache_Access_BW(EV, level, thresh);
 }
 float CPU_Utilization(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0}, level) /
-           EV({"msr/tsc/", 0, 4, 0}, 0);
+    return EV(CEV("CPU_CLK_UNHALTED.REF_TSC"), level) /
+           g_ev_error("msr/tsc/", 0);
 }
 float Average_Frequency(FEV EV, int level, bool& thresh) {
-    return Turbo_Utilization(EV, level, thresh) * EV({"msr/tsc/", 0, 4, 0}, 0) /
+    return Turbo_Utilization(EV, level, thresh) * g_ev_error("msr/tsc/", 0) /
            OneBillion / Time(EV, level, thresh);
 }
 float GFLOPs(FEV EV, int level, bool& thresh) {
@@ -4403,36 +4584,36 @@ float GFLOPs(FEV EV, int level, bool& thresh) {
 }
 float Turbo_Utilization(FEV EV, int level, bool& thresh) {
     return CLKS(EV, level, thresh) /
-           EV({"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0}, level);
+           EV(CEV("CPU_CLK_UNHALTED.REF_TSC"), level);
 }
 float SMT_2T_Utilization(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
         return 1 -
-               g_ev_error("CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", level) /
-                       g_ev_error("CPU_CLK_UNHALTED.REF_DISTRIBUTED", level);
+               EV(CEV("CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE"), level) /
+                       EV(CEV("CPU_CLK_UNHALTED.REF_DISTRIBUTED"), level);
     } else {
         return 0;
     }
 }
 float Kernel_Utilization(FEV EV, int level, bool& thresh) {
-    float val = EV({"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1}, level) /
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level);
+    float val = EV(CEV("CPU_CLK_UNHALTED.THREAD_P:SUP"), level) /
+                EV(CEV("CPU_CLK_UNHALTED.THREAD"), level);
     thresh = (val > 0.05);
     return val;
 }
 float Kernel_CPI(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1}, level) /
-           EV({"INST_RETIRED.ANY_P:SUP", 0xc0, 4, 1}, level);
+    return EV(CEV("CPU_CLK_UNHALTED.THREAD_P:SUP"), level) /
+           EV(CEV("INST_RETIRED.ANY_P:SUP"), level);
 }
 float DRAM_BW_Use(FEV EV, int level, bool& thresh) {
     return 64 *
-           (EV({"UNC_ARB_TRK_REQUESTS.ALL", 0, 4, 0}, level) +
-            EV({"UNC_ARB_COH_TRK_REQUESTS.ALL", 0, 4, 0}, level)) /
+           (g_ev_error("UNC_ARB_TRK_REQUESTS.ALL", level) +
+            g_ev_error("UNC_ARB_COH_TRK_REQUESTS.ALL", level)) /
            OneMillion / Time(EV, level, thresh) / 1000;
 }
 float MEM_Parallel_Requests(FEV EV, int level, bool& thresh) {
-    return EV({"UNC_ARB_TRK_OCCUPANCY.ALL", 0, 4, 0}, level) /
-           EV({"UNC_ARB_TRK_REQUESTS.ALL", 0, 4, 0}, level);
+    return g_ev_error("UNC_ARB_TRK_OCCUPANCY.ALL", level) /
+           g_ev_error("UNC_ARB_TRK_REQUESTS.ALL", level);
 }
 float Time(FEV EV, int level, bool& thresh) {
     float val = g_ev_error("interval-s", 0);
@@ -4440,16 +4621,18 @@ float Time(FEV EV, int level, bool& thresh) {
     return val;
 }
 float Socket_CLKS(FEV EV, int level, bool& thresh) {
-    return EV({"UNC_CLOCK.SOCKET", 0, 4, 0}, level);
+    return g_ev_error("UNC_CLOCK.SOCKET", level);
 }
 float IpFarBranch(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.FAR_BRANCH:USER", 0x40c4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.FAR_BRANCH:USER"), level);
     thresh = (val < 1000000);
     return val;
 }
+}  // namespace
 
 ADLGLCSetUpImpl::ADLGLCSetUpImpl() {
+    set_catalog(adl_glc_events::kEvents);
     m_vmtc_core.push_back(std::make_pair("Frontend_Bound",
                                          (MetricBase*)(new Frontend_Bound())));
     m_vmtc_core.push_back(std::make_pair("Fetch_Latency",
@@ -0,0 +1,104 @@
+/**
+ * \file eca/tma/arch_ratios/adl_grt_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// generated by gen_event_catalog.py, do not edit
+#pragma once
+#include "event_catalog.h"
+
+namespace mperf {
+namespace tma {
+namespace adl_grt_events {
+constexpr CatalogEvent kEvents[] = {
+        {"TOPDOWN_RETIRING.ALL", 0xc2, 4, 0, false, 0x0, true},
+        {"LD_HEAD.ANY_AT_RET", 0xff05, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.SMC", 0x1c3, 4, 0, false, 0x0, true},
+        {"MEM_BOUND_STALLS.LOAD_DRAM_HIT", 0x434, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.DATA_UNKNOWN", 0x103, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BAD_SPECULATION.MISPREDICT", 0x473, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.ALL", 0xc2, 4, 0, false, 0x0, true},
+        {"BACLEARS.ANY", 0x1fe6, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.L2_HIT", 0x2d1, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.PREDECODE", 0x471, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.PAGE_FAULT", 0x20c3, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.OTHER", 0x8071, 4, 0, false, 0x0, true},
+        {"MEM_SCHEDULER_BLOCK.ST_BUF", 0x104, 4, 0, false, 0x0, true},
+        {"MEM_BOUND_STALLS.IFETCH_LLC_HIT", 0x1034, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BE_BOUND.SERIALIZATION", 0x1074, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY", 0xc0, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BE_BOUND.REORDER_BUFFER", 0x4074, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.FRONTEND_LATENCY", 0x7271, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BAD_SPECULATION.ALL", 0x73, 4, 0, false, 0x0, true},
+        {"MEM_UOPS_RETIRED.ALL_STORES", 0x82d0, 4, 0, false, 0x0, true},
+        {"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.ITLB", 0x1071, 4, 0, false, 0x0, true},
+        {"MEM_SCHEDULER_BLOCK.RSV", 0x404, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.FP_ASSIST", 0x4c3, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.MS", 0x1c2, 4, 0, false, 0x0, true},
+        {"MEM_BOUND_STALLS.IFETCH_DRAM_HIT", 0x2034, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.CALL", 0xf9c4, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.FRONTEND_BANDWIDTH", 0x8d71, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.ALL", 0x71, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BAD_SPECULATION.NUKE", 0x173, 4, 0, false, 0x0, true},
+        {"LD_HEAD.DTLB_MISS_AT_RET", 0x9005, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.DRAM_HIT", 0x80d1, 4, 0, false, 0x0, true},
+        {"LD_HEAD.OTHER_AT_RET", 0xc005, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0, false, 0x0, true},
+        {"LD_HEAD.ST_ADDR_AT_RET", 0x8405, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BE_BOUND.MEM_SCHEDULER", 0x274, 4, 0, false, 0x0, true},
+        {"MEM_BOUND_STALLS.LOAD_L2_HIT", 0x134, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.L3_HIT", 0x4d1, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.ICACHE", 0x2071, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BE_BOUND.ALL", 0x74, 4, 0, false, 0x0, true},
+        {"MEM_BOUND_STALLS.IFETCH", 0x3834, 4, 0, false, 0x0, true},
+        {"MEM_SCHEDULER_BLOCK.LD_BUF", 0x204, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.CORE", 0x3c, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.CORE_P", 0x3c, 4, 0, false, 0x0, true},
+        {"LD_HEAD.L1_BOUND_AT_RET", 0xf405, 4, 0, false, 0x0, true},
+        {"MEM_BOUND_STALLS.LOAD_LLC_HIT", 0x234, 4, 0, false, 0x0, true},
+        {"MEM_SCHEDULER_BLOCK.ALL", 0x704, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.FAR_BRANCH", 0xbfc4, 4, 0, false, 0x0, true},
+        {"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.BRANCH_DETECT", 0x271, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.FPDIV", 0x8c2, 4, 0, false, 0x0, true},
+        {"LD_HEAD.PGWALK_AT_RET", 0xa005, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.DECODE", 0x871, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.MEMORY_ORDERING", 0x2c3, 4, 0, false, 0x0, true},
+        {"SERIALIZATION.NON_C01_MS_SCB", 0x275, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BAD_SPECULATION.FASTNUKE", 0x273, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BAD_SPECULATION.MACHINE_CLEARS", 0x373, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.CORE:sup", 0x3c, 4, 1, false, 0x0, true},
+        {"TOPDOWN_BE_BOUND.NON_MEM_SCHEDULER", 0x874, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BE_BOUND.ALLOC_RESTRICTIONS", 0x174, 4, 0, false, 0x0, true},
+        {"TOPDOWN_BE_BOUND.REGISTER", 0x2074, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.IDIV", 0x10c2, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.SLOW", 0x6fc3, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.4K_ALIAS", 0x403, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.CISC", 0x171, 4, 0, false, 0x0, true},
+        {"MEM_UOPS_RETIRED.SPLIT_LOADS", 0x41d0, 4, 0, false, 0x0, true},
+        {"MEM_BOUND_STALLS.IFETCH_L2_HIT", 0x834, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.DISAMBIGUATION", 0x8c3, 4, 0, false, 0x0, true},
+        {"TOPDOWN_FE_BOUND.BRANCH_RESTEER", 0x4071, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.X87", 0x2c2, 4, 0, false, 0x0, true},
+};
+constexpr int32_t kDisp[] = {
+        1, 0, 3, 0, 3, 0, -68, -58, 0, 1,
+        -57, 6, -56, 0, -55, 1, -52, 0, 0, 0,
+        0, 4, 1, -49, -48, 1, 0, -47, -41, 1,
+        -40, 0, 0, -35, 0, 0, -32, 0, 0, 2,
+        0, 0, -30, 0, 7, 2, -28, 0, 0, 0,
+        0, 3, 4, 0, 0, 6, 0, 0, 2, -22,
+        -19, 0, -17, -5, 5, 0, -2, 0, 0, 16,
+        -1,
+};
+constexpr size_t find(const char* name) {
+    return catalog_find(kEvents, kDisp, name);
+}
+}  // namespace adl_grt_events
+}  // namespace tma
+}  // namespace mperf
@@ -1,8 +1,12 @@
 // Automatically generated by the script cvt_from_pmu_tools.sh.
 #include "arch_ratios.h"
+#include "adl_grt_events.h"
+
+#define CEV(NAME) TMA_CATALOG_EV(adl_grt_events, NAME)
 
 namespace mperf {
 namespace tma {
+namespace {
 
 static std::string version = "2.0";
 static float base_frequency = -1.0;
@@ -1175,440 +1179,526 @@ public:
 };
 
 float Frontend_Bound::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.ALL", 1) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.ALL"), 1) / SLOTS(EV, 1, thresh);
     thresh = (val > 0.20);
     return val;
 }
 float Frontend_Latency::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.FRONTEND_LATENCY", 2) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.FRONTEND_LATENCY"), 2) /
           SLOTS(EV, 2, thresh);
     thresh = (val > 0.15);
     return val;
 }
 float Icache::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.ICACHE", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.ICACHE"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float ITLB::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.ITLB", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.ITLB"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Branch_Detect::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.BRANCH_DETECT", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.BRANCH_DETECT"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Branch_Resteer::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.BRANCH_RESTEER", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.BRANCH_RESTEER"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Frontend_Bandwidth::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.FRONTEND_BANDWIDTH", 2) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.FRONTEND_BANDWIDTH"), 2) /
           SLOTS(EV, 2, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Cisc::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.CISC", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.CISC"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Decode::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.DECODE", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.DECODE"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Predecode::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.PREDECODE", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.PREDECODE"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Other_FB::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_FE_BOUND.OTHER", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_FE_BOUND.OTHER"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Bad_Speculation::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BAD_SPECULATION.ALL", 1) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BAD_SPECULATION.ALL"), 1) /
+          SLOTS(EV, 1, thresh);
     thresh = (val > 0.15);
     return val;
 }
 float Branch_Mispredicts::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BAD_SPECULATION.MISPREDICT", 2) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BAD_SPECULATION.MISPREDICT"), 2) /
           SLOTS(EV, 2, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Machine_Clears::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BAD_SPECULATION.MACHINE_CLEARS", 2) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BAD_SPECULATION.MACHINE_CLEARS"), 2) /
           SLOTS(EV, 2, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Nuke::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BAD_SPECULATION.NUKE", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BAD_SPECULATION.NUKE"), 3) /
+          SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float SMC::compute(FEV EV) {
-    val = Nuke::compute(EV) * (g_ev_error("MACHINE_CLEARS.SMC", 4) /
-                               g_ev_error("MACHINE_CLEARS.SLOW", 4));
+    TMA_MEMOIZE();
+    val = Nuke::compute(EV) * (EV(CEV("MACHINE_CLEARS.SMC"), 4) /
+                               EV(CEV("MACHINE_CLEARS.SLOW"), 4));
     thresh = (val > 0.02);
     return val;
 }
 float Memory_Ordering::compute(FEV EV) {
-    val = Nuke::compute(EV) * (g_ev_error("MACHINE_CLEARS.MEMORY_ORDERING", 4) /
-                               g_ev_error("MACHINE_CLEARS.SLOW", 4));
+    TMA_MEMOIZE();
+    val = Nuke::compute(EV) * (EV(CEV("MACHINE_CLEARS.MEMORY_ORDERING"),
+                                  4) / EV(CEV("MACHINE_CLEARS.SLOW"), 4));
     thresh = (val > 0.02);
     return val;
 }
 float FP_Assist::compute(FEV EV) {
-    val = Nuke::compute(EV) * (g_ev_error("MACHINE_CLEARS.FP_ASSIST", 4) /
-                               g_ev_error("MACHINE_CLEARS.SLOW", 4));
+    TMA_MEMOIZE();
+    val = Nuke::compute(EV) * (EV(CEV("MACHINE_CLEARS.FP_ASSIST"), 4) /
+                               EV(CEV("MACHINE_CLEARS.SLOW"), 4));
     thresh = (val > 0.02);
     return val;
 }
 float Disambiguation::compute(FEV EV) {
-    val = Nuke::compute(EV) * (g_ev_error("MACHINE_CLEARS.DISAMBIGUATION", 4) /
-                               g_ev_error("MACHINE_CLEARS.SLOW", 4));
+    TMA_MEMOIZE();
+    val = Nuke::compute(EV) * (EV(CEV("MACHINE_CLEARS.DISAMBIGUATION"),
+                                  4) / EV(CEV("MACHINE_CLEARS.SLOW"), 4));
     thresh = (val > 0.02);
     return val;
 }
 float Page_Fault::compute(FEV EV) {
-    val = Nuke::compute(EV) * (g_ev_error("MACHINE_CLEARS.PAGE_FAULT", 4) /
-                               g_ev_error("MACHINE_CLEARS.SLOW", 4));
+    TMA_MEMOIZE();
+    val = Nuke::compute(EV) * (EV(CEV("MACHINE_CLEARS.PAGE_FAULT"), 4) /
+                               EV(CEV("MACHINE_CLEARS.SLOW"), 4));
     thresh = (val > 0.02);
     return val;
 }
 float Fast_Nuke::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BAD_SPECULATION.FASTNUKE", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BAD_SPECULATION.FASTNUKE"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Backend_Bound::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BE_BOUND.ALL", 1) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BE_BOUND.ALL"), 1) / SLOTS(EV, 1, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Core_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Backend_Bound::compute(EV) - Load_Store_Bound::compute(EV));
     thresh = (val > 0.10);
     return val;
 }
 float Load_Store_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::min<float>(
-            (g_ev_error("TOPDOWN_BE_BOUND.ALL", 2) / SLOTS(EV, 2, thresh)),
-            (g_ev_error("LD_HEAD.ANY_AT_RET", 2) / CLKS(EV, 2, thresh)) +
+            (EV(CEV("TOPDOWN_BE_BOUND.ALL"), 2) / SLOTS(EV, 2, thresh)),
+            (EV(CEV("LD_HEAD.ANY_AT_RET"), 2) / CLKS(EV, 2, thresh)) +
                     Store_Bound::compute(EV));
     thresh = (val > 0.20);
     return val;
 }
 float Store_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_Scheduler::compute(EV) *
-          (g_ev_error("MEM_SCHEDULER_BLOCK.ST_BUF", 3) /
-           g_ev_error("MEM_SCHEDULER_BLOCK.ALL", 3));
+          (EV(CEV("MEM_SCHEDULER_BLOCK.ST_BUF"), 3) /
+           EV(CEV("MEM_SCHEDULER_BLOCK.ALL"), 3));
     thresh = (val > 0.10);
     return val;
 }
 float L1_Bound::compute(FEV EV) {
-    val = g_ev_error("LD_HEAD.L1_BOUND_AT_RET", 3) / CLKS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("LD_HEAD.L1_BOUND_AT_RET"), 3) / CLKS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Store_Fwd::compute(FEV EV) {
-    val = g_ev_error("LD_HEAD.ST_ADDR_AT_RET", 4) / CLKS(EV, 4, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("LD_HEAD.ST_ADDR_AT_RET"), 4) / CLKS(EV, 4, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float STLB_Hit::compute(FEV EV) {
-    val = g_ev_error("LD_HEAD.DTLB_MISS_AT_RET", 4) / CLKS(EV, 4, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("LD_HEAD.DTLB_MISS_AT_RET"), 4) / CLKS(EV, 4, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float STLB_Miss::compute(FEV EV) {
-    val = g_ev_error("LD_HEAD.PGWALK_AT_RET", 4) / CLKS(EV, 4, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("LD_HEAD.PGWALK_AT_RET"), 4) / CLKS(EV, 4, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Other_L1::compute(FEV EV) {
-    val = g_ev_error("LD_HEAD.OTHER_AT_RET", 4) / CLKS(EV, 4, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("LD_HEAD.OTHER_AT_RET"), 4) / CLKS(EV, 4, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float L2_Bound::compute(FEV EV) {
-    val = g_ev_error("MEM_BOUND_STALLS.LOAD_L2_HIT", 3) / CLKS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("MEM_BOUND_STALLS.LOAD_L2_HIT"), 3) /
+          CLKS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float L3_Bound::compute(FEV EV) {
-    val = g_ev_error("MEM_BOUND_STALLS.LOAD_LLC_HIT", 3) / CLKS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("MEM_BOUND_STALLS.LOAD_LLC_HIT"), 3) /
+          CLKS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float DRAM_Bound::compute(FEV EV) {
-    val = g_ev_error("MEM_BOUND_STALLS.LOAD_DRAM_HIT", 3) / CLKS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("MEM_BOUND_STALLS.LOAD_DRAM_HIT"), 3) /
+          CLKS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Backend_Bound_Aux::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Backend_Bound::compute(EV);
     thresh = (val > 0.20);
     return val;
 }
 float Resource_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Backend_Bound::compute(EV);
     thresh = (val > 0.20);
     return val;
 }
 float Mem_Scheduler::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BE_BOUND.MEM_SCHEDULER", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BE_BOUND.MEM_SCHEDULER"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float ST_Buffer::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_Scheduler::compute(EV) *
-          (g_ev_error("MEM_SCHEDULER_BLOCK.ST_BUF", 4) /
-           g_ev_error("MEM_SCHEDULER_BLOCK.ALL", 4));
+          (EV(CEV("MEM_SCHEDULER_BLOCK.ST_BUF"), 4) /
+           EV(CEV("MEM_SCHEDULER_BLOCK.ALL"), 4));
     thresh = (val > 0.05);
     return val;
 }
 float LD_Buffer::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_Scheduler::compute(EV) *
-          g_ev_error("MEM_SCHEDULER_BLOCK.LD_BUF", 4) /
-          g_ev_error("MEM_SCHEDULER_BLOCK.ALL", 4);
+          EV(CEV("MEM_SCHEDULER_BLOCK.LD_BUF"), 4) /
+          EV(CEV("MEM_SCHEDULER_BLOCK.ALL"), 4);
     thresh = (val > 0.05);
     return val;
 }
 float RSV::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_Scheduler::compute(EV) *
-          g_ev_error("MEM_SCHEDULER_BLOCK.RSV", 4) /
-          g_ev_error("MEM_SCHEDULER_BLOCK.ALL", 4);
+          EV(CEV("MEM_SCHEDULER_BLOCK.RSV"), 4) /
+          EV(CEV("MEM_SCHEDULER_BLOCK.ALL"), 4);
     thresh = (val > 0.05);
     return val;
 }
 float Non_Mem_Scheduler::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BE_BOUND.NON_MEM_SCHEDULER", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BE_BOUND.NON_MEM_SCHEDULER"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Register::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BE_BOUND.REGISTER", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BE_BOUND.REGISTER"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Reorder_Buffer::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BE_BOUND.REORDER_BUFFER", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BE_BOUND.REORDER_BUFFER"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Alloc_Restriction::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BE_BOUND.ALLOC_RESTRICTIONS", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BE_BOUND.ALLOC_RESTRICTIONS"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Serialization::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_BE_BOUND.SERIALIZATION", 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_BE_BOUND.SERIALIZATION"), 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Retiring::compute(FEV EV) {
-    val = g_ev_error("TOPDOWN_RETIRING.ALL", 1) / SLOTS(EV, 1, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("TOPDOWN_RETIRING.ALL"), 1) / SLOTS(EV, 1, thresh);
     thresh = (val > 0.75);
     return val;
 }
 float Base::compute(FEV EV) {
-    val = (g_ev_error("TOPDOWN_RETIRING.ALL", 2) -
-           g_ev_error("UOPS_RETIRED.MS", 2)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("TOPDOWN_RETIRING.ALL"), 2) -
+           EV(CEV("UOPS_RETIRED.MS"), 2)) /
           SLOTS(EV, 2, thresh);
     thresh = (val > 0.60);
     return val;
 }
 float FP_uops::compute(FEV EV) {
-    val = g_ev_error("UOPS_RETIRED.FPDIV", 3) / SLOTS(EV, 3, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_RETIRED.FPDIV"), 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.20);
     return val;
 }
 float Other_Ret::compute(FEV EV) {
-    val = (g_ev_error("TOPDOWN_RETIRING.ALL", 3) -
-           g_ev_error("UOPS_RETIRED.MS", 3) -
-           g_ev_error("UOPS_RETIRED.FPDIV", 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("TOPDOWN_RETIRING.ALL"), 3) -
+           EV(CEV("UOPS_RETIRED.MS"), 3) -
+           EV(CEV("UOPS_RETIRED.FPDIV"), 3)) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.30);
     return val;
 }
 float MS_uops::compute(FEV EV) {
-    val = g_ev_error("UOPS_RETIRED.MS", 2) / SLOTS(EV, 2, thresh);
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_RETIRED.MS"), 2) / SLOTS(EV, 2, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Metric_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CLKS_P::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CLKS_P(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_SLOTS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SLOTS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_UPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = UPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Store_Fwd_Blocks::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Store_Fwd_Blocks(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Address_Alias_Blocks::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Address_Alias_Blocks(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Load_Splits::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Load_Splits(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpBranch(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpCall::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpCall(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpLoad::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpLoad(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpStore::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpStore(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpMispredict::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpMispredict(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpFarBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpFarBranch(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Branch_Mispredict_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branch_Mispredict_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Branch_Mispredict_to_Unknown_Branch_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branch_Mispredict_to_Unknown_Branch_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Microcode_Uop_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Microcode_Uop_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_FPDiv_Uop_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FPDiv_Uop_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IDiv_Uop_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IDiv_Uop_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_X87_Uop_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = X87_Uop_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Turbo_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Turbo_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Kernel_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Kernel_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CPU_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPU_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Estimated_Pause_Cost::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Estimated_Pause_Cost(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cycles_per_Demand_Load_L2_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_per_Demand_Load_L2_Hit(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cycles_per_Demand_Load_L3_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_per_Demand_Load_L3_Hit(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cycles_per_Demand_Load_DRAM_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_per_Demand_Load_DRAM_Hit(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Inst_Miss_Cost_L2Hit_Percent::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Inst_Miss_Cost_L2Hit_Percent(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Inst_Miss_Cost_L3Hit_Percent::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Inst_Miss_Cost_L3Hit_Percent(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Inst_Miss_Cost_DRAMHit_Percent::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Inst_Miss_Cost_DRAMHit_Percent(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_MemLoadPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MemLoadPKI(EV, 0, thresh);
     thresh = true;
     return val;
@@ -1618,133 +1708,135 @@ float Pipeline_Width(FEV EV, int level, bool& thresh) {
     return 5;
 }
 float CLKS(FEV EV, int level, bool& thresh) {
-    return g_ev_error("CPU_CLK_UNHALTED.CORE", level);
+    return EV(CEV("CPU_CLK_UNHALTED.CORE"), level);
 }
 float CLKS_P(FEV EV, int level, bool& thresh) {
-    return g_ev_error("CPU_CLK_UNHALTED.CORE_P", level);
+    return EV(CEV("CPU_CLK_UNHALTED.CORE_P"), level);
 }
 float SLOTS(FEV EV, int level, bool& thresh) {
     return Pipeline_Width(EV, level, thresh) * CLKS(EV, level, thresh);
 }
 float IPC(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    return EV(CEV("INST_RETIRED.ANY"), level) /
            CLKS(EV, level, thresh);
 }
 float CPI(FEV EV, int level, bool& thresh) {
     return CLKS(EV, level, thresh) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float UPI(FEV EV, int level, bool& thresh) {
-    return g_ev_error("UOPS_RETIRED.ALL", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return EV(CEV("UOPS_RETIRED.ALL"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float Store_Fwd_Blocks(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("LD_BLOCKS.DATA_UNKNOWN", level) /
-           EV({"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0}, level);
+    return 100 * EV(CEV("LD_BLOCKS.DATA_UNKNOWN"), level) /
+           EV(CEV("MEM_UOPS_RETIRED.ALL_LOADS"), level);
 }
 float Address_Alias_Blocks(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("LD_BLOCKS.4K_ALIAS", level) /
-           EV({"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0}, level);
+    return 100 * EV(CEV("LD_BLOCKS.4K_ALIAS"), level) /
+           EV(CEV("MEM_UOPS_RETIRED.ALL_LOADS"), level);
 }
 float Load_Splits(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("MEM_UOPS_RETIRED.SPLIT_LOADS", level) /
-           EV({"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0}, level);
+    return 100 * EV(CEV("MEM_UOPS_RETIRED.SPLIT_LOADS"), level) /
+           EV(CEV("MEM_UOPS_RETIRED.ALL_LOADS"), level);
 }
 float IpBranch(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-           EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+    return EV(CEV("INST_RETIRED.ANY"), level) /
+           EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
 }
 float IpCall(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-           g_ev_error("BR_INST_RETIRED.CALL", level);
+    return EV(CEV("INST_RETIRED.ANY"), level) /
+           EV(CEV("BR_INST_RETIRED.CALL"), level);
 }
 float IpLoad(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-           EV({"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0}, level);
+    return EV(CEV("INST_RETIRED.ANY"), level) /
+           EV(CEV("MEM_UOPS_RETIRED.ALL_LOADS"), level);
 }
 float IpStore(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-           EV({"MEM_UOPS_RETIRED.ALL_STORES", 0x82d0, 4, 0}, level);
+    return EV(CEV("INST_RETIRED.ANY"), level) /
+           EV(CEV("MEM_UOPS_RETIRED.ALL_STORES"), level);
 }
 float IpMispredict(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-           EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level);
+    return EV(CEV("INST_RETIRED.ANY"), level) /
+           EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level);
 }
 float IpFarBranch(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-           (g_ev_error("BR_INST_RETIRED.FAR_BRANCH", level) / 2);
+    return EV(CEV("INST_RETIRED.ANY"), level) /
+           (EV(CEV("BR_INST_RETIRED.FAR_BRANCH"), level) / 2);
 }
 float Branch_Mispredict_Ratio(FEV EV, int level, bool& thresh) {
-    return EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level) /
-           EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+    return EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level) /
+           EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
 }
 float Branch_Mispredict_to_Unknown_Branch_Ratio(FEV EV, int level,
                                                 bool& thresh) {
-    return EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level) /
-           EV({"BACLEARS.ANY", 0x1fe6, 4, 0}, level);
+    return EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level) /
+           EV(CEV("BACLEARS.ANY"), level);
 }
 float Microcode_Uop_Ratio(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("UOPS_RETIRED.MS", level) /
-           g_ev_error("UOPS_RETIRED.ALL", level);
+    return 100 * EV(CEV("UOPS_RETIRED.MS"), level) /
+           EV(CEV("UOPS_RETIRED.ALL"), level);
 }
 float FPDiv_Uop_Ratio(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("UOPS_RETIRED.FPDIV", level) /
-           g_ev_error("UOPS_RETIRED.ALL", level);
+    return 100 * EV(CEV("UOPS_RETIRED.FPDIV"), level) /
+           EV(CEV("UOPS_RETIRED.ALL"), level);
 }
 float IDiv_Uop_Ratio(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("UOPS_RETIRED.IDIV", level) /
-           g_ev_error("UOPS_RETIRED.ALL", level);
+    return 100 * EV(CEV("UOPS_RETIRED.IDIV"), level) /
+           EV(CEV("UOPS_RETIRED.ALL"), level);
 }
 float X87_Uop_Ratio(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("UOPS_RETIRED.X87", level) /
-           g_ev_error("UOPS_RETIRED.ALL", level);
+    return 100 * EV(CEV("UOPS_RETIRED.X87"), level) /
+           EV(CEV("UOPS_RETIRED.ALL"), level);
 }
 float Turbo_Utilization(FEV EV, int level, bool& thresh) {
     return CLKS(EV, level, thresh) /
-           EV({"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0}, level);
+           EV(CEV("CPU_CLK_UNHALTED.REF_TSC"), level);
 }
 float Kernel_Utilization(FEV EV, int level, bool& thresh) {
-    return g_ev_error("CPU_CLK_UNHALTED.CORE:sup", level) /
-           g_ev_error("CPU_CLK_UNHALTED.CORE", level);
+    return EV(CEV("CPU_CLK_UNHALTED.CORE:sup"), level) /
+           EV(CEV("CPU_CLK_UNHALTED.CORE"), level);
 }
 float CPU_Utilization(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0}, level) /
-           EV({"msr/tsc/", 0, 4, 0}, 0);
+    return EV(CEV("CPU_CLK_UNHALTED.REF_TSC"), level) /
+           g_ev_error("msr/tsc/", 0);
 }
 float Estimated_Pause_Cost(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("SERIALIZATION.NON_C01_MS_SCB", level) /
+    return 100 * EV(CEV("SERIALIZATION.NON_C01_MS_SCB"), level) /
            SLOTS(EV, level, thresh);
 }
 float Cycles_per_Demand_Load_L2_Hit(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_BOUND_STALLS.LOAD_L2_HIT", level) /
-           EV({"MEM_LOAD_UOPS_RETIRED.L2_HIT", 0x2d1, 4, 0}, level);
+    return EV(CEV("MEM_BOUND_STALLS.LOAD_L2_HIT"), level) /
+           EV(CEV("MEM_LOAD_UOPS_RETIRED.L2_HIT"), level);
 }
 float Cycles_per_Demand_Load_L3_Hit(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_BOUND_STALLS.LOAD_LLC_HIT", level) /
-           EV({"MEM_LOAD_UOPS_RETIRED.L3_HIT", 0x4d1, 4, 0}, level);
+    return EV(CEV("MEM_BOUND_STALLS.LOAD_LLC_HIT"), level) /
+           EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_HIT"), level);
 }
 float Cycles_per_Demand_Load_DRAM_Hit(FEV EV, int level, bool& thresh) {
-    return g_ev_error("MEM_BOUND_STALLS.LOAD_DRAM_HIT", level) /
-           g_ev_error("MEM_LOAD_UOPS_RETIRED.DRAM_HIT", level);
+    return EV(CEV("MEM_BOUND_STALLS.LOAD_DRAM_HIT"), level) /
+           EV(CEV("MEM_LOAD_UOPS_RETIRED.DRAM_HIT"), level);
 }
 float Inst_Miss_Cost_L2Hit_Percent(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("MEM_BOUND_STALLS.IFETCH_L2_HIT", level) /
-           (g_ev_error("MEM_BOUND_STALLS.IFETCH", level));
+    return 100 * EV(CEV("MEM_BOUND_STALLS.IFETCH_L2_HIT"), level) /
+           (EV(CEV("MEM_BOUND_STALLS.IFETCH"), level));
 }
 float Inst_Miss_Cost_L3Hit_Percent(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("MEM_BOUND_STALLS.IFETCH_LLC_HIT", level) /
-           (g_ev_error("MEM_BOUND_STALLS.IFETCH", level));
+    return 100 * EV(CEV("MEM_BOUND_STALLS.IFETCH_LLC_HIT"), level) /
+           (EV(CEV("MEM_BOUND_STALLS.IFETCH"), level));
 }
 float Inst_Miss_Cost_DRAMHit_Percent(FEV EV, int level, bool& thresh) {
-    return 100 * g_ev_error("MEM_BOUND_STALLS.IFETCH_DRAM_HIT", level) /
-           (g_ev_error("MEM_BOUND_STALLS.IFETCH", level));
+    return 100 * EV(CEV("MEM_BOUND_STALLS.IFETCH_DRAM_HIT"), level) /
+           (EV(CEV("MEM_BOUND_STALLS.IFETCH"), level));
 }
 float MemLoadPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * EV({"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0}, level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_UOPS_RETIRED.ALL_LOADS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
+}  // namespace
 
 ADLGRTSetUpImpl::ADLGRTSetUpImpl() {
+    set_catalog(adl_grt_events::kEvents);
     m_vmtc_core.push_back(std::make_pair("Frontend_Bound",
                                          (MetricBase*)(new Frontend_Bound())));
     m_vmtc_core.push_back(std::make_pair(
@@ -7,14 +7,13 @@
  */
 
 #include "arch_ratios.h"
+#include "a510_events.h"
+#include "a55_events.h"
+#include "mperf_build_config.h"
 
 namespace mperf {
 namespace tma {
 
-MetricBase* MetricBase::parent = nullptr;
-float MetricBase::val = 0;
-bool MetricBase::thresh = 0;
-
 MetricBase* SetUpBase::metric(std::string name) const {
     size_t cz = m_vmtc_core.size();
     for (size_t i = 0; i < cz; ++i) {
@@ -31,103 +30,173 @@ MetricBase* SetUpBase::metric(std::string name) const {
     return nullptr;
 }
 
-ArchRatioSetup* ArchRatioSetup::inst(MPFXPUType t) {
-    static ArchRatioSetup instance(t);
-    return &instance;
+void SetUpBase::link_parents() {
+    // the last metric seen of each level
+    std::vector<MetricBase*> last;
+    for (auto& it : m_vmtc_core) {
+        MetricBase* metric = it.second;
+        if (!metric || metric->level <= 0) {
+            continue;
+        }
+        size_t level = metric->level;
+        metric->parent = level > 1 && level - 1 <= last.size()
+                                 ? last[level - 2]
+                                 : nullptr;
+        last.resize(level);
+        last[level - 1] = metric;
+    }
+}
+
+#if MPERF_WITH_TMA_ALL_ARCHS || (!defined(__aarch64__) && !defined(__arm__))
+// the counters of an intel core. gp_num is the number of the gp counters of a
+// logical core with hyper-threading on, which halves them before icelake.
+static void set_core_constraints(CounterConstraints& cons, size_t gp_num,
+                                 bool pending_on_counter2) {
+    cons.gp_num = gp_num;
+    cons.fixed_events = {{"INST_RETIRED.ANY", 0xc0, 4, 0},
+                         {"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0},
+                         {"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0}};
+    if (pending_on_counter2) {
+        // L1D_PEND_MISS.PENDING, CYCLE_ACTIVITY.CYCLES_L1D_PENDING and
+        // CYCLE_ACTIVITY.STALLS_L1D_PENDING can only use counter 2 before
+        // skylake
+        cons.restricted_events = {{0x148, 2}, {0x8a3, 2}, {0xca3, 2}};
+    }
+    cons.anchor = {"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0};
+}
+
+// TOPDOWN.SLOTS is on the fixed counter 3 since icelake, it leads the
+// PERF_METRICS events, which take no counter.
+static void set_topdown_constraints(CounterConstraints& cons) {
+    cons.fixed_events.push_back({"TOPDOWN.SLOTS", 0x400, 4, 0});
+    cons.leader = {"TOPDOWN.SLOTS", 0x400, 4, 0};
+    cons.free_events = {{"PERF_METRICS.RETIRING", 0x8000, 4, 0},
+                        {"PERF_METRICS.BAD_SPECULATION", 0x8100, 4, 0},
+                        {"PERF_METRICS.FRONTEND_BOUND", 0x8200, 4, 0},
+                        {"PERF_METRICS.BACKEND_BOUND", 0x8300, 4, 0},
+                        {"PERF_METRICS.HEAVY_OPERATIONS", 0x8400, 4, 0},
+                        {"PERF_METRICS.BRANCH_MISPREDICTS", 0x8500, 4, 0},
+                        {"PERF_METRICS.FETCH_LATENCY", 0x8600, 4, 0},
+                        {"PERF_METRICS.MEMORY_BOUND", 0x8700, 4, 0}};
 }
+#endif
 
 ArchRatioSetup::ArchRatioSetup(MPFXPUType t) {
-    // FIXME. Confirm the correct number of counters.
-    m_counter_num = 3;
     switch (t) {
-#if defined(__aarch64__) || defined(__arm__)
+#if MPERF_WITH_TMA_ALL_ARCHS || defined(__aarch64__) || defined(__arm__)
         case A55: {
             m_setup = std::make_unique<A55SetUpImpl>();
-            // FIXME(hc): the counter num in a55 trm is six, but less than six
-            // counters can be use for some unknown reasons
-            m_counter_num = 3;
+            // the trm has six event counters, the groups take three of them,
+            // more did not count on the tested devices
+            m_constraints.gp_num = 3;
+            // CPU_CYCLES is counted on the dedicated PMCCNTR_EL0
+            m_constraints.fixed_events = {
+                    TMA_CATALOG_EV(a55_events, "CPU_CYCLES")};
+            m_constraints.anchor = TMA_CATALOG_EV(a55_events, "CPU_CYCLES");
             break;
         }
         case A510: {
             m_setup = std::make_unique<A510SetUpImpl>();
-            m_counter_num = 3;
-            break;
-        }
-#else
-        // case ADL_GLC: {
-        //     m_setup = std::make_unique<ADLGLCSetUpImpl>();
-        //     break;
-        // }
-        // case ADL_GRT: {
-        //     m_setup = std::make_unique<ADLGRTSetUpImpl>();
-        //     break;
-        // }
-        // case BDW_CLIENT: {
-        //     m_setup = std::make_unique<BDWCLIENTSetUpImpl>();
-        //     break;
-        // }
-        // case BDX_SERVER: {
-        //     m_setup = std::make_unique<BDXSERVERSetUpImpl>();
-        //     break;
-        // }
-        // case CLX_SERVER: {
-        //     m_setup = std::make_unique<CLXSERVERSetUpImpl>();
-        //     break;
-        // }
-        // case HSW_CLIENT: {
-        //    m_setup = std::make_unique<HSWCLIENTSetUpImpl>();
-        //    break;
-        //}
+            // as the a55
+            m_constraints.gp_num = 3;
+            m_constraints.fixed_events = {
+                    TMA_CATALOG_EV(a510_events, "CPU_CYCLES")};
+            m_constraints.anchor = TMA_CATALOG_EV(a510_events, "CPU_CYCLES");
+            break;
+        }
+#endif
+#if MPERF_WITH_TMA_ALL_ARCHS || (!defined(__aarch64__) && !defined(__arm__))
+        case SNB_CLIENT: {
+            m_setup = std::make_unique<SNBCLIENTSetUpImpl>();
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
+        case JKT_SERVER: {
+            m_setup = std::make_unique<JKTSERVERSetUpImpl>();
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
+        case IVB_CLIENT: {
+            m_setup = std::make_unique<IVBCLIENTSetUpImpl>();
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
+        case IVB_SERVER: {
+            m_setup = std::make_unique<IVBSERVERSetUpImpl>();
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
+        case HSW_CLIENT: {
+            m_setup = std::make_unique<HSWCLIENTSetUpImpl>();
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
         case HSX_SERVER: {
             m_setup = std::make_unique<HSXSERVERSetUpImpl>();
-            // TODO(hc): encountered a situation that resulting in wront result
-            // with m_counter_num 3 and sample set of
-            // "INST_RETIRED.ALL,MEM_LOAD_UOPS_RETIRED.L1_MISS,MEM_LOAD_UOPS_RETIRED.L2_MISS",
-            // so set the m_counter_num equal 2 temporarily
-            m_counter_num = 2;
-            break;
-        }
-            // case ICL_CLIENT: {
-            //     m_setup = std::make_unique<ICLCLIENTSetUpImpl>();
-            //     break;
-            // }
-            // case ICX_SERVER: {
-            //     m_setup = std::make_unique<ICXSERVERSetUpImpl>();
-            //     break;
-            // }
-            // case IVB_CLIENT: {
-            //     m_setup = std::make_unique<IVBCLIENTSetUpImpl>();
-            //     break;
-            // }
-            // case IVB_SERVER: {
-            //     m_setup = std::make_unique<IVBSERVERSetUpImpl>();
-            //     break;
-            // }
-            // case JKT_SERVER: {
-            //     m_setup = std::make_unique<JKTSERVERSetUpImpl>();
-            //     break;
-            // }
-            // case SKL_CLIENT: {
-            //     m_setup = std::make_unique<SKLCLIENTSetUpImpl>();
-            //     break;
-            // }
-            // case SKX_SERVER: {
-            //     m_setup = std::make_unique<SKXSERVERSetUpImpl>();
-            //     break;
-            // }
-            // case SNB_CLIENT: {
-            //     m_setup = std::make_unique<SNBCLIENTSetUpImpl>();
-            //     break;
-            // }
-            // case SPR_SERVER: {
-            //     m_setup = std::make_unique<SPRSERVERSetUpImpl>();
-            //     break;
-            // }
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
+        case BDW_CLIENT: {
+            m_setup = std::make_unique<BDWCLIENTSetUpImpl>();
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
+        case BDX_SERVER: {
+            m_setup = std::make_unique<BDXSERVERSetUpImpl>();
+            set_core_constraints(m_constraints, 4, true);
+            break;
+        }
+        case SKL_CLIENT: {
+            m_setup = std::make_unique<SKLCLIENTSetUpImpl>();
+            set_core_constraints(m_constraints, 4, false);
+            break;
+        }
+        case SKX_SERVER: {
+            m_setup = std::make_unique<SKXSERVERSetUpImpl>();
+            set_core_constraints(m_constraints, 4, false);
+            break;
+        }
+        case CLX_SERVER: {
+            m_setup = std::make_unique<CLXSERVERSetUpImpl>();
+            set_core_constraints(m_constraints, 4, false);
+            break;
+        }
+        case ICL_CLIENT: {
+            m_setup = std::make_unique<ICLCLIENTSetUpImpl>();
+            set_core_constraints(m_constraints, 8, false);
+            set_topdown_constraints(m_constraints);
+            break;
+        }
+        case ICX_SERVER: {
+            m_setup = std::make_unique<ICXSERVERSetUpImpl>();
+            set_core_constraints(m_constraints, 8, false);
+            set_topdown_constraints(m_constraints);
+            break;
+        }
+        case ADL_GLC: {
+            m_setup = std::make_unique<ADLGLCSetUpImpl>();
+            set_core_constraints(m_constraints, 8, false);
+            set_topdown_constraints(m_constraints);
+            break;
+        }
+        case ADL_GRT: {
+            // the gracemont cores have no PERF_METRICS
+            m_setup = std::make_unique<ADLGRTSetUpImpl>();
+            set_core_constraints(m_constraints, 6, false);
+            break;
+        }
+        case SPR_SERVER: {
+            m_setup = std::make_unique<SPRSERVERSetUpImpl>();
+            set_core_constraints(m_constraints, 8, false);
+            set_topdown_constraints(m_constraints);
+            break;
+        }
 #endif
         case DEFAULT:  // SIMPLE
         default:
             mperf_throw(MperfError, "unknown CPU type.");
     }
+    m_setup->link_parents();
 }
 
 MetricBase* ArchRatioSetup::metric(std::string name) const {
@@ -139,7 +208,11 @@ MetricBase* ArchRatioSetup::metric(std::string name) const {
 }
 
 size_t ArchRatioSetup::counter_num() const {
-    return m_counter_num;
+    return m_constraints.gp_num;
+}
+
+const CounterConstraints& ArchRatioSetup::constraints() const {
+    return m_constraints;
 }
 
 }  // namespace tma
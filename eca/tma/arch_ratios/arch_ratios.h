@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include <functional>
 #include <string>
+#include "../group_scheduler.h"
+#include "../metric_dag.h"
 #include "mperf/exception.h"
 #include "mperf/tma/tma.h"
 
@@ -21,16 +23,53 @@ public:
     std::string name;
     std::string domain;
     std::string area;
-    int level;
+    // 0 for the info metrics
+    int level = 0;
     std::string desc;
-    static float val;
-    static bool thresh;
 
-    static MetricBase* parent;
+    MetricBase* parent = nullptr;
     void* func_compute;
 };
 
-using FEV = std::function<float(EventAttr attr, int level)>;
+// Memoizes the compute of a generated metric in the MetricDag of the
+// session, the value and thresh of a metric already computed in this
+// evaluation are restored instead of being computed again.
+class MetricMemo {
+public:
+    MetricMemo(const FEV& EV, MetricCompute func, float& val, bool& thresh)
+            : m_dag(EV.dag()), m_val(val), m_thresh(thresh) {
+        m_id = m_dag->enter(func, m_hit, m_val, m_thresh);
+    }
+    ~MetricMemo() {
+        if (!m_hit) {
+            m_dag->leave(m_id, m_val, m_thresh);
+        }
+    }
+    bool hit() const { return m_hit; }
+
+private:
+    MetricDag* m_dag;
+    float& m_val;
+    bool& m_thresh;
+    size_t m_id = MetricDag::npos;
+    bool m_hit = false;
+};
+
+// the first statement of every generated `compute`, val and thresh are the
+// value and the thresh of the metric
+#define TMA_MEMOIZE()                                  \
+    float val = 0;                                     \
+    bool thresh = false;                               \
+    MetricMemo tma_memo_(EV, &compute, val, thresh);   \
+    if (tma_memo_.hit())                               \
+        return val;
+
+// the thresh of the metric NAME last computed in the session of EV
+#define TMA_THRESH(NAME) \
+    EV.dag()->thresh(reinterpret_cast<const void*>(&NAME::compute))
+
+// whether the topdown metrics are read from the fixed counters of the session
+#define TMA_TOPDOWN_FIXED() EV.dag()->topdown_fixed()
 
 inline float g_ev_error(std::string name, int level) {
     MPERF_MARK_USED_VAR(name);
@@ -46,8 +85,19 @@ public:
     SetUpBase() {}
     virtual ~SetUpBase() {}
     MetricBase* metric(std::string name) const;
+    // the catalog of the events the metrics read, e.g. a55_events::kEvents
+    template <size_t N>
+    void set_catalog(const CatalogEvent (&events)[N]) {
+        m_catalog = events;
+        m_catalog_size = N;
+    }
+    // link every core metric to its parent, the core metrics are listed in
+    // the pre-order of the TMA tree.
+    void link_parents();
     std::vector<std::pair<std::string, MetricBase*>> m_vmtc_core;
     std::vector<std::pair<std::string, MetricBase*>> m_vmtc_extra;
+    const CatalogEvent* m_catalog = nullptr;
+    size_t m_catalog_size = 0;
 };
 
 #define DEF_SETUP_CLS(NAME)                    \
@@ -57,9 +107,10 @@ public:
         ~NAME##SetUpImpl();                    \
     };
 
+// The metrics of a cpu type, every MPFTMA session owns its own instance.
 class ArchRatioSetup {
 public:
-    static ArchRatioSetup* inst(MPFXPUType t);
+    explicit ArchRatioSetup(MPFXPUType t);
 
     DEF_SETUP_CLS(SNBCLIENT)
     DEF_SETUP_CLS(JKTSERVER)
@@ -82,11 +133,12 @@ public:
 
     MetricBase* metric(std::string name) const;
     size_t counter_num() const;
+    const CounterConstraints& constraints() const;
+    const CatalogEvent* catalog() const { return m_setup->m_catalog; }
+    size_t catalog_size() const { return m_setup->m_catalog_size; }
 
 private:
-    ArchRatioSetup(MPFXPUType t);
-
-    size_t m_counter_num;
+    CounterConstraints m_constraints;
     std::unique_ptr<SetUpBase> m_setup;
 };
 #undef DEF_SETUP_CLS
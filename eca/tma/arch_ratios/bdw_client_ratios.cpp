@@ -1,8 +1,12 @@
 // Automatically generated by the script cvt_from_pmu_tools.sh.
 #include "arch_ratios.h"
+#include "bdw_client_events.h"
+
+#define CEV(NAME) TMA_CATALOG_EV(bdw_client_events, NAME)
 
 namespace mperf {
 namespace tma {
+namespace {
 
 static bool smt_enabled = false;
 static bool ebs_mode = false;
@@ -19,7 +23,7 @@ static float Avg_Assist_Cost = 100;
 static float OneMillion = 1000000;
 static float OneBillion = 1000000000;
 static float Energy_Unit = 61;
-static float Errata_Whitelist = "BDE69;BDE70";
+static std::string Errata_Whitelist = "BDE69;BDE70";
 
 float Backend_Bound_Cycles(FEV EV, int level, bool& thresh);
 float Cycles_0_Ports_Utilized(FEV EV, int level, bool& thresh);
@@ -2112,101 +2116,116 @@ public:
 };
 
 float Frontend_Bound::compute(FEV EV) {
-    val = EV({"IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c, 4, 0}, 1) /
+    TMA_MEMOIZE();
+    val = EV(CEV("IDQ_UOPS_NOT_DELIVERED.CORE"), 1) /
           SLOTS(EV, 1, thresh);
     thresh = (val > 0.15);
     return val;
 }
 float Fetch_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Pipeline_Width *
-          EV({"IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE", 0x400019c, 4,
-              0},
+          EV(CEV("IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE"),
              2) /
           SLOTS(EV, 2, thresh);
-    thresh = (val > 0.10) && Frontend_Bound::thresh;
+    thresh = (val > 0.10) && TMA_THRESH(Frontend_Bound);
     return val;
 }
 float ICache_Misses::compute(FEV EV) {
-    val = EV({"ICACHE.IFDATA_STALL", 0x480, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("ICACHE.IFDATA_STALL"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float ITLB_Misses::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ITLB_Miss_Cycles(EV, 3, thresh) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Branch_Resteers::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = BAClear_Cost *
-          (EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, 3) +
-           EV({"MACHINE_CLEARS.COUNT", 0, 4, 0}, 3) +
-           EV({"BACLEARS.ANY", 0x1fe6, 4, 0}, 3)) /
+          (EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), 3) +
+           EV(CEV("MACHINE_CLEARS.COUNT"), 3) +
+           EV(CEV("BACLEARS.ANY"), 3)) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Mispredicts_Resteers::compute(FEV EV) {
-    val = EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, 4) *
+    TMA_MEMOIZE();
+    val = EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), 4) *
           Branch_Resteers::compute(EV) /
-          (EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, 4) +
-           EV({"MACHINE_CLEARS.COUNT", 0, 4, 0}, 4) +
-           EV({"BACLEARS.ANY", 0x1fe6, 4, 0}, 4));
-    thresh = (val > 0.05) && Branch_Resteers::thresh;
+          (EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), 4) +
+           EV(CEV("MACHINE_CLEARS.COUNT"), 4) +
+           EV(CEV("BACLEARS.ANY"), 4));
+    thresh = (val > 0.05) && TMA_THRESH(Branch_Resteers);
     return val;
 }
 float Clears_Resteers::compute(FEV EV) {
-    val = EV({"MACHINE_CLEARS.COUNT", 0, 4, 0}, 4) *
+    TMA_MEMOIZE();
+    val = EV(CEV("MACHINE_CLEARS.COUNT"), 4) *
           Branch_Resteers::compute(EV) /
-          (EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, 4) +
-           EV({"MACHINE_CLEARS.COUNT", 0, 4, 0}, 4) +
-           EV({"BACLEARS.ANY", 0x1fe6, 4, 0}, 4));
-    thresh = (val > 0.05) && Branch_Resteers::thresh;
+          (EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), 4) +
+           EV(CEV("MACHINE_CLEARS.COUNT"), 4) +
+           EV(CEV("BACLEARS.ANY"), 4));
+    thresh = (val > 0.05) && TMA_THRESH(Branch_Resteers);
     return val;
 }
 float Unknown_Branches::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branch_Resteers::compute(EV) - Mispredicts_Resteers::compute(EV) -
           Clears_Resteers::compute(EV);
-    thresh = (val > 0.05) && Branch_Resteers::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Branch_Resteers);
     return val;
 }
 float DSB_Switches::compute(FEV EV) {
-    val = EV({"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x2ab, 4, 0}, 3) /
+    TMA_MEMOIZE();
+    val = EV(CEV("DSB2MITE_SWITCHES.PENALTY_CYCLES"), 3) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float LCP::compute(FEV EV) {
-    val = EV({"ILD_STALL.LCP", 0x187, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("ILD_STALL.LCP"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float MS_Switches::compute(FEV EV) {
-    val = MS_Switches_Cost * EV({"IDQ.MS_SWITCHES", 0, 4, 0}, 3) /
+    TMA_MEMOIZE();
+    val = MS_Switches_Cost * EV(CEV("IDQ.MS_SWITCHES"), 3) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Fetch_Latency::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Fetch_Latency);
     return val;
 }
 float Fetch_Bandwidth::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Frontend_Bound::compute(EV) - Fetch_Latency::compute(EV);
-    thresh = (val > 0.1) && Frontend_Bound::thresh && HighIPC(EV, 2, thresh);
+    thresh = (val > 0.1) && TMA_THRESH(Frontend_Bound) &&
+             HighIPC(EV, 2, thresh);
     return val;
 }
 float MITE::compute(FEV EV) {
-    val = (EV({"IDQ.ALL_MITE_CYCLES_ANY_UOPS", 0x1002479, 4, 0}, 3) -
-           EV({"IDQ.ALL_MITE_CYCLES_4_UOPS", 0x4002479, 4, 0}, 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("IDQ.ALL_MITE_CYCLES_ANY_UOPS"), 3) -
+           EV(CEV("IDQ.ALL_MITE_CYCLES_4_UOPS"), 3)) /
           CORE_CLKS(EV, 3, thresh) / 2;
-    thresh = (val > 0.1) && Fetch_Bandwidth::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Fetch_Bandwidth);
     return val;
 }
 float DSB::compute(FEV EV) {
-    val = (EV({"IDQ.ALL_DSB_CYCLES_ANY_UOPS", 0x1001879, 4, 0}, 3) -
-           EV({"IDQ.ALL_DSB_CYCLES_4_UOPS", 0x4001879, 4, 0}, 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("IDQ.ALL_DSB_CYCLES_ANY_UOPS"), 3) -
+           EV(CEV("IDQ.ALL_DSB_CYCLES_4_UOPS"), 3)) /
           CORE_CLKS(EV, 3, thresh) / 2;
-    thresh = (val > 0.15) && Fetch_Bandwidth::thresh;
+    thresh = (val > 0.15) && TMA_THRESH(Fetch_Bandwidth);
     return val;
 }
 float Bad_Speculation::compute(FEV EV) {
-    val = (EV({"UOPS_ISSUED.ANY", 0x10e, 4, 0}, 1) -
+    TMA_MEMOIZE();
+    val = (EV(CEV("UOPS_ISSUED.ANY"), 1) -
            Retired_Slots(EV, 1, thresh) +
            Pipeline_Width * Recovery_Cycles(EV, 1, thresh)) /
           SLOTS(EV, 1, thresh);
@@ -2214,691 +2233,807 @@ float Bad_Speculation::compute(FEV EV) {
     return val;
 }
 float Branch_Mispredicts::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mispred_Clears_Fraction(EV, 2, thresh) * Bad_Speculation::compute(EV);
-    thresh = (val > 0.1) && Bad_Speculation::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Bad_Speculation);
     return val;
 }
 float Machine_Clears::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Bad_Speculation::compute(EV) - Branch_Mispredicts::compute(EV);
-    thresh = (val > 0.1) && Bad_Speculation::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Bad_Speculation);
     return val;
 }
 float Backend_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = 1 - (Frontend_Bound::compute(EV) + Bad_Speculation::compute(EV) +
                Retiring::compute(EV));
     thresh = (val > 0.2);
     return val;
 }
 float Memory_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Memory_Bound_Fraction(EV, 2, thresh) * Backend_Bound::compute(EV);
-    thresh = (val > 0.2) && Backend_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Backend_Bound);
     return val;
 }
 float L1_Bound::compute(FEV EV) {
-    val = std::max<float>((g_ev_error("CYCLE_ACTIVITY.STALLS_MEM_ANY", 3) -
-                           g_ev_error("CYCLE_ACTIVITY.STALLS_L1D_MISS", 3)) /
+    TMA_MEMOIZE();
+    val = std::max<float>((EV(CEV("CYCLE_ACTIVITY.STALLS_MEM_ANY"), 3) -
+                           EV(CEV("CYCLE_ACTIVITY.STALLS_L1D_MISS"), 3)) /
                                   CLKS(EV, 3, thresh),
                           0);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float DTLB_Load::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Mem_STLB_Hit_Cost *
-                   EV({"DTLB_LOAD_MISSES.STLB_HIT", 0x6008, 4, 0}, 4) +
-           g_ev_error("DTLB_LOAD_MISSES.WALK_DURATION:c1", 4) +
-           7 * g_ev_error("DTLB_LOAD_MISSES.WALK_COMPLETED", 4)) /
+                   EV(CEV("DTLB_LOAD_MISSES.STLB_HIT"), 4) +
+           EV(CEV("DTLB_LOAD_MISSES.WALK_DURATION:c1"), 4) +
+           7 * EV(CEV("DTLB_LOAD_MISSES.WALK_COMPLETED"), 4)) /
           CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && L1_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(L1_Bound);
     return val;
 }
 float Store_Fwd_Blk::compute(FEV EV) {
-    val = 13 * EV({"LD_BLOCKS.STORE_FORWARD", 0x203, 4, 0}, 4) /
+    TMA_MEMOIZE();
+    val = 13 * EV(CEV("LD_BLOCKS.STORE_FORWARD"), 4) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && L1_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(L1_Bound);
     return val;
 }
 float Lock_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_Lock_St_Fraction(EV, 4, thresh) *
           ORO_Demand_RFO_C1(EV, 4, thresh) / CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.2) && L1_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(L1_Bound);
     return val;
 }
 float Split_Loads::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Load_Miss_Real_Latency(EV, 4, thresh) *
-          EV({"LD_BLOCKS.NO_SR", 0x803, 4, 0}, 4) / CLKS(EV, 4, thresh);
+          EV(CEV("LD_BLOCKS.NO_SR"), 4) / CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.2) && L1_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(L1_Bound);
     return val;
 }
 float G4K_Aliasing::compute(FEV EV) {
-    val = EV({"LD_BLOCKS_PARTIAL.ADDRESS_ALIAS", 0x107, 4, 0}, 4) /
+    TMA_MEMOIZE();
+    val = EV(CEV("LD_BLOCKS_PARTIAL.ADDRESS_ALIAS"), 4) /
           CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && L1_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(L1_Bound);
     return val;
 }
 float FB_Full::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Load_Miss_Real_Latency(EV, 4, thresh) *
-          g_ev_error("L1D_PEND_MISS.FB_FULL:c1", 4) / CLKS(EV, 4, thresh);
+          EV(CEV("L1D_PEND_MISS.FB_FULL:c1"), 4) / CLKS(EV, 4, thresh);
     thresh = (val > 0.3);
     return val;
 }
 float L2_Bound::compute(FEV EV) {
-    val = (g_ev_error("CYCLE_ACTIVITY.STALLS_L1D_MISS", 3) -
-           g_ev_error("CYCLE_ACTIVITY.STALLS_L2_MISS", 3)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("CYCLE_ACTIVITY.STALLS_L1D_MISS"), 3) -
+           EV(CEV("CYCLE_ACTIVITY.STALLS_L2_MISS"), 3)) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Memory_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float L3_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_L3_Hit_Fraction(EV, 3, thresh) *
-          g_ev_error("CYCLE_ACTIVITY.STALLS_L2_MISS", 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.05) && Memory_Bound::thresh;
+          EV(CEV("CYCLE_ACTIVITY.STALLS_L2_MISS"), 3) /
+          CLKS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Contested_Accesses::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Mem_XSNP_HitM_Cost(EV, 4, thresh) * LOAD_XSNP_HITM(EV, 4, thresh) +
            Mem_XSNP_Hit_Cost(EV, 4, thresh) * LOAD_XSNP_MISS(EV, 4, thresh)) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && L3_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(L3_Bound);
     return val;
 }
 float Data_Sharing::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_XSNP_Hit_Cost(EV, 4, thresh) * LOAD_XSNP_HIT(EV, 4, thresh) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && L3_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(L3_Bound);
     return val;
 }
 float L3_Hit_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_XSNP_None_Cost(EV, 4, thresh) * LOAD_L3_HIT(EV, 4, thresh) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && L3_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(L3_Bound);
     return val;
 }
 float SQ_Full::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SQ_Full_Cycles(EV, 4, thresh) / CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.3) && L3_Bound::thresh;
+    thresh = (val > 0.3) && TMA_THRESH(L3_Bound);
     return val;
 }
 float DRAM_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (1 - Mem_L3_Hit_Fraction(EV, 3, thresh)) *
-          g_ev_error("CYCLE_ACTIVITY.STALLS_L2_MISS", 3) / CLKS(EV, 3, thresh);
+          EV(CEV("CYCLE_ACTIVITY.STALLS_L2_MISS"), 3) /
+          CLKS(EV, 3, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && Memory_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float MEM_Bandwidth::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ORO_DRD_BW_Cycles(EV, 4, thresh) / CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && DRAM_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(DRAM_Bound);
     return val;
 }
 float MEM_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ORO_DRD_Any_Cycles(EV, 4, thresh) / CLKS(EV, 4, thresh) -
           MEM_Bandwidth::compute(EV);
-    thresh = (val > 0.1) && DRAM_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(DRAM_Bound);
     return val;
 }
 float Store_Bound::compute(FEV EV) {
-    val = EV({"RESOURCE_STALLS.SB", 0x8a2, 4, 0}, 3) / CLKS(EV, 3, thresh);
-    thresh = (val > 0.2) && Memory_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("RESOURCE_STALLS.SB"), 3) / CLKS(EV, 3, thresh);
+    thresh = (val > 0.2) && TMA_THRESH(Memory_Bound);
     return val;
 }
 float Store_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Store_L2_Hit_Cycles(EV, 4, thresh) +
            (1 - Mem_Lock_St_Fraction(EV, 4, thresh)) *
                    ORO_Demand_RFO_C1(EV, 4, thresh)) /
           CLKS(EV, 4, thresh);
-    thresh = (val > 0.1) && Store_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Store_Bound);
     return val;
 }
 float False_Sharing::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Mem_XSNP_HitM_Cost(EV, 4, thresh) *
-          g_ev_error("OFFCORE_RESPONSE.DEMAND_RFO.L3_HIT.SNOOP_HITM", 4) /
+          EV(CEV("OFFCORE_RESPONSE.DEMAND_RFO.L3_HIT.SNOOP_HITM"), 4) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && Store_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Store_Bound);
     return val;
 }
 float Split_Stores::compute(FEV EV) {
-    val = 2 * EV({"MEM_UOPS_RETIRED.SPLIT_STORES", 0x42d0, 4, 0}, 4) /
+    TMA_MEMOIZE();
+    val = 2 * EV(CEV("MEM_UOPS_RETIRED.SPLIT_STORES"), 4) /
           CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && Store_Bound::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Store_Bound);
     return val;
 }
 float DTLB_Store::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Mem_STLB_Hit_Cost *
-                   EV({"DTLB_STORE_MISSES.STLB_HIT", 0x6049, 4, 0}, 4) +
-           g_ev_error("DTLB_STORE_MISSES.WALK_DURATION:c1", 4) +
-           7 * g_ev_error("DTLB_STORE_MISSES.WALK_COMPLETED", 4)) /
+                   EV(CEV("DTLB_STORE_MISSES.STLB_HIT"), 4) +
+           EV(CEV("DTLB_STORE_MISSES.WALK_DURATION:c1"), 4) +
+           7 * EV(CEV("DTLB_STORE_MISSES.WALK_COMPLETED"), 4)) /
           CLKS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.05) && Store_Bound::thresh;
+    thresh = (val > 0.05) && TMA_THRESH(Store_Bound);
     return val;
 }
 float Core_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Backend_Bound::compute(EV) - Memory_Bound::compute(EV);
-    thresh = (val > 0.1) && Backend_Bound::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Backend_Bound);
     return val;
 }
 float Divider::compute(FEV EV) {
-    val = g_ev_error("ARITH.FPU_DIV_ACTIVE", 3) / CORE_CLKS(EV, 3, thresh);
-    thresh = (val > 0.2) && Core_Bound::thresh;
+    TMA_MEMOIZE();
+    val = EV(CEV("ARITH.FPU_DIV_ACTIVE"), 3) / CORE_CLKS(EV, 3, thresh);
+    thresh = (val > 0.2) && TMA_THRESH(Core_Bound);
     return val;
 }
 float Ports_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (Backend_Bound_Cycles(EV, 3, thresh) -
-           EV({"RESOURCE_STALLS.SB", 0x8a2, 4, 0}, 3) -
-           g_ev_error("CYCLE_ACTIVITY.STALLS_MEM_ANY", 3)) /
+           EV(CEV("RESOURCE_STALLS.SB"), 3) -
+           EV(CEV("CYCLE_ACTIVITY.STALLS_MEM_ANY"), 3)) /
           CLKS(EV, 3, thresh);
-    thresh = (val > 0.15) && Core_Bound::thresh;
+    thresh = (val > 0.15) && TMA_THRESH(Core_Bound);
     return val;
 }
 float Ports_Utilized_0::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_0_Ports_Utilized(EV, 4, thresh) / CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && Ports_Utilization::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float Ports_Utilized_1::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_1_Port_Utilized(EV, 4, thresh) / CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.2) && Ports_Utilization::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float Ports_Utilized_2::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_2_Ports_Utilized(EV, 4, thresh) / CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.15) && Ports_Utilization::thresh;
+    thresh = (val > 0.15) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float Ports_Utilized_3m::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_3m_Ports_Utilized(EV, 4, thresh) / CORE_CLKS(EV, 4, thresh);
-    thresh = (val > 0.7) && Ports_Utilization::thresh;
+    thresh = (val > 0.7) && TMA_THRESH(Ports_Utilization);
     return val;
 }
 float ALU_Op_Utilization::compute(FEV EV) {
-    val = (EV({"UOPS_DISPATCHED_PORT.PORT_0", 0x1a1, 4, 0}, 5) +
-           EV({"UOPS_DISPATCHED_PORT.PORT_1", 0x2a1, 4, 0}, 5) +
-           EV({"UOPS_DISPATCHED_PORT.PORT_5", 0x20a1, 4, 0}, 5) +
-           EV({"UOPS_DISPATCHED_PORT.PORT_6", 0x40a1, 4, 0}, 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("UOPS_DISPATCHED_PORT.PORT_0"), 5) +
+           EV(CEV("UOPS_DISPATCHED_PORT.PORT_1"), 5) +
+           EV(CEV("UOPS_DISPATCHED_PORT.PORT_5"), 5) +
+           EV(CEV("UOPS_DISPATCHED_PORT.PORT_6"), 5)) /
           (4 * CORE_CLKS(EV, 5, thresh));
     thresh = (val > 0.6);
     return val;
 }
 float Port_0::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_0", 0x1a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_0"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_1::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_1", 0x2a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_1"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_5::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_5", 0x20a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_5"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_6::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_6", 0x40a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_6"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Load_Op_Utilization::compute(FEV EV) {
-    val = (EV({"UOPS_DISPATCHED_PORT.PORT_2", 0x4a1, 4, 0}, 5) +
-           EV({"UOPS_DISPATCHED_PORT.PORT_3", 0x8a1, 4, 0}, 5) +
-           EV({"UOPS_DISPATCHED_PORT.PORT_7", 0x80a1, 4, 0}, 5) -
-           EV({"UOPS_DISPATCHED_PORT.PORT_4", 0x10a1, 4, 0}, 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("UOPS_DISPATCHED_PORT.PORT_2"), 5) +
+           EV(CEV("UOPS_DISPATCHED_PORT.PORT_3"), 5) +
+           EV(CEV("UOPS_DISPATCHED_PORT.PORT_7"), 5) -
+           EV(CEV("UOPS_DISPATCHED_PORT.PORT_4"), 5)) /
           (2 * CORE_CLKS(EV, 5, thresh));
     thresh = (val > 0.6);
     return val;
 }
 float Port_2::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_2", 0x4a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_2"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_3::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_3", 0x8a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_3"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Store_Op_Utilization::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_4", 0x10a1, 4, 0}, 5) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_4"), 5) /
           CORE_CLKS(EV, 5, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_4::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_4", 0x10a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_4"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Port_7::compute(FEV EV) {
-    val = EV({"UOPS_DISPATCHED_PORT.PORT_7", 0x80a1, 4, 0}, 6) /
+    TMA_MEMOIZE();
+    val = EV(CEV("UOPS_DISPATCHED_PORT.PORT_7"), 6) /
           CORE_CLKS(EV, 6, thresh);
     thresh = (val > 0.6);
     return val;
 }
 float Retiring::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Retired_Slots(EV, 1, thresh) / SLOTS(EV, 1, thresh);
-    thresh = (val > 0.7) | Heavy_Operations::thresh;
+    thresh = (val > 0.7) | TMA_THRESH(Heavy_Operations);
     return val;
 }
 float Light_Operations::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Retiring::compute(EV) - Heavy_Operations::compute(EV);
     thresh = (val > 0.6);
     return val;
 }
 float FP_Arith::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = X87_Use::compute(EV) + FP_Scalar::compute(EV) +
           FP_Vector::compute(EV);
-    thresh = (val > 0.2) && Light_Operations::thresh;
+    thresh = (val > 0.2) && TMA_THRESH(Light_Operations);
     return val;
 }
 float X87_Use::compute(FEV EV) {
-    val = EV({"INST_RETIRED.X87", 0x2c0, 4, 0}, 4) * UPI(EV, 4, thresh) /
+    TMA_MEMOIZE();
+    val = EV(CEV("INST_RETIRED.X87"), 4) * UPI(EV, 4, thresh) /
           Retired_Slots(EV, 4, thresh);
-    thresh = (val > 0.1) && FP_Arith::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Arith);
     return val;
 }
 float FP_Scalar::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FP_Arith_Scalar(EV, 4, thresh) / Retired_Slots(EV, 4, thresh);
-    thresh = (val > 0.1) && FP_Arith::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Arith);
     return val;
 }
 float FP_Vector::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FP_Arith_Vector(EV, 4, thresh) / Retired_Slots(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && FP_Arith::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Arith);
     return val;
 }
 float FP_Vector_128b::compute(FEV EV) {
-    val = (g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", 5) +
-           g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"), 5) +
+           EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"), 5)) /
           Retired_Slots(EV, 5, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && FP_Vector::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Vector);
     return val;
 }
 float FP_Vector_256b::compute(FEV EV) {
-    val = (g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", 5) +
-           g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", 5)) /
+    TMA_MEMOIZE();
+    val = (EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"), 5) +
+           EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"), 5)) /
           Retired_Slots(EV, 5, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && FP_Vector::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(FP_Vector);
     return val;
 }
 float Heavy_Operations::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Microcode_Sequencer::compute(EV);
     thresh = (val > 0.1);
     return val;
 }
 float Microcode_Sequencer::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Retire_Fraction(EV, 3, thresh) *
-          EV({"IDQ.MS_UOPS", 0x3079, 4, 0}, 3) / SLOTS(EV, 3, thresh);
-    thresh = (val > 0.05) && Heavy_Operations::thresh;
+          EV(CEV("IDQ.MS_UOPS"), 3) / SLOTS(EV, 3, thresh);
+    thresh = (val > 0.05) && TMA_THRESH(Heavy_Operations);
     return val;
 }
 float Assists::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Avg_Assist_Cost *
-          EV({"OTHER_ASSISTS.ANY_WB_ASSIST", 0x40c1, 4, 0}, 4) /
+          EV(CEV("OTHER_ASSISTS.ANY_WB_ASSIST"), 4) /
           SLOTS(EV, 4, thresh);
     val = std::min<float>(val, 1);
-    thresh = (val > 0.1) && Microcode_Sequencer::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Microcode_Sequencer);
     return val;
 }
 float CISC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = std::max<float>(
             0, Microcode_Sequencer::compute(EV) - Assists::compute(EV));
-    thresh = (val > 0.1) && Microcode_Sequencer::thresh;
+    thresh = (val > 0.1) && TMA_THRESH(Microcode_Sequencer);
     return val;
 }
 float Metric_IPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_UPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = UPI(EV, 0, thresh);
     thresh = (val > 1.05);
     return val;
 }
 float Metric_UpTB::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = UpTB(EV, 0, thresh);
     thresh = val < Pipeline_Width * 1.5;
     return val;
 }
 float Metric_CPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_SLOTS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SLOTS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Execute_per_Issue::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Execute_per_Issue(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CoreIPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CoreIPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_FLOPc::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FLOPc(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_FP_Arith_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FP_Arith_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_ILP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = ILP(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CORE_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CORE_CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpLoad::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpLoad(EV, 0, thresh);
     thresh = (val < 3);
     return val;
 }
 float Metric_IpStore::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpStore(EV, 0, thresh);
     thresh = (val < 8);
     return val;
 }
 float Metric_IpBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpBranch(EV, 0, thresh);
     thresh = (val < 8);
     return val;
 }
 float Metric_IpCall::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpCall(EV, 0, thresh);
     thresh = (val < 200);
     return val;
 }
 float Metric_IpTB::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpTB(EV, 0, thresh);
     thresh = val < Pipeline_Width * 2;
     return val;
 }
 float Metric_BpTkBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = BpTkBranch(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpFLOP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpFLOP(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_Scalar_SP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_Scalar_SP(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_Scalar_DP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_Scalar_DP(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_AVX128::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_AVX128(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_IpArith_AVX256::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpArith_AVX256(EV, 0, thresh);
     thresh = (val < 10);
     return val;
 }
 float Metric_Instructions::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Instructions(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Retire::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Retire(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Execute::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Execute(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DSB_Coverage::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DSB_Coverage(EV, 0, thresh);
     thresh = (val < 0.7) && HighIPC(EV, 1, thresh);
     return val;
 }
 float Metric_IpMispredict::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpMispredict(EV, 0, thresh);
     thresh = (val < 200);
     return val;
 }
 float Metric_Branch_Misprediction_Cost::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branch_Misprediction_Cost(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Load_Miss_Real_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Load_Miss_Real_Latency(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_MLP::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MLP(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2MPKI_All::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2MPKI_All(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2MPKI_Load::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2MPKI_Load(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2HPKI_All::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2HPKI_All(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2HPKI_Load::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2HPKI_Load(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3MPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3MPKI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Page_Walks_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Page_Walks_Utilization(EV, 0, thresh);
     thresh = (val > 0.5);
     return val;
 }
 float Metric_L1D_Cache_Fill_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_Cache_Fill_BW(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2_Cache_Fill_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2_Cache_Fill_BW(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3_Cache_Fill_BW::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3_Cache_Fill_BW(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L1D_Cache_Fill_BW_1T::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L1D_Cache_Fill_BW_1T(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L2_Cache_Fill_BW_1T::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L2_Cache_Fill_BW_1T(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_L3_Cache_Fill_BW_1T::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = L3_Cache_Fill_BW_1T(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CPU_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPU_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Average_Frequency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Average_Frequency(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_GFLOPs::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = GFLOPs(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Turbo_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Turbo_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_SMT_2T_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SMT_2T_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Kernel_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Kernel_Utilization(EV, 0, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Metric_Kernel_CPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Kernel_CPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_DRAM_BW_Use::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = DRAM_BW_Use(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_MEM_Request_Latency::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MEM_Request_Latency(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_MEM_Parallel_Requests::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MEM_Parallel_Requests(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Time::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Time(EV, 0, thresh);
     thresh = (val < 1);
     return val;
 }
 float Metric_Socket_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Socket_CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpFarBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpFarBranch(EV, 0, thresh);
     thresh = (val < 1000000);
     return val;
 }
 
 float Backend_Bound_Cycles(FEV EV, int level, bool& thresh) {
-    return (g_ev_error("CYCLE_ACTIVITY.STALLS_TOTAL", level) +
-            g_ev_error("UOPS_EXECUTED.CYCLES_GE_1_UOP_EXEC", level) -
+    return (EV(CEV("CYCLE_ACTIVITY.STALLS_TOTAL"), level) +
+            EV(CEV("UOPS_EXECUTED.CYCLES_GE_1_UOP_EXEC"), level) -
             Few_Uops_Executed_Threshold(EV, level, thresh) -
             Frontend_RS_Empty_Cycles(EV, level, thresh) +
-            EV({"RESOURCE_STALLS.SB", 0x8a2, 4, 0}, level));
+            EV(CEV("RESOURCE_STALLS.SB"), level));
 }
 float Cycles_0_Ports_Utilized(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (g_ev_error("UOPS_EXECUTED.CORE:i1:c1", level)) / 2;
+        return (EV(CEV("UOPS_EXECUTED.CORE:i1:c1"), level)) / 2;
     } else {
-        return (g_ev_error("CYCLE_ACTIVITY.STALLS_TOTAL", level) -
+        return (EV(CEV("CYCLE_ACTIVITY.STALLS_TOTAL"), level) -
                 Frontend_RS_Empty_Cycles(EV, level, thresh));
     }
 }
 float Cycles_1_Port_Utilized(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (EV({"UOPS_EXECUTED.CORE:c1", 0x10002b1, 4, 0}, level) -
-                EV({"UOPS_EXECUTED.CORE:c2", 0x20002b1, 4, 0}, level)) /
+        return (EV(CEV("UOPS_EXECUTED.CORE:c1"), level) -
+                EV(CEV("UOPS_EXECUTED.CORE:c2"), level)) /
                2;
     } else {
-        return (g_ev_error("UOPS_EXECUTED.CYCLES_GE_1_UOP_EXEC", level) -
-                g_ev_error("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC", level));
+        return (EV(CEV("UOPS_EXECUTED.CYCLES_GE_1_UOP_EXEC"), level) -
+                EV(CEV("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC"), level));
     }
 }
 float Cycles_2_Ports_Utilized(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (EV({"UOPS_EXECUTED.CORE:c2", 0x20002b1, 4, 0}, level) -
-                EV({"UOPS_EXECUTED.CORE:c3", 0x30002b1, 4, 0}, level)) /
+        return (EV(CEV("UOPS_EXECUTED.CORE:c2"), level) -
+                EV(CEV("UOPS_EXECUTED.CORE:c3"), level)) /
                2;
     } else {
-        return (g_ev_error("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC", level) -
-                g_ev_error("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC", level));
+        return (EV(CEV("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC"), level) -
+                EV(CEV("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC"), level));
     }
 }
 float Cycles_3m_Ports_Utilized(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (EV({"UOPS_EXECUTED.CORE:c3", 0x30002b1, 4, 0}, level) / 2);
+        return (EV(CEV("UOPS_EXECUTED.CORE:c3"), level) / 2);
     } else {
-        return g_ev_error("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC", level);
+        return EV(CEV("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC"), level);
     }
 }
 float DurationTimeInSeconds(FEV EV, int level, bool& thresh) {
@@ -2909,49 +3044,54 @@ float Exe_Ports(FEV EV, int level, bool& thresh) {
 }
 float Execute_Cycles(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (EV({"UOPS_EXECUTED.CORE:c1", 0x10002b1, 4, 0}, level) / 2);
+        return (EV(CEV("UOPS_EXECUTED.CORE:c1"), level) / 2);
     } else {
-        return g_ev_error("UOPS_EXECUTED.CYCLES_GE_1_UOP_EXEC", level);
+        return EV(CEV("UOPS_EXECUTED.CYCLES_GE_1_UOP_EXEC"), level);
     }
 }
 float Fetched_Uops(FEV EV, int level, bool& thresh) {
-    return (EV({"IDQ.DSB_UOPS", 0x879, 4, 0}, level) +
-            EV({"LSD.UOPS", 0x1a8, 4, 0}, level) +
-            EV({"IDQ.MITE_UOPS", 0x479, 4, 0}, level) +
-            EV({"IDQ.MS_UOPS", 0x3079, 4, 0}, level));
+    return (EV(CEV("IDQ.DSB_UOPS"), level) +
+            EV(CEV("LSD.UOPS"), level) +
+            EV(CEV("IDQ.MITE_UOPS"), level) +
+            EV(CEV("IDQ.MS_UOPS"), level));
 }
 float Few_Uops_Executed_Threshold(FEV EV, int level, bool& thresh) {
-    g_ev_error("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC", level);
-    g_ev_error("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC", level);
+    EV(CEV("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC"), level);
+    EV(CEV("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC"), level);
     if ((IPC(EV, level, thresh) > 1.8)) {
-        return g_ev_error("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC", level);
+        return EV(CEV("UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC"), level);
     } else {
-        return g_ev_error("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC", level);
+        return EV(CEV("UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC"), level);
     }
 }
 float FLOP_Count(FEV EV, int level, bool& thresh) {
-    return (1 * (g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_SINGLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", level)) +
-            2 * g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", level) +
-            4 * (g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE",
-                            level)) +
-            8 * g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", level));
+    return (1 * (EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_SINGLE"), level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE"), level)) +
+            2 *
+                    EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"),
+                       level) +
+            4 * (EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"),
+                    level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"),
+                    level)) +
+            8 *
+                    EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"),
+                       level));
 }
 float FP_Arith_Scalar(FEV EV, int level, bool& thresh) {
-    return g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_SINGLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", level);
+    return EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_SINGLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE"), level);
 }
 float FP_Arith_Vector(FEV EV, int level, bool& thresh) {
-    return g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", level) +
-           g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", level);
+    return EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"), level) +
+           EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"), level);
 }
 float Frontend_RS_Empty_Cycles(FEV EV, int level, bool& thresh) {
-    EV({"RS_EVENTS.EMPTY_CYCLES", 0x15e, 4, 0}, level);
+    EV(CEV("RS_EVENTS.EMPTY_CYCLES"), level);
     if ((Fetch_Latency::compute(EV) > 0.1)) {
-        return EV({"RS_EVENTS.EMPTY_CYCLES", 0x15e, 4, 0}, level);
+        return EV(CEV("RS_EVENTS.EMPTY_CYCLES"), level);
     } else {
         return 0;
     }
@@ -2961,67 +3101,66 @@ float HighIPC(FEV EV, int level, bool& thresh) {
     return val;
 }
 float ITLB_Miss_Cycles(FEV EV, int level, bool& thresh) {
-    return (14 * EV({"ITLB_MISSES.STLB_HIT", 0x6085, 4, 0}, level) +
-            g_ev_error("ITLB_MISSES.WALK_DURATION:c1", level) +
-            7 * g_ev_error("ITLB_MISSES.WALK_COMPLETED", level));
+    return (14 * EV(CEV("ITLB_MISSES.STLB_HIT"), level) +
+            EV(CEV("ITLB_MISSES.WALK_DURATION:c1"), level) +
+            7 * EV(CEV("ITLB_MISSES.WALK_COMPLETED"), level));
 }
 float LOAD_L1_MISS(FEV EV, int level, bool& thresh) {
-    return EV({"MEM_LOAD_UOPS_RETIRED.L2_HIT", 0x2d1, 4, 0}, level) +
-           EV({"MEM_LOAD_UOPS_RETIRED.L3_HIT", 0x4d1, 4, 0}, level) +
-           EV({"MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HIT", 0x2d2, 4, 0}, level) +
-           EV({"MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HITM", 0x4d2, 4, 0}, level) +
-           EV({"MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_MISS", 0x1d2, 4, 0}, level);
+    return EV(CEV("MEM_LOAD_UOPS_RETIRED.L2_HIT"), level) +
+           EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_HIT"), level) +
+           EV(CEV("MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HIT"), level) +
+           EV(CEV("MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HITM"), level) +
+           EV(CEV("MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_MISS"), level);
 }
 float LOAD_L1_MISS_NET(FEV EV, int level, bool& thresh) {
     return LOAD_L1_MISS(EV, level, thresh) +
-           EV({"MEM_LOAD_UOPS_RETIRED.L3_MISS", 0x20d1, 4, 0}, level);
+           EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_MISS"), level);
 }
 float LOAD_L3_HIT(FEV EV, int level, bool& thresh) {
-    return EV({"MEM_LOAD_UOPS_RETIRED.L3_HIT", 0x4d1, 4, 0}, level) *
-           (1 + EV({"MEM_LOAD_UOPS_RETIRED.HIT_LFB", 0x40d1, 4, 0}, level) /
+    return EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_HIT"), level) *
+           (1 + EV(CEV("MEM_LOAD_UOPS_RETIRED.HIT_LFB"), level) /
                         LOAD_L1_MISS_NET(EV, level, thresh));
 }
 float LOAD_XSNP_HIT(FEV EV, int level, bool& thresh) {
-    return EV({"MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HIT", 0x2d2, 4, 0}, level) *
-           (1 + EV({"MEM_LOAD_UOPS_RETIRED.HIT_LFB", 0x40d1, 4, 0}, level) /
+    return EV(CEV("MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HIT"), level) *
+           (1 + EV(CEV("MEM_LOAD_UOPS_RETIRED.HIT_LFB"), level) /
                         LOAD_L1_MISS_NET(EV, level, thresh));
 }
 float LOAD_XSNP_HITM(FEV EV, int level, bool& thresh) {
-    return EV({"MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HITM", 0x4d2, 4, 0}, level) *
-           (1 + EV({"MEM_LOAD_UOPS_RETIRED.HIT_LFB", 0x40d1, 4, 0}, level) /
+    return EV(CEV("MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_HITM"), level) *
+           (1 + EV(CEV("MEM_LOAD_UOPS_RETIRED.HIT_LFB"), level) /
                         LOAD_L1_MISS_NET(EV, level, thresh));
 }
 float LOAD_XSNP_MISS(FEV EV, int level, bool& thresh) {
-    return EV({"MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_MISS", 0x1d2, 4, 0}, level) *
-           (1 + EV({"MEM_LOAD_UOPS_RETIRED.HIT_LFB", 0x40d1, 4, 0}, level) /
+    return EV(CEV("MEM_LOAD_UOPS_L3_HIT_RETIRED.XSNP_MISS"), level) *
+           (1 + EV(CEV("MEM_LOAD_UOPS_RETIRED.HIT_LFB"), level) /
                         LOAD_L1_MISS_NET(EV, level, thresh));
 }
 float Mem_L3_Hit_Fraction(FEV EV, int level, bool& thresh) {
-    return EV({"MEM_LOAD_UOPS_RETIRED.L3_HIT", 0x4d1, 4, 0}, level) /
-           (EV({"MEM_LOAD_UOPS_RETIRED.L3_HIT", 0x4d1, 4, 0}, level) +
+    return EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_HIT"), level) /
+           (EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_HIT"), level) +
             Mem_L3_Weight *
-                    EV({"MEM_LOAD_UOPS_RETIRED.L3_MISS", 0x20d1, 4, 0}, level));
+                    EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_MISS"), level));
 }
 float Mem_Lock_St_Fraction(FEV EV, int level, bool& thresh) {
-    return EV({"MEM_UOPS_RETIRED.LOCK_LOADS", 0x21d0, 4, 0}, level) /
-           EV({"MEM_UOPS_RETIRED.ALL_STORES", 0x82d0, 4, 0}, level);
+    return EV(CEV("MEM_UOPS_RETIRED.LOCK_LOADS"), level) /
+           EV(CEV("MEM_UOPS_RETIRED.ALL_STORES"), level);
 }
 float Memory_Bound_Fraction(FEV EV, int level, bool& thresh) {
-    return (g_ev_error("CYCLE_ACTIVITY.STALLS_MEM_ANY", level) +
-            EV({"RESOURCE_STALLS.SB", 0x8a2, 4, 0}, level)) /
+    return (EV(CEV("CYCLE_ACTIVITY.STALLS_MEM_ANY"), level) +
+            EV(CEV("RESOURCE_STALLS.SB"), level)) /
            Backend_Bound_Cycles(EV, level, thresh);
 }
 float Mispred_Clears_Fraction(FEV EV, int level, bool& thresh) {
-    return EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level) /
-           (EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level) +
-            EV({"MACHINE_CLEARS.COUNT", 0, 4, 0}, level));
+    return EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level) /
+           (EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level) +
+            EV(CEV("MACHINE_CLEARS.COUNT"), level));
 }
 float ORO_Demand_RFO_C1(FEV EV, int level, bool& thresh) {
     auto func = [&]() -> float {
         return std::min<float>(
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level),
-                EV({"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO",
-                    0x1000460, 4, 0},
+                EV(CEV("CPU_CLK_UNHALTED.THREAD"), level),
+                EV(CEV("OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO"),
                    level));
     };
     return g_ev_process(func, level);
@@ -3029,46 +3168,44 @@ float ORO_Demand_RFO_C1(FEV EV, int level, bool& thresh) {
 float ORO_DRD_Any_Cycles(FEV EV, int level, bool& thresh) {
     auto func = [&]() -> float {
         return std::min<float>(
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level),
-                EV({"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD",
-                    0x1000860, 4, 0},
+                EV(CEV("CPU_CLK_UNHALTED.THREAD"), level),
+                EV(CEV("OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD"),
                    level));
     };
     return g_ev_process(func, level);
 }
 float ORO_DRD_BW_Cycles(FEV EV, int level, bool& thresh) {
     auto func = [&]() -> float {
-        return std::min<float>(
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level),
-                g_ev_error("OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c4",
-                           level));
+        return std::min<float>(EV(CEV("CPU_CLK_UNHALTED.THREAD"),
+                                  level),
+                               EV(CEV("OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c4"), level));
     };
     return g_ev_process(func, level);
 }
 float Recovery_Cycles(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (g_ev_error("INT_MISC.RECOVERY_CYCLES_ANY", level) / 2);
+        return (EV(CEV("INT_MISC.RECOVERY_CYCLES_ANY"), level) / 2);
     } else {
-        return EV({"INT_MISC.RECOVERY_CYCLES", 0x100030d, 4, 0}, level);
+        return EV(CEV("INT_MISC.RECOVERY_CYCLES"), level);
     }
 }
 float Retire_Fraction(FEV EV, int level, bool& thresh) {
     return Retired_Slots(EV, level, thresh) /
-           EV({"UOPS_ISSUED.ANY", 0x10e, 4, 0}, level);
+           EV(CEV("UOPS_ISSUED.ANY"), level);
 }
 float Retired_Slots(FEV EV, int level, bool& thresh) {
-    return EV({"UOPS_RETIRED.RETIRE_SLOTS", 0x2c2, 4, 0}, level);
+    return EV(CEV("UOPS_RETIRED.RETIRE_SLOTS"), level);
 }
 float SQ_Full_Cycles(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
-        return (EV({"OFFCORE_REQUESTS_BUFFER.SQ_FULL", 0x1b2, 4, 0}, level) /
+        return (EV(CEV("OFFCORE_REQUESTS_BUFFER.SQ_FULL"), level) /
                 2);
     } else {
-        return EV({"OFFCORE_REQUESTS_BUFFER.SQ_FULL", 0x1b2, 4, 0}, level);
+        return EV(CEV("OFFCORE_REQUESTS_BUFFER.SQ_FULL"), level);
     }
 }
 float Store_L2_Hit_Cycles(FEV EV, int level, bool& thresh) {
-    return EV({"L2_RQSTS.RFO_HIT", 0xc224, 4, 0}, level) * Mem_L2_Store_Cost *
+    return EV(CEV("L2_RQSTS.RFO_HIT"), level) * Mem_L2_Store_Cost *
            (1 - Mem_Lock_St_Fraction(EV, level, thresh));
 }
 float Mem_XSNP_HitM_Cost(FEV EV, int level, bool& thresh) {
@@ -3081,18 +3218,18 @@ float Mem_XSNP_None_Cost(FEV EV, int level, bool& thresh) {
     return 29;
 }
 float IPC(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    return EV(CEV("INST_RETIRED.ANY"), level) /
            CLKS(EV, level, thresh);
 }
 float UPI(FEV EV, int level, bool& thresh) {
     float val = Retired_Slots(EV, level, thresh) /
-                EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+                EV(CEV("INST_RETIRED.ANY"), level);
     thresh = (val > 1.05);
     return val;
 }
 float UpTB(FEV EV, int level, bool& thresh) {
     float val = Retired_Slots(EV, level, thresh) /
-                EV({"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0}, level);
+                EV(CEV("BR_INST_RETIRED.NEAR_TAKEN"), level);
     thresh = val < Pipeline_Width * 1.5;
     return val;
 }
@@ -3100,17 +3237,17 @@ float CPI(FEV EV, int level, bool& thresh) {
     return 1 / IPC(EV, level, thresh);
 }
 float CLKS(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level);
+    return EV(CEV("CPU_CLK_UNHALTED.THREAD"), level);
 }
 float SLOTS(FEV EV, int level, bool& thresh) {
     return Pipeline_Width * CORE_CLKS(EV, level, thresh);
 }
 float Execute_per_Issue(FEV EV, int level, bool& thresh) {
-    return g_ev_error("UOPS_EXECUTED.THREAD", level) /
-           EV({"UOPS_ISSUED.ANY", 0x10e, 4, 0}, level);
+    return EV(CEV("UOPS_EXECUTED.THREAD"), level) /
+           EV(CEV("UOPS_ISSUED.ANY"), level);
 }
 float CoreIPC(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    return EV(CEV("INST_RETIRED.ANY"), level) /
            CORE_CLKS(EV, level, thresh);
 }
 float FLOPc(FEV EV, int level, bool& thresh) {
@@ -3122,115 +3259,120 @@ float FP_Arith_Utilization(FEV EV, int level, bool& thresh) {
            (2 * CORE_CLKS(EV, level, thresh));
 }
 float ILP(FEV EV, int level, bool& thresh) {
-    return g_ev_error("UOPS_EXECUTED.THREAD", level) /
+    return EV(CEV("UOPS_EXECUTED.THREAD"), level) /
            Execute_Cycles(EV, level, thresh);
 }
 float CORE_CLKS(FEV EV, int level, bool& thresh) {
     if (ebs_mode) {
-        return ((EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level) / 2) *
-                (1 + g_ev_error("CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", level) /
-                             g_ev_error("CPU_CLK_UNHALTED.REF_XCLK", level)));
+        return ((EV(CEV("CPU_CLK_UNHALTED.THREAD"), level) / 2) *
+                (1 +
+                 EV(CEV("CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE"), level) /
+                         EV(CEV("CPU_CLK_UNHALTED.REF_XCLK"), level)));
     } else {
         if (smt_enabled) {
-            return (g_ev_error("CPU_CLK_UNHALTED.THREAD_ANY", level) / 2);
+            return (EV(CEV("CPU_CLK_UNHALTED.THREAD_ANY"), level) / 2);
         } else {
             return CLKS(EV, level, thresh);
         }
     }
 }
 float IpLoad(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("MEM_UOPS_RETIRED.ALL_LOADS"), level);
     thresh = (val < 3);
     return val;
 }
 float IpStore(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"MEM_UOPS_RETIRED.ALL_STORES", 0x82d0, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("MEM_UOPS_RETIRED.ALL_STORES"), level);
     thresh = (val < 8);
     return val;
 }
 float IpBranch(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level);
     thresh = (val < 8);
     return val;
 }
 float IpCall(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.NEAR_CALL"), level);
     thresh = (val < 200);
     return val;
 }
 float IpTB(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.NEAR_TAKEN"), level);
     thresh = val < Pipeline_Width * 2;
     return val;
 }
 float BpTkBranch(FEV EV, int level, bool& thresh) {
-    return EV({"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0}, level) /
-           EV({"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0}, level);
+    return EV(CEV("BR_INST_RETIRED.ALL_BRANCHES"), level) /
+           EV(CEV("BR_INST_RETIRED.NEAR_TAKEN"), level);
 }
 float IpFLOP(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
                 FLOP_Count(EV, level, thresh);
     thresh = (val < 10);
     return val;
 }
 float IpArith(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
                 (FP_Arith_Scalar(EV, level, thresh) +
                  FP_Arith_Vector(EV, level, thresh));
     thresh = (val < 10);
     return val;
 }
 float IpArith_Scalar_SP(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_SINGLE", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_SINGLE"), level);
     thresh = (val < 10);
     return val;
 }
 float IpArith_Scalar_DP(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                g_ev_error("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("FP_ARITH_INST_RETIRED.SCALAR_DOUBLE"), level);
     thresh = (val < 10);
     return val;
 }
 float IpArith_AVX128(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                (g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", level));
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                (EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"),
+                    level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE"),
+                    level));
     thresh = (val < 10);
     return val;
 }
 float IpArith_AVX256(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                (g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", level) +
-                 g_ev_error("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", level));
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                (EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"),
+                    level) +
+                 EV(CEV("FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE"),
+                    level));
     thresh = (val < 10);
     return val;
 }
 float Instructions(FEV EV, int level, bool& thresh) {
-    return EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return EV(CEV("INST_RETIRED.ANY"), level);
 }
 float Retire(FEV EV, int level, bool& thresh) {
     return Retired_Slots(EV, level, thresh) /
-           EV({"UOPS_RETIRED.RETIRE_SLOTS:c1", 0x10002c2, 4, 0}, level);
+           EV(CEV("UOPS_RETIRED.RETIRE_SLOTS:c1"), level);
 }
 float Execute(FEV EV, int level, bool& thresh) {
-    return g_ev_error("UOPS_EXECUTED.THREAD", level) /
-           g_ev_error("UOPS_EXECUTED.THREAD:c1", level);
+    return EV(CEV("UOPS_EXECUTED.THREAD"), level) /
+           EV(CEV("UOPS_EXECUTED.THREAD:c1"), level);
 }
 float DSB_Coverage(FEV EV, int level, bool& thresh) {
-    float val = EV({"IDQ.DSB_UOPS", 0x879, 4, 0}, level) /
+    float val = EV(CEV("IDQ.DSB_UOPS"), level) /
                 Fetched_Uops(EV, level, thresh);
     thresh = (val < 0.7) && HighIPC(EV, 1, thresh);
     return val;
 }
 float IpMispredict(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level);
     thresh = (val < 200);
     return val;
 }
@@ -3241,68 +3383,68 @@ float Branch_Misprediction_Cost(FEV EV, int level, bool& thresh) {
                      DSB_Switches::compute(EV) + Branch_Resteers::compute(EV) +
                      MS_Switches::compute(EV) + ITLB_Misses::compute(EV))) *
            SLOTS(EV, level, thresh) /
-           EV({"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0}, level);
+           EV(CEV("BR_MISP_RETIRED.ALL_BRANCHES"), level);
 }
 float Load_Miss_Real_Latency(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_PEND_MISS.PENDING", 0x148, 4, 0}, level) /
-           (EV({"MEM_LOAD_UOPS_RETIRED.L1_MISS", 0x8d1, 4, 0}, level) +
-            EV({"MEM_LOAD_UOPS_RETIRED.HIT_LFB", 0x40d1, 4, 0}, level));
+    return EV(CEV("L1D_PEND_MISS.PENDING"), level) /
+           (EV(CEV("MEM_LOAD_UOPS_RETIRED.L1_MISS"), level) +
+            EV(CEV("MEM_LOAD_UOPS_RETIRED.HIT_LFB"), level));
 }
 float MLP(FEV EV, int level, bool& thresh) {
-    return EV({"L1D_PEND_MISS.PENDING", 0x148, 4, 0}, level) /
-           EV({"L1D_PEND_MISS.PENDING_CYCLES", 0x1000148, 4, 0}, level);
+    return EV(CEV("L1D_PEND_MISS.PENDING"), level) /
+           EV(CEV("L1D_PEND_MISS.PENDING_CYCLES"), level);
 }
 float L1MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * EV({"MEM_LOAD_UOPS_RETIRED.L1_MISS", 0x8d1, 4, 0}, level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_LOAD_UOPS_RETIRED.L1_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * EV({"MEM_LOAD_UOPS_RETIRED.L2_MISS", 0x10d1, 4, 0}, level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_LOAD_UOPS_RETIRED.L2_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2MPKI_All(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("L2_RQSTS.MISS", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("L2_RQSTS.MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2MPKI_Load(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("L2_RQSTS.DEMAND_DATA_RD_MISS", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("L2_RQSTS.DEMAND_DATA_RD_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2HPKI_All(FEV EV, int level, bool& thresh) {
     return 1000 *
-           (g_ev_error("L2_RQSTS.REFERENCES", level) -
-            g_ev_error("L2_RQSTS.MISS", level)) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+           (EV(CEV("L2_RQSTS.REFERENCES"), level) -
+            EV(CEV("L2_RQSTS.MISS"), level)) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L2HPKI_Load(FEV EV, int level, bool& thresh) {
-    return 1000 * g_ev_error("L2_RQSTS.DEMAND_DATA_RD_HIT", level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("L2_RQSTS.DEMAND_DATA_RD_HIT"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float L3MPKI(FEV EV, int level, bool& thresh) {
-    return 1000 * EV({"MEM_LOAD_UOPS_RETIRED.L3_MISS", 0x20d1, 4, 0}, level) /
-           EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level);
+    return 1000 * EV(CEV("MEM_LOAD_UOPS_RETIRED.L3_MISS"), level) /
+           EV(CEV("INST_RETIRED.ANY"), level);
 }
 float Page_Walks_Utilization(FEV EV, int level, bool& thresh) {
-    float val = (g_ev_error("ITLB_MISSES.WALK_DURATION:c1", level) +
-                 g_ev_error("DTLB_LOAD_MISSES.WALK_DURATION:c1", level) +
-                 g_ev_error("DTLB_STORE_MISSES.WALK_DURATION:c1", level) +
-                 7 * (g_ev_error("DTLB_STORE_MISSES.WALK_COMPLETED", level) +
-                      g_ev_error("DTLB_LOAD_MISSES.WALK_COMPLETED", level) +
-                      g_ev_error("ITLB_MISSES.WALK_COMPLETED", level))) /
+    float val = (EV(CEV("ITLB_MISSES.WALK_DURATION:c1"), level) +
+                 EV(CEV("DTLB_LOAD_MISSES.WALK_DURATION:c1"), level) +
+                 EV(CEV("DTLB_STORE_MISSES.WALK_DURATION:c1"), level) +
+                 7 * (EV(CEV("DTLB_STORE_MISSES.WALK_COMPLETED"), level) +
+                      EV(CEV("DTLB_LOAD_MISSES.WALK_COMPLETED"), level) +
+                      EV(CEV("ITLB_MISSES.WALK_COMPLETED"), level))) /
                 CORE_CLKS(EV, level, thresh);
     thresh = (val > 0.5);
     return val;
 }
 float L1D_Cache_Fill_BW(FEV EV, int level, bool& thresh) {
-    return 64 * EV({"L1D.REPLACEMENT", 0x151, 4, 0}, level) / OneBillion /
+    return 64 * EV(CEV("L1D.REPLACEMENT"), level) / OneBillion /
            Time(EV, level, thresh);
 }
 float L2_Cache_Fill_BW(FEV EV, int level, bool& thresh) {
-    return 64 * EV({"L2_LINES_IN.ALL", 0x7f1, 4, 0}, level) / OneBillion /
+    return 64 * EV(CEV("L2_LINES_IN.ALL"), level) / OneBillion /
            Time(EV, level, thresh);
 }
 float L3_Cache_Fill_BW(FEV EV, int level, bool& thresh) {
-    return 64 * EV({"LONGEST_LAT_CACHE.MISS", 0x412e, 4, 0}, level) /
+    return 64 * EV(CEV("LONGEST_LAT_CACHE.MISS"), level) /
            OneBillion / Time(EV, level, thresh);
 }
 float L1D_Cache_Fill_BW_1T(FEV EV, int level, bool& thresh) {
@@ -3315,11 +3457,11 @@ float L3_Cache_Fill_BW_1T(FEV EV, int level, bool& thresh) {
     return L3_Cache_Fill_BW(EV, level, thresh);
 }
 float CPU_Utilization(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0}, level) /
-           EV({"msr/tsc/", 0, 4, 0}, 0);
+    return EV(CEV("CPU_CLK_UNHALTED.REF_TSC"), level) /
+           g_ev_error("msr/tsc/", 0);
 }
 float Average_Frequency(FEV EV, int level, bool& thresh) {
-    return Turbo_Utilization(EV, level, thresh) * EV({"msr/tsc/", 0, 4, 0}, 0) /
+    return Turbo_Utilization(EV, level, thresh) * g_ev_error("msr/tsc/", 0) /
            OneBillion / Time(EV, level, thresh);
 }
 float GFLOPs(FEV EV, int level, bool& thresh) {
@@ -3328,40 +3470,41 @@ float GFLOPs(FEV EV, int level, bool& thresh) {
 }
 float Turbo_Utilization(FEV EV, int level, bool& thresh) {
     return CLKS(EV, level, thresh) /
-           EV({"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0}, level);
+           EV(CEV("CPU_CLK_UNHALTED.REF_TSC"), level);
 }
 float SMT_2T_Utilization(FEV EV, int level, bool& thresh) {
     if (smt_enabled) {
         return 1 -
-               g_ev_error("CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", level) /
-                       (g_ev_error("CPU_CLK_UNHALTED.REF_XCLK_ANY", level) / 2);
+               EV(CEV("CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE"), level) /
+                       (EV(CEV("CPU_CLK_UNHALTED.REF_XCLK_ANY"), level) /
+                        2);
     } else {
         return 0;
     }
 }
 float Kernel_Utilization(FEV EV, int level, bool& thresh) {
-    float val = EV({"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1}, level) /
-                EV({"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0}, level);
+    float val = EV(CEV("CPU_CLK_UNHALTED.THREAD_P:SUP"), level) /
+                EV(CEV("CPU_CLK_UNHALTED.THREAD"), level);
     thresh = (val > 0.05);
     return val;
 }
 float Kernel_CPI(FEV EV, int level, bool& thresh) {
-    return EV({"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1}, level) /
-           EV({"INST_RETIRED.ANY_P:SUP", 0xc0, 4, 1}, level);
+    return EV(CEV("CPU_CLK_UNHALTED.THREAD_P:SUP"), level) /
+           EV(CEV("INST_RETIRED.ANY_P:SUP"), level);
 }
 float DRAM_BW_Use(FEV EV, int level, bool& thresh) {
     return 64 *
-           (EV({"UNC_ARB_TRK_REQUESTS.ALL", 0, 4, 0}, level) +
-            EV({"UNC_ARB_COH_TRK_REQUESTS.ALL", 0, 4, 0}, level)) /
+           (g_ev_error("UNC_ARB_TRK_REQUESTS.ALL", level) +
+            g_ev_error("UNC_ARB_COH_TRK_REQUESTS.ALL", level)) /
            OneMillion / Time(EV, level, thresh) / 1000;
 }
 float MEM_Request_Latency(FEV EV, int level, bool& thresh) {
-    return EV({"UNC_ARB_TRK_OCCUPANCY.ALL", 0, 4, 0}, level) /
-           EV({"UNC_ARB_TRK_REQUESTS.ALL", 0, 4, 0}, level);
+    return g_ev_error("UNC_ARB_TRK_OCCUPANCY.ALL", level) /
+           g_ev_error("UNC_ARB_TRK_REQUESTS.ALL", level);
 }
 float MEM_Parallel_Requests(FEV EV, int level, bool& thresh) {
-    return EV({"UNC_ARB_TRK_OCCUPANCY.ALL", 0, 4, 0}, level) /
-           EV({"UNC_ARB_TRK_REQUESTS.ALL", 0, 4, 0}, level);
+    return g_ev_error("UNC_ARB_TRK_OCCUPANCY.ALL", level) /
+           g_ev_error("UNC_ARB_TRK_REQUESTS.ALL", level);
 }
 float Time(FEV EV, int level, bool& thresh) {
     float val = g_ev_error("interval-s", 0);
@@ -3369,16 +3512,18 @@ float Time(FEV EV, int level, bool& thresh) {
     return val;
 }
 float Socket_CLKS(FEV EV, int level, bool& thresh) {
-    return EV({"UNC_CLOCK.SOCKET", 0, 4, 0}, level);
+    return g_ev_error("UNC_CLOCK.SOCKET", level);
 }
 float IpFarBranch(FEV EV, int level, bool& thresh) {
-    float val = EV({"INST_RETIRED.ANY", 0xc0, 4, 0}, level) /
-                EV({"BR_INST_RETIRED.FAR_BRANCH:USER", 0x40c4, 4, 0}, level);
+    float val = EV(CEV("INST_RETIRED.ANY"), level) /
+                EV(CEV("BR_INST_RETIRED.FAR_BRANCH:USER"), level);
     thresh = (val < 1000000);
     return val;
 }
+}  // namespace
 
 BDWCLIENTSetUpImpl::BDWCLIENTSetUpImpl() {
+    set_catalog(bdw_client_events::kEvents);
     m_vmtc_core.push_back(std::make_pair("Frontend_Bound",
                                          (MetricBase*)(new Frontend_Bound())));
     m_vmtc_core.push_back(std::make_pair("Fetch_Latency",
@@ -22,10 +22,13 @@ do
         IN_NAME=$PMU_TOOS/$IN_FNAME
         OT_NAME=$DST_PATH/$OT_FNAME
         python3 ./gen_from_pmu_tools.py -T x86 -I $IN_NAME -M ./raw_map.txt -O $OT_NAME
+        # the event literals of the tables to the compiled-in catalog
+        python3 ./gen_event_catalog.py -N $(echo ${IN_FNAME} | sed 's/_ratios.py//') -I $OT_NAME --rewrite
         clang-format-5.0 -i $OT_NAME
     fi
 done
 
 # process arm ratios files
 python3 ./gen_from_pmu_tools.py -T arm -I $DST_PATH/a55_ratios.py -M ../../../../../third_party/libpfm4/lib/events/arm_cortex_a55_events.h -O $DST_PATH/a55_ratios.cpp
+python3 ./gen_event_catalog.py -N a55 -I $DST_PATH/a55_ratios.cpp --rewrite
 clang-format-5.0 -i $DST_PATH/a55_ratios.cpp
\ No newline at end of file
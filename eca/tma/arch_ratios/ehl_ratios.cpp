@@ -745,11 +745,13 @@ public:
 };
 
 float Frontend_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_FE_BOUND.ALL", 1) / SLOTS(EV, 1, thresh);
     thresh = (val > 0.20);
     return val;
 }
 float Bad_Speculation::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (g_ev_error("TOPDOWN_BAD_SPECULATION.MISPREDICT", 1) +
            g_ev_error("TOPDOWN_BAD_SPECULATION.MONUKE", 1)) /
           SLOTS(EV, 1, thresh);
@@ -757,29 +759,34 @@ float Bad_Speculation::compute(FEV EV) {
     return val;
 }
 float Branch_Mispredicts::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BAD_SPECULATION.MISPREDICT", 2) /
           SLOTS(EV, 2, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Machine_Clears::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (g_ev_error("TOPDOWN_BAD_SPECULATION.MONUKE", 2)) /
           SLOTS(EV, 2, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Fast_Nuke::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BAD_SPECULATION.MONUKE", 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Backend_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.ALL", 1) / SLOTS(EV, 1, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Load_Store_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (g_ev_error("MEM_BOUND_STALLS.LOAD_L2_HIT", 2) +
            g_ev_error("MEM_BOUND_STALLS.LOAD_LLC_HIT", 2) +
            g_ev_error("MEM_BOUND_STALLS.LOAD_DRAM_HIT", 2)) /
@@ -788,76 +795,90 @@ float Load_Store_Bound::compute(FEV EV) {
     return val;
 }
 float L2_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("MEM_BOUND_STALLS.LOAD_L2_HIT", 3) / CLKS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float L3_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("MEM_BOUND_STALLS.LOAD_LLC_HIT", 3) / CLKS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float DRAM_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("MEM_BOUND_STALLS.LOAD_DRAM_HIT", 3) / CLKS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Backend_Bound_Aux::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Backend_Bound::compute(EV);
     thresh = (val > 0.20);
     return val;
 }
 float Resource_Bound::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Backend_Bound::compute(EV);
     thresh = (val > 0.20);
     return val;
 }
 float Mem_Scheduler::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.MEM_SCHEDULER", 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Non_Mem_Scheduler::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.NON_MEM_SCHEDULER", 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Register::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.REGISTER", 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Reorder_Buffer::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.REORDER_BUFFER", 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Store_Buffer::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.STORE_BUFFER", 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Alloc_Restriction::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.ALLOC_RESTRICTIONS", 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Serialization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_BE_BOUND.SERIALIZATION", 3) /
           SLOTS(EV, 3, thresh);
     thresh = (val > 0.10);
     return val;
 }
 float Retiring::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("TOPDOWN_RETIRING.ALL", 1) / SLOTS(EV, 1, thresh);
     thresh = (val > 0.75);
     return val;
 }
 float Base::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (g_ev_error("TOPDOWN_RETIRING.ALL", 2) -
            g_ev_error("UOPS_RETIRED.MS", 2)) /
           SLOTS(EV, 2, thresh);
@@ -865,11 +886,13 @@ float Base::compute(FEV EV) {
     return val;
 }
 float FP_uops::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("UOPS_RETIRED.FPDIV", 3) / SLOTS(EV, 3, thresh);
     thresh = (val > 0.20);
     return val;
 }
 float Other_Ret::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = (g_ev_error("TOPDOWN_RETIRING.ALL", 3) -
            g_ev_error("UOPS_RETIRED.MS", 3) -
            g_ev_error("UOPS_RETIRED.FPDIV", 3)) /
@@ -878,141 +901,169 @@ float Other_Ret::compute(FEV EV) {
     return val;
 }
 float MS_uops::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = g_ev_error("UOPS_RETIRED.MS", 2) / SLOTS(EV, 2, thresh);
     thresh = (val > 0.05);
     return val;
 }
 float Metric_CLKS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CLKS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CLKS_P::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CLKS_P(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_SLOTS::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = SLOTS(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IPC::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IPC(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_UPI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = UPI(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Store_Fwd_Blocks::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Store_Fwd_Blocks(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Address_Alias_Blocks::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Address_Alias_Blocks(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Load_Splits::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Load_Splits(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpBranch(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpCall::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpCall(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpLoad::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpLoad(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpStore::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpStore(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpMispredict::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpMispredict(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IpFarBranch::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IpFarBranch(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Branch_Mispredict_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branch_Mispredict_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Branch_Mispredict_to_Unknown_Branch_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Branch_Mispredict_to_Unknown_Branch_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Microcode_Uop_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Microcode_Uop_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_FPDiv_Uop_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = FPDiv_Uop_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_IDiv_Uop_Ratio::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = IDiv_Uop_Ratio(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Turbo_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Turbo_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Kernel_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Kernel_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_CPU_Utilization::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = CPU_Utilization(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cycles_per_Demand_Load_L2_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_per_Demand_Load_L2_Hit(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cycles_per_Demand_Load_L3_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_per_Demand_Load_L3_Hit(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_Cycles_per_Demand_Load_DRAM_Hit::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = Cycles_per_Demand_Load_DRAM_Hit(EV, 0, thresh);
     thresh = true;
     return val;
 }
 float Metric_MemLoadPKI::compute(FEV EV) {
+    TMA_MEMOIZE();
     val = MemLoadPKI(EV, 0, thresh);
     thresh = true;
     return val;
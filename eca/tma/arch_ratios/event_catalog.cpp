@@ -0,0 +1,94 @@
+/**
+ * \file eca/tma/arch_ratios/event_catalog.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "mperf/tma/event_catalog.h"
+#include <algorithm>
+#include "a510_events.h"
+#include "a55_events.h"
+#include "adl_glc_events.h"
+#include "adl_grt_events.h"
+#include "bdw_client_events.h"
+#include "bdx_server_events.h"
+#include "clx_server_events.h"
+#include "hsw_client_events.h"
+#include "hsx_server_events.h"
+#include "icl_client_events.h"
+#include "icx_server_events.h"
+#include "ivb_client_events.h"
+#include "ivb_server_events.h"
+#include "jkt_server_events.h"
+#include "skl_client_events.h"
+#include "skx_server_events.h"
+#include "snb_client_events.h"
+#include "spr_server_events.h"
+
+namespace mperf {
+namespace tma {
+namespace {
+// call f(kEvents, kDisp) of the catalog of the cpu, the catalogs are only
+// constant tables, so every build has all of them
+template <typename F>
+bool visit_catalog(MPFXPUType t, F f) {
+#define CASE(TYPE, CATALOG)                  \
+    case TYPE:                               \
+        f(CATALOG::kEvents, CATALOG::kDisp); \
+        return true
+    switch (t) {
+        CASE(SNB_CLIENT, snb_client_events);
+        CASE(JKT_SERVER, jkt_server_events);
+        CASE(IVB_CLIENT, ivb_client_events);
+        CASE(IVB_SERVER, ivb_server_events);
+        CASE(HSW_CLIENT, hsw_client_events);
+        CASE(HSX_SERVER, hsx_server_events);
+        CASE(BDW_CLIENT, bdw_client_events);
+        CASE(BDX_SERVER, bdx_server_events);
+        CASE(SKL_CLIENT, skl_client_events);
+        CASE(SKX_SERVER, skx_server_events);
+        CASE(CLX_SERVER, clx_server_events);
+        CASE(ICL_CLIENT, icl_client_events);
+        CASE(ICX_SERVER, icx_server_events);
+        CASE(ADL_GLC, adl_glc_events);
+        CASE(ADL_GRT, adl_grt_events);
+        CASE(SPR_SERVER, spr_server_events);
+        CASE(A55, a55_events);
+        CASE(A510, a510_events);
+        case DEFAULT:
+        default:
+            return false;
+    }
+#undef CASE
+}
+}  // namespace
+
+bool catalog_event(MPFXPUType t, const std::string& name, EventAttr& attr) {
+    bool found = false;
+    visit_catalog(t, [&](const auto& events, const auto& disp) {
+        size_t i = catalog_find(events, disp, name.c_str());
+        if (i != kCatalogNpos && events[i].has_encoding) {
+            attr = events[i];
+            found = true;
+        }
+    });
+    return found;
+}
+
+std::vector<std::string> catalog_event_names(MPFXPUType t) {
+    std::vector<std::string> names;
+    visit_catalog(t, [&](const auto& events, const auto&) {
+        for (auto& ev : events) {
+            if (ev.has_encoding) {
+                names.push_back(ev.name);
+            }
+        }
+    });
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+}  // namespace tma
+}  // namespace mperf
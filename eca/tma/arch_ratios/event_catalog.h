@@ -0,0 +1,77 @@
+/**
+ * \file eca/tma/arch_ratios/event_catalog.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "mperf/pmu_types.h"
+
+namespace mperf {
+namespace tma {
+
+// An event of the compiled-in catalog of a cpu, the catalogs(e.g.
+// a55_events.h) are generated by gen_event_catalog.py.
+struct CatalogEvent {
+    const char* name;
+    uint64_t config;
+    uint32_t type;
+    // 1 counts the kernel only(e.g. the :SUP events), 0 the user space only
+    int exclude_user;
+    bool is_uncore;
+    uint64_t config1;
+    // false for the events of config 0 the generator could not encode, which
+    // the tables resolve at runtime(cf. X86EventMap)
+    bool has_encoding;
+
+    operator EventAttr() const {
+        return EventAttr(name, config, type, exclude_user, is_uncore, config1);
+    }
+};
+
+constexpr size_t kCatalogNpos = static_cast<size_t>(-1);
+
+// FNV-1 seeded by d(the offset basis if 0), the hash of gen_event_catalog.py
+constexpr uint32_t catalog_hash(uint32_t d, const char* name) {
+    uint32_t h = d ? d : 0x01000193u;
+    for (; *name; ++name) {
+        h = (h * 0x01000193u) ^ static_cast<uint8_t>(*name);
+    }
+    return h;
+}
+
+constexpr bool catalog_equal(const char* a, const char* b) {
+    for (; *a && *a == *b; ++a, ++b) {
+    }
+    return *a == *b;
+}
+
+// The index of an event in a catalog, kCatalogNpos if it is not there. The
+// name hashes to a bucket, whose displacement is either the seed of the
+// second hash, or the slot(-1 - disp) of the only event of the bucket.
+template <size_t N>
+constexpr size_t catalog_find(const CatalogEvent (&events)[N],
+                              const int32_t (&disp)[N], const char* name) {
+    int32_t d = disp[catalog_hash(0, name) % N];
+    size_t i = d < 0 ? static_cast<size_t>(-1 - d)
+                     : catalog_hash(static_cast<uint32_t>(d), name) % N;
+    return catalog_equal(events[i].name, name) ? i : kCatalogNpos;
+}
+
+template <size_t I>
+constexpr size_t catalog_require() {
+    static_assert(I != kCatalogNpos, "the event is not in the catalog");
+    return I;
+}
+
+// the event NAME of the catalog namespace CATALOG, looked up at compile time,
+// e.g. EV(TMA_CATALOG_EV(a55_events, "CPU_CYCLES"), level)
+#define TMA_CATALOG_EV(CATALOG, NAME) \
+    (CATALOG::kEvents[::mperf::tma::catalog_require<CATALOG::find(NAME)>()])
+
+}  // namespace tma
+}  // namespace mperf
@@ -0,0 +1,34 @@
+#!/bin/bash -e
+# Pin the kernel pmu-events json of the x86 ratio tables, the events the
+# tables use, to pmu-events/<catalog>.json and encode the catalogs from it:
+#     ./fetch_pmu_events.sh [the linux tag, v6.6 by default]
+# gen_event_catalog.py reads the pinned json later on with no kernel tree,
+# and the build regenerates the catalogs when it changes.
+
+LINUX_TAG=${1:-v6.6}
+LINUX_GIT=https://github.com/torvalds/linux.git
+SRC=$(mktemp -d)
+trap "rm -rf $SRC" EXIT
+
+git clone --depth 1 --branch $LINUX_TAG --filter=blob:none --sparse \
+    $LINUX_GIT $SRC
+git -C $SRC sparse-checkout set tools/perf/pmu-events/arch/x86
+ARCH=$SRC/tools/perf/pmu-events/arch/x86
+
+# <catalog>:<the cpu dir of the kernel>[:<the core pmu of a hybrid cpu>]
+for CPU in snb_client:sandybridge jkt_server:jaketown \
+    ivb_client:ivybridge ivb_server:ivytown \
+    hsw_client:haswell hsx_server:haswellx \
+    bdw_client:broadwell bdx_server:broadwellx \
+    skl_client:skylake skx_server:skylakex clx_server:cascadelakex \
+    icl_client:icelake icx_server:icelakex spr_server:sapphirerapids \
+    adl_glc:alderlake:cpu_core adl_grt:alderlake:cpu_atom
+do
+    NAME=$(echo $CPU | cut -d: -f 1)
+    DIR=$(echo $CPU | cut -d: -f 2)
+    UNIT=$(echo $CPU | cut -d: -f 3)
+    python3 ./gen_event_catalog.py -N $NAME -J $ARCH/$DIR/*.json \
+        -I ./${NAME}_ratios.cpp ${UNIT:+-U $UNIT} --pin
+    # the catalog of the events of the tables only
+    python3 ./gen_event_catalog.py -N $NAME -I ./${NAME}_ratios.cpp
+done
@@ -0,0 +1,315 @@
+# Generate the compiled-in event catalog of a cpu(<name>_events.h) for the
+# lookups of event_catalog.h, from the kernel pmu-events json files
+# (tools/perf/pmu-events/arch/<arch>/<cpu>/*.json) and / or the events the
+# ratio tables use:
+#     python3 gen_event_catalog.py -N a55 -I a55_ratios.cpp --rewrite
+#     python3 gen_event_catalog.py -N skx_server -J /path/skylakex/*.json \
+#         -I skx_server_ratios.cpp --rewrite
+# --rewrite replaces the event literals of the ratio tables, e.g.
+# EV({"CPU_CYCLES", 0x11, 4, 0}, level), by the lookups EV(CEV("CPU_CYCLES"),
+# level), and every event they use has to be in the catalog.
+# --pin writes the json events the tables use to pmu-events/<name>.json,
+# which is read instead of the kernel tree if no -J is given(cf.
+# fetch_pmu_events.sh), and the build regenerates the x86 catalogs from it
+# when it changes(cf. eca/tma/CMakeLists.txt):
+#     python3 gen_event_catalog.py -N skx_server -I skx_server_ratios.cpp
+# The events nothing encodes stay in the catalog with has_encoding false, for
+# the runtime map of x86_events.h.
+import argparse
+import json
+import os
+import re
+import sys
+
+FNV_PRIME = 0x01000193
+PERF_TYPE_RAW = 4
+# the fields of the intel core pmu, see /sys/bus/event_source/devices/cpu/format
+INTEL_X86_FIELDS = (("EventCode", 0), ("UMask", 8), ("EdgeDetect", 18),
+                    ("AnyThread", 21), ("Invert", 23), ("CounterMask", 24))
+EV_LITERAL = re.compile(r'EV\(\{([^{}]*)\}')
+CEV_NAME = re.compile(r'CEV\("([^"]+)"\)')
+CATALOG_ENTRY = re.compile(r'\{"([^"]+)", (0x[0-9a-f]+), (\d+), (\d+), '
+                           r'(true|false), (0x[0-9a-f]+)(?:, (?:true|false))?'
+                           r'\}')
+# the pmu-tools modifiers of the event names, e.g. UOPS_ISSUED.ANY:c1:e1
+MODIFIER_FIELDS = {"c": 24, "e": 18, "i": 23}
+PINNED_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                          "pmu-events")
+
+def fnv(d, name):
+    # catalog_hash of event_catalog.h
+    h = d if d else FNV_PRIME
+    for c in name.encode():
+        h = ((h * FNV_PRIME) & 0xffffffff) ^ c
+    return h
+
+def parse_int(s):
+    s = str(s).strip()
+    return int(s, 16) if s.lower().startswith("0x") else int(s or "0")
+
+def load_json(paths, unit=None):
+    # the json events of the cpu by name, of the core pmu unit(e.g. cpu_core)
+    # of a hybrid one
+    # arm: {"ArchStdEvent": "CPU_CYCLES"} refers to the common events of the
+    # arch(e.g. arm/armv8-common-and-microarch.json), pass it as well
+    raw = []
+    for path in paths:
+        with open(path) as f:
+            raw += [e for e in json.load(f) if isinstance(e, dict)]
+    std = {e["EventName"]: e for e in raw
+           if "EventName" in e and "EventCode" in e}
+    events = {}
+    for e in raw:
+        if "ArchStdEvent" in e:
+            base = std.get(e["ArchStdEvent"])
+            if base is None:
+                continue
+            e = dict(base, **{k: v for k, v in e.items()
+                              if k != "ArchStdEvent"})
+            e.setdefault("EventName", e["ArchStdEvent"])
+        name = e.get("EventName")
+        if not name or "EventCode" not in e or e.get("Unit", unit) != unit:
+            # the uncore events are read by the uncore pmus
+            continue
+        events[name] = e
+    return events
+
+def json_event(e):
+    config = 0
+    for field, shift in INTEL_X86_FIELDS:
+        if field in e:
+            # e.g. "0xB7,0xBB" of the offcore events on both counters
+            config |= parse_int(str(e[field]).split(",")[0]) << shift
+    config1 = parse_int(e.get("MSRValue", "0")) if e.get("MSRIndex") else 0
+    return (config, PERF_TYPE_RAW, 0, False, config1)
+
+def modified_event(name, raw):
+    # BASE:mod1:mod2 of the json event BASE, as X86EventMap::resolve does it,
+    # None if a modifier is not a raw encoding(e.g. percore)
+    mods = name.split(":")
+    if mods[0] not in raw:
+        return None
+    config, type_, exclude_user, is_uncore, config1 = json_event(raw[mods[0]])
+    for mod in mods[1:]:
+        if mod in ("SUP", "sup"):
+            exclude_user = 1
+        elif mod == "USER":
+            exclude_user = 0
+        elif mod[:1] == "u" and len(mod) > 1:
+            # the umask is hex even without the 0x prefix, e.g. :uF
+            config = (config & ~0xff00) | (int(mod[1:], 16) & 0xff) << 8
+        elif mod[:1] in MODIFIER_FIELDS:
+            val = int(mod[1:] or "1")
+            shift = MODIFIER_FIELDS[mod[0]]
+            mask = 0xff if mod[0] == "c" else 1
+            config = (config & ~(mask << shift)) | (val & mask) << shift
+        else:
+            return None
+    return (config, type_, exclude_user, is_uncore, config1)
+
+def encode_events(events, raw):
+    # the events of the tables with a modifier from the json ones, the json
+    # encodes them over the catalog of before
+    for name, ev in events.items():
+        if ":" in name or (ev[0] == 0 and ev[1] == PERF_TYPE_RAW):
+            encoded = modified_event(name, raw)
+            if encoded is not None:
+                events[name] = encoded
+    return events
+
+def pin_json(path, events, raw):
+    # the json events the catalog uses, with no other field than the encoding,
+    # the unit of a hybrid cpu is the catalog itself
+    keep = ("EventCode", "UMask", "EdgeDetect", "AnyThread", "Invert",
+            "CounterMask", "MSRIndex", "MSRValue")
+    pinned = []
+    for name in sorted(set(n.split(":")[0] for n in events) & set(raw)):
+        e = {"EventName": name}
+        e.update((k, raw[name][k]) for k in keep if k in raw[name])
+        pinned.append(e)
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(pinned, f, indent=4)
+        f.write("\n")
+
+def catalog_names(ratios):
+    # the events the ratio tables rewritten by a catalog look up
+    used = set()
+    for r in ratios:
+        with open(r) as f:
+            used |= set(CEV_NAME.findall(f.read()))
+    return used
+
+def load_catalog_events(path, ratios):
+    # the events of a catalog generated before, which the ratio tables
+    # rewritten by it still use
+    used = catalog_names(ratios)
+    events = {}
+    if not os.path.exists(path):
+        return events
+    with open(path) as f:
+        for m in CATALOG_ENTRY.finditer(f.read()):
+            if m.group(1) in used:
+                events[m.group(1)] = (int(m.group(2), 16), int(m.group(3)),
+                                      int(m.group(4)), m.group(5) == "true",
+                                      int(m.group(6), 16))
+    return events
+
+def load_ratio_events(paths, events):
+    # the literal of an event: "NAME", config, type, exclude_user[, is_uncore]
+    for path in paths:
+        with open(path) as f:
+            data = f.read()
+        for m in EV_LITERAL.finditer(data):
+            fields = [x.strip() for x in m.group(1).split(",")]
+            name = fields[0].strip('"')
+            ev = (parse_int(fields[1]), parse_int(fields[2]),
+                  parse_int(fields[3]),
+                  len(fields) > 4 and fields[4] == "true", 0)
+            if name in events and events[name] != ev:
+                if events[name][0] != 0 and ev[0] != 0:
+                    sys.exit("%s: the event %s conflicts with %s" %
+                             (path, m.group(0), str(events[name])))
+                # the unresolved events(config 0) of the tables
+                ev = events[name] if ev[0] == 0 else ev
+            events[name] = ev
+    return events
+
+def perfect_hash(names):
+    # hash and displace: the buckets of the first hash, largest first, look for
+    # a seed putting their names in free slots, a bucket of one name takes a
+    # free slot directly
+    n = len(names)
+    buckets = [[] for _ in range(n)]
+    for name in names:
+        buckets[fnv(0, name) % n].append(name)
+    disp = [0] * n
+    slots = [None] * n
+    order = sorted(range(n), key=lambda b: -len(buckets[b]))
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) <= 1:
+            break
+        d = 1
+        while True:
+            pos = [fnv(d, name) % n for name in bucket]
+            if len(set(pos)) == len(pos) and \
+                    all(slots[p] is None for p in pos):
+                break
+            d += 1
+        disp[b] = d
+        for p, name in zip(pos, bucket):
+            slots[p] = name
+    free = [i for i in range(n) if slots[i] is None]
+    for b in order:
+        if len(buckets[b]) == 1:
+            p = free.pop()
+            disp[b] = -1 - p
+            slots[p] = buckets[b][0]
+    return slots, disp
+
+def write_header(path, name, events):
+    slots, disp = perfect_hash(sorted(events))
+    out = []
+    out.append("/**")
+    out.append(" * \\file eca/tma/arch_ratios/%s" % os.path.basename(path))
+    out.append(" *")
+    out.append(" * This file is part of mperf.")
+    out.append(" *")
+    out.append(" * \\copyright Copyright (c) 2022-2023 Megvii Inc. All rights "
+               "reserved.")
+    out.append(" */")
+    out.append("")
+    out.append("// generated by gen_event_catalog.py, do not edit")
+    out.append("#pragma once")
+    out.append('#include "event_catalog.h"')
+    out.append("")
+    out.append("namespace mperf {")
+    out.append("namespace tma {")
+    out.append("namespace %s_events {" % name)
+    out.append("constexpr CatalogEvent kEvents[] = {")
+    for s in slots:
+        config, type_, exclude_user, is_uncore, config1 = events[s]
+        # the raw events of config 0 are the ones nothing encodes
+        has_encoding = config != 0 or type_ != PERF_TYPE_RAW
+        out.append('        {"%s", %s, %d, %d, %s, %s, %s},' %
+                   (s, hex(config), type_, exclude_user,
+                    "true" if is_uncore else "false", hex(config1),
+                    "true" if has_encoding else "false"))
+    out.append("};")
+    out.append("constexpr int32_t kDisp[] = {")
+    for i in range(0, len(disp), 10):
+        out.append("        " + ", ".join(str(d) for d in disp[i:i + 10]) +
+                   ",")
+    out.append("};")
+    out.append("constexpr size_t find(const char* name) {")
+    out.append("    return catalog_find(kEvents, kDisp, name);")
+    out.append("}")
+    out.append("}  // namespace %s_events" % name)
+    out.append("}  // namespace tma")
+    out.append("}  // namespace mperf")
+    with open(path, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+def rewrite_ratios(path, name):
+    with open(path) as f:
+        data = f.read()
+    data = EV_LITERAL.sub(
+        lambda m: "EV(CEV(%s)" % m.group(1).split(",")[0].strip(), data)
+    include = '#include "%s_events.h"\n' % name
+    if include not in data:
+        data = data.replace('#include "arch_ratios.h"\n',
+                            '#include "arch_ratios.h"\n' + include +
+                            "\n#define CEV(NAME) TMA_CATALOG_EV(%s_events, "
+                            "NAME)\n" % name, 1)
+    # the EV call sites are resolved by their index in the catalog
+    catalog = "    set_catalog(%s_events::kEvents);\n" % name
+    if catalog not in data:
+        data = re.sub(r"\n(\w+)SetUpImpl::\1SetUpImpl\(\) ?\{\n",
+                      lambda m: m.group(0) + catalog, data, 1)
+    with open(path, "w") as f:
+        f.write(data)
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-N", "--name", required=True,
+                        help="the catalog, e.g. a55 for a55_events.h")
+    parser.add_argument("-J", "--json", nargs="*", default=[],
+                        help="the pmu-events json files of the cpu")
+    parser.add_argument("-I", "--ratios", nargs="*", default=[],
+                        help="the ratio tables using the events")
+    parser.add_argument("-U", "--unit", help="the core pmu of the events of "
+                        "a hybrid cpu, e.g. cpu_core")
+    parser.add_argument("-O", "--out", help="the header, <name>_events.h of "
+                        "the directory of this script by default")
+    parser.add_argument("--rewrite", action="store_true",
+                        help="use the catalog in the ratio tables")
+    parser.add_argument("--pin", action="store_true",
+                        help="write the json events the catalog uses to "
+                        "pmu-events/<name>.json")
+    args = parser.parse_args()
+    out = args.out or os.path.join(os.path.dirname(os.path.abspath(
+        __file__)), args.name + "_events.h")
+    pinned = os.path.join(PINNED_DIR, args.name + ".json")
+    paths = args.json or ([pinned] if os.path.exists(pinned) else [])
+    raw = load_json(paths, args.unit)
+    # the json events the rewritten tables use, all of them before --rewrite
+    used = catalog_names(args.ratios)
+    events = {name: json_event(e) for name, e in raw.items()
+              if not used or name in used}
+    # the catalog of before keeps the events the json files do not encode,
+    # e.g. the uncore ones
+    catalog = load_catalog_events(out, args.ratios)
+    for name, ev in catalog.items():
+        if name not in events:
+            events[name] = ev
+    events = encode_events(load_ratio_events(args.ratios, events), raw)
+    if not events:
+        sys.exit("no events for the catalog %s" % args.name)
+    write_header(out, args.name, events)
+    if args.pin:
+        # the events the tables use, not all the json ones
+        pin_json(pinned, load_ratio_events(args.ratios, catalog), raw)
+    if args.rewrite:
+        for path in args.ratios:
+            rewrite_ratios(path, args.name)
@@ -10,6 +10,88 @@ g_all_clss = []
 g_x86_event_map = {}
 g_arm_event_map = {}
 INTEL_X86_CMASK_BIT = 24
+# the fields of the intel core pmu, see /sys/bus/event_source/devices/cpu/format
+INTEL_X86_FLAG_BITS = {"edge": 18, "pc": 19, "any": 21, "inv": 23,
+                       "in_tx": 32, "in_tx_cp": 33}
+INTEL_X86_CONFIG1_TERMS = ("offcore_rsp", "ldlat", "frontend", "config1")
+
+def split_top(s, sep):
+    # the positions of the word sep out of the parentheses
+    pos = []
+    depth = 0
+    for m in re.finditer(r'[()]|\b' + sep + r'\b', s):
+        if m.group(0) == "(":
+            depth += 1
+        elif m.group(0) == ")":
+            depth -= 1
+        elif depth == 0:
+            pos.append(m.start())
+    return pos
+
+def cvt_cond(s):
+    # python `a if c else b` to `c ? a : b`, inside the parentheses too
+    out = ""
+    last = 0
+    depth = 0
+    start = 0
+    for i, c in enumerate(s):
+        if c == "(":
+            if depth == 0:
+                out += s[last:i + 1]
+                start = i + 1
+            depth += 1
+        elif c == ")":
+            depth -= 1
+            if depth == 0:
+                out += cvt_cond(s[start:i])
+                last = i
+    out += s[last:]
+    ifs = split_top(out, "if")
+    if not ifs:
+        return out
+    i = ifs[0]
+    e = [k for k in split_top(out, "else") if k > i][0]
+    cond = out[i + 2:e].strip()
+    cond = re.sub(r'\bnot\b ?', "!", cond)
+    cond = re.sub(r'\band\b', "&&", cond)
+    cond = re.sub(r'\bor\b', "||", cond)
+    return (cond + " ? " + out[:i].strip() + " : " +
+            cvt_cond(out[e + 4:]).strip())
+
+def x86_encoding(v):
+    # the raw config of cpu/event=0xd1,umask=0x8,cmask=1,inv/k, None if any
+    # term is unknown
+    b = v.find("/")
+    e = v.rfind("/")
+    if b < 0 or e == b:
+        return None
+    config = 0
+    config1 = 0
+    for term in v[b + 1:e].split(","):
+        if not term:
+            continue
+        key, _, val = term.partition("=")
+        val = int(val, 0) if val else 1
+        if key == "event":
+            config |= val & 0xff
+        elif key == "umask":
+            config |= (val & 0xff) << 8 | (val >> 8 & 0xff) << 40
+        elif key == "cmask":
+            config |= (val & 0xff) << INTEL_X86_CMASK_BIT
+        elif key in INTEL_X86_FLAG_BITS:
+            config |= (1 if val else 0) << INTEL_X86_FLAG_BITS[key]
+        elif key == "config":
+            config = val
+        elif key in INTEL_X86_CONFIG1_TERMS:
+            config1 = val
+        elif key not in ("period", "name"):
+            return None
+    return config, config1, 1 if "k" in v[e:] else 0
+
+def is_x86_core_event(name):
+    # the uncore, software and metric group events keep g_ev_error
+    return not (name.startswith("UNC_") or name.startswith("interval-") or
+                "/" in name or name.endswith("."))
 
 def parse_if(l, in_else):
     ret = ""
@@ -34,7 +116,7 @@ def parse_if(l, in_else):
             return "return " +  tmp + ";\n" 
         else:
             if l.startswith("val ="):
-                return "float " + l + ";\n"
+                return "float " + cvt_cond(l) + ";\n"
             else:
                 if "lambda" in l:
                     al = l.replace("return ", "")
@@ -76,8 +158,8 @@ def parse_func(l, flines, idx):
     sfunc = sfunc.replace("self.", "")
     sfunc = sfunc.replace(".compute", "::compute")
     sfunc = sfunc.replace(" and ", " && ")
-    sfunc = sfunc.replace(" False", " false")
-    sfunc = sfunc.replace(" True", " true")
+    sfunc = re.sub(r"\bFalse\b", "false", sfunc)
+    sfunc = re.sub(r"\bTrue\b", "true", sfunc)
     sfunc = sfunc.replace(" min(", " std::min<float>(")
     sfunc = sfunc.replace(" max(", " std::max<float>(")
     sfunc = sfunc.replace("(EV, level)", "(EV, level, thresh)")
@@ -140,15 +222,15 @@ def parse_class(l, flines, idx):
             if cls_name in g_cls_name_parents:
                 pname = g_cls_name_parents[cls_name]
                 # print(cls_name, pname)
-            thresh = thresh.replace("and self.parent.thresh", "&& " + pname + "::thresh")
+            thresh = thresh.replace("and self.parent.thresh", "&& TMA_THRESH(" + pname + ")")
             thresh = thresh.replace(" and ", " && ")
             thresh = thresh.replace(" or ", " | ")
             thresh = thresh.replace("self, ", "")
             thresh = thresh.replace("self.val", "val")
             thresh = thresh.replace("self.", "")
-            thresh = thresh.replace(".thresh", "::thresh")
-            thresh = thresh.replace(" False", " false")
-            thresh = thresh.replace(" True", " true")
+            thresh = re.sub(r"(\w+)\.thresh", r"TMA_THRESH(\1)", thresh)
+            thresh = re.sub(r"\bFalse\b", "false", thresh)
+            thresh = re.sub(r"\bTrue\b", "true", thresh)
         else:
             continue
     
@@ -172,7 +254,8 @@ def parse_class(l, flines, idx):
     data += "};\n"
 
     data_compute_def += "float " + cls_name + "::compute(FEV EV) {\n"
-    data_compute_def += "val = " + compute + ";\n"
+    data_compute_def += "TMA_MEMOIZE();\n"
+    data_compute_def += "val = " + cvt_cond(compute) + ";\n"
     data_compute_def += "thresh = " + thresh + ";\n"
     data_compute_def += "return val;\n"
     data_compute_def += "}\n"
@@ -204,6 +287,10 @@ def parse_expr(l, data):
     # process expr
     if right.startswith("lambda"):
         return ""
+    elif left == "topdown_use_fixed":
+        return "" # chosen by the session, see TMA_TOPDOWN_FIXED
+    elif right.startswith("\""):
+        return "static std::string " + left + " = " + right + ";\n"
     elif right.startswith("False"):
         return "static bool " + left + " = " + "false;\n"
     elif right.startswith("True"):
@@ -303,42 +390,30 @@ def parse_ratios_file(is_x86, map_file, in_name, ot_name, arch_cpu_name):
         str_def = str_def.replace('EV("', 'g_ev_error("')
 
         for k,v in g_x86_event_map.items():
-            av = v.split(",")
-            lav = len(av)
-            config = 0
-            exclude_user = 0
-            if lav == 2: # cpu/event=,umask=
-                if av[0].split("=")[0].strip() != "cpu/event":
-                    continue
-                if av[1].split("=")[0].strip() != "umask":
-                    continue
-                ecode = int(av[0].split("=")[1].strip(), 0)
-                umask = int(av[1].split("=")[1].strip().split("/")[0], 0)
-                if av[1].split("=")[1].strip().split("/")[1] == 'k':
-                    exclude_user = 1 # only count kernel
-                config = hex(ecode | (umask << 8))
-            elif lav == 3:  # cpu/event=,umask=,cmask=
-                if av[0].split("=")[0].strip() != "cpu/event":
-                    continue
-                if av[1].split("=")[0].strip() != "umask":
-                    continue
-                if av[2].split("=")[0].strip() != "cmask":
-                    continue
-                ecode = int(av[0].split("=")[1].strip(), 0)
-                umask = int(av[1].split("=")[1].strip().split("/")[0], 0)
-                cmask = int(av[2].split("=")[1].strip()[0:-1], 0)
-                # print(av, ecode, umask, cmask)
-                config = hex(ecode | (umask << 8) | (cmask << INTEL_X86_CMASK_BIT))
-            else:
-                config = 0
-                exclude_user = 0
-
-            # print(str(rv))
+            enc = x86_encoding(v)
+            if enc is None:
+                continue
+            config, config1, exclude_user = enc
             rp_s = "g_ev_error(\"" + k + "\""
             # PERF_TYPE_RAW: 4
-            rp_d = "EV({\"" + k + "\", " + str(config) + ", 4, " + str(exclude_user) + "}"
+            rp_d = "EV({\"" + k + "\", " + hex(config) + ", 4, " + str(exclude_user)
+            if config1:
+                rp_d += ", 0, " + hex(config1)
+            rp_d += "}"
             str_cls_def = str_cls_def.replace(rp_s, rp_d)
             str_def = str_def.replace(rp_s, rp_d)
+
+        # the core events not in the map are encoded by X86EventMap at runtime
+        def ev_unknown(m):
+            if not is_x86_core_event(m.group(1)):
+                return m.group(0)
+            return "EV({\"" + m.group(1) + "\", 0, 4, 0}"
+        str_cls_def = re.sub(r'g_ev_error\("([^"]*)"', ev_unknown, str_cls_def)
+        str_def = re.sub(r'g_ev_error\("([^"]*)"', ev_unknown, str_def)
+        str_cls_def = re.sub(r"\btopdown_use_fixed\b", "TMA_TOPDOWN_FIXED()",
+                             str_cls_def)
+        str_def = re.sub(r"\btopdown_use_fixed\b", "TMA_TOPDOWN_FIXED()",
+                         str_def)
     else:
         arm_event_name = []
         arm_value_name = []
@@ -373,6 +448,8 @@ def parse_ratios_file(is_x86, map_file, in_name, ot_name, arch_cpu_name):
         f.write('\n')
         f.write('namespace mperf {\n')
         f.write('namespace tma {\n')
+        # the metrics of every cpu are local to its file
+        f.write('namespace {\n')
         f.write('\n')
 
         # expr
@@ -394,6 +471,8 @@ def parse_ratios_file(is_x86, map_file, in_name, ot_name, arch_cpu_name):
         f.write(str_def)
         f.write('\n\n')
 
+        f.write('}  // namespace\n\n')
+
         # SetUp
         clsname = arch_cpu_name.upper() + "SetUpImpl"
         setup_cls = clsname + "::" + clsname + "(){\n"
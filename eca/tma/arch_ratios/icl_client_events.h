@@ -0,0 +1,186 @@
+/**
+ * \file eca/tma/arch_ratios/icl_client_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// generated by gen_event_catalog.py, do not edit
+#pragma once
+#include "event_catalog.h"
+
+namespace mperf {
+namespace tma {
+namespace icl_client_events {
+constexpr CatalogEvent kEvents[] = {
+        {"UOPS_EXECUTED.THREAD:c1", 0x10001b1, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE", 0x400019c, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.WALK_ACTIVE", 0x1001049, 4, 0, false, 0x0, true},
+        {"ARITH.DIVIDER_ACTIVE", 0x1000914, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS.ALL_REQUESTS", 0x80b0, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_UOPS:c4", 0x4000479, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_UOPS:c5", 0x5000479, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", 0x8c7, 4, 0, false, 0x0, true},
+        {"UOPS_DECODED.DEC0:c1", 0x1000156, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.FB_FULL", 0x248, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.SPLIT_STORES", 0x42d0, 4, 0, false, 0x0, true},
+        {"IDQ.MS_SWITCHES", 0x1043079, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.NOP", 0x2c0, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_DISTRIBUTED", 0x83c, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS.DEMAND_DATA_RD", 0x1b0, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING_CYCLES", 0x1000148, 4, 0, false, 0x0, true},
+        {"OCR.DEMAND_RFO.L3_HIT.SNOOP_HITM", 0x1b7, 4, 0, false, 0x10003c0002, true},
+        {"UOPS_EXECUTED.THREAD", 0x1b1, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_UOPS", 0x479, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.RFO_HIT", 0xc224, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.BAD_SPECULATION", 0x8100, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.X87", 0x10b1, 4, 0, false, 0x0, true},
+        {"TOPDOWN.BACKEND_BOUND_SLOTS", 0x2a4, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.ALL_DEMAND_MISS", 0x2724, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.512B_PACKED_SINGLE", 0x80c7, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_4_9", 0x10a1, 4, 0, false, 0x0, true},
+        {"LSD.CYCLES_ACTIVE", 0x10001a8, 4, 0, false, 0x0, true},
+        {"ILD_STALL.LCP", 0x187, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.CYCLES_MEM_ANY", 0x100010a3, 4, 0, false, 0x0, true},
+        {"CORE_POWER.LVL0_TURBO_LICENSE", 0x728, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.FRONTEND_BOUND", 0x8200, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.COND_NTAKEN", 0x10c4, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.3_PORTS_UTIL:u0x80", 0x80a6, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ALL_LOADS", 0x81d0, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_CYCLES_OK", 0x5000879, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY", 0xc0, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.FB_HIT", 0x40d1, 4, 0, false, 0x0, true},
+        {"LSD.UOPS", 0x1a8, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CYCLES_GE_3", 0x30001b1, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.512B_PACKED_DOUBLE", 0x40c7, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.SLOTS", 0x2c2, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_CYCLES_OK", 0x5000479, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.FAR_BRANCH:USER", 0x40c4, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_TOTAL", 0x40004a3, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L1D_MISS", 0xc000ca3, 4, 0, false, 0x0, true},
+        {"ITLB_MISSES.WALK_PENDING", 0x1085, 4, 0, false, 0x0, true},
+        {"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L2_MISS", 0x10d1, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.STLB_HIT:c1", 0x1002049, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_UOPS", 0x879, 4, 0, false, 0x0, true},
+        {"SW_PREFETCH_ACCESS.T0:uF", 0xf32, 4, 0, false, 0x0, true},
+        {"LONGEST_LAT_CACHE.MISS", 0x412e, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.ALL_DEMAND_DATA_RD", 0xe124, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_1", 0x2a1, 4, 0, false, 0x0, true},
+        {"MISC_RETIRED.PAUSE_INST", 0x40cc, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.VECTOR_WIDTH_MISMATCH", 0x20e, 4, 0, false, 0x0, true},
+        {"ASSISTS.ANY", 0x7c1, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", 0x4c7, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_5", 0x20a1, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L3_MISS", 0x60006a3, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", 0x23c, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.2_PORTS_UTIL", 0x4a6, 4, 0, false, 0x0, true},
+        {"LSD.CYCLES_OK", 0x50001a8, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c4", 0x4000860, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L3_HIT", 0x4d1, 4, 0, false, 0x0, true},
+        {"INT_MISC.RECOVERY_CYCLES:c1:e1", 0x104030d, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING", 0x148, 4, 0, false, 0x0, true},
+        {"OCR.STREAMING_WR.ANY_RESPONSE", 0x1b7, 4, 0, false, 0x10800, true},
+        {"UOPS_DISPATCHED.PORT_7_8", 0x80a1, 4, 0, false, 0x0, true},
+        {"ICACHE_64B.IFTAG_STALL", 0x483, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.ALL_RFO", 0xe224, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.COND_TAKEN", 0x1c4, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.SCALAR_SINGLE", 0x2c7, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_RETURN", 0x8c4, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO", 0x1000460, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.WALK_PENDING", 0x1049, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.PENALTY_CYCLES:c1:e1", 0x10402ab, 4, 0, false, 0x0, true},
+        {"INST_DECODED.DECODERS:c1", 0x1000155, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.WALK_ACTIVE", 0x1001008, 4, 0, false, 0x0, true},
+        {"UOPS_DECODED.DEC0", 0x156, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.CYCLES_L1D_MISS", 0x80008a3, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L3_MISS", 0x20d1, 4, 0, false, 0x0, true},
+        {"FRONTEND_RETIRED.ANY_DSB_MISS", 0x1c6, 4, 0, false, 0x1, true},
+        {"DTLB_LOAD_MISSES.WALK_PENDING", 0x1008, 4, 0, false, 0x0, true},
+        {"CORE_POWER.LVL2_TURBO_LICENSE", 0x2028, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_MISS", 0x1d2, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.ANY", 0x10e, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.DISTRIBUTED", 0x2ec, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", 0x20c7, 4, 0, false, 0x0, true},
+        {"BACLEARS.ANY", 0x1fe6, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS_PARTIAL.ADDRESS_ALIAS", 0x107, 4, 0, false, 0x0, true},
+        {"L2_LINES_IN.ALL", 0x7f1, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.STLB_HIT:c1", 0x1002008, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.STORE_FORWARD", 0x203, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.1_PORTS_UTIL", 0x2a6, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.NO_SR", 0x803, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ANY", 0x83d0, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L1_MISS", 0x8d1, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L2_HIT", 0x2d1, 4, 0, false, 0x0, true},
+        {"CORE_POWER.LVL1_TURBO_LICENSE", 0x1828, 4, 0, false, 0x0, true},
+        {"TOPDOWN.SLOTS:percore", 0x0, 4, 0, false, 0x0, false},
+        {"IDQ.MS_UOPS", 0x3079, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.FB_FULL_PERIODS", 0x1040248, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", 0x1c7, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_2_3", 0x4a1, 4, 0, false, 0x0, true},
+        {"TOPDOWN.SLOTS", 0x400, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.ANY:c1", 0x100010e, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.DEMAND_DATA_RD_HIT", 0xc124, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x2ab, 4, 0, false, 0x0, true},
+        {"L1D.REPLACEMENT", 0x151, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE_CYCLES_GE_1", 0x10002b1, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.DEMAND_DATA_RD_MISS", 0x2124, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_6", 0x40a1, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_HIT", 0x2d2, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_CYCLES_ANY", 0x1000479, 4, 0, false, 0x0, true},
+        {"INT_MISC.CLEAR_RESTEER_CYCLES", 0x800d, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS.ALL_DATA_RD", 0x8b0, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.COUNT", 0x10401c3, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.L2_STALL", 0x448, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.BACKEND_BOUND", 0x8300, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L2_MISS", 0x50005a3, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1, false, 0x0, true},
+        {"EXE_ACTIVITY.BOUND_ON_STORES", 0x20040a6, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY_P:SUP", 0xc0, 4, 1, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_MEM_ANY", 0x140014a3, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD", 0x1000860, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.LOCK_LOADS", 0x21d0, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.COND", 0x11c4, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.SLOTS:c1", 0x10002c2, 4, 0, false, 0x0, true},
+        {"INST_DECODED.DECODERS:c2", 0x2000155, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_CYCLES_ANY", 0x1000879, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.SWPF_MISS", 0x2824, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_0", 0x1a1, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.RETIRING", 0x8000, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM", 0x4d2, 4, 0, false, 0x0, true},
+        {"ICACHE_16B.IFDATA_STALL", 0x480, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", 0x10c7, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ALL_STORES", 0x82d0, 4, 0, false, 0x0, true},
+        {"INT_MISC.UOP_DROPPING", 0x100d, 4, 0, false, 0x0, true},
+        {"RESOURCE_STALLS.SCOREBOARD", 0x2a2, 4, 0, false, 0x0, true},
+};
+constexpr int32_t kDisp[] = {
+        0, -146, 1, -134, 0, 0, 1, 0, -133, 0,
+        -131, 0, 0, 1, 4, -130, 0, 4, 0, 1,
+        -128, 5, 0, -126, 0, 0, -125, 0, -122, 1,
+        0, 3, 0, -120, 1, 1, -118, 0, 0, 0,
+        -114, 0, 1, 1, 0, 2, -113, 0, 0, 1,
+        1, -112, 0, 1, -111, -110, 0, 1, -105, 0,
+        0, -104, 0, 1, 5, 10, -102, 0, 0, -101,
+        0, -98, -92, 0, -89, 0, 5, 0, -86, -83,
+        1, -80, 1, -79, -74, -72, 0, -70, 6, 0,
+        -69, 8, 2, 1, -68, -64, 0, -61, 13, 1,
+        1, -59, -57, -54, -53, 0, 0, -36, 3, 0,
+        0, 8, -35, 0, 0, -31, 0, 2, -28, 0,
+        0, -23, -21, -18, 0, 0, -13, 0, -11, 2,
+        11, -9, -8, 0, 0, 1, -7, -6, -3, 11,
+        0, 0, 5, 0, -2, 0,
+};
+constexpr size_t find(const char* name) {
+    return catalog_find(kEvents, kDisp, name);
+}
+}  // namespace icl_client_events
+}  // namespace tma
+}  // namespace mperf
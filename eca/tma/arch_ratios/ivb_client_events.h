@@ -0,0 +1,134 @@
+/**
+ * \file eca/tma/arch_ratios/ivb_client_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// generated by gen_event_catalog.py, do not edit
+#pragma once
+#include "event_catalog.h"
+
+namespace mperf {
+namespace tma {
+namespace ivb_client_events {
+constexpr CatalogEvent kEvents[] = {
+        {"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY_P:SUP", 0xc0, 4, 1, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE:c3", 0x30002b1, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE:c2", 0x20002b1, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_5", 0x20a1, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.STLB_HIT", 0x6049, 4, 0, false, 0x0, true},
+        {"ILD_STALL.LCP", 0x187, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L2_PENDING", 0x50005a3, 4, 0, false, 0x0, true},
+        {"MEM_UOPS_RETIRED.ALL_STORES", 0x82d0, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS_PARTIAL.ADDRESS_ALIAS", 0x107, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD_ANY", 0x20003c, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L1D_PENDING", 0xc000ca3, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_MITE_CYCLES_4_UOPS", 0x4002479, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_UOPS", 0x479, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_UOPS", 0x879, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_2", 0x4a1, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE:i1:c1", 0x18002b1, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_LLC_HIT_RETIRED.XSNP_HITM", 0x4d2, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_BUFFER.SQ_FULL", 0x1b2, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CYCLES_GE_1_UOP_EXEC", 0x10001b1, 4, 0, false, 0x0, true},
+        {"RS_EVENTS.EMPTY_CYCLES", 0x15e, 4, 0, false, 0x0, true},
+        {"OFFCORE_RESPONSE.DEMAND_RFO.LLC_HIT.HITM_OTHER_CORE", 0x1b7, 4, 0, false, 0x10003c0002, true},
+        {"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1, false, 0x0, true},
+        {"UOPS_RETIRED.RETIRE_SLOTS:c1", 0x10002c2, 4, 0, false, 0x0, true},
+        {"ITLB_MISSES.STLB_HIT", 0x6085, 4, 0, false, 0x0, true},
+        {"INT_MISC.RECOVERY_CYCLES_ANY", 0x120030d, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_LLC_HIT_RETIRED.XSNP_HIT", 0x2d2, 4, 0, false, 0x0, true},
+        {"RESOURCE_STALLS.SB", 0x8a2, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_SCALAR_DOUBLE", 0x8010, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c6", 0x6000860, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.THREAD:c1", 0x10001b1, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.HIT_LFB", 0x40d1, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_DSB_CYCLES_ANY_UOPS", 0x1001879, 4, 0, false, 0x0, true},
+        {"IDQ.MS_SWITCHES", 0x1043079, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING_CYCLES", 0x1000148, 4, 0, false, 0x0, true},
+        {"ARITH.FPU_DIV_ACTIVE", 0x114, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE", 0x400019c, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.LLC_MISS", 0x20d1, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.WALK_DURATION", 0x1008, 4, 0, false, 0x0, true},
+        {"INT_MISC.RECOVERY_CYCLES", 0x100030d, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.WALK_DURATION", 0x1049, 4, 0, false, 0x0, true},
+        {"IDQ.MS_UOPS", 0x3079, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.L2_HIT", 0x2d1, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.RFO_HIT", 0xc224, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY", 0xc0, 4, 0, false, 0x0, true},
+        {"ITLB_MISSES.WALK_DURATION", 0x1085, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD", 0x1000860, 4, 0, false, 0x0, true},
+        {"ICACHE.IFETCH_STALL", 0x480, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CYCLES_GE_2_UOPS_EXEC", 0x20001b1, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING", 0x148, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.STLB_HIT", 0x6008, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE:c1", 0x10002b1, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x2ab, 4, 0, false, 0x0, true},
+        {"MEM_UOPS_RETIRED.SPLIT_STORES", 0x42d0, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.CYCLES_NO_EXECUTE", 0x40004a3, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_0", 0x1a1, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_3", 0x8a1, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.L2_MISS", 0x10d1, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_SCALAR_SINGLE", 0x2010, 4, 0, false, 0x0, true},
+        {"L1D.REPLACEMENT", 0x151, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.THREAD", 0x1b1, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.X87", 0x110, 4, 0, false, 0x0, true},
+        {"SIMD_FP_256.PACKED_DOUBLE", 0x211, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO", 0x1000460, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.LLC_HIT", 0x4d1, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_XCLK", 0x13c, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", 0x23c, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.ANY", 0x10e, 4, 0, false, 0x0, true},
+        {"MEM_UOPS_RETIRED.LOCK_LOADS", 0x21d0, 4, 0, false, 0x0, true},
+        {"SIMD_FP_256.PACKED_SINGLE", 0x111, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_1", 0x2a1, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_MITE_CYCLES_ANY_UOPS", 0x1002479, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_XCLK_ANY", 0x20013c, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_4", 0x10a1, 4, 0, false, 0x0, true},
+        {"MEM_UOPS_RETIRED.ALL_LOADS", 0x81d0, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_PACKED_DOUBLE", 0x1010, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.RETIRE_SLOTS", 0x2c2, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.COUNT", 0x10401c3, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.FB_FULL:c1", 0x1000248, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.L1_MISS", 0x8d1, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.STORE_FORWARD", 0x203, 4, 0, false, 0x0, true},
+        {"OTHER_ASSISTS.ANY_WB_ASSIST", 0x40c1, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_DSB_CYCLES_4_UOPS", 0x4001879, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_LDM_PENDING", 0x60006a3, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CYCLES_GE_3_UOPS_EXEC", 0x30001b1, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_LLC_HIT_RETIRED.XSNP_MISS", 0x1d2, 4, 0, false, 0x0, true},
+        {"LONGEST_LAT_CACHE.MISS", 0x412e, 4, 0, false, 0x0, true},
+        {"BACLEARS.ANY", 0x1fe6, 4, 0, false, 0x0, true},
+        {"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0, false, 0x0, true},
+        {"LSD.UOPS", 0x1a8, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.NO_SR", 0x803, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.FAR_BRANCH:USER", 0x40c4, 4, 0, false, 0x0, true},
+        {"L2_LINES_IN.ALL", 0x7f1, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_PACKED_SINGLE", 0x4010, 4, 0, false, 0x0, true},
+};
+constexpr int32_t kDisp[] = {
+        1, 1, 0, -99, -97, 1, 0, -95, 4, -93,
+        0, 0, -92, 1, 0, -90, 2, 0, 0, -88,
+        0, 1, -86, 0, 1, 0, 0, -84, 0, -83,
+        -82, -80, 0, 1, 4, 1, 0, 0, 0, -74,
+        0, -73, -71, 2, 0, 4, 0, 3, -70, 0,
+        0, -69, -67, 0, -66, 5, 1, 3, 4, -62,
+        -61, 1, -60, -58, 3, 0, -56, 0, -54, 0,
+        -53, -51, 0, -50, -49, -45, 1, -44, 0, -42,
+        4, 0, 1, 0, 0, 9, 0, -41, -36, -30,
+        -28, -23, -17, -15, -14, -13, -9, -5, -4,
+};
+constexpr size_t find(const char* name) {
+    return catalog_find(kEvents, kDisp, name);
+}
+}  // namespace ivb_client_events
+}  // namespace tma
+}  // namespace mperf
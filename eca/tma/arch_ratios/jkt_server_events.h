@@ -0,0 +1,84 @@
+/**
+ * \file eca/tma/arch_ratios/jkt_server_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// generated by gen_event_catalog.py, do not edit
+#pragma once
+#include "event_catalog.h"
+
+namespace mperf {
+namespace tma {
+namespace jkt_server_events {
+constexpr CatalogEvent kEvents[] = {
+        {"RESOURCE_STALLS.SB", 0x8a2, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_PACKED_DOUBLE", 0x1010, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.CYCLES_NO_DISPATCH", 0x40004a3, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.CORE:c1", 0x10002b1, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_XCLK_ANY", 0x20013c, 4, 0, false, 0x0, true},
+        {"LSD.UOPS", 0x1a8, 4, 0, false, 0x0, true},
+        {"ITLB_MISSES.STLB_HIT", 0x6085, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.COUNT", 0x10401c3, 4, 0, false, 0x0, true},
+        {"ITLB_MISSES.WALK_DURATION", 0x1085, 4, 0, false, 0x0, true},
+        {"INT_MISC.RECOVERY_CYCLES", 0x100030d, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.FAR_BRANCH:USER", 0x40c4, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD", 0x1000860, 4, 0, false, 0x0, true},
+        {"INT_MISC.RECOVERY_CYCLES_ANY", 0x120030d, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.THREAD", 0x1b1, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x2ab, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_SCALAR_SINGLE", 0x2010, 4, 0, false, 0x0, true},
+        {"IDQ.MS_SWITCHES", 0x1043079, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", 0x23c, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1, false, 0x0, true},
+        {"UOPS_RETIRED.RETIRE_SLOTS", 0x2c2, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L2_PENDING", 0x50005a3, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.STLB_HIT", 0x6008, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.THREAD:c3", 0x30001b1, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L1D_PENDING", 0xc000ca3, 4, 0, false, 0x0, true},
+        {"SIMD_FP_256.PACKED_DOUBLE", 0x211, 4, 0, false, 0x0, true},
+        {"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0, false, 0x0, true},
+        {"ARITH.FPU_DIV_ACTIVE", 0x114, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c, 4, 0, false, 0x0, true},
+        {"ILD_STALL.LCP", 0x187, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.ANY", 0x10e, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.THREAD:c1", 0x10001b1, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_UOPS", 0x479, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY", 0xc0, 4, 0, false, 0x0, true},
+        {"RS_EVENTS.EMPTY_CYCLES", 0x15e, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD_ANY", 0x20003c, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.RETIRE_SLOTS:c1", 0x10002c2, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY_P:SUP", 0xc0, 4, 1, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.LLC_HIT", 0x4d1, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE", 0x400019c, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.X87", 0x110, 4, 0, false, 0x0, true},
+        {"BACLEARS.ANY", 0x1fe6, 4, 0, false, 0x0, true},
+        {"SIMD_FP_256.PACKED_SINGLE", 0x111, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_XCLK", 0x13c, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_UOPS_RETIRED.LLC_MISS", 0x20d1, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_SCALAR_DOUBLE", 0x8010, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_UOPS", 0x879, 4, 0, false, 0x0, true},
+        {"FP_COMP_OPS_EXE.SSE_PACKED_SINGLE", 0x4010, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.THREAD:c2", 0x20001b1, 4, 0, false, 0x0, true},
+        {"IDQ.MS_UOPS", 0x3079, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.WALK_DURATION", 0x1008, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c6", 0x6000860, 4, 0, false, 0x0, true},
+};
+constexpr int32_t kDisp[] = {
+        1, -51, 0, -49, 1, -46, 0, 10, -44, 0,
+        -43, 0, 0, 3, -41, -39, -38, 2, 0, 0,
+        -37, 1, 11, 8, -32, 0, -28, 0, -26, 0,
+        0, 0, 2, 0, 0, -22, 0, -19, -18, 1,
+        -13, -8, 0, 0, -5, 0, 5, 0, 0, -3,
+        0, -2, 0,
+};
+constexpr size_t find(const char* name) {
+    return catalog_find(kEvents, kDisp, name);
+}
+}  // namespace jkt_server_events
+}  // namespace tma
+}  // namespace mperf
@@ -0,0 +1,172 @@
+/**
+ * \file eca/tma/arch_ratios/skl_client_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// generated by gen_event_catalog.py, do not edit
+#pragma once
+#include "event_catalog.h"
+
+namespace mperf {
+namespace tma {
+namespace skl_client_events {
+constexpr CatalogEvent kEvents[] = {
+        {"UOPS_DISPATCHED_PORT.PORT_3", 0x8a1, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.FB_HIT", 0x40d1, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.BOUND_ON_STORES", 0x40a6, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.NOP", 0x0, 4, 0, false, 0x0, false},
+        {"EXE_ACTIVITY.2_PORTS_UTIL", 0x4a6, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_1", 0x2a1, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_0", 0x1a1, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.NO_SR", 0x803, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_5", 0x20a1, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.RFO_HIT", 0xc224, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.ALL_RFO", 0xe224, 4, 0, false, 0x0, true},
+        {"PARTIAL_RAT_STALLS.SCOREBOARD", 0x159, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_HIT", 0x2d2, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.CONDITIONAL", 0x1c4, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_4", 0x10a1, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_6", 0x40a1, 4, 0, false, 0x0, true},
+        {"ARITH.DIVIDER_ACTIVE", 0x1000114, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", 0x23c, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING_CYCLES", 0x1000148, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.RETIRE_SLOTS:c1", 0x10002c2, 4, 0, false, 0x0, true},
+        {"LSD.CYCLES_ACTIVE", 0x10001a8, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L3_MISS", 0x20d1, 4, 0, false, 0x0, true},
+        {"FRONTEND_RETIRED.ANY_DSB_MISS", 0x1c6, 4, 0, false, 0x1, true},
+        {"OTHER_ASSISTS.ANY", 0x3fc1, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ALL_STORES", 0x82d0, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.FAR_BRANCH:USER", 0x40c4, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_BUFFER.SQ_FULL", 0x1b2, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING", 0x148, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_DSB_CYCLES_ANY_UOPS", 0x1001879, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.FB_FULL:c1", 0x1000248, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE_CYCLES_GE_2", 0x20002b1, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.THREAD:c1", 0x10001b1, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE_CYCLES_GE_3", 0x30002b1, 4, 0, false, 0x0, true},
+        {"INST_DECODED.DECODERS:c1", 0x1000155, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE", 0x400019c, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_RETURN", 0x8c4, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L2_MISS", 0x50005a3, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.REFERENCES", 0xff24, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", 0x4c7, 4, 0, false, 0x0, true},
+        {"ITLB_MISSES.WALK_PENDING", 0x1085, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L1_MISS", 0x8d1, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE_CYCLES_NONE", 0x18002b1, 4, 0, false, 0x0, true},
+        {"L1D.REPLACEMENT", 0x151, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_7", 0x80a1, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ANY", 0x83d0, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.RETIRE_SLOTS", 0x2c2, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.EXE_BOUND_0_PORTS", 0x1a6, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c, 4, 0, false, 0x0, true},
+        {"INST_DECODED.DECODERS:c2", 0x2000155, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", 0x10c7, 4, 0, false, 0x0, true},
+        {"FP_ASSIST.ANY", 0x1001eca, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.WALK_ACTIVE", 0x1001049, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_MISS", 0x1d2, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.DEMAND_DATA_RD_HIT", 0x4124, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.1_PORTS_UTIL", 0x2a6, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.STORE_FORWARD", 0x203, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.CYCLES_MEM_ANY", 0x100010a3, 4, 0, false, 0x0, true},
+        {"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x2ab, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L3_MISS", 0x60006a3, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.SCALAR_SINGLE", 0x2c7, 4, 0, false, 0x0, true},
+        {"INT_MISC.RECOVERY_CYCLES", 0x100030d, 4, 0, false, 0x0, true},
+        {"OFFCORE_RESPONSE.DEMAND_RFO.L3_HIT.SNOOP_HITM", 0x1b7, 4, 0, false, 0x10003c0002, true},
+        {"CYCLE_ACTIVITY.STALLS_TOTAL", 0x40004a3, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.ANY", 0x10e, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_UOPS", 0x879, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1, false, 0x0, true},
+        {"ICACHE_16B.IFDATA_STALL:c1:e1", 0x1040480, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L3_HIT", 0x4d1, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_DSB_CYCLES_4_UOPS", 0x4001879, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", 0x1c7, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_MITE_CYCLES_4_UOPS", 0x4002479, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_XCLK", 0x13c, 4, 0, false, 0x0, true},
+        {"SW_PREFETCH_ACCESS.T0:uF", 0xf32, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c4", 0x4000860, 4, 0, false, 0x0, true},
+        {"INT_MISC.CLEAR_RESTEER_CYCLES", 0x800d, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS_PARTIAL.ADDRESS_ALIAS", 0x107, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.WALK_PENDING", 0x1008, 4, 0, false, 0x0, true},
+        {"ILD_STALL.LCP", 0x187, 4, 0, false, 0x0, true},
+        {"LONGEST_LAT_CACHE.MISS", 0x412e, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.WALK_PENDING", 0x1049, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.CYCLES_L1D_MISS", 0x80008a3, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD", 0x1000860, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.MISS", 0x3f24, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", 0x8c7, 4, 0, false, 0x0, true},
+        {"EPT.WALK_PENDING", 0x104f, 4, 0, false, 0x0, true},
+        {"L2_LINES_IN.ALL", 0x7f1, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_L1D_MISS", 0xc000ca3, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY", 0xc0, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ALL_LOADS", 0x81d0, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_XCLK_ANY", 0x20013c, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L2_MISS", 0x10d1, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.ALL_DEMAND_DATA_RD", 0xe124, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD_ANY", 0x20003c, 4, 0, false, 0x0, true},
+        {"INT_MISC.RECOVERY_CYCLES_ANY", 0x20010d, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.THREAD", 0x1b1, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.WALK_ACTIVE", 0x1001008, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_UOPS", 0x479, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO", 0x1000460, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.VECTOR_WIDTH_MISMATCH", 0x20e, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS.ALL_REQUESTS", 0x80b0, 4, 0, false, 0x0, true},
+        {"ICACHE_16B.IFDATA_STALL", 0x480, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.COUNT", 0x0, 4, 0, false, 0x0, false},
+        {"INST_RETIRED.ANY_P:SUP", 0xc0, 4, 1, false, 0x0, true},
+        {"MEM_INST_RETIRED.LOCK_LOADS", 0x21d0, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.MACRO_FUSED", 0x4c2, 4, 0, false, 0x0, true},
+        {"BACLEARS.ANY", 0x1fe6, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.SPLIT_STORES", 0x42d0, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.X87", 0x10b1, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", 0x20c7, 4, 0, false, 0x0, true},
+        {"IDQ.MS_UOPS", 0x3079, 4, 0, false, 0x0, true},
+        {"ROB_MISC_EVENTS.PAUSE_INST", 0x40cc, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L2_HIT", 0x2d1, 4, 0, false, 0x0, true},
+        {"LSD.CYCLES_4_UOPS", 0x40001a8, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NOT_TAKEN", 0x10c4, 4, 0, false, 0x0, true},
+        {"IDQ.ALL_MITE_CYCLES_ANY_UOPS", 0x1002479, 4, 0, false, 0x0, true},
+        {"ICACHE_64B.IFTAG_STALL", 0x483, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.ANY:c1", 0x100010e, 4, 0, false, 0x0, true},
+        {"LSD.UOPS", 0x1a8, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_MEM_ANY", 0x140014a3, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.STLB_HIT:c1", 0x1002008, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED_PORT.PORT_2", 0x4a1, 4, 0, false, 0x0, true},
+        {"IDQ.MS_SWITCHES", 0x1043079, 4, 0, false, 0x0, true},
+        {"MACHINE_CLEARS.COUNT", 0x10401c3, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM", 0x4d2, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.STLB_HIT:c1", 0x1002049, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE_CYCLES_GE_1", 0x10002b1, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.DEMAND_DATA_RD_MISS", 0x2124, 4, 0, false, 0x0, true},
+};
+constexpr int32_t kDisp[] = {
+        0, -128, -126, 1, -125, 0, 1, 0, -123, 2,
+        -122, -120, 0, 0, 0, 2, 0, -118, -117, 1,
+        -115, 0, -111, -110, -108, -106, 3, 0, 1, 0,
+        0, 0, -105, 0, -104, 0, -102, 0, -101, -100,
+        2, 2, 3, -98, 2, 0, -94, 5, -93, 2,
+        0, 0, 1, 0, -91, 1, 0, -88, 7, -87,
+        0, -85, 0, 1, -82, 1, -79, 1, -78, 0,
+        -77, 1, -73, 0, -71, 1, -66, 0, 1, 0,
+        0, -65, 0, -63, 0, 3, 0, -60, -59, 0,
+        -56, 0, 0, -54, 1, -50, 0, -46, 0, -38,
+        0, 5, -35, -33, -31, 5, -30, 8, -29, 0,
+        0, 9, 0, 0, 0, -27, 0, 0, -25, -21,
+        -19, 0, -16, 1, -15, -9, 2, 5, -7, -6,
+        -4, 0, -3,
+};
+constexpr size_t find(const char* name) {
+    return catalog_find(kEvents, kDisp, name);
+}
+}  // namespace skl_client_events
+}  // namespace tma
+}  // namespace mperf
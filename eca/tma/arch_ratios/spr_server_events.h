@@ -0,0 +1,221 @@
+/**
+ * \file eca/tma/arch_ratios/spr_server_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+// generated by gen_event_catalog.py, do not edit
+#pragma once
+#include "event_catalog.h"
+
+namespace mperf {
+namespace tma {
+namespace spr_server_events {
+constexpr CatalogEvent kEvents[] = {
+        {"UOPS_ISSUED.ANY:c1", 0x10001ae, 4, 0, false, 0x0, true},
+        {"INT_MISC.UOP_DROPPING", 0x10ad, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING", 0x148, 4, 0, false, 0x0, true},
+        {"MEM_UOP_RETIRED.ANY", 0x3e5, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_MISS_RETIRED.REMOTE_FWD", 0x8d3, 4, 0, false, 0x0, true},
+        {"OCR.DEMAND_RFO.L3_HIT.SNOOP_HITM", 0x12a, 4, 0, false, 0x10003c0002, true},
+        {"CYCLE_ACTIVITY.CYCLES_MEM_ANY", 0x100010a3, 4, 0, false, 0x0, true},
+        {"MEMORY_ACTIVITY.STALLS_L3_MISS", 0x9000947, 4, 0, false, 0x0, true},
+        {"ICACHE_DATA.STALLS", 0x480, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.128B_PACKED_SINGLE", 0x8c7, 4, 0, false, 0x0, true},
+        {"INT_VEC_RETIRED.VNNI_128", 0x10e7, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_DISTRIBUTED", 0x83c, 4, 0, false, 0x0, true},
+        {"INST_DECODED.DECODERS:c2", 0x2000175, 4, 0, false, 0x0, true},
+        {"MEMORY_ACTIVITY.STALLS_L1D_MISS", 0x3000347, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.REF_TSC", 0x300, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.LOCAL_PMM", 0x80d1, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.REP_ITERATION", 0x8c0, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.SCALAR_DOUBLE", 0x1c7, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.THREAD:c1", 0x10001b1, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.STLB_HIT:c1", 0x1002013, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.ALL_RFO", 0xe224, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_MISS_RETIRED.REMOTE_DRAM", 0x2d3, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.RFO_HIT", 0xc224, 4, 0, false, 0x0, true},
+        {"INT_VEC_RETIRED.ADD_256", 0xce7, 4, 0, false, 0x0, true},
+        {"OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HITM", 0x12a, 4, 0, false, 0x10003c0001, true},
+        {"AMX_OPS_RETIRED.BF16:c1", 0x10002ce, 4, 0, false, 0x0, true},
+        {"INT_VEC_RETIRED.ADD_128", 0x3e7, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.RETIRING", 0x8000, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.THREAD", 0x1b1, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.HEAVY", 0x1c2, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD", 0x3c, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.BOUND_ON_LOADS", 0x50021a6, 4, 0, false, 0x0, true},
+        {"TOPDOWN.MEMORY_BOUND_SLOTS", 0x10a4, 4, 0, false, 0x0, true},
+        {"XQ.FULL_CYCLES", 0x100012d, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.PENALTY_CYCLES", 0x261, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_CYCLES_OK", 0x6000479, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.L2_STALLS", 0x448, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.STLB_HIT:c1", 0x1002012, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY", 0xc0, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.THREAD_P:SUP", 0x3c, 4, 1, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.512B_PACKED_DOUBLE", 0x40c7, 4, 0, false, 0x0, true},
+        {"INT_VEC_RETIRED.SHUFFLES", 0x40e7, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.REFERENCES", 0xff24, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.2_PORTS_UTIL", 0x4a6, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_CYCLES_OK", 0x6000879, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ALL_STORES", 0x82d0, 4, 0, false, 0x0, true},
+        {"LONGEST_LAT_CACHE.MISS", 0x412e, 4, 0, false, 0x0, true},
+        {"INT_MISC.UNKNOWN_BRANCH_CYCLES", 0x0, 4, 0, false, 0x0, false},
+        {"MEM_LOAD_RETIRED.FB_HIT", 0x40d1, 4, 0, false, 0x0, true},
+        {"ICACHE_TAG.STALLS", 0x483, 4, 0, false, 0x0, true},
+        {"FRONTEND_RETIRED.ANY_DSB_MISS", 0x0, 4, 0, false, 0x0, false},
+        {"BR_INST_RETIRED.COND_NTAKEN", 0x10c4, 4, 0, false, 0x0, true},
+        {"FP_ARITH_DISPATCHED.PORT_1", 0x2b3, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DATA_RD", 0x1000820, 4, 0, false, 0x0, true},
+        {"UOPS_ISSUED.ANY", 0x1ae, 4, 0, false, 0x0, true},
+        {"TOPDOWN.BR_MISPREDICT_SLOTS", 0x8a4, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_2_3_10", 0x4b2, 4, 0, false, 0x0, true},
+        {"IDQ.MS_UOPS", 0x3079, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L2_MISS", 0x10d1, 4, 0, false, 0x0, true},
+        {"ASSISTS.SSE_AVX_MIX", 0x10c1, 4, 0, false, 0x0, true},
+        {"L2_LINES_OUT.SILENT", 0x126, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.256B_PACKED_SINGLE", 0x20c7, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.ALL_BRANCHES", 0xc4, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_TAKEN", 0x20c4, 4, 0, false, 0x0, true},
+        {"FP_ARITH_DISPATCHED.PORT_5", 0x4b3, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CORE", 0x19c, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.BAD_SPECULATION", 0x8100, 4, 0, false, 0x0, true},
+        {"ASSISTS.ANY:u0x1B", 0x1bc1, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.ALL_DEMAND_DATA_RD", 0xe124, 4, 0, false, 0x0, true},
+        {"DTLB_STORE_MISSES.WALK_PENDING", 0x1013, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.PENDING_CYCLES", 0x1000148, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.CYCLES_WITH_DEMAND_RFO", 0x1000420, 4, 0, false, 0x0, true},
+        {"ITLB_MISSES.WALK_PENDING", 0x1011, 4, 0, false, 0x0, true},
+        {"AMX_OPS_RETIRED.BF16", 0x2ce, 4, 0, false, 0x0, true},
+        {"AMX_OPS_RETIRED.INT8:c1", 0x10001ce, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.BACKEND_BOUND", 0x8300, 4, 0, false, 0x0, true},
+        {"AMX_OPS_RETIRED.INT8", 0x1ce, 4, 0, false, 0x0, true},
+        {"L2_LINES_OUT.NON_SILENT", 0x226, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_NO_FWD", 0x2d2, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.512B_PACKED_SINGLE", 0x80c7, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_UOPS", 0x879, 4, 0, false, 0x0, true},
+        {"DSB2MITE_SWITCHES.PENALTY_CYCLES:c1:e1", 0x1040261, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED2.SCALAR_HALF", 0x1cf, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_MISS_RETIRED.REMOTE_PMM", 0x10d3, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.BRANCH_MISPREDICTS", 0x8500, 4, 0, false, 0x0, true},
+        {"INT_MISC.CLEAR_RESTEER_CYCLES", 0x80ad, 4, 0, false, 0x0, true},
+        {"TOPDOWN.SLOTS", 0x400, 4, 0, false, 0x0, true},
+        {"ARITH.DIVIDER_ACTIVE", 0x10009b0, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.COND_TAKEN", 0x1c4, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.SLOTS", 0x2c2, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.ALL_LOADS", 0x81d0, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_MISS_RETIRED.LOCAL_DRAM", 0x1d3, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.LOCK_LOADS", 0x21d0, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS.ALL_REQUESTS", 0x8021, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.FAR_BRANCH:USER", 0x40c4, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_UOPS", 0x479, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED2.256B_PACKED_HALF", 0x8cf, 4, 0, false, 0x0, true},
+        {"ASSISTS.PAGE_FAULT", 0x8c1, 4, 0, false, 0x0, true},
+        {"UOPS_RETIRED.SLOTS:c1", 0x10002c2, 4, 0, false, 0x0, true},
+        {"L1D.REPLACEMENT", 0x151, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.NO_SR", 0x8803, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.HEAVY_OPERATIONS", 0x8400, 4, 0, false, 0x0, true},
+        {"L2_LINES_IN.ALL", 0x1f25, 4, 0, false, 0x0, true},
+        {"OFFCORE_REQUESTS_OUTSTANDING.ALL_DATA_RD:c4", 0x4000820, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.PAUSE", 0x40ec, 4, 0, false, 0x0, true},
+        {"BR_MISP_RETIRED.ALL_BRANCHES", 0xc5, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_COMPLETED.L1_MISS_ANY", 0xfd43, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.WALK_ACTIVE", 0x1001012, 4, 0, false, 0x0, true},
+        {"MISC2_RETIRED.LFENCE", 0x20e0, 4, 0, false, 0x0, true},
+        {"LD_BLOCKS.STORE_FORWARD", 0x8203, 4, 0, false, 0x0, true},
+        {"TOPDOWN.BACKEND_BOUND_SLOTS", 0x2a4, 4, 0, false, 0x0, true},
+        {"OCR.STREAMING_WR.ANY_RESPONSE", 0x12a, 4, 0, false, 0x10800, true},
+        {"DTLB_STORE_MISSES.WALK_ACTIVE", 0x1001013, 4, 0, false, 0x0, true},
+        {"CYCLE_ACTIVITY.STALLS_TOTAL", 0x40004a3, 4, 0, false, 0x0, true},
+        {"MEM_INST_RETIRED.SPLIT_STORES", 0x42d0, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.DEMAND_DATA_RD_MISS", 0x2124, 4, 0, false, 0x0, true},
+        {"DECODE.LCP", 0x187, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.DISTRIBUTED", 0x2ec, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.FRONTEND_BOUND", 0x8200, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_MISS", 0x1d2, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED2.VECTOR", 0x1ccf, 4, 0, false, 0x0, true},
+        {"INT_VEC_RETIRED.VNNI_256", 0x20e7, 4, 0, false, 0x0, true},
+        {"MEM_STORE_RETIRED.L2_HIT", 0x144, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L1_MISS", 0x8d1, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.X87", 0x10b1, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.3_PORTS_UTIL:u0x80", 0x80a6, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.NOP", 0x2c0, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.MACRO_FUSED", 0x10c0, 4, 0, false, 0x0, true},
+        {"IDQ.MITE_CYCLES_ANY", 0x1000479, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_HIT_RETIRED.XSNP_FWD", 0x4d2, 4, 0, false, 0x0, true},
+        {"DTLB_LOAD_MISSES.WALK_PENDING", 0x1012, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_5_11", 0x20b2, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_7_8", 0x80b2, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.SCALAR_SINGLE", 0x2c7, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CORE_CYCLES_GE_1", 0x10002b1, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED2.COMPLEX_SCALAR_HALF", 0x2cf, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.DEMAND_DATA_RD_HIT", 0xc124, 4, 0, false, 0x0, true},
+        {"IDQ_UOPS_NOT_DELIVERED.CYCLES_0_UOPS_DELIV.CORE", 0x600019c, 4, 0, false, 0x0, true},
+        {"INST_RETIRED.ANY_P:SUP", 0xc0, 4, 1, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L3_MISS", 0x20d1, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_0", 0x1b2, 4, 0, false, 0x0, true},
+        {"INT_VEC_RETIRED.MUL_256", 0x80e7, 4, 0, false, 0x0, true},
+        {"FP_ARITH_DISPATCHED.PORT_0", 0x1b3, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE", 0x10c7, 4, 0, false, 0x0, true},
+        {"ASSISTS.FP", 0x2c1, 4, 0, false, 0x0, true},
+        {"L2_RQSTS.MISS", 0x3f24, 4, 0, false, 0x0, true},
+        {"MEMORY_ACTIVITY.CYCLES_L1D_MISS", 0x2000247, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED2.128B_PACKED_HALF", 0x4cf, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.2_PORTS_UTIL:u0xc", 0xca6, 4, 0, false, 0x0, true},
+        {"L1D_PEND_MISS.FB_FULL", 0x248, 4, 0, false, 0x0, true},
+        {"CPU_CLK_UNHALTED.ONE_THREAD_ACTIVE", 0x23c, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_L3_MISS_RETIRED.REMOTE_HITM", 0x4d3, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.BOUND_ON_STORES", 0x20040a6, 4, 0, false, 0x0, true},
+        {"TOPDOWN.SLOTS:percore", 0x0, 4, 0, false, 0x0, false},
+        {"UOPS_DISPATCHED.PORT_4_9", 0x10b2, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_1", 0x2b2, 4, 0, false, 0x0, true},
+        {"UOPS_DISPATCHED.PORT_6", 0x40b2, 4, 0, false, 0x0, true},
+        {"SW_PREFETCH_ACCESS.T0:uF", 0xf40, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE", 0x4c7, 4, 0, false, 0x0, true},
+        {"INST_DECODED.DECODERS:c1", 0x1000175, 4, 0, false, 0x0, true},
+        {"MEM_LOAD_RETIRED.L3_HIT", 0x4d1, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.MEMORY_BOUND", 0x8700, 4, 0, false, 0x0, true},
+        {"EXE_ACTIVITY.1_PORTS_UTIL", 0x2a6, 4, 0, false, 0x0, true},
+        {"MEMORY_ACTIVITY.STALLS_L2_MISS", 0x5000547, 4, 0, false, 0x0, true},
+        {"IDQ.MS_SWITCHES", 0x1043079, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED2.512B_PACKED_HALF", 0x10cf, 4, 0, false, 0x0, true},
+        {"OCR.DEMAND_DATA_RD.L3_HIT.SNOOP_HIT_WITH_FWD", 0x12a, 4, 0, false, 0x8003c0001, true},
+        {"UOPS_RETIRED.MS", 0x4c2, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_RETURN", 0x8c4, 4, 0, false, 0x0, true},
+        {"PERF_METRICS.FETCH_LATENCY", 0x8600, 4, 0, false, 0x0, true},
+        {"INT_MISC.MBA_STALLS", 0x20ad, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.NEAR_CALL", 0x2c4, 4, 0, false, 0x0, true},
+        {"FP_ARITH_INST_RETIRED2.SCALAR", 0x3cf, 4, 0, false, 0x0, true},
+        {"EXE.AMX_BUSY", 0x2b7, 4, 0, false, 0x0, true},
+        {"UOPS_EXECUTED.CYCLES_GE_3", 0x30001b1, 4, 0, false, 0x0, true},
+        {"RESOURCE_STALLS.SCOREBOARD", 0x2a2, 4, 0, false, 0x0, true},
+        {"IDQ.DSB_CYCLES_ANY", 0x1000879, 4, 0, false, 0x0, true},
+        {"BR_INST_RETIRED.COND", 0x11c4, 4, 0, false, 0x0, true},
+};
+constexpr int32_t kDisp[] = {
+        1, 0, 0, 0, -178, 0, 1, 0, 1, -177,
+        1, -169, -168, 1, 0, 0, 0, 0, 4, 1,
+        -166, 0, -163, 2, -162, 0, -161, 3, 0, -160,
+        1, -159, 1, 0, 0, 2, -155, -154, -153, 0,
+        1, -145, -141, 1, 0, -140, -139, 5, 1, 3,
+        -138, 2, -136, 1, -132, 3, -130, -129, -127, 4,
+        1, -126, 1, 9, 0, -124, -123, -112, 0, -108,
+        -100, -99, 0, 1, 0, 1, 1, -95, -94, 0,
+        0, 0, -92, 0, 0, -90, 0, 0, -89, -87,
+        6, -82, 0, 6, -79, -76, 0, -75, -71, -70,
+        0, -68, 0, 1, 2, 1, 0, -67, 0, 0,
+        3, -66, -62, -61, 0, 0, 0, -56, -55, 0,
+        13, -53, 0, 0, -52, 4, 0, 6, 5, 0,
+        -51, 0, 0, 0, -50, -49, 0, -43, 0, 0,
+        1, -40, 0, 0, 1, -39, -29, 11, 0, 0,
+        -27, -26, -24, 5, -23, 2, 0, 0, 0, 0,
+        6, -22, 0, 0, -19, 0, 1, -18, -14, -12,
+        -9, 0, 0, 3, -8, 5, -5, 1,
+};
+constexpr size_t find(const char* name) {
+    return catalog_find(kEvents, kDisp, name);
+}
+}  // namespace spr_server_events
+}  // namespace tma
+}  // namespace mperf
@@ -0,0 +1,207 @@
+/**
+ * \file eca/tma/group_scheduler.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "group_scheduler.h"
+#include <algorithm>
+#include "mperf/utils.h"
+
+namespace mperf {
+namespace tma {
+
+bool GroupScheduler::is_fixed(const EventAttr& ev) const {
+    for (auto& fev : m_constraints.fixed_events) {
+        if (fev.config == ev.config && fev.type == ev.type &&
+            fev.config1 == ev.config1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GroupScheduler::is_free(const EventAttr& ev) const {
+    for (auto& fev : m_constraints.free_events) {
+        // the type is the one of the core pmu the session is bound to
+        if (fev.config == ev.config) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t GroupScheduler::gp_cost(const std::set<EventAttr>& events) const {
+    size_t cost = 0;
+    std::set<uint64_t> used_fixed;
+    for (auto& ev : events) {
+        if (is_free(ev)) {
+            continue;
+        }
+        // the second event of a fixed counter falls back to a gp counter
+        if (is_fixed(ev) && used_fixed.insert(ev.config).second) {
+            continue;
+        }
+        ++cost;
+    }
+    return cost;
+}
+
+bool GroupScheduler::fits(const std::set<EventAttr>& events) const {
+    if (gp_cost(events) > m_constraints.gp_num) {
+        return false;
+    }
+    std::set<int> used_restricted;
+    for (auto& ev : events) {
+        auto it = m_constraints.restricted_events.find(ev.config & 0xffff);
+        if (it != m_constraints.restricted_events.end() &&
+            !used_restricted.insert(it->second).second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::vector<EventAttr>> GroupScheduler::schedule(
+        const std::vector<std::string>& metric_names,
+        const std::vector<std::set<EventAttr>>& metric_events,
+        std::vector<size_t>& metric_groups) const {
+    const EventAttr& anchor = m_constraints.anchor;
+    const bool has_anchor = !anchor.name.empty();
+    std::set<EventAttr> empty_group;
+    if (has_anchor) {
+        empty_group.insert(anchor);
+    }
+
+    // place the metrics that need the most counters first, the smaller ones
+    // fill the space left in their groups.
+    size_t mz = metric_events.size();
+    std::vector<size_t> cost(mz);
+    std::vector<size_t> order(mz);
+    std::vector<std::set<EventAttr>> led_events(metric_events);
+    for (size_t i = 0; i < mz; ++i) {
+        // the free events bring their leader along
+        for (auto& ev : metric_events[i]) {
+            if (is_free(ev)) {
+                led_events[i].insert(m_constraints.leader);
+                break;
+            }
+        }
+        std::set<EventAttr> evs = led_events[i];
+        evs.insert(empty_group.begin(), empty_group.end());
+        cost[i] = gp_cost(evs);
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return cost[a] > cost[b]; });
+
+    std::vector<std::set<EventAttr>> groups;
+    metric_groups.assign(mz, 0);
+    for (size_t i : order) {
+        const std::set<EventAttr>& evs = led_events[i];
+        if (evs.empty()) {
+            continue;
+        }
+        // best fit: the group that needs the fewest additional counters, the
+        // fuller one on a tie.
+        size_t best = groups.size();
+        size_t best_added = 0, best_cost = 0;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            std::set<EventAttr> merged = groups[g];
+            merged.insert(evs.begin(), evs.end());
+            if (!fits(merged)) {
+                continue;
+            }
+            size_t gcost = gp_cost(groups[g]);
+            size_t added = gp_cost(merged) - gcost;
+            if (best == groups.size() || added < best_added ||
+                (added == best_added && gcost > best_cost)) {
+                best = g;
+                best_added = added;
+                best_cost = gcost;
+            }
+        }
+        if (best != groups.size()) {
+            groups[best].insert(evs.begin(), evs.end());
+            metric_groups[i] = best;
+            continue;
+        }
+
+        std::set<EventAttr> merged = empty_group;
+        merged.insert(evs.begin(), evs.end());
+        if (fits(merged)) {
+            metric_groups[i] = groups.size();
+            groups.push_back(merged);
+            continue;
+        }
+        // the metric needs more counters than a group has, so its events
+        // have to be counted in several runs anyway: reuse the events
+        // already counted, and fill the free counters of the groups first.
+        size_t old_num = groups.size();
+        for (auto& ev : evs) {
+            // a free event goes with its leader
+            std::set<EventAttr> unit = {ev};
+            if (is_free(ev)) {
+                unit.insert(m_constraints.leader);
+            }
+            bool placed = false;
+            for (size_t g = 0; g < groups.size() && !placed; ++g) {
+                placed = std::includes(groups[g].begin(), groups[g].end(),
+                                       unit.begin(), unit.end());
+            }
+            for (size_t g = 0; g < groups.size() && !placed; ++g) {
+                std::set<EventAttr> next = groups[g];
+                next.insert(unit.begin(), unit.end());
+                if (fits(next)) {
+                    groups[g] = next;
+                    placed = true;
+                }
+            }
+            if (!placed) {
+                groups.push_back(empty_group);
+                groups.back().insert(unit.begin(), unit.end());
+            }
+        }
+        size_t most = 0;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            size_t n = 0;
+            for (auto& ev : evs) {
+                n += groups[g].count(ev);
+            }
+            if (n > most) {
+                most = n;
+                metric_groups[i] = g;
+            }
+        }
+        mperf_log_warn(
+                "the events of metric(%s) can not be counted in one group, "
+                "%zu new groups are added for it.\n",
+                metric_names[i].c_str(), groups.size() - old_num);
+    }
+
+    std::vector<std::vector<EventAttr>> res(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        res[g].assign(groups[g].begin(), groups[g].end());
+        lead(res[g]);
+    }
+    return res;
+}
+
+void GroupScheduler::lead(std::vector<EventAttr>& group) const {
+    const std::string& leader = m_constraints.leader.name;
+    if (leader.empty()) {
+        return;
+    }
+    // the first event opened leads the kernel group
+    auto it = std::find_if(
+            group.begin(), group.end(),
+            [&](const EventAttr& ev) { return ev.name == leader; });
+    if (it != group.end()) {
+        std::rotate(group.begin(), it, it + 1);
+    }
+}
+
+}  // namespace tma
+}  // namespace mperf
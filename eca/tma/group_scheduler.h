@@ -0,0 +1,71 @@
+/**
+ * \file eca/tma/group_scheduler.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "mperf/pmu_types.h"
+
+namespace mperf {
+namespace tma {
+
+// The pmu constraints that decide which events can be counted in one group.
+struct CounterConstraints {
+    // the number of general purpose counters available to a group
+    size_t gp_num = 0;
+    // the events that have a dedicated fixed counter, matched by the whole
+    // config, so that the events with cmask/inv/edge set always take a
+    // general purpose counter. Each fixed counter holds one event per group.
+    std::vector<EventAttr> fixed_events;
+    // the events(event select and umask, the low 16 bits of config) that can
+    // only be counted on the given general purpose counter.
+    std::map<uint64_t, int> restricted_events;
+    // the event added to every group, used to relate the groups to each
+    // other, e.g. the cycles.
+    EventAttr anchor;
+    // the events read without a counter of their own, which have to be in
+    // the group led by the leader, e.g. the PERF_METRICS events led by
+    // TOPDOWN.SLOTS on icelake and later.
+    std::vector<EventAttr> free_events;
+    EventAttr leader;
+};
+
+// Packs the events the metrics depend on into as few groups(workload runs) as
+// possible. The events of a metric are kept in one group whenever they fit,
+// so every ratio is computed from the counts of a single run.
+class GroupScheduler {
+public:
+    explicit GroupScheduler(const CounterConstraints& constraints)
+            : m_constraints(constraints) {}
+
+    // metric_events[i] is the event set of the i-th metric. Returns the event
+    // groups, and the group each metric has to be evaluated from in
+    // metric_groups.
+    std::vector<std::vector<EventAttr>> schedule(
+            const std::vector<std::string>& metric_names,
+            const std::vector<std::set<EventAttr>>& metric_events,
+            std::vector<size_t>& metric_groups) const;
+    // move the leader of the constraints to the front of the group, if the
+    // group has it.
+    void lead(std::vector<EventAttr>& group) const;
+
+private:
+    bool is_fixed(const EventAttr& ev) const;
+    bool is_free(const EventAttr& ev) const;
+    // the number of general purpose counters the events take
+    size_t gp_cost(const std::set<EventAttr>& events) const;
+    bool fits(const std::set<EventAttr>& events) const;
+
+    const CounterConstraints& m_constraints;
+};
+
+}  // namespace tma
+}  // namespace mperf
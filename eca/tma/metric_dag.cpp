@@ -0,0 +1,213 @@
+/**
+ * \file eca/tma/metric_dag.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "metric_dag.h"
+#include <math.h>
+#include <algorithm>
+#include "mperf/exception.h"
+
+namespace mperf {
+namespace tma {
+
+constexpr size_t MetricDag::npos;
+
+void MetricDag::begin_trace(const CollectFunc& collect) {
+    m_tracing = true;
+    m_stack.clear();
+    m_collect = collect;
+}
+
+size_t MetricDag::trace(MetricCompute func) {
+    m_next = npos;
+    func(FEV(this));
+    return find(func);
+}
+
+void MetricDag::end_trace() {
+    m_tracing = false;
+    m_collect = nullptr;
+    m_vals.assign(m_nodes.size(), 0);
+    m_threshs.assign(m_nodes.size(), false);
+    m_epochs.assign(m_nodes.size(), 0);
+    m_needed.assign(m_nodes.size(), 0);
+}
+
+size_t MetricDag::add_event(const EventAttr& attr) {
+    auto it = m_slot_index.find(attr.name);
+    if (it != m_slot_index.end()) {
+        return it->second;
+    }
+    size_t slot = m_events.size();
+    m_events.push_back(attr);
+    m_slot_index.emplace(attr.name, slot);
+    return slot;
+}
+
+float MetricDag::collect(const CatalogEvent& ev, int level) {
+    size_t slot = m_collect(ev, level);
+    m_catalog_slots[&ev - m_catalog] = slot;
+    if (!m_stack.empty()) {
+        auto& slots = m_nodes[m_stack.back()].slots;
+        if (std::find(slots.begin(), slots.end(), slot) == slots.end()) {
+            slots.push_back(slot);
+        }
+    }
+    return 1;
+}
+
+float MetricDag::not_found(const CatalogEvent& ev) const {
+    // the uncore events are not sampled in interval mode, and a record may
+    // not hold the events of the metrics added later
+    if (m_lenient) {
+        return NAN;
+    }
+    mperf_throw(MperfError,
+                "Internal Error. No execution result of event(%s) was found.",
+                ev.name);
+    return 0;
+}
+
+std::vector<size_t> MetricDag::node_slots(size_t id) const {
+    std::vector<size_t> slots;
+    std::vector<bool> seen(m_nodes.size(), false);
+    std::vector<size_t> pending = {id};
+    seen[id] = true;
+    while (!pending.empty()) {
+        const Node& node = m_nodes[pending.back()];
+        pending.pop_back();
+        slots.insert(slots.end(), node.slots.begin(), node.slots.end());
+        for (size_t child : node.children) {
+            if (!seen[child]) {
+                seen[child] = true;
+                pending.push_back(child);
+            }
+        }
+    }
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    return slots;
+}
+
+void MetricDag::begin_eval(const float* values, const float* merged,
+                           bool lenient) {
+    m_values = values;
+    m_merged = merged;
+    m_lenient = lenient;
+    m_stack.clear();
+    ++m_epoch;
+}
+
+void MetricDag::evaluate(const std::vector<size_t>& ids) {
+    // mark the nodes the metrics refer to, then compute them children first,
+    // so a formula finds the metrics it refers to computed
+    m_pending.clear();
+    for (size_t id : ids) {
+        if (id != npos && m_needed[id] != m_epoch) {
+            m_needed[id] = m_epoch;
+            m_pending.push_back(id);
+        }
+    }
+    while (!m_pending.empty()) {
+        size_t id = m_pending.back();
+        m_pending.pop_back();
+        for (size_t child : m_nodes[id].children) {
+            if (m_needed[child] != m_epoch) {
+                m_needed[child] = m_epoch;
+                m_pending.push_back(child);
+            }
+        }
+    }
+    for (size_t id : m_order) {
+        if (m_needed[id] == m_epoch && m_epochs[id] != m_epoch) {
+            m_next = id;
+            m_nodes[id].func(FEV(this));
+        }
+    }
+    m_next = npos;
+}
+
+size_t MetricDag::find(MetricCompute func) const {
+    // a child of the node being computed, or the node evaluate computes
+    if (!m_stack.empty() && m_stack.back() != npos) {
+        for (size_t child : m_nodes[m_stack.back()].children) {
+            if (m_nodes[child].func == func) {
+                return child;
+            }
+        }
+    } else if (m_next != npos && m_nodes[m_next].func == func) {
+        return m_next;
+    }
+    // e.g. a formula taking a branch it did not take while tracing
+    auto it = m_node_index.find(reinterpret_cast<const void*>(func));
+    return it == m_node_index.end() ? npos : it->second;
+}
+
+size_t MetricDag::enter(MetricCompute func, bool& hit, float& val,
+                        bool& thresh) {
+    hit = false;
+    size_t id = find(func);
+    if (!m_tracing) {
+        // a node not met while tracing is not memoized
+        if (id != npos && m_epochs[id] == m_epoch) {
+            hit = true;
+            val = m_vals[id];
+            thresh = m_threshs[id];
+            return id;
+        }
+        m_stack.push_back(id);
+        return id;
+    }
+
+    if (id == npos) {
+        id = m_nodes.size();
+        m_nodes.push_back({func, {}, {}});
+        m_node_index.emplace(reinterpret_cast<const void*>(func), id);
+        m_ordered.push_back(false);
+    }
+    if (!m_stack.empty()) {
+        auto& children = m_nodes[m_stack.back()].children;
+        if (std::find(children.begin(), children.end(), id) ==
+            children.end()) {
+            children.push_back(id);
+        }
+    }
+    m_stack.push_back(id);
+    return id;
+}
+
+void MetricDag::leave(size_t id, float val, bool thresh) {
+    if (!m_stack.empty()) {
+        m_stack.pop_back();
+    }
+    if (m_tracing) {
+        // the children leave first, so the order is topological
+        if (!m_ordered[id]) {
+            m_ordered[id] = true;
+            m_order.push_back(id);
+        }
+        return;
+    }
+    if (id == npos) {
+        return;
+    }
+    m_vals[id] = val;
+    m_threshs[id] = thresh;
+    m_epochs[id] = m_epoch;
+}
+
+bool MetricDag::thresh(const void* func) const {
+    auto it = m_node_index.find(func);
+    if (it == m_node_index.end() || it->second >= m_epochs.size() ||
+        m_epochs[it->second] == 0) {
+        return false;
+    }
+    return m_threshs[it->second];
+}
+
+}  // namespace tma
+}  // namespace mperf
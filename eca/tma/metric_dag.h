@@ -0,0 +1,183 @@
+/**
+ * \file eca/tma/metric_dag.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "arch_ratios/event_catalog.h"
+#include "mperf/pmu_types.h"
+#include "mperf/utils.h"
+
+namespace mperf {
+namespace tma {
+
+class MetricDag;
+
+// the values not sampled are NAN, which std::isnan does not tell under the
+// -Ofast of the release builds
+inline bool not_sampled(float val) {
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    return (bits & 0x7fffffff) > 0x7f800000;
+}
+
+// The events of the session a formula is computed in, e.g.
+// EV(CEV("CPU_CYCLES"), level). It is a handle of the MetricDag of the
+// session, which holds the values and the threshs of the metrics, so the
+// sessions share no state.
+class FEV {
+public:
+    explicit FEV(MetricDag* dag) : m_dag(dag) {}
+    inline float operator()(const CatalogEvent& ev, int level) const;
+    MetricDag* dag() const { return m_dag; }
+
+private:
+    MetricDag* m_dag;
+};
+
+// the compute of a generated metric
+typedef float (*MetricCompute)(FEV EV);
+
+// The metric set compiled into a DAG: the nodes are the compute functions of
+// the generated metrics, the leaves are the events resolved to dense slots.
+// The DAG is traced once when the metrics collect their events, which
+// resolves every EV call site(an event of the catalog of the cpu) to its
+// slot, and orders the nodes children first. An evaluation computes the
+// nodes the metrics need in that order, so the parent metrics a formula
+// refers to(e.g. Bad_Speculation refers to Frontend_Bound, Backend_Bound and
+// Retiring) are known before, and reads the events by their catalog index.
+class MetricDag {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    struct Node {
+        MetricCompute func;
+        std::vector<size_t> children;
+        // the slots of the events the node reads itself
+        std::vector<size_t> slots;
+    };
+
+    // collect an event of the formulas while tracing, returns its slot(cf.
+    // add_event)
+    typedef std::function<size_t(const EventAttr&, int)> CollectFunc;
+
+    // the catalog of the cpu the EV call sites are resolved by, set before
+    // tracing
+    void set_catalog(const CatalogEvent* events, size_t num) {
+        m_catalog = events;
+        m_catalog_slots.assign(num, npos);
+    }
+
+    // record the nodes and the events of the metrics traced until end_trace
+    void begin_trace(const CollectFunc& collect);
+    // trace the compute of a metric, returns its node
+    size_t trace(MetricCompute func);
+    void end_trace();
+
+    // the slot of the event, it is allocated while tracing.
+    size_t add_event(const EventAttr& attr);
+    size_t slot(const std::string& name) const {
+        auto it = m_slot_index.find(name);
+        return it == m_slot_index.end() ? npos : it->second;
+    }
+    size_t num_slots() const { return m_events.size(); }
+    const EventAttr& event(size_t slot) const { return m_events[slot]; }
+    // the slots of the events of the node and of the nodes it refers to
+    std::vector<size_t> node_slots(size_t id) const;
+
+    size_t num_nodes() const { return m_nodes.size(); }
+    const Node& node(size_t id) const { return m_nodes[id]; }
+
+    // Start an evaluation on the values of the slots, the events not sampled
+    // in values are taken from merged. An event sampled in neither is NAN if
+    // lenient(e.g. not in a record), and throws otherwise. The node values of
+    // the last evaluation are dropped.
+    void begin_eval(const float* values, const float* merged, bool lenient);
+    // compute the nodes, and the nodes they refer to
+    void evaluate(const std::vector<size_t>& ids);
+    float value(size_t id) const { return m_vals[id]; }
+
+    float ev(const CatalogEvent& ev, int level) {
+        if (mperf_unlikely(m_tracing)) {
+            return collect(ev, level);
+        }
+        size_t slot = m_catalog_slots[&ev - m_catalog];
+        if (mperf_likely(slot != npos)) {
+            float val = m_values[slot];
+            if (mperf_likely(!not_sampled(val))) {
+                return val;
+            }
+            val = m_merged[slot];
+            if (mperf_likely(!not_sampled(val))) {
+                return val;
+            }
+        }
+        return not_found(ev);
+    }
+
+    // called by MetricMemo around the compute of a metric, enter returns the
+    // node id and sets hit if its value of this evaluation is known.
+    size_t enter(MetricCompute func, bool& hit, float& val, bool& thresh);
+    void leave(size_t id, float val, bool thresh);
+    // the thresh of the node last computed, false if it was never computed
+    bool thresh(const void* func) const;
+
+    // whether the topdown metrics read the fixed TOPDOWN.SLOTS counter and
+    // the PERF_METRICS events(icelake and later), fixed before tracing.
+    void set_topdown_fixed(bool fixed) { m_topdown_fixed = fixed; }
+    bool topdown_fixed() const { return m_topdown_fixed; }
+
+private:
+    float collect(const CatalogEvent& ev, int level);
+    float not_found(const CatalogEvent& ev) const;
+    // the node of a compute met while tracing, npos if none
+    size_t find(MetricCompute func) const;
+
+    std::vector<EventAttr> m_events;
+    std::unordered_map<std::string, size_t> m_slot_index;
+    const CatalogEvent* m_catalog = nullptr;
+    // the slot of every event of the catalog, npos if no formula reads it
+    std::vector<size_t> m_catalog_slots;
+    CollectFunc m_collect;
+
+    std::vector<Node> m_nodes;
+    std::unordered_map<const void*, size_t> m_node_index;
+    // the nodes in topological order, children first
+    std::vector<size_t> m_order;
+    std::vector<bool> m_ordered;
+
+    // the nodes being computed
+    std::vector<size_t> m_stack;
+    // the node evaluate is about to compute
+    size_t m_next = npos;
+    // the node values, valid if the epoch equals the current one, the epoch
+    // 0 means never computed
+    std::vector<float> m_vals;
+    std::vector<bool> m_threshs;
+    std::vector<uint32_t> m_epochs;
+    // the nodes needed by the evaluation of the epoch
+    std::vector<uint32_t> m_needed;
+    std::vector<size_t> m_pending;
+    uint32_t m_epoch = 0;
+    const float* m_values = nullptr;
+    const float* m_merged = nullptr;
+    bool m_lenient = false;
+    bool m_tracing = false;
+    bool m_topdown_fixed = false;
+};
+
+float FEV::operator()(const CatalogEvent& ev, int level) const {
+    return m_dag->ev(ev, level);
+}
+
+}  // namespace tma
+}  // namespace mperf
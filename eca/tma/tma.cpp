@@ -1,16 +1,147 @@
 #include "mperf/tma/tma.h"
+#include <algorithm>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <cmath>
 #include "arch_ratios/arch_ratios.h"
+#include "group_scheduler.h"
+#include "metric_dag.h"
+#include "mperf/cpu_info.h"
 #include "mperf/exception.h"
+#include "mperf/pmu_events.h"
+#include "mperf/trace.h"
 #include "mperf/utils.h"
 #include "mperf/xpmu/xpmu.h"
+#include "x86_events.h"
 namespace mperf {
 namespace tma {
 
-typedef float (*TMACompute)(FEV EV);
+namespace {
+// The records of save_record are traces(cf. mperf/trace.h) with a column
+// per event of the metrics, holding the bits of the double values, NAN if
+// not sampled. A record per group, of the group id as the region, and one
+// of the merged values of kTraceNoRegion, or a record per interval in the
+// interval mode, timestamped by its end. The info text is a line per key:
+//     mperf_tma_record <version>
+//     xpu_type <the name of the MPFXPUType, e.g. SKX_SERVER>
+//     interval_ms <the interval, 0 if not in the interval mode>
+//     metrics <metric>...
+constexpr int kTMARecordVersion = 3;
+
+// the names of the xpu types of the records, the values of MPFXPUType change
+// across the builds
+#define XPU_TYPE_NAME(T) \
+    { T, #T }
+const std::pair<MPFXPUType, const char*> kXPUTypeNames[] = {
+        XPU_TYPE_NAME(DEFAULT),    XPU_TYPE_NAME(SNB_CLIENT),
+        XPU_TYPE_NAME(JKT_SERVER), XPU_TYPE_NAME(IVB_CLIENT),
+        XPU_TYPE_NAME(IVB_SERVER), XPU_TYPE_NAME(HSW_CLIENT),
+        XPU_TYPE_NAME(HSX_SERVER), XPU_TYPE_NAME(BDW_CLIENT),
+        XPU_TYPE_NAME(BDX_SERVER), XPU_TYPE_NAME(SKL_CLIENT),
+        XPU_TYPE_NAME(SKX_SERVER), XPU_TYPE_NAME(CLX_SERVER),
+        XPU_TYPE_NAME(ICL_CLIENT), XPU_TYPE_NAME(ICX_SERVER),
+        XPU_TYPE_NAME(ADL_GLC),    XPU_TYPE_NAME(ADL_GRT),
+        XPU_TYPE_NAME(SPR_SERVER), XPU_TYPE_NAME(A55),
+        XPU_TYPE_NAME(A510),
+};
+#undef XPU_TYPE_NAME
+
+const char* xpu_type_name(MPFXPUType t) {
+    for (auto& it : kXPUTypeNames) {
+        if (it.first == t) {
+            return it.second;
+        }
+    }
+    return "UNKNOWN";
+}
+
+struct TMARecord {
+    // double keeps the counts of the intervals exact
+    typedef std::vector<std::pair<std::string, double>> Values;
+    const std::pair<MPFXPUType, const char*>* xpu_type{nullptr};
+    size_t interval_ms{0};
+    std::vector<std::string> metrics;
+    std::vector<Values> groups;
+    Values merged;
+    std::vector<std::pair<float, Values>> intervals;
+};
+
+// not_sampled of the doubles of a record
+bool not_recorded(uint64_t bits) {
+    return (bits & 0x7fffffffffffffffULL) > 0x7ff0000000000000ULL;
+}
+
+void read_record(const std::string& path, TMARecord& rec) {
+    TraceReader trace(path);
+    int version = 0;
+    for (auto& line : StrSplit(trace.info(), '\n')) {
+        std::vector<std::string> tokens;
+        for (auto& token : StrSplit(line, ' ')) {
+            if (!token.empty()) {
+                tokens.push_back(token);
+            }
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+        const std::string& key = tokens[0];
+        if (key == "mperf_tma_record" && tokens.size() == 2) {
+            version = atoi(tokens[1].c_str());
+        } else if (key == "xpu_type" && tokens.size() == 2) {
+            for (auto& it : kXPUTypeNames) {
+                if (tokens[1] == it.second) {
+                    rec.xpu_type = &it;
+                }
+            }
+            if (!rec.xpu_type) {
+                mperf_throw(MperfError, "%s is of an unknown cpu type %s.\n",
+                            path.c_str(), tokens[1].c_str());
+            }
+        } else if (key == "interval_ms" && tokens.size() == 2) {
+            rec.interval_ms = strtoul(tokens[1].c_str(), nullptr, 10);
+        } else if (key == "metrics") {
+            rec.metrics.assign(tokens.begin() + 1, tokens.end());
+        }
+    }
+    if (version != kTMARecordVersion || !rec.xpu_type) {
+        mperf_throw(MperfError, "%s is not a tma record of version %d.\n",
+                    path.c_str(), kTMARecordVersion);
+    }
+    const auto& events = trace.events();
+    for (size_t b = 0; b < trace.num_blocks(); ++b) {
+        for (size_t i = 0; i < trace.block_size(b); ++i) {
+            TMARecord::Values values;
+            for (size_t k = 0; k < events.size(); ++k) {
+                uint64_t bits = trace.counter(b, k)[i];
+                double val;
+                memcpy(&val, &bits, sizeof(val));
+                if (!not_recorded(bits)) {
+                    values.emplace_back(events[k].name, val);
+                }
+            }
+            uint32_t region = trace.regions(b)[i];
+            if (rec.interval_ms > 0) {
+                rec.intervals.emplace_back(trace.timestamps(b)[i] * 1e-6f,
+                                           std::move(values));
+            } else if (region == kTraceNoRegion) {
+                rec.merged = std::move(values);
+            } else {
+                if (region >= rec.groups.size()) {
+                    rec.groups.resize(region + 1);
+                }
+                rec.groups[region] = std::move(values);
+            }
+        }
+    }
+}
+}  // namespace
+
+constexpr size_t MPFTMA::kAllUncoreEvents;
 
 // collect events
-float MPFTMA::ev_collect(EventAttr attr, int level) {
+size_t MPFTMA::ev_collect(EventAttr attr, int level) {
 #if 0  
     // TODO. Maybe make some modifications to attr in the future.
     auto adjust_ev = [&]() -> int {
@@ -18,68 +149,267 @@ float MPFTMA::ev_collect(EventAttr attr, int level) {
     };
 #endif
 
+    // the events the generator could not encode have config 0, which does
+    // not matter when evaluating a record
+    if (!attr.is_uncore && !m_event_map->resolve(attr) && attr.config == 0 &&
+        !m_offline) {
+        mperf_throw(MperfError,
+                    "the encoding of event(%s) is unknown, load the raw event "
+                    "map of the cpu by load_event_map or "
+                    "MPERF_TMA_EVENT_MAP.\n",
+                    attr.name.c_str());
+    }
+    if (!attr.is_uncore && attr.type == 4) {  // PERF_TYPE_RAW: 4
+        attr.type = m_pmu_type;
+    }
     if (attr.is_uncore) {
         m_uncore_events.insert(attr);
-    } else {
-        if (attr.name.compare("time_interval") != 0) {
-            m_events.insert(attr);
-        }
+    } else if (attr.name.compare("time_interval") != 0) {
+        m_events.insert(attr);
     }
-    return 1;
+    return m_dag->add_event(attr);
 }
 
-// execute formula
-float MPFTMA::ev_query(EventAttr attr, int level) {
-    size_t ss = m_duration.size();
-    for (size_t i = 0; i < ss; ++i) {
-        if (attr.name == m_duration[i].first)
-            return m_duration[i].second;
-    }
-    mperf_throw(MperfError,
-                "Internal Error. No execution result of event(%s) was found.",
-                attr.name.c_str());
-    return 0;
-}
+MPFTMA::MPFTMA(MPFXPUType t) : MPFTMA(t, nullptr) {}
+
+MPFTMA::MPFTMA(const CpuCorePmu& pmu) : MPFTMA(pmu.xpu_type, &pmu) {}
 
-MPFTMA::MPFTMA(MPFXPUType t) {
+MPFTMA::MPFTMA(MPFXPUType t, const CpuCorePmu* pmu) {
+    m_pmu_type = pmu ? pmu->type : 4;  // PERF_TYPE_RAW: 4
+    // detect the micro-architecture of the core the session is created on
+    if (t == DEFAULT && !pmu) {
+        t = cpu_info_xpu_type();
+        mperf_log("the detected cpu type is %d.", t);
+        // the raw events only count on the cores of the pmu they are opened
+        // on, which is the one of the current core on a hybrid system
+        std::vector<CpuCorePmu> pmus = cpu_info_core_pmus();
+        int cpu = sched_getcpu();
+        for (size_t i = 0; pmus.size() > 1 && i < pmus.size(); ++i) {
+            auto& cpus = pmus[i].cpus;
+            if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) {
+                m_pmu_type = pmus[i].type;
+                mperf_log_warn("only the %s cores are counted on the hybrid "
+                               "cpu.\n",
+                               pmus[i].name.c_str());
+            }
+        }
+    }
     m_xpu_type = t;
 
-    m_ratio_setup = ArchRatioSetup::inst(t);
+    m_ratio_setup = new ArchRatioSetup(t);
+    m_event_map = new X86EventMap();
+    if (const char* path = getenv("MPERF_TMA_EVENT_MAP")) {
+        m_event_map->load(path);
+    }
 
     mperf::CpuCounterSet2 cpuset;
     m_xpmu = new XPMU(cpuset);
 
     m_binit = false;
+    m_offline = false;
+    m_multiplex = false;
     m_group_id = -1;
+    m_group_base = 0;
+    m_group_num = 0;
+    m_level = 0;
+    m_drilldown = false;
+    m_dag = nullptr;
+    m_sampler_stop = false;
+    m_sampler_started = false;
+    m_interval_ms = 0;
+    m_per_thread = false;
+    m_subtract_overhead = false;
+    m_overhead_iter_num = 1000;
 }
 
-int MPFTMA::init(std::vector<std::string> metrics) {
-    // collect all events
+MPFTMA::~MPFTMA() {
+    if (m_sampler.joinable()) {
+        stop_interval();
+    }
+    delete m_dag;
+    delete m_xpmu;
+    delete m_event_map;
+    delete m_ratio_setup;
+}
+
+size_t MPFTMA::load_event_map(const std::string& path) {
+    return m_event_map->load(path);
+}
+
+void MPFTMA::collect(const std::vector<std::string>& metrics) {
+    // collect all events, and the events of each metric
     size_t mz = metrics.size();
+    m_metric_events.assign(mz, {});
+    m_metric_nodes.assign(mz, MetricDag::npos);
+    m_dag = new MetricDag();
+    m_dag->set_catalog(m_ratio_setup->catalog(),
+                       m_ratio_setup->catalog_size());
+    // the topdown metrics events have to be grouped with their leader, which
+    // the multiplexed groups can not guarantee.
+    m_dag->set_topdown_fixed(
+            !m_multiplex && !m_ratio_setup->constraints().leader.name.empty());
+    m_dag->begin_trace(std::bind(&MPFTMA::ev_collect, this,
+                                 std::placeholders::_1, std::placeholders::_2));
     for (size_t i = 0; i < mz; ++i) {
         auto pmetric = m_ratio_setup->metric(metrics[i]);
         if (!pmetric) {
             mperf_throw(MperfError, "can not found metirc(%s)\n",
                         metrics[i].c_str());
-        } else {
-            auto fec = std::bind(&MPFTMA::ev_collect, this,
-                                 std::placeholders::_1, std::placeholders::_2);
-            ((TMACompute)(pmetric->func_compute))(fec);
+        }
+        m_metric_nodes[i] =
+                m_dag->trace((MetricCompute)(pmetric->func_compute));
+    }
+    m_dag->end_trace();
+    for (size_t i = 0; i < mz; ++i) {
+        for (size_t slot : m_dag->node_slots(m_metric_nodes[i])) {
+            const EventAttr& attr = m_dag->event(slot);
+            if (m_events.count(attr)) {
+                m_metric_events[i].insert(attr);
+            }
         }
     }
     m_metrics = metrics;
+    m_metric_groups.assign(mz, 0);
+    m_metric_active.assign(mz, false);
+    m_merged_values.assign(m_dag->num_slots(), NAN);
+    m_uncore_events_num = m_uncore_events.size();
+    mperf_log("the initial events num is %zu.", m_events.size());
+}
+
+void MPFTMA::schedule(const std::vector<size_t>& metric_ids) {
+    std::vector<std::string> names;
+    std::vector<std::set<EventAttr>> events;
+    for (size_t i : metric_ids) {
+        names.push_back(m_metrics[i]);
+        events.push_back(m_metric_events[i]);
+        m_metric_active[i] = true;
+    }
+    std::vector<size_t> local_groups;
+    std::vector<std::vector<EventAttr>> groups;
+    if (m_multiplex) {
+        std::set<EventAttr> all;
+        for (auto& evs : events) {
+            all.insert(evs.begin(), evs.end());
+        }
+        if (!all.empty()) {
+            groups.emplace_back(all.begin(), all.end());
+        }
+        local_groups.assign(metric_ids.size(), 0);
+    } else {
+        GroupScheduler scheduler(m_ratio_setup->constraints());
+        groups = scheduler.schedule(names, events, local_groups);
+    }
+
+    // the groups of the earlier levels are kept, so are their samples
+    m_group_base = m_groups.size();
+    m_group_num = groups.size();
+    for (size_t k = 0; k < metric_ids.size(); ++k) {
+        m_metric_groups[metric_ids[k]] = m_group_base + local_groups[k];
+    }
+    for (size_t g = 0; g < m_group_num; ++g) {
+        std::string evnames;
+        for (auto& ev : groups[g]) {
+            // the anchor and the leader added by the scheduler
+            if (!ev.is_uncore && ev.type == 4) {
+                ev.type = m_pmu_type;
+            }
+            evnames += ev.name + " ";
+        }
+        mperf_log_debug("group %zu: %s\n", m_group_base + g, evnames.c_str());
+        m_groups.push_back(std::move(groups[g]));
+    }
+    m_slot_values.resize(m_groups.size() * m_dag->num_slots(), NAN);
+}
 
-    size_t counter_num = m_ratio_setup->counter_num();
-    size_t events_num = m_events.size();
-    mperf_log("the initial events num is %zu.", events_num);
+int MPFTMA::init(std::vector<std::string> metrics, bool multiplex) {
+    m_multiplex = multiplex;
+    collect(metrics);
     // FIXME(hc): when events_num is zero and m_uncore_events_num is not zero,
     // we will get wrong time_interval result
-    m_group_num = std::ceil(1.0f * events_num / counter_num);
-    m_uncore_events_num = m_uncore_events.size();
+    m_drilldown = false;
+    std::vector<size_t> ids(metrics.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = i;
+    }
+    schedule(ids);
     m_binit = true;
     return 0;
 }
 
+int MPFTMA::init_drilldown(std::vector<std::string> metrics) {
+    m_multiplex = false;
+    collect(metrics);
+    m_drilldown = true;
+    m_level = 0;
+    m_group_num = 0;
+    m_binit = true;
+    return 0;
+}
+
+// the level a metric is collected at, the info metrics go with level 1
+static int drilldown_level(const MetricBase* metric) {
+    return std::max(metric->level, 1);
+}
+
+bool MPFTMA::next_level() {
+    if (!m_binit || !m_drilldown) {
+        mperf_throw(MperfError, "You should call `init_drilldown` first.");
+    }
+    size_t mz = m_metrics.size();
+    int max_level = 0;
+    std::vector<MetricBase*> pmetrics(mz);
+    for (size_t i = 0; i < mz; ++i) {
+        pmetrics[i] = m_ratio_setup->metric(m_metrics[i]);
+        max_level = std::max(max_level, drilldown_level(pmetrics[i]));
+    }
+    // evaluate the metrics collected so far, to get the thresh of the
+    // metrics of the current level
+    if (m_level > 0) {
+        std::vector<float> res;
+        evaluate(res);
+    }
+
+    // a metric is collected if its nearest requested ancestor was collected
+    // and flagged by its thresh.
+    auto index_of = [&](const MetricBase* metric) -> size_t {
+        for (size_t i = 0; i < mz; ++i) {
+            if (pmetrics[i] == metric) {
+                return i;
+            }
+        }
+        return mz;
+    };
+    while (m_level < max_level) {
+        ++m_level;
+        std::vector<size_t> ids;
+        for (size_t i = 0; i < mz; ++i) {
+            if (drilldown_level(pmetrics[i]) != m_level) {
+                continue;
+            }
+            bool flagged = true;
+            for (MetricBase* p = pmetrics[i]->parent; p; p = p->parent) {
+                size_t pi = index_of(p);
+                if (pi != mz) {
+                    flagged = m_metric_active[pi] &&
+                              m_dag->thresh(p->func_compute);
+                    break;
+                }
+            }
+            if (flagged) {
+                ids.push_back(i);
+            }
+        }
+        if (!ids.empty()) {
+            mperf_log("drill down to level %d with %zu metrics.", m_level,
+                      ids.size());
+            schedule(ids);
+            return true;
+        }
+    }
+    m_group_num = 0;
+    return false;
+}
+
 size_t MPFTMA::group_num() const {
     if (!m_binit) {
         mperf_throw(MperfError, "You should call `init` first.");
@@ -95,23 +425,21 @@ size_t MPFTMA::uncore_events_num() const {
 }
 
 int MPFTMA::start(size_t group_id) {
-    m_group_id = group_id;
+    if (group_id >= m_group_num) {
+        mperf_throw(MperfError, "group_id(%zu) out of range(%zu).\n",
+                    group_id, m_group_num);
+    }
+    // the groups of the current level follow the ones of the earlier levels
+    m_group_id = m_group_base + group_id;
     mperf_log_debug("the group_id %zu\n", m_group_id);
-    size_t counter_num = m_ratio_setup->counter_num();
-    size_t events_num = m_events.size();
-    size_t ts = (group_id != m_group_num - 1)
-                        ? counter_num
-                        : (events_num - counter_num * group_id);
-    ts = std::min(ts, events_num);
-
-    std::vector<EventAttr> all_tev(events_num);
-    std::copy(m_events.begin(), m_events.end(), all_tev.begin());
 
     if (is_cpu()) {
-        std::vector<EventAttr> part_tev(ts);
-        std::copy(all_tev.begin() + group_id * counter_num,
-                  all_tev.begin() + group_id * counter_num + ts,
-                  part_tev.begin());
+        const std::vector<EventAttr>& part_tev = m_groups[m_group_id];
+        // a scheduled group is opened as one kernel group, in the multiplex
+        // mode the kernel groups are cut by the hardware counter number.
+        m_xpmu->set_cpu_counter_group_size(m_multiplex ? 0 : part_tev.size());
+        m_xpmu->set_cpu_overhead_subtraction_enabled(m_subtract_overhead,
+                                                     m_overhead_iter_num);
         m_xpmu->set_enabled_cpu_counters(part_tev);
     } else {
 #if 0
@@ -127,13 +455,20 @@ int MPFTMA::start(size_t group_id) {
 }
 
 int MPFTMA::start_uncore(size_t evt_idx) {
+    if (evt_idx != kAllUncoreEvents && evt_idx >= m_uncore_events_num) {
+        mperf_throw(MperfError, "evt_idx(%zu) out of range(%zu).\n", evt_idx,
+                    m_uncore_events_num);
+    }
+    // the uncore values are not of any group
+    m_group_id = -1;
     if (is_cpu()) {
-        std::vector<EventAttr> part_tev(1);
-        std::vector<EventAttr> all_tev(m_uncore_events_num);
-        std::copy(m_uncore_events.begin(), m_uncore_events.end(),
-                  all_tev.begin());
-        std::copy(all_tev.begin() + evt_idx, all_tev.begin() + evt_idx + 1,
-                  part_tev.begin());
+        std::vector<EventAttr> part_tev(m_uncore_events.begin(),
+                                        m_uncore_events.end());
+        if (evt_idx != kAllUncoreEvents) {
+            part_tev = {part_tev[evt_idx]};
+        }
+        m_xpmu->set_cpu_counter_group_size(0);
+        m_xpmu->set_cpu_overhead_subtraction_enabled(false);
         m_xpmu->set_enabled_cpu_counters(part_tev);
         m_xpmu->set_cpu_uncore_event_enabled();
     } else {
@@ -149,15 +484,35 @@ int MPFTMA::start_uncore(size_t evt_idx) {
 // same event_list
 int MPFTMA::sample(size_t iter_num) {
     if (is_cpu()) {
-        auto cpu_measurements = m_xpmu->sample().cpu;
+        auto measurements = m_xpmu->sample();
+        auto cpu_measurements = measurements.cpu;
+        // the counts of the instances of an uncore event add up to it
+        std::map<std::string, float> uncore_totals;
+        m_uncore_instance_values.clear();
         for (size_t k = 0; k < cpu_measurements->size(); k++) {
             auto iter = (*cpu_measurements)[k];
-            mperf_log_debug("sample: %s:%lu, \n", iter.first.c_str(),
-                            iter.second / iter_num);
-            m_duration.push_back(
-                    {iter.first.c_str(), (float)iter.second / iter_num});
+            mperf_log_debug("sample: %s:%lu, running ratio %f\n",
+                            iter.first.c_str(), iter.second / iter_num,
+                            (*measurements.cpu_ratios)[k]);
+            float value = (float)iter.second / iter_num;
+            std::string event = uncore_event_name(iter.first);
+            if (event != iter.first) {
+                m_uncore_instance_values.emplace_back(iter.first, value);
+                uncore_totals[event] += value;
+                continue;
+            }
+            set_value(iter.first, value);
+        }
+        for (auto& total : uncore_totals) {
+            set_value(total.first, total.second);
         }
-        if (m_group_id == 0) {
+        for (auto& thread : *measurements.cpu_threads) {
+            ThreadValues& tv = m_thread_values[thread.first];
+            for (auto& iter : thread.second) {
+                set_value(iter.first, (float)iter.second / iter_num, &tv);
+            }
+        }
+        if (m_group_id == m_group_base) {
             auto now = clock::now();
             float time = std::chrono::duration_cast<std::chrono::nanoseconds>(
                                  now - m_start_point)
@@ -165,7 +520,7 @@ int MPFTMA::sample(size_t iter_num) {
                          1e-6;
 
             // add a fake event entry names time_interval to record sample duration
-            m_duration.push_back({"time_interval", time / iter_num});
+            set_value("time_interval", time / iter_num);
             m_group_id = -1;
             mperf_log_debug("sample: time_interval:%f, and iter_num %zu\n",
                             time / iter_num, iter_num);
@@ -184,35 +539,526 @@ int MPFTMA::sample_and_stop(size_t iter_num) {
     return 0;
 }
 
+int MPFTMA::sample_repeated(
+        size_t group_id, size_t iter_num, const std::function<void()>& workload,
+        std::vector<std::pair<std::string, SampleStats>>* stats) {
+    Repeater rep(m_repeat_options);
+    while (rep.next()) {
+        start(group_id);
+        workload();
+        sample_and_stop(iter_num);
+        // the values sample() just set, time_interval by the first group
+        std::vector<std::string> names;
+        for (auto& attr : m_groups[m_group_base + group_id]) {
+            names.push_back(attr.name);
+        }
+        if (group_id == 0) {
+            names.push_back("time_interval");
+        }
+        for (auto& name : names) {
+            size_t slot = m_dag->slot(name);
+            if (slot != MetricDag::npos) {
+                rep.record(name, m_merged_values[slot]);
+            }
+        }
+    }
+    m_group_id = m_group_base + group_id;
+    if (stats) {
+        stats->clear();
+    }
+    for (auto& name : rep.names()) {
+        SampleStats s = rep.stats(name);
+        set_value(name, s.median);
+        if (stats) {
+            stats->emplace_back(name, s);
+        }
+    }
+    m_group_id = -1;
+    return 0;
+}
+
+void MPFTMA::evaluate(std::vector<float>& res) {
+    // evaluate the metrics group by group, the events are preferred from the
+    // metric's group, and the nodes are memoized within a group. the metrics
+    // not collected in drill-down mode are NAN.
+    size_t mz = m_metrics.size();
+    std::vector<size_t> order;
+    for (size_t i = 0; i < mz; ++i) {
+        if (m_metric_active[i]) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return m_metric_groups[a] < m_metric_groups[b];
+    });
+    res.assign(mz, NAN);
+    // the uncore events are not sampled in interval mode, and a record may
+    // not hold the events of the metrics added later
+    const bool lenient = m_interval_ms > 0 || m_offline;
+    const size_t ns = m_dag->num_slots();
+    std::vector<size_t> nodes;
+    for (size_t k = 0; k < order.size();) {
+        size_t g = m_metric_groups[order[k]];
+        size_t end = k;
+        nodes.clear();
+        for (; end < order.size() && m_metric_groups[order[end]] == g; ++end) {
+            nodes.push_back(m_metric_nodes[order[end]]);
+        }
+        m_dag->begin_eval(&m_slot_values[g * ns], m_merged_values.data(),
+                          lenient);
+        m_dag->evaluate(nodes);
+        for (; k < end; ++k) {
+            res[order[k]] = m_dag->value(m_metric_nodes[order[k]]);
+        }
+    }
+}
+
+int MPFTMA::start_interval(size_t interval_ms) {
+    if (!m_binit) {
+        mperf_throw(MperfError, "You should call `init` first.");
+    }
+    if (!is_cpu()) {
+        mperf_throw(MperfError,
+                    "ERROR: this interface only support on cpu platform.\n");
+    }
+    if (m_sampler.joinable()) {
+        mperf_throw(MperfError, "the interval sampler is already running.\n");
+    }
+    if (m_events.empty() || interval_ms == 0) {
+        mperf_throw(MperfError, "no events or zero interval to sample.\n");
+    }
+    if (m_uncore_events_num > 0) {
+        mperf_log_warn("the uncore events are not sampled in interval mode.\n");
+    }
+    std::vector<EventAttr> all_tev(m_events.begin(), m_events.end());
+    // the topdown metrics events and their leader open the first kernel
+    // group, the groups are cut by its size then.
+    const CounterConstraints& cons = m_ratio_setup->constraints();
+    auto is_free = [&](const EventAttr& ev) {
+        for (auto& fev : cons.free_events) {
+            if (fev.config == ev.config) {
+                return true;
+            }
+        }
+        return false;
+    };
+    size_t group_size = 0;
+    size_t nfree =
+            std::stable_partition(all_tev.begin(), all_tev.end(), is_free) -
+            all_tev.begin();
+    if (nfree > 0) {
+        if (m_events.count(cons.leader) == 0) {
+            all_tev.push_back(cons.leader);
+            all_tev.back().type = m_pmu_type;
+        }
+        // by name, the collected leader may differ in its type or modes
+        auto it = std::find_if(all_tev.begin(), all_tev.end(),
+                               [&](const EventAttr& ev) {
+                                   return ev.name == cons.leader.name;
+                               });
+        if (it == all_tev.end()) {
+            mperf_throw(MperfError, "the group leader %s is not collected.\n",
+                        cons.leader.name.c_str());
+        }
+        std::rotate(all_tev.begin(), it, it + 1);
+        group_size = nfree + 1;
+    }
+    m_interval_ms = interval_ms;
+    m_intervals.clear();
+    m_sampler_stop = false;
+    m_sampler_started = false;
+    // the sampler is created before the counters are opened, so it does not
+    // inherit them, and its reads, the evaluation and the callback are not
+    // counted as the workload. It waits for run().
+    m_sampler = std::thread(&MPFTMA::sampler_loop, this);
+    m_group_id = -1;
+    std::fill(m_slot_values.begin(), m_slot_values.end(), NAN);
+    std::fill(m_merged_values.begin(), m_merged_values.end(), NAN);
+    try {
+        m_xpmu->set_cpu_counter_group_size(group_size);
+        // the intervals are long and sampled back to back
+        m_xpmu->set_cpu_overhead_subtraction_enabled(false);
+        m_xpmu->set_enabled_cpu_counters(all_tev);
+        std::lock_guard<std::mutex> lock(m_sampler_mutex);
+        m_start_point = clock::now();
+        m_xpmu->run();
+        m_sampler_started = true;
+    } catch (...) {
+        stop_interval();
+        throw;
+    }
+    m_sampler_cv.notify_one();
+    return 0;
+}
+
+void MPFTMA::sampler_loop() {
+    std::unique_lock<std::mutex> lock(m_sampler_mutex);
+    m_sampler_cv.wait(lock,
+                      [this] { return m_sampler_started || m_sampler_stop; });
+    if (!m_sampler_started) {
+        return;
+    }
+    auto last = m_start_point;
+    auto next = last + std::chrono::milliseconds(m_interval_ms);
+    bool stop = false;
+    while (!stop) {
+        stop = m_sampler_cv.wait_until(lock, next,
+                                       [this] { return m_sampler_stop; });
+        auto now = clock::now();
+        auto measurements = m_xpmu->sample();
+        TMAInterval interval;
+        for (auto& iter : *measurements.cpu) {
+            set_value(iter.first, (float)iter.second);
+            interval.counts.push_back(iter);
+        }
+        float time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             now - last)
+                             .count() *
+                     1e-6;
+        set_value("time_interval", time);
+
+        interval.timestamp_ms =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        now - m_start_point)
+                        .count() *
+                1e-6;
+        evaluate(interval.values);
+        if (m_interval_callback) {
+            m_interval_callback(interval);
+        }
+        m_intervals.push_back(std::move(interval));
+        last = now;
+        next += std::chrono::milliseconds(m_interval_ms);
+    }
+}
+
+const std::vector<TMAInterval>& MPFTMA::stop_interval() {
+    if (m_sampler.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_sampler_mutex);
+            m_sampler_stop = true;
+        }
+        m_sampler_cv.notify_one();
+        m_sampler.join();
+        if (m_sampler_started) {
+            m_xpmu->stop();
+        }
+        m_sampler_started = false;
+    }
+    return m_intervals;
+}
+
 int MPFTMA::deinit() {
-    std::vector<std::pair<std::string, float>> res;
+    if (m_sampler.joinable()) {
+        stop_interval();
+    }
     size_t mz = m_metrics.size();
+    if (!m_intervals.empty()) {
+        printf("TMA INTERVAL RESULTS:\n");
+        printf("%12s", "time(ms)");
+        for (size_t i = 0; i < mz; ++i) {
+            printf(" %20s", m_metrics[i].c_str());
+        }
+        printf("\n");
+        for (auto& interval : m_intervals) {
+            printf("%12.3f", interval.timestamp_ms);
+            for (size_t i = 0; i < mz; ++i) {
+                printf(" %20.5f", interval.values[i]);
+            }
+            printf("\n");
+        }
+        release();
+        return 0;
+    }
+
+    std::vector<float> vals;
+    evaluate(vals);
+    // FIXME. The value and usage of thresh need to be fixed.
+    std::vector<std::pair<std::string, float>> res(mz);
     for (size_t i = 0; i < mz; ++i) {
-        auto pmetric = m_ratio_setup->metric(m_metrics[i]);
-        auto feq = std::bind(&MPFTMA::ev_query, this, std::placeholders::_1,
-                             std::placeholders::_2);
-        float val = ((TMACompute)(pmetric->func_compute))(feq);
-        // FIXME. The value and usage of thresh need to be fixed.
-        res.push_back({pmetric->name, val});
+        res[i] = {m_metrics[i], vals[i]};
     }
 
     printf("TAM STATIS RESULTS:\n");
     for (size_t i = 0; i < mz; ++i) {
+        if (!m_metric_active[i]) {
+            continue;
+        }
         printf("%10s : %10.5f\n", res[i].first.c_str(), res[i].second);
     }
+    if (m_per_thread) {
+        printf("TMA THREAD RESULTS:\n");
+        printf("%10s", "tid");
+        for (size_t i = 0; i < mz; ++i) {
+            if (m_metric_active[i]) {
+                printf(" %20s", m_metrics[i].c_str());
+            }
+        }
+        printf("\n");
+        for (auto& thread : thread_metrics()) {
+            printf("%10d", thread.first);
+            for (size_t i = 0; i < mz; ++i) {
+                if (m_metric_active[i]) {
+                    printf(" %20.5f", thread.second[i]);
+                }
+            }
+            printf("\n");
+        }
+    }
+
+    release();
+    return 0;
+}
 
+void MPFTMA::release() {
     delete m_xpmu;
     m_xpmu = nullptr;
+    m_intervals.clear();
+    m_interval_ms = 0;
     m_metrics.clear();
     m_events.clear();
     m_uncore_events.clear();
-    m_duration.clear();
+    m_uncore_instance_values.clear();
+    m_metric_events.clear();
+    m_groups.clear();
+    m_metric_groups.clear();
+    m_metric_active.clear();
+    m_slot_values.clear();
+    m_merged_values.clear();
+    m_thread_values.clear();
+    delete m_dag;
+    m_dag = nullptr;
     m_group_num = 0;
+    m_group_base = 0;
+    m_level = 0;
+    m_drilldown = false;
     m_binit = false;
+    m_offline = false;
+}
 
+void MPFTMA::set_value(const std::string& name, float value,
+                       ThreadValues* tv) {
+    size_t slot = m_dag->slot(name);
+    if (slot == MetricDag::npos) {
+        return;
+    }
+    size_t ns = m_dag->num_slots();
+    std::vector<float>& slot_values = tv ? tv->slot_values : m_slot_values;
+    std::vector<float>& merged_values =
+            tv ? tv->merged_values : m_merged_values;
+    // the groups of the new drill-down levels
+    slot_values.resize(m_slot_values.size(), NAN);
+    merged_values.resize(ns, NAN);
+    if (m_group_id < m_groups.size()) {
+        slot_values[m_group_id * ns + slot] = value;
+    }
+    merged_values[slot] = value;
+}
+
+void MPFTMA::set_overhead_subtraction_enabled(bool enabled,
+                                              size_t iter_num) {
+    m_subtract_overhead = enabled;
+    m_overhead_iter_num = iter_num;
+}
+
+void MPFTMA::set_target_pid(pid_t pid, bool enable_on_exec) {
+    m_xpmu->set_cpu_target_pid(pid, enable_on_exec);
+}
+
+void MPFTMA::set_per_thread_enabled(bool enabled) {
+    m_per_thread = enabled;
+    m_xpmu->set_cpu_per_thread_enabled(enabled);
+}
+
+std::vector<std::pair<int, std::vector<float>>> MPFTMA::thread_metrics() {
+    std::vector<std::pair<int, std::vector<float>>> res;
+    for (auto& it : m_thread_values) {
+        ThreadValues tv = it.second;
+        tv.slot_values.resize(m_slot_values.size(), NAN);
+        tv.merged_values.resize(m_merged_values.size(), NAN);
+        for (size_t i = 0; i < tv.merged_values.size(); ++i) {
+            if (not_sampled(tv.merged_values[i])) {
+                tv.merged_values[i] = m_merged_values[i];
+            }
+        }
+        // evaluate on the values of the thread
+        std::swap(tv.slot_values, m_slot_values);
+        std::swap(tv.merged_values, m_merged_values);
+        std::vector<float> vals;
+        evaluate(vals);
+        std::swap(tv.slot_values, m_slot_values);
+        std::swap(tv.merged_values, m_merged_values);
+        res.emplace_back(it.first, std::move(vals));
+    }
+    return res;
+}
+
+int MPFTMA::save_record(const std::string& path) {
+    if (!m_binit) {
+        mperf_throw(MperfError, "You should call `init` first.");
+    }
+    if (m_sampler.joinable()) {
+        stop_interval();
+    }
+    std::string info = "mperf_tma_record " +
+                       std::to_string(kTMARecordVersion) + "\nxpu_type " +
+                       xpu_type_name(m_xpu_type) +
+                       "\ninterval_ms " + std::to_string(m_interval_ms) +
+                       "\nmetrics";
+    for (auto& metric : m_metrics) {
+        info += " " + metric;
+    }
+    info += "\n";
+    size_t ns = m_dag->num_slots();
+    std::vector<EventAttr> counters;
+    for (size_t slot = 0; slot < ns; ++slot) {
+        counters.push_back(m_dag->event(slot));
+    }
+    TraceWriter trace(path, counters, 4096, info);
+    std::vector<uint64_t> bits(ns);
+    auto set_bits = [&bits](size_t slot, double val) {
+        memcpy(&bits[slot], &val, sizeof(val));
+    };
+    if (!m_intervals.empty()) {
+        const size_t time_slot = m_dag->slot("time_interval");
+        float last = 0;
+        for (auto& interval : m_intervals) {
+            for (size_t slot = 0; slot < ns; ++slot) {
+                set_bits(slot, NAN);
+            }
+            for (auto& count : interval.counts) {
+                size_t slot = m_dag->slot(count.first);
+                if (slot != MetricDag::npos) {
+                    set_bits(slot, count.second);
+                }
+            }
+            if (time_slot != MetricDag::npos) {
+                set_bits(time_slot, interval.timestamp_ms - last);
+            }
+            last = interval.timestamp_ms;
+            trace.append(static_cast<uint64_t>(interval.timestamp_ms * 1e6),
+                         kTraceNoRegion, bits.data());
+        }
+    } else {
+        auto append = [&](uint32_t region, const float* values) {
+            for (size_t slot = 0; slot < ns; ++slot) {
+                set_bits(slot, values[slot]);
+            }
+            trace.append(0, region, bits.data());
+        };
+        for (size_t g = 0; g < m_groups.size(); ++g) {
+            append(g, &m_slot_values[g * ns]);
+        }
+        append(kTraceNoRegion, m_merged_values.data());
+    }
+    trace.flush();
     return 0;
 }
 
+MPFXPUType MPFTMA::record_xpu_type(const std::string& path) {
+    TMARecord rec;
+    read_record(path, rec);
+    return rec.xpu_type->first;
+}
+
+int MPFTMA::load_record(const std::string& path,
+                        std::vector<std::string> metrics) {
+    if (m_binit) {
+        mperf_throw(MperfError, "load_record is called instead of `init`.\n");
+    }
+    TMARecord rec;
+    read_record(path, rec);
+    if (rec.xpu_type->first != m_xpu_type) {
+        mperf_throw(MperfError,
+                    "the record %s is of the cpu type %s, not %s of the "
+                    "session.\n",
+                    path.c_str(), rec.xpu_type->second,
+                    xpu_type_name(m_xpu_type));
+    }
+    if (metrics.empty()) {
+        metrics = rec.metrics;
+    }
+    m_offline = true;
+    init(metrics);
+
+    std::set<std::string> recorded;
+    size_t ns = m_dag->num_slots();
+    m_group_id = -1;
+    if (!rec.intervals.empty()) {
+        m_interval_ms = rec.interval_ms;
+        for (auto& it : rec.intervals) {
+            std::fill(m_merged_values.begin(), m_merged_values.end(), NAN);
+            TMAInterval interval;
+            interval.timestamp_ms = it.first;
+            for (auto& v : it.second) {
+                set_value(v.first, v.second);
+                recorded.insert(v.first);
+                if (v.first != "time_interval") {
+                    interval.counts.emplace_back(v.first, (uint64_t)v.second);
+                }
+            }
+            evaluate(interval.values);
+            m_intervals.push_back(std::move(interval));
+        }
+    } else {
+        for (auto& v : rec.merged) {
+            set_value(v.first, v.second);
+            recorded.insert(v.first);
+        }
+        // a group is filled from a recorded group holding all its events, so
+        // that the metrics are still computed from the counts of one run
+        auto holds = [](const TMARecord::Values& values,
+                        const std::string& name) {
+            for (auto& v : values) {
+                if (v.first == name) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        for (size_t g = 0; g < m_groups.size(); ++g) {
+            for (auto& values : rec.groups) {
+                bool all = true;
+                for (auto& ev : m_groups[g]) {
+                    all = all && holds(values, ev.name);
+                }
+                if (!all) {
+                    continue;
+                }
+                for (auto& v : values) {
+                    size_t slot = m_dag->slot(v.first);
+                    if (slot != MetricDag::npos) {
+                        m_slot_values[g * ns + slot] = v.second;
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    std::string missing;
+    for (size_t slot = 0; slot < ns; ++slot) {
+        if (recorded.count(m_dag->event(slot).name) == 0) {
+            missing += " " + m_dag->event(slot).name;
+        }
+    }
+    if (!missing.empty()) {
+        mperf_log_warn("the events not in the record:%s, the metrics of "
+                       "them are NAN.\n",
+                       missing.c_str());
+    }
+    return 0;
+}
+
+std::vector<float> MPFTMA::metric_values() {
+    if (!m_binit) {
+        mperf_throw(MperfError, "You should call `init` first.");
+    }
+    std::vector<float> res;
+    evaluate(res);
+    return res;
+}
+
 bool MPFTMA::is_cpu() const {
 #if 0  // TODO. support GPU later.
     if(m_xpu_type == MALI || m_xpu_type == ADRENO) {
@@ -0,0 +1,137 @@
+/**
+ * \file eca/tma/x86_events.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "x86_events.h"
+#include <stdio.h>
+#include <string.h>
+#include "mperf/exception.h"
+#include "mperf/utils.h"
+
+namespace mperf {
+namespace tma {
+
+X86EventMap::X86EventMap(const std::string& root) : m_root(root) {
+    // TOPDOWN.SLOTS is counted on the fixed counter 3, the PERF_METRICS
+    // events(event 0x00, umask 0x80 and on) read the topdown metrics register
+    // and have to be grouped with TOPDOWN.SLOTS as the leader.
+    add({"TOPDOWN.SLOTS", 0x400, 4, 0});
+    add({"PERF_METRICS.RETIRING", 0x8000, 4, 0});
+    add({"PERF_METRICS.BAD_SPECULATION", 0x8100, 4, 0});
+    add({"PERF_METRICS.FRONTEND_BOUND", 0x8200, 4, 0});
+    add({"PERF_METRICS.BACKEND_BOUND", 0x8300, 4, 0});
+    add({"PERF_METRICS.HEAVY_OPERATIONS", 0x8400, 4, 0});
+    add({"PERF_METRICS.BRANCH_MISPREDICTS", 0x8500, 4, 0});
+    add({"PERF_METRICS.FETCH_LATENCY", 0x8600, 4, 0});
+    add({"PERF_METRICS.MEMORY_BOUND", 0x8700, 4, 0});
+}
+
+bool X86EventMap::parse(const std::string& encoding, EventAttr& attr) const {
+    try {
+        EventAttr parsed = m_parser->parse(encoding);
+        attr.config = parsed.config;
+        attr.config1 = parsed.config1;
+        attr.type = 4;
+        attr.exclude_user = parsed.exclude_user;
+        attr.exclude_kernel = parsed.exclude_kernel;
+    } catch (const MperfError& e) {
+        mperf_log_debug("%s", e.what());
+        return false;
+    }
+    return true;
+}
+
+size_t X86EventMap::load(const std::string& path) {
+    FILE* fp = fopen(path.c_str(), "r");
+    if (!fp) {
+        mperf_log_warn("can not open the event map %s.\n", path.c_str());
+        return 0;
+    }
+    if (!m_parser) {
+        m_parser.reset(new PmuEventParser(m_root));
+    }
+    size_t num = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        const char* comma = strchr(line, ',');
+        if (!comma || line[0] == '#') {
+            continue;
+        }
+        EventAttr attr(std::string(line, comma - line));
+        if (!parse(comma + 1, attr)) {
+            mperf_log_warn("skip the event %s of an unknown encoding %s.\n",
+                           attr.name.c_str(), comma + 1);
+            continue;
+        }
+        add(attr);
+        m_encodings[attr.name] = comma + 1;
+        ++num;
+    }
+    fclose(fp);
+    mperf_log("%zu events are loaded from %s.", num, path.c_str());
+    return num;
+}
+
+bool X86EventMap::resolve(EventAttr& attr) const {
+    auto it = m_events.find(attr.name);
+    if (it != m_events.end()) {
+        attr.config = it->second.config;
+        attr.config1 = it->second.config1;
+        attr.exclude_user = it->second.exclude_user;
+        attr.exclude_kernel = it->second.exclude_kernel;
+        return true;
+    }
+    // BASE:mod1:mod2, e.g. INT_MISC.RECOVERY_CYCLES:c1:e1
+    size_t colon = attr.name.find(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    auto enc = m_encodings.find(attr.name.substr(0, colon));
+    if (enc == m_encodings.end()) {
+        return false;
+    }
+    // the modifiers are the terms of the fields, after those of the base
+    // event, which they override
+    std::string terms;
+    while (colon != std::string::npos) {
+        size_t next = attr.name.find(':', colon + 1);
+        std::string mod = attr.name.substr(
+                colon + 1,
+                next == std::string::npos ? std::string::npos
+                                          : next - colon - 1);
+        colon = next;
+        if (mod.empty()) {
+            return false;
+        }
+        std::string val = mod.size() == 1 ? "1" : mod.substr(1);
+        switch (mod[0]) {
+            case 'c':
+                terms += ",cmask=" + val;
+                break;
+            case 'e':
+                terms += ",edge=" + val;
+                break;
+            case 'i':
+                terms += ",inv=" + val;
+                break;
+            case 'u':
+                // the umask is hex even without the 0x prefix, e.g. :uF
+                terms += ",umask=0x" + val;
+                break;
+            default:
+                // e.g. percore, which is not a raw encoding
+                return false;
+        }
+    }
+    const std::string& base = enc->second;
+    size_t last = base.rfind('/');
+    return parse(base.substr(0, last) + terms + base.substr(last), attr);
+}
+
+}  // namespace tma
+}  // namespace mperf
@@ -0,0 +1,57 @@
+/**
+ * \file eca/tma/x86_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "mperf/pmu_events.h"
+#include "mperf/pmu_types.h"
+
+namespace mperf {
+namespace tma {
+
+// The encodings of the x86 core events, looked up by name at init. The
+// generated ratio tables only carry the encodings known to the generator, the
+// events with config 0 are resolved here from the raw event map of the cpu,
+// e.g. the dump of `toplev.py --dump-raw-events`, one event per line:
+//     CYCLE_ACTIVITY.STALLS_L2_MISS,cpu/event=0xa3,umask=0x5,cmask=5/
+// The encodings are parsed by PmuEventParser, by the fields the core pmu
+// lists in the sysfs. The toplev modifiers of a name(e.g.
+// UOPS_EXECUTED.CORE:i1:c1) are the terms appended to the encoding of the
+// base event.
+class X86EventMap {
+public:
+    // with the built-in events, i.e. the fixed topdown events of icelake and
+    // later, which are the same on every cpu that has them. root is the root
+    // of the sysfs tree of the pmus, empty on a real system.
+    explicit X86EventMap(const std::string& root = "");
+
+    // load a raw event map, returns the number of events loaded.
+    size_t load(const std::string& path);
+    void add(const EventAttr& attr) { m_events[attr.name] = attr; }
+    // fill the encoding of the event, false if the event is unknown. The
+    // name is kept.
+    bool resolve(EventAttr& attr) const;
+
+private:
+    // parse an encoding in the perf raw event format, e.g.
+    // cpu/event=0xd1,umask=0x8,cmask=1,inv/k, false if it is malformed.
+    bool parse(const std::string& encoding, EventAttr& attr) const;
+
+    std::string m_root;
+    // read at the first load
+    std::unique_ptr<PmuEventParser> m_parser;
+    std::unordered_map<std::string, EventAttr> m_events;
+    // the encodings of the loaded events, the modifiers append to them
+    std::unordered_map<std::string, std::string> m_encodings;
+};
+
+}  // namespace tma
+}  // namespace mperf
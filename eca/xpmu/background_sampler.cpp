@@ -0,0 +1,257 @@
+/**
+ * \file eca/xpmu/background_sampler.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "mperf/xpmu/background_sampler.h"
+#include <errno.h>
+#include <math.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include "mperf/cpu_info.h"
+#include "mperf/exception.h"
+#include "mperf/trace.h"
+#include "mperf/xpmu/xpmu.h"
+
+namespace mperf {
+namespace {
+uint64_t monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#if MPERF_WITH_ADRENO
+std::string gpu_counter_name(const std::string& name) {
+    return name;
+}
+#else
+std::string gpu_counter_name(GpuCounter counter) {
+    auto it = counter_enum_to_names.find(counter);
+    return it != counter_enum_to_names.end()
+                   ? it->second
+                   : std::to_string(static_cast<int>(counter));
+}
+#endif
+}  // namespace
+
+constexpr int BackgroundSampler::kHousekeepingCpu;
+
+BackgroundSampler::BackgroundSampler(XPMU* xpmu, uint64_t period_us,
+                                     size_t capacity, int cpu)
+        : xpmu_(xpmu), period_us_(period_us), capacity_(capacity), cpu_(cpu) {
+    if (!xpmu || period_us == 0) {
+        mperf_throw(MperfError,
+                    "the background sampler needs an xpmu and a period.\n");
+    }
+    if (xpmu->cpu_profiler() && xpmu->cpu_profiler()->is_user_read()) {
+        mperf_throw(MperfError,
+                    "the counters read from user space can not be sampled by "
+                    "another thread.\n");
+    }
+    if (cpu_ == kHousekeepingCpu) {
+        std::vector<int> cpus = cpu_info_get_cluster_cpus(1);
+        cpu_ = cpus.empty() ? -1 : cpus[0];
+    }
+    // the threads wait for start(), they exist before the counters are
+    // opened so that they do not inherit them
+    sampler_ = std::thread(&BackgroundSampler::sampler_loop, this);
+    try {
+        writer_ = std::thread(&BackgroundSampler::writer_loop, this);
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+BackgroundSampler::~BackgroundSampler() {
+    stop();
+}
+
+void BackgroundSampler::start() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    if (started_ || stop_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    // the start of the first period, and the order of the counters
+    Measurements m = xpmu_->sample();
+    if (m.cpu) {
+        for (auto& c : *m.cpu) {
+            cpu_names_.push_back(c.first);
+        }
+    }
+    if (m.gpu) {
+        for (auto& g : *m.gpu) {
+            gpu_names_.push_back(gpu_counter_name(g.first));
+        }
+    }
+    ring_.reset(new SpscRing(capacity_,
+                             1 + cpu_names_.size() + gpu_names_.size()));
+    if (!trace_path_.empty()) {
+        std::vector<EventAttr> counters;
+        for (auto& name : cpu_names_) {
+            counters.emplace_back(name);
+        }
+        for (auto& name : gpu_names_) {
+            counters.emplace_back(name);
+        }
+        trace_.reset(new TraceWriter(trace_path_, counters));
+        trace_counts_.assign(counters.size(), 0);
+    }
+    start_ns_ = monotonic_ns();
+    started_ = true;
+    start_cv_.notify_all();
+}
+
+bool BackgroundSampler::wait_start() {
+    std::unique_lock<std::mutex> lock(start_mutex_);
+    start_cv_.wait(lock, [this] {
+        return started_ || stop_.load(std::memory_order_relaxed);
+    });
+    return started_;
+}
+
+void BackgroundSampler::sampler_loop() {
+    if (!wait_start()) {
+        return;
+    }
+    if (cpu_ >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu_, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            mperf_log_warn("failed to pin the background sampler to the cpu "
+                           "%d: %s\n",
+                           cpu_, strerror(errno));
+        }
+    }
+    // the periods follow the absolute deadlines, the sampling time does not
+    // drift them
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    bool last = false;
+    while (!last) {
+        uint64_t ns = next.tv_nsec + period_us_ * 1000;
+        next.tv_sec += ns / 1000000000ULL;
+        next.tv_nsec = ns % 1000000000ULL;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next,
+                               nullptr) == EINTR) {
+        }
+        last = stop_.load(std::memory_order_acquire);
+        if (!push_sample(monotonic_ns() - start_ns_)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool BackgroundSampler::push_sample(uint64_t timestamp_ns) {
+    // the counters are read even if the ring is full, so the next record
+    // still counts its own period only
+    CpuValues cpu = xpmu_->sample_cpu_values();
+    const GpuMeasurements* gpu =
+            xpmu_->gpu_profiler() ? &xpmu_->gpu_profiler()->sample() : nullptr;
+    uint64_t* slot = ring_->acquire();
+    if (!slot) {
+        return false;
+    }
+    slot[0] = timestamp_ns;
+    const size_t nc = cpu_names_.size();
+    for (size_t i = 0; i < nc; ++i) {
+        slot[1 + i] = i < cpu.size ? cpu[i] : 0;
+    }
+    size_t k = 0;
+    if (gpu) {
+        for (auto& g : *gpu) {
+            if (k == gpu_names_.size()) {
+                break;
+            }
+            double val = g.second.get<double>();
+            memcpy(&slot[1 + nc + k++], &val, sizeof(val));
+        }
+    }
+    // the measurements the gpu did not return are 0.0, not the ones of an
+    // older record
+    for (; k < gpu_names_.size(); ++k) {
+        slot[1 + nc + k] = 0;
+    }
+    ring_->commit();
+    return true;
+}
+
+size_t BackgroundSampler::drain(
+        const std::function<void(const BackgroundSample&)>& fn,
+        size_t max_records) {
+    const size_t nc = cpu_names_.size();
+    if (!ring_) {
+        return 0;
+    }
+    std::vector<double> gpu(gpu_names_.size());
+    size_t n = 0;
+    for (; n < max_records; ++n) {
+        const uint64_t* record = ring_->front();
+        if (!record) {
+            break;
+        }
+        memcpy(gpu.data(), record + 1 + nc, gpu.size() * sizeof(double));
+        BackgroundSample sample{record[0], {record + 1, nc}, gpu.data(),
+                                gpu.size()};
+        fn(sample);
+        ring_->pop();
+    }
+    return n;
+}
+
+void BackgroundSampler::write_trace(const std::string& path,
+                                    uint32_t drain_ms) {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    if (started_ || !trace_path_.empty()) {
+        mperf_throw(MperfError,
+                    "the trace of the background sampler is set before "
+                    "run(), once.\n");
+    }
+    trace_path_ = path;
+    drain_ms_ = drain_ms;
+}
+
+void BackgroundSampler::writer_loop() {
+    if (!wait_start() || !trace_) {
+        return;
+    }
+    auto append = [this](const BackgroundSample& sample) {
+        std::copy(sample.cpu.begin(), sample.cpu.end(), trace_counts_.begin());
+        for (size_t k = 0; k < sample.gpu_size; ++k) {
+            trace_counts_[sample.cpu.size + k] =
+                    static_cast<uint64_t>(llround(sample.gpu[k]));
+        }
+        trace_->append(sample.timestamp_ns, 0, trace_counts_.data());
+    };
+    while (!writer_stop_.load(std::memory_order_acquire)) {
+        drain(append);
+        std::this_thread::sleep_for(std::chrono::milliseconds(drain_ms_));
+    }
+    drain(append);
+    trace_->flush();
+}
+
+void BackgroundSampler::stop() {
+    if (sampler_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(start_mutex_);
+            stop_.store(true, std::memory_order_release);
+        }
+        start_cv_.notify_all();
+        sampler_.join();
+    }
+    if (writer_.joinable()) {
+        writer_stop_.store(true, std::memory_order_release);
+        writer_.join();
+    }
+}
+
+}  // namespace mperf
@@ -0,0 +1,390 @@
+/**
+ * \file eca/xpmu/region.cpp
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#include "mperf/xpmu/region.h"
+#include "mperf/exception.h"
+#include "mperf/utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <mutex>
+
+#ifdef __linux__
+#include "vendor/cpu/pmu_counter.h"
+#endif
+
+namespace mperf {
+namespace detail {
+std::atomic<bool> g_region_enabled{false};
+}  // namespace detail
+
+namespace {
+// the wall time and the events
+constexpr int kSlots = kMaxRegionEvents + 1;
+
+struct RegionStats {
+    uint64_t calls;
+    uint64_t inclusive[kSlots];
+    uint64_t exclusive[kSlots];
+    uint64_t min[kSlots];
+    uint64_t max[kSlots];
+
+    void clear() {
+        calls = 0;
+        for (int i = 0; i < kSlots; ++i) {
+            inclusive[i] = exclusive[i] = max[i] = 0;
+            min[i] = UINT64_MAX;
+        }
+    }
+
+    void merge(const RegionStats& rhs) {
+        calls += rhs.calls;
+        for (int i = 0; i < kSlots; ++i) {
+            inclusive[i] += rhs.inclusive[i];
+            exclusive[i] += rhs.exclusive[i];
+            min[i] = std::min(min[i], rhs.min[i]);
+            max[i] = std::max(max[i], rhs.max[i]);
+        }
+    }
+};
+
+struct RegionFrame {
+    int id;
+    // false if the counters could not be read as the region was entered
+    bool counted;
+    uint64_t start[kSlots];
+    // the inclusive counts of the nested regions
+    uint64_t child[kSlots];
+};
+
+inline uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+/** The regions of a thread. */
+class RegionTable {
+public:
+    RegionTable() { clear(); }
+    ~RegionTable() { close(); }
+
+    void clear() {
+        for (auto& s : stats) {
+            s.clear();
+        }
+    }
+
+    // the totals are cleared by the thread of the table only, as it sees a
+    // new reset epoch, the other threads ignore them until then
+    void reset(uint64_t epoch) {
+        clear();
+        epoch_.store(epoch, std::memory_order_release);
+    }
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    // open the counters of the current events, only outside of the regions
+    void open(const CpuCounterSet2& events, uint64_t generation);
+
+    void close() {
+#ifdef __linux__
+        counters_ = PerfCounters::NoCounters();
+#endif
+        nr_events_ = 0;
+    }
+
+    uint64_t generation() const { return generation_; }
+    int depth() const { return depth_; }
+
+    MPERF_ALWAYS_INLINE bool enter(int id) {
+        if (id < 0 || depth_ == kMaxRegionDepth) {
+            return false;
+        }
+        RegionFrame& f = stack_[depth_++];
+        f.id = id;
+        memset(f.child, 0, sizeof(f.child));
+        f.counted = read(f.start);
+        return true;
+    }
+
+    MPERF_ALWAYS_INLINE void leave() {
+        uint64_t now[kSlots];
+        const bool counted = read(now);
+        RegionFrame& f = stack_[--depth_];
+        RegionStats& s = stats[f.id];
+        ++s.calls;
+        // a call the counters failed to read is counted by the wall time only
+        const int nr = counted && f.counted ? nr_events_ + 1 : 1;
+        for (int i = 0; i < nr; ++i) {
+            uint64_t d = now[i] - f.start[i];
+            s.inclusive[i] += d;
+            s.exclusive[i] += d - std::min(d, f.child[i]);
+            s.min[i] = std::min(s.min[i], d);
+            s.max[i] = std::max(s.max[i], d);
+            if (depth_ > 0) {
+                stack_[depth_ - 1].child[i] += d;
+            }
+        }
+    }
+
+    RegionStats stats[kMaxRegions];
+
+private:
+    // the wall time and the counters, false if the counters failed to read
+    MPERF_ALWAYS_INLINE bool read(uint64_t* out) {
+        out[0] = now_ns();
+#ifdef __linux__
+        if (nr_events_ > 0) {
+            if (!counters_.Snapshot(&values_)) {
+                return false;
+            }
+            for (int i = 0; i < nr_events_; ++i) {
+                out[i + 1] = values_[i];
+            }
+        }
+#endif
+        return true;
+    }
+
+    RegionFrame stack_[kMaxRegionDepth];
+    int depth_{0};
+    int nr_events_{0};
+    uint64_t generation_{0};
+    std::atomic<uint64_t> epoch_{0};
+#ifdef __linux__
+    PerfCounters counters_{PerfCounters::NoCounters()};
+    PerfCounterValues values_{0};
+#endif
+};
+
+void RegionTable::open(const CpuCounterSet2& events, uint64_t generation) {
+    close();
+    generation_ = generation;
+#ifdef __linux__
+    if (events.empty()) {
+        return;
+    }
+    try {
+        // one pinned group, so the events of a region are always counted
+        // together, read with rdpmc where the kernel allows it
+        counters_ = PerfCounters::Create(events, true, events.size(),
+                                         syscall(SYS_gettid));
+        values_.resize(events.size(), events.size());
+        nr_events_ = events.size();
+    } catch (const MperfError& e) {
+        // the wall time is still counted
+        mperf_log_warn("the region counters are not opened: %s", e.what());
+    }
+#endif
+}
+
+/** The regions of the process. */
+struct RegionState {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    CpuCounterSet2 events;
+    std::atomic<uint64_t> generation{0};
+    // the totals of the tables of an older epoch are cleared
+    std::atomic<uint64_t> epoch{0};
+    // the tables of the running threads
+    std::vector<RegionTable*> tables;
+    // the totals of the exited threads
+    RegionStats retired[kMaxRegions];
+    bool dump_at_exit{false};
+
+    RegionState() {
+        names.reserve(kMaxRegions);
+        for (auto& s : retired) {
+            s.clear();
+        }
+    }
+};
+
+// never destroyed, the threads may leave their regions after the statics
+// are gone
+RegionState& state() {
+    static RegionState* s = new RegionState();
+    return *s;
+}
+
+/** Retire the table of a thread as it exits. */
+struct RegionTableHolder {
+    RegionTable* table{nullptr};
+
+    ~RegionTableHolder() {
+        if (!table) {
+            return;
+        }
+        RegionState& st = state();
+        std::lock_guard<std::mutex> lock(st.mutex);
+        if (table->epoch() == st.epoch.load(std::memory_order_relaxed)) {
+            for (int i = 0; i < kMaxRegions; ++i) {
+                st.retired[i].merge(table->stats[i]);
+            }
+        }
+        st.tables.erase(std::find(st.tables.begin(), st.tables.end(), table));
+        delete table;
+    }
+};
+
+thread_local RegionTableHolder t_holder;
+
+RegionTable* thread_table() {
+    RegionTable* table = t_holder.table;
+    if (mperf_likely(table)) {
+        return table;
+    }
+    table = new RegionTable();
+    RegionState& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    st.tables.push_back(table);
+    t_holder.table = table;
+    return table;
+}
+
+void dump_regions_at_exit() {
+    region_dump(stdout);
+}
+}  // namespace
+
+bool detail::region_enter(int id) {
+    RegionTable* table = thread_table();
+    RegionState& st = state();
+    uint64_t epoch = st.epoch.load(std::memory_order_acquire);
+    if (mperf_unlikely(table->epoch() != epoch)) {
+        table->reset(epoch);
+    }
+    uint64_t generation = st.generation.load(std::memory_order_acquire);
+    if (mperf_unlikely(table->generation() != generation) &&
+        table->depth() == 0) {
+        CpuCounterSet2 events;
+        {
+            std::lock_guard<std::mutex> lock(st.mutex);
+            events = st.events;
+            generation = st.generation.load(std::memory_order_relaxed);
+        }
+        table->open(events, generation);
+    }
+    return table->enter(id);
+}
+
+void detail::region_leave() {
+    t_holder.table->leave();
+}
+
+void region_enable(const CpuCounterSet2& events, bool dump_at_exit) {
+#ifndef __linux__
+    mperf_throw(MperfError, "unsupport platform.");
+#endif
+    if (events.size() > (size_t)kMaxRegionEvents) {
+        mperf_throw(MperfError, "at most %d events are counted in regions.\n",
+                    kMaxRegionEvents);
+    }
+    RegionState& st = state();
+    {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.events = events;
+        // the tables reopen their counters when they are out of regions
+        st.generation.fetch_add(1, std::memory_order_release);
+        // the tables clear themselves, they are updated without a lock
+        st.epoch.fetch_add(1, std::memory_order_release);
+        for (auto& s : st.retired) {
+            s.clear();
+        }
+        if (dump_at_exit && !st.dump_at_exit) {
+            st.dump_at_exit = true;
+            atexit(dump_regions_at_exit);
+        }
+    }
+    detail::g_region_enabled.store(true, std::memory_order_release);
+}
+
+void region_disable() {
+    detail::g_region_enabled.store(false, std::memory_order_release);
+}
+
+void region_reset() {
+    RegionState& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    st.epoch.fetch_add(1, std::memory_order_release);
+    for (auto& s : st.retired) {
+        s.clear();
+    }
+}
+
+int region_register(const char* name) {
+    RegionState& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    for (size_t i = 0; i < st.names.size(); ++i) {
+        if (st.names[i] == name) {
+            return i;
+        }
+    }
+    if (st.names.size() == (size_t)kMaxRegions) {
+        mperf_log_warn("too many regions, %s is not counted\n", name);
+        return -1;
+    }
+    st.names.push_back(name);
+    return st.names.size() - 1;
+}
+
+std::vector<RegionReport> region_report() {
+    std::vector<RegionReport> reports;
+    RegionState& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    for (size_t id = 0; id < st.names.size(); ++id) {
+        RegionStats total = st.retired[id];
+        const uint64_t epoch = st.epoch.load(std::memory_order_relaxed);
+        for (auto table : st.tables) {
+            // not cleared yet by its thread
+            if (table->epoch() == epoch) {
+                total.merge(table->stats[id]);
+            }
+        }
+        if (total.calls == 0) {
+            continue;
+        }
+        RegionReport report;
+        report.name = st.names[id];
+        report.calls = total.calls;
+        for (size_t i = 0; i < st.events.size() + 1; ++i) {
+            report.counters.push_back(
+                    {i == 0 ? "time(ns)" : st.events[i - 1].name,
+                     total.inclusive[i], total.exclusive[i],
+                     // not counted, e.g. the counters failed to open
+                     total.min[i] == UINT64_MAX ? 0 : total.min[i],
+                     total.max[i]});
+        }
+        reports.push_back(report);
+    }
+    return reports;
+}
+
+void region_dump(FILE* fp) {
+    std::vector<RegionReport> reports = region_report();
+    fprintf(fp, "REGION RESULTS:\n");
+    fprintf(fp, "%-24s %10s %-20s %16s %16s %16s %16s\n", "region", "calls",
+            "counter", "inclusive", "exclusive", "min", "max");
+    for (auto& report : reports) {
+        for (size_t i = 0; i < report.counters.size(); ++i) {
+            const RegionCounter& c = report.counters[i];
+            fprintf(fp, "%-24s %10s %-20s %16lu %16lu %16lu %16lu\n",
+                    i == 0 ? report.name.c_str() : "",
+                    i == 0 ? std::to_string(report.calls).c_str() : "",
+                    c.name.c_str(), (unsigned long)c.inclusive,
+                    (unsigned long)c.exclusive, (unsigned long)c.min,
+                    (unsigned long)c.max);
+        }
+    }
+}
+
+}  // namespace mperf
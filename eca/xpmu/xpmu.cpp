@@ -2,7 +2,12 @@
 #include "mperf_build_config.h"
 
 #ifdef __linux__
+#include "mperf/cpu_info.h"
+#include "vendor/cpu/hybrid_profiler.h"
 #include "vendor/cpu/pmu_profiler.h"
+#include "vendor/cpu/sample_profiler.h"
+#include "vendor/cpu/system_profiler.h"
+#include "vendor/cpu/thread_profiler.h"
 #if MPERF_WITH_MALI
 #include "vendor/mali/mali_profiler.h"
 #endif
@@ -11,18 +16,25 @@
 #endif
 #endif
 
+#include <algorithm>
 #include <memory>
 
 namespace mperf {
 #if MPERF_WITH_PFM
 XPMU::XPMU(CpuCounterSet enabled_cpu_counters,
            GpuCounterSet enabled_gpu_counters) {
+    cpu_event_names_ = StrSplit(enabled_cpu_counters, ',');
+    cpu_event_attrs_.clear();
     create_profilers(std::move(enabled_cpu_counters),
                      std::move(enabled_gpu_counters));
 }
 #endif
 
 XPMU::XPMU(CpuCounterSet2 enabled_cpu_counters) {
+    for (auto& attr : enabled_cpu_counters) {
+        cpu_event_names_.push_back(attr.name);
+    }
+    cpu_event_attrs_ = enabled_cpu_counters;
     create_profilers(std::move(enabled_cpu_counters));
 }
 
@@ -32,20 +44,44 @@ XPMU::XPMU(GpuCounterSet enabled_gpu_counters) {
 
 #if MPERF_WITH_PFM
 void XPMU::set_enabled_cpu_counters(CpuCounterSet counters) {
+    cpu_event_names_ = StrSplit(counters, ',');
+    cpu_event_attrs_.clear();
     if (cpu_profiler_) {
         cpu_profiler_->set_enabled_counters(std::move(StrSplit(counters, ',')));
     } else {
         create_profilers(counters, {});
     }
+    cpu_profiler_group_size_ = cpu_group_size_;
+    update_cpu_overhead();
 }
 #endif
 
 void XPMU::set_enabled_cpu_counters(CpuCounterSet2 event_attrs) {
-    if (cpu_profiler_) {
+    cpu_event_names_.clear();
+    for (auto& attr : event_attrs) {
+        cpu_event_names_.push_back(attr.name);
+    }
+    cpu_event_attrs_ = event_attrs;
+    if (cpu_profiler_ && cpu_mode_of(event_attrs) == cpu_profiler_mode_ &&
+        cpu_target_pid_ == cpu_profiler_target_pid_ &&
+        cpu_target_exec_ == cpu_profiler_target_exec_ &&
+        (cpu_profiler_mode_ != CpuMode::SYSTEM_WIDE ||
+         cpu_system_wide_cpus_ == cpu_profiler_cpus_) &&
+        (cpu_profiler_mode_ != CpuMode::SAMPLING ||
+         (cpu_sample_period_ == cpu_profiler_sample_period_ &&
+          cpu_sample_freq_ == cpu_profiler_sample_freq_))) {
         cpu_profiler_->set_enabled_counters(event_attrs);
     } else {
+        if (cpu_profiler_) {
+            // close the counters of the profiler of the other mode(or of the
+            // other cpus)
+            cpu_profiler_->set_enabled_counters(CpuCounterSet2());
+            cpu_profiler_.reset();
+        }
         create_profilers(event_attrs);
     }
+    cpu_profiler_group_size_ = cpu_group_size_;
+    update_cpu_overhead();
 }
 
 void XPMU::set_enabled_gpu_counters(GpuCounterSet counters) {
@@ -62,6 +98,71 @@ void XPMU::set_cpu_uncore_event_enabled() {
     }
 }
 
+void XPMU::set_cpu_user_read_enabled(bool enabled) {
+    if (cpu_profiler_ && enabled != cpu_user_read_) {
+        // the counters are opened again
+        cpu_profiler_->set_user_read_enabled(enabled);
+        cpu_profiler_group_size_ = cpu_group_size_;
+    }
+    cpu_user_read_ = enabled;
+    update_cpu_overhead();
+}
+
+void XPMU::set_cpu_counter_group_size(size_t group_size) {
+    cpu_group_size_ = group_size;
+    if (cpu_profiler_) {
+        cpu_profiler_->set_counter_group_size(group_size);
+    }
+    update_cpu_overhead();
+}
+
+void XPMU::set_cpu_per_thread_enabled(bool enabled) {
+    if (enabled) {
+        cpu_mode_ = CpuMode::PER_THREAD;
+    } else if (cpu_mode_ == CpuMode::PER_THREAD) {
+        cpu_mode_ = CpuMode::CALLING_THREAD;
+    }
+}
+
+void XPMU::set_cpu_system_wide_enabled(bool enabled,
+                                       const std::vector<int>& cpus) {
+    if (enabled) {
+        cpu_mode_ = CpuMode::SYSTEM_WIDE;
+        cpu_system_wide_cpus_ = cpus;
+    } else if (cpu_mode_ == CpuMode::SYSTEM_WIDE) {
+        cpu_mode_ = CpuMode::CALLING_THREAD;
+    }
+}
+
+void XPMU::set_cpu_sampling_enabled(bool enabled, uint64_t period,
+                                    bool freq) {
+    if (enabled) {
+        cpu_mode_ = CpuMode::SAMPLING;
+        cpu_sample_period_ = period;
+        cpu_sample_freq_ = freq;
+    } else if (cpu_mode_ == CpuMode::SAMPLING) {
+        cpu_mode_ = CpuMode::CALLING_THREAD;
+    }
+}
+
+void XPMU::set_cpu_target_pid(pid_t pid, bool enable_on_exec) {
+    cpu_target_pid_ = pid;
+    cpu_target_exec_ = pid != 0 && enable_on_exec;
+}
+
+XPMU::CpuMode XPMU::cpu_mode_of(const CpuCounterSet2& event_attrs) const {
+    // the uncore events are counted by the calling thread
+    if (event_attrs.size() != 0 && event_attrs[0].is_uncore) {
+        return CpuMode::CALLING_THREAD;
+    }
+    // the threads a process created before are only found one by one
+    if (cpu_target_pid_ != 0 && !cpu_target_exec_ &&
+        cpu_mode_ == CpuMode::CALLING_THREAD) {
+        return CpuMode::PER_THREAD;
+    }
+    return cpu_mode_;
+}
+
 void XPMU::run() {
     if (cpu_profiler_) {
         cpu_profiler_->run();
@@ -69,12 +170,35 @@ void XPMU::run() {
     if (gpu_profiler_) {
         gpu_profiler_->run();
     }
+    if (background_sampler_) {
+        background_sampler_->start();
+    }
 }
 
 Measurements XPMU::sample() {
     Measurements m;
     if (cpu_profiler_) {
         m.cpu = &cpu_profiler_->sample();
+        if (cpu_overhead_subtraction_ && !cpu_overhead_.empty()) {
+            const CpuMeasurements& cpu = *m.cpu;
+            if (cpu_adjusted_.size() != cpu.size()) {
+                cpu_adjusted_ = cpu;
+            }
+            const size_t nr = std::min(cpu.size(), cpu_overhead_values_.size());
+            for (size_t i = 0; i < nr; ++i) {
+                uint64_t overhead = cpu_overhead_values_[i];
+                cpu_adjusted_[i].second =
+                        cpu[i].second > overhead ? cpu[i].second - overhead : 0;
+            }
+            m.cpu = &cpu_adjusted_;
+        }
+        m.cpu_overhead = &cpu_overhead_;
+        m.cpu_ratios = &cpu_profiler_->running_ratios();
+        m.cpu_parts = &cpu_profiler_->core_pmu_measurements();
+        m.cpu_threads = &cpu_profiler_->thread_measurements();
+        m.cpu_cores = &cpu_profiler_->core_measurements();
+        m.cpu_clusters = &cpu_profiler_->cluster_measurements();
+        m.cpu_hotspots = &cpu_profiler_->hotspots();
     }
     if (gpu_profiler_) {
         m.gpu = &gpu_profiler_->sample();
@@ -82,7 +206,144 @@ Measurements XPMU::sample() {
     return m;
 }
 
+CpuValues XPMU::sample_cpu_values() {
+    if (!cpu_profiler_) {
+        return {nullptr, 0};
+    }
+    CpuValues values = cpu_profiler_->sample_values();
+    if (!cpu_overhead_subtraction_ || cpu_overhead_.empty()) {
+        return values;
+    }
+    // sized once per counter set
+    cpu_adjusted_values_.resize(values.size);
+    const size_t nr = std::min(values.size, cpu_overhead_values_.size());
+    for (size_t i = 0; i < values.size; ++i) {
+        uint64_t overhead = i < nr ? cpu_overhead_values_[i] : 0;
+        cpu_adjusted_values_[i] =
+                values[i] > overhead ? values[i] - overhead : 0;
+    }
+    return {cpu_adjusted_values_.data(), cpu_adjusted_values_.size()};
+}
+
+const CpuMeasurements& XPMU::calibrate_cpu_overhead(size_t iter_num) {
+    cpu_overhead_.clear();
+    cpu_overhead_values_.clear();
+    cpu_adjusted_.clear();
+    if (!cpu_profiler_) {
+        return cpu_overhead_;
+    }
+    if (cpu_profiler_mode_ != CpuMode::CALLING_THREAD &&
+        cpu_profiler_mode_ != CpuMode::PER_THREAD) {
+        mperf_throw(MperfError,
+                    "the overhead is only calibrated in the calling thread "
+                    "and the per-thread modes.\n");
+    }
+    // the first sessions fault the code and the buffers in
+    const size_t warmup = 10;
+    iter_num = std::max<size_t>(iter_num, 1);
+    std::vector<std::vector<uint64_t>> counts;
+    for (size_t it = 0; it < warmup + iter_num; ++it) {
+        cpu_profiler_->run();
+        CpuValues values = cpu_profiler_->sample_values();
+        cpu_profiler_->stop();
+        if (it < warmup) {
+            continue;
+        }
+        counts.resize(values.size);
+        for (size_t i = 0; i < values.size; ++i) {
+            counts[i].push_back(values[i]);
+        }
+    }
+    for (size_t i = 0; i < counts.size(); ++i) {
+        std::vector<uint64_t>& c = counts[i];
+        std::nth_element(c.begin(), c.begin() + c.size() / 2, c.end());
+        cpu_overhead_values_.push_back(c[c.size() / 2]);
+        cpu_overhead_.emplace_back(
+                i < cpu_event_names_.size() ? cpu_event_names_[i] : "",
+                c[c.size() / 2]);
+    }
+    cpu_overhead_cache_[cpu_counters_key()] = cpu_overhead_;
+    return cpu_overhead_;
+}
+
+void XPMU::set_cpu_overhead_subtraction_enabled(bool enabled,
+                                                size_t iter_num) {
+    cpu_overhead_subtraction_ = enabled;
+    cpu_overhead_iter_num_ = iter_num;
+    update_cpu_overhead();
+}
+
+std::string XPMU::cpu_counters_key() const {
+    // the sessions of the modes, of the user space reads and of the group
+    // sizes cost differently
+    std::string key = std::to_string(static_cast<int>(cpu_profiler_mode_)) +
+                      (cpu_profiler_ && cpu_profiler_->is_user_read() ? ",u"
+                                                                      : ",k") +
+                      "," + std::to_string(cpu_profiler_group_size_);
+    for (auto& name : cpu_event_names_) {
+        key += "," + name;
+    }
+    return key;
+}
+
+void XPMU::update_cpu_overhead() {
+    cpu_overhead_.clear();
+    cpu_overhead_values_.clear();
+    cpu_adjusted_.clear();
+    if (!cpu_profiler_) {
+        return;
+    }
+    auto cached = cpu_overhead_cache_.find(cpu_counters_key());
+    if (cached != cpu_overhead_cache_.end()) {
+        cpu_overhead_ = cached->second;
+        for (auto& m : cpu_overhead_) {
+            cpu_overhead_values_.push_back(m.second);
+        }
+    } else if (cpu_overhead_subtraction_) {
+        calibrate_cpu_overhead(cpu_overhead_iter_num_);
+    }
+}
+
+int XPMU::cpu_event_id(const std::string& name) const {
+    for (size_t i = 0; i < cpu_event_names_.size(); ++i) {
+        if (cpu_event_names_[i] == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+BackgroundSampler& XPMU::start_background_sampling(uint64_t period_us,
+                                                   size_t capacity, int cpu) {
+    stop_background_sampling();
+    background_sampler_.reset(
+            new BackgroundSampler(this, period_us, capacity, cpu));
+    // the counters opened before the sampler thread would count it by
+    // inheritance, so they are opened again
+    if (cpu_profiler_) {
+#if MPERF_WITH_PFM
+        if (cpu_event_attrs_.empty()) {
+            std::string counters;
+            for (auto& name : cpu_event_names_) {
+                counters += (counters.empty() ? "" : ",") + name;
+            }
+            set_enabled_cpu_counters(counters);
+            return *background_sampler_;
+        }
+#endif
+        set_enabled_cpu_counters(cpu_event_attrs_);
+    }
+    return *background_sampler_;
+}
+
+void XPMU::stop_background_sampling() {
+    if (background_sampler_) {
+        background_sampler_->stop();
+    }
+}
+
 void XPMU::stop() {
+    stop_background_sampling();
     if (cpu_profiler_) {
         cpu_profiler_->stop();
     }
@@ -97,7 +358,11 @@ void XPMU::create_profilers(CpuCounterSet enabled_cpu_counters,
 #ifdef __linux__
     if (enabled_cpu_counters.size() != 0) {
         cpu_profiler_ = std::unique_ptr<PmuProfiler>(
-                new PmuProfiler(StrSplit(enabled_cpu_counters, ',')));
+                new PmuProfiler(StrSplit(enabled_cpu_counters, ','), false,
+                                cpu_group_size_));
+        if (cpu_user_read_) {
+            cpu_profiler_->set_user_read_enabled(true);
+        }
     }
 
     if (enabled_gpu_counters.size() != 0) {
@@ -135,8 +400,58 @@ void XPMU::create_profilers(GpuCounterSet enabled_gpu_counters) {
 void XPMU::create_profilers(CpuCounterSet2 enabled_cpu_counters) {
 #ifdef __linux__
     if (enabled_cpu_counters.size() != 0) {
-        cpu_profiler_ = std::unique_ptr<PmuProfiler>(
-                new PmuProfiler(enabled_cpu_counters));
+        // the pmus of a system do not change
+        static const std::vector<CpuCorePmu> core_pmus = cpu_info_core_pmus();
+        auto create = [](const CpuCounterSet2& event_attrs, size_t group_size,
+                         pid_t tid,
+                         bool enable_on_exec) -> std::unique_ptr<CpuProfiler> {
+            if (core_pmus.size() > 1) {
+                return std::unique_ptr<HybridPmuProfiler>(
+                        new HybridPmuProfiler(core_pmus, event_attrs,
+                                              group_size, tid, enable_on_exec));
+            }
+            return std::unique_ptr<PmuProfiler>(new PmuProfiler(
+                    event_attrs, false, group_size, tid, -1, enable_on_exec));
+        };
+        auto factory = [create](const CpuCounterSet2& event_attrs,
+                                size_t group_size, pid_t tid) {
+            return create(event_attrs, group_size, tid, false);
+        };
+        cpu_profiler_mode_ = cpu_mode_of(enabled_cpu_counters);
+        cpu_profiler_target_pid_ = cpu_target_pid_;
+        cpu_profiler_target_exec_ = cpu_target_exec_;
+        if (cpu_target_pid_ != 0 &&
+            (cpu_profiler_mode_ == CpuMode::SAMPLING ||
+             cpu_profiler_mode_ == CpuMode::SYSTEM_WIDE)) {
+            mperf_throw(MperfError,
+                        "the sampling and the system-wide modes can not "
+                        "count another process.\n");
+        }
+        if (cpu_profiler_mode_ == CpuMode::PER_THREAD) {
+            cpu_profiler_ = std::unique_ptr<ThreadPmuProfiler>(
+                    new ThreadPmuProfiler(factory, enabled_cpu_counters,
+                                          cpu_group_size_, cpu_target_pid_));
+        } else if (cpu_profiler_mode_ == CpuMode::SAMPLING) {
+            cpu_profiler_sample_period_ = cpu_sample_period_;
+            cpu_profiler_sample_freq_ = cpu_sample_freq_;
+            cpu_profiler_ = std::unique_ptr<SamplePmuProfiler>(
+                    new SamplePmuProfiler(enabled_cpu_counters,
+                                          cpu_sample_period_, cpu_sample_freq_,
+                                          cpu_group_size_));
+        } else if (cpu_profiler_mode_ == CpuMode::SYSTEM_WIDE) {
+            cpu_profiler_cpus_ = cpu_system_wide_cpus_;
+            cpu_profiler_ = std::unique_ptr<SystemPmuProfiler>(
+                    new SystemPmuProfiler(core_pmus, enabled_cpu_counters,
+                                          cpu_group_size_,
+                                          cpu_system_wide_cpus_));
+        } else {
+            cpu_profiler_ = create(enabled_cpu_counters, cpu_group_size_,
+                                   cpu_target_pid_, cpu_target_exec_);
+        }
+        // the profilers of the other modes warn that they can not
+        if (cpu_user_read_) {
+            cpu_profiler_->set_user_read_enabled(true);
+        }
     }
 #else
     mperf_thorw(MperfError, "ERROR: unsupport platform.");
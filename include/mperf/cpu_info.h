@@ -12,8 +12,12 @@
  */
 #pragma once
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <map>
 #include <string>
+#include <vector>
+#include "mperf/pmu_types.h"
 
 namespace mperf {
 // print cpu supported features
@@ -78,6 +82,15 @@ int cpu_info_get_max_freq_khz(int cpuid);
 int cpu_info_get_cpu_powersave();
 int cpu_info_set_cpu_powersave(int powersave);
 
+// the cpus of a cluster told apart by the max frequency, numbered as the
+// powersave above(1 = little, 2 = middle, 3 = big), every cpu if 0
+std::vector<int> cpu_info_get_cluster_cpus(int cluster);
+// the cpus of a list of the sysfs like "0-7,16,18-19"
+std::vector<int> cpu_info_parse_cpu_list(const char* list);
+// the online cpus, from <root>/sys/devices/system/cpu/online, every cpu if
+// it can not be read
+std::vector<int> cpu_info_online_cpus(const std::string& root = "");
+
 // need to flush denormals on Intel Chipset.
 // Other architectures such as ARM can be added as needed.
 // 0 = DAZ OFF, FTZ OFF
@@ -94,4 +107,34 @@ uint64_t cpu_info_ref_cycles(int dev_id = 0);
 
 double cpu_thread_time_ms();
 double cpu_process_time_ms();
+
+// the micro-architecture of a MIDR_EL1 value / x86 cpuid family, model and
+// stepping, DEFAULT if unknown.
+MPFXPUType cpu_info_xpu_type_from_midr(uint64_t midr);
+MPFXPUType cpu_info_xpu_type_from_x86(int family, int model,
+                                      int stepping = 0);
+// the micro-architecture of every cpu core, keyed by the core id, from
+// <root>/sys/devices/system/cpu/cpu*/regs/identification/midr_el1 or
+// <root>/proc/cpuinfo, and cpuid on x86 if neither is available. The atom
+// cores of the hybrid intel parts are told apart by the cpu_atom pmu. root is
+// empty on a real system, and a fake tree for testing.
+std::map<int, MPFXPUType> cpu_info_xpu_types(const std::string& root = "");
+// the micro-architecture of the given core, the current core if cpuid < 0
+MPFXPUType cpu_info_xpu_type(int cpuid = -1);
+
+// a core pmu and the cpus it counts on. The hybrid systems have one per core
+// type, e.g. cpu_core and cpu_atom of alder lake or one per cluster of the arm
+// DynamIQ SoCs, and an event only counts on the cpus of the pmu it is opened
+// on.
+struct CpuCorePmu {
+    std::string name;
+    // the perf_event_attr.type of the pmu
+    uint32_t type;
+    std::vector<int> cpus;
+    MPFXPUType xpu_type;
+};
+// the core pmus listing their cpus in <root>/sys/bus/event_source/devices/
+// */cpus, sorted by their first cpu. More than one means a hybrid system,
+// empty if the cores share one pmu without a cpus file(e.g. x86 non-hybrid).
+std::vector<CpuCorePmu> cpu_info_core_pmus(const std::string& root = "");
 }  // namespace mperf
\ No newline at end of file
@@ -283,6 +283,7 @@ public:
     float insts_gflops_latency() const;
     void ensure_min_niter(double min_time_us, int& niter,
                           std::function<double()> run);
+    // the median us of the kernel over at least iters runs, cf. Repeater
     float bench_kernel(cl_kernel kern, const NDRange& global_size,
                        const NDRange& local_size, size_t iters) const;
     float execute_kernel(cl_kernel kern, const NDRange& global_size,
@@ -0,0 +1,115 @@
+/**
+ * \file include/mperf/pmu_events.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "mperf/pmu_types.h"
+
+namespace mperf {
+/** A pmu of <root>/sys/bus/event_source/devices, as perf sees it. */
+struct SysfsPmu {
+    // the bits of a format field in perf_event_attr, e.g. "config:0-7,32-35"
+    struct Field {
+        // 0 for config, 1 for config1 and 2 for config2
+        int config{0};
+        // the low bits of a value fill the first ones
+        std::vector<int> bits;
+    };
+
+    std::string name;
+    // the perf_event_attr.type of the pmu
+    uint32_t type{0};
+    // the cpus of the cpus file of a core pmu, or of the cpumask of an uncore
+    // one, empty if the pmu counts on every cpu(e.g. the software events)
+    std::vector<int> cpus;
+    bool is_uncore{false};
+    std::map<std::string, Field> formats;
+    // the terms of the events the pmu names, e.g. "event=0x3c,umask=0x0"
+    std::map<std::string, std::string> events;
+};
+
+/** An instance of an uncore pmu and the cpu to open its events on. */
+struct UncoreInstance {
+    // e.g. uncore_imc_3, arm_dsu_0
+    std::string pmu;
+    uint32_t type;
+    // a cpu of the cpumask of the pmu, one per socket
+    int cpu;
+};
+
+/** Encode the perf style event strings by the pmus of the sysfs. */
+// The events are the strings `perf stat -e` takes for a pmu, without libpfm:
+//     armv8_pmuv3_0/event=0x24/
+//     cpu/event=0x3c,umask=0x1,cmask=1,name=cycles_c1/
+//     arm_dsu_0/cycles/
+//     uncore_imc/cas_count_read/
+//     cpu/cpu-cycles/k
+//     cpu/instructions/uk
+// A term is field=value, a flag field(e.g. edge, for edge=1), an event
+// named by the pmu, or name=NAME to name the event(the string itself by
+// default). The modifiers count the user space(u), the kernel(k) or both
+// (uk), the user space only without them.
+class PmuEventParser {
+public:
+    // the pmus of <root>/sys/bus/event_source/devices, root is empty on a
+    // real system, and a fake tree for testing
+    explicit PmuEventParser(const std::string& root = "");
+
+    const std::vector<SysfsPmu>& pmus() const { return m_pmus; }
+    // the pmu of the name, nullptr if there is none
+    const SysfsPmu* pmu(const std::string& name) const;
+
+    // The instances of the uncore pmu of the type, once per cpu of its
+    // cpumask, and with all_instances those of its siblings, the pmus named
+    // alike but the trailing number(e.g. uncore_imc_0 ... uncore_imc_7,
+    // uncore_cha_*, arm_cmn_*). An event of the pmu is counted on all of
+    // them. Only the type on cpu 0 if no uncore pmu has the type.
+    std::vector<UncoreInstance> uncore_instances(
+            uint32_t type, bool all_instances = true) const;
+
+    // Throw MperfError if the string is not an event of a pmu. An uncore
+    // event of a numbered pmu(e.g. uncore_imc_3) counts on that pmu only,
+    // one of the family(uncore_imc) or a wildcard(uncore_imc_*) on all the
+    // instances of the family.
+    EventAttr parse(const std::string& event) const;
+    // the events of a comma separated list, the commas between the slashes
+    // separate the terms
+    std::vector<EventAttr> parse_list(const std::string& events) const;
+
+private:
+    // the pmu of the name of an event, or the first one of the family it
+    // names, and whether the event counts on all the instances
+    const SysfsPmu* event_pmu(const std::string& name,
+                              bool* all_instances) const;
+
+    std::vector<SysfsPmu> m_pmus;
+};
+
+// encode an event by the pmus of the system, read once
+EventAttr parse_pmu_event(const std::string& event);
+// the uncore instances by the pmus of the system, read once
+std::vector<UncoreInstance> uncore_pmu_instances(uint32_t type,
+                                                 bool all_instances = true);
+// the counter of an uncore event on one instance, "event[pmu:cpuN]"
+std::string uncore_instance_name(const std::string& event,
+                                 const UncoreInstance& instance);
+// the event of a counter of uncore_instance_name, the name itself otherwise
+std::string uncore_event_name(const std::string& counter);
+// apply the modifiers of perf to the event: u counts the user space, k the
+// kernel and uk both, nothing changes without them. false if there is
+// another modifier
+bool apply_event_modifiers(const std::string& modifiers, EventAttr& attr);
+// split a comma separated list of events, the commas between the slashes
+// separate the terms of an event
+std::vector<std::string> split_pmu_events(const std::string& events);
+
+}  // namespace mperf
@@ -9,7 +9,7 @@ namespace mperf {
 enum MPFXPUType {
     DEFAULT,
     SNB_CLIENT,
-    // JKT_SERVER,
+    JKT_SERVER,
     IVB_CLIENT,
     IVB_SERVER,
     HSW_CLIENT,
@@ -18,12 +18,12 @@ enum MPFXPUType {
     BDX_SERVER,
     SKL_CLIENT,
     SKX_SERVER,
-    // CLX_SERVER,
+    CLX_SERVER,
     ICL_CLIENT,
     ICX_SERVER,
-    // ADL_GLC,
-    // ADL_GRT,
-    // SPR_SERVER,
+    ADL_GLC,
+    ADL_GRT,
+    SPR_SERVER,
     A55,
     A510
 };
@@ -42,24 +42,31 @@ public:
      *  \param[_config1] is used for setting events that need an extra
      *  register or otherwise do not fit in the regular config field,
      *  e.g. the offcore event of intel_x86 offcore pmu.
+     *  \param[_ek] exclude kernel, the count excludes events that happen
+     *  in the kernel. -1 follows _eu: the user space only by default, the
+     *  kernel only if the user space is excluded. 0 with _eu 0 counts both.
      */
     EventAttr(std::string _name = "", uint64_t _config = 0, uint32_t _t = 4,
-              int _eu = 0, bool _is_uncore = false, uint64_t _config1 = 0)
+              int _eu = 0, bool _is_uncore = false, uint64_t _config1 = 0,
+              int _ek = -1)
             : name(_name),
               config(_config),
               type(_t),
               exclude_user(_eu),
               is_uncore(_is_uncore),
-              config1(_config1) {}
+              config1(_config1),
+              exclude_kernel(_ek < 0 ? !_eu : _ek) {}
 
     bool operator!=(const EventAttr& rhs) const {
         return name != rhs.name || config != rhs.config || type != rhs.type ||
-               exclude_user != rhs.exclude_user;
+               exclude_user != rhs.exclude_user ||
+               exclude_kernel != rhs.exclude_kernel;
     }
 
     bool operator==(const EventAttr& rhs) const {
         return name == rhs.name && config == rhs.config && type == rhs.type &&
-               exclude_user == rhs.exclude_user;
+               exclude_user == rhs.exclude_user &&
+               exclude_kernel == rhs.exclude_kernel;
     }
 
     bool operator<(const EventAttr& rhs) const { return name < rhs.name; }
@@ -70,6 +77,10 @@ public:
     int exclude_user;
     bool is_uncore;
     uint64_t config1;
+    int exclude_kernel;
+    // an uncore event counts on every instance of the family of its pmu(cf.
+    // uncore_pmu_instances), false on the numbered pmu of the event only
+    bool all_instances{true};
 };
 
 }  // namespace mperf
\ No newline at end of file
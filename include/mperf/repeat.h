@@ -0,0 +1,88 @@
+/**
+ * \file include/mperf/repeat.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace mperf {
+/** The statistics of the samples of a quantity, without the outliers. */
+struct SampleStats {
+    // the samples kept, and the outliers discarded
+    size_t count{0};
+    size_t outliers{0};
+    double mean{0};
+    double median{0};
+    // the median absolute deviation from the median
+    double mad{0};
+    double p5{0};
+    double p95{0};
+    // the bootstrap confidence interval of the median
+    double ci_low{0};
+    double ci_high{0};
+
+    // the half width of the confidence interval relative to the median
+    double rel_ci() const;
+};
+
+struct RepeatOptions {
+    size_t min_reps{5};
+    size_t max_reps{100};
+    // stop once the relative half width of the confidence interval of every
+    // quantity is below it
+    double target_rel_ci{0.01};
+    // stop anyway after min_reps when the repetitions took longer, in seconds
+    double time_budget{1.0};
+    double confidence{0.95};
+    size_t bootstrap{200};
+    // discard the samples farther than outlier_mads standard deviations(as
+    // estimated by the MAD) from the median, 0 keeps all the samples
+    double outlier_mads{3.0};
+};
+
+SampleStats compute_sample_stats(const std::vector<double>& samples,
+                                 const RepeatOptions& opts = RepeatOptions());
+
+/** Repeat a measurement until its statistics are stable. */
+// Record the quantities(e.g. the time and the counts) of every repetition:
+//     Repeater rep;
+//     while (rep.next()) {
+//         WallTimer t;
+//         work();
+//         rep.record("time", t.get_msecs());
+//     }
+//     double ms = rep.stats("time").median;
+class Repeater {
+public:
+    explicit Repeater(const RepeatOptions& opts = RepeatOptions());
+
+    // whether to run one more repetition
+    bool next();
+    void record(const std::string& name, double value);
+
+    size_t repetitions() const { return reps_; }
+    // whether every quantity reached the target confidence interval
+    bool converged() const { return converged_; }
+    // the quantities in the order they were first recorded
+    const std::vector<std::string>& names() const { return names_; }
+    const std::vector<double>& samples(const std::string& name) const;
+    SampleStats stats(const std::string& name) const;
+
+private:
+    RepeatOptions opts_;
+    std::vector<std::string> names_;
+    std::vector<std::vector<double>> samples_;
+    size_t reps_{0};
+    bool converged_{false};
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace mperf
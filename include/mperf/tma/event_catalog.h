@@ -0,0 +1,28 @@
+/**
+ * \file include/mperf/tma/event_catalog.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include "mperf/pmu_types.h"
+
+namespace mperf {
+namespace tma {
+// The events of the compiled-in catalog of a cpu, the events the TMA ratio
+// tables of the cpu use(cf. eca/tma/arch_ratios/gen_event_catalog.py). The
+// lookups hash the name once, with no table to build at runtime.
+
+// the event of the name, false if it is not in the catalog of the cpu or the
+// catalog has no encoding of it(e.g. an x86 event missing from the pinned
+// pmu-events json, cf. fetch_pmu_events.sh)
+bool catalog_event(MPFXPUType t, const std::string& name, EventAttr& attr);
+// the sorted names of the encoded events of the catalog, empty if the cpu has
+// none
+std::vector<std::string> catalog_event_names(MPFXPUType t);
+}  // namespace tma
+}  // namespace mperf
@@ -9,29 +9,161 @@
 #pragma once
 #include <stdint.h>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
+#include "mperf/cpu_info.h"
 #include "mperf/pmu_types.h"
+#include "mperf/repeat.h"
 #include "mperf/xpmu/xpmu.h"
 
 namespace mperf {
 namespace tma {
 
 class ArchRatioSetup;
+class MetricDag;
+class X86EventMap;
+
+// The metric values of one interval in the interval mode.
+struct TMAInterval {
+    // the end of the interval, in ms since start_interval
+    float timestamp_ms;
+    // the values of the metrics, in the order passed to init
+    std::vector<float> values;
+    // the counts of the events in the interval
+    std::vector<std::pair<std::string, uint64_t>> counts;
+};
+
 class MPFTMA {
 public:
+    // Every MPFTMA is an independent session with its own metrics and
+    // counters, sessions can run concurrently on different threads.
+    // DEFAULT detects the micro-architecture of the current core, pin the
+    // thread to the cluster to profile on a heterogeneous SoC. On a hybrid
+    // system with a pmu per core type, the session is bound to the pmu of the
+    // current core as well.
     explicit MPFTMA(MPFXPUType t);
+    // A session counting on the cores of one core pmu of a hybrid system with
+    // the ratio table of their type, e.g. one session for each of
+    // cpu_info_core_pmus(). The raw events are opened on the pmu, so they
+    // only count while the task runs on its cores.
+    explicit MPFTMA(const CpuCorePmu& pmu);
+    ~MPFTMA();
+    MPFTMA(const MPFTMA&) = delete;
+    MPFTMA& operator=(const MPFTMA&) = delete;
 
-    int init(std::vector<std::string> metrics);
+    // The events are packed into groups by the metrics depending on them, so
+    // that each metric is computed from the counts of a single run(group).
+    // If multiplex is true, all the events are collected in a single run and
+    // the kernel multiplexes them onto the hardware counters, so group_num()
+    // is 1. The counts are scaled estimates, which need a long enough run.
+    int init(std::vector<std::string> metrics, bool multiplex = false);
+    // Load the raw event map of the cpu(e.g. dumped by toplev.py
+    // --dump-raw-events) before init, it encodes the x86 events the ratio
+    // tables do not, and overrides the ones they do. The map in the env
+    // MPERF_TMA_EVENT_MAP is loaded on construction. Returns the number of
+    // the events loaded.
+    size_t load_event_map(const std::string& path);
+    // Drill-down mode: the metrics are collected level by level, a metric of
+    // level n is collected only if the thresh of its parent(the nearest
+    // requested ancestor) fired at level n - 1. Call next_level() before the
+    // runs of every level, it returns false when nothing is left to collect:
+    //     while (tma.next_level()) {
+    //         for (size_t i = 0; i < tma.group_num(); ++i) { ...runs... }
+    //     }
+    int init_drilldown(std::vector<std::string> metrics);
+    bool next_level();
     // int init(const std::string& metric_group);
-    // call after init
+    // call after init, the number of groups of the current level in the
+    // drill-down mode
     size_t group_num() const;
     size_t uncore_events_num() const;
+    // Per-thread mode, call before start: every thread of the process is
+    // counted on its own, including the ones created after start, and the
+    // metrics of each thread are reported besides the ones of the process.
+    // The threads created after start are counted from the next sample.
+    void set_per_thread_enabled(bool enabled);
+    // count the process pid instead of the calling thread, call before
+    // start, cf. XPMU::set_cpu_target_pid. The uncore events are system wide
+    // anyway.
+    void set_target_pid(pid_t pid, bool enable_on_exec = false);
+    // the metrics of each thread in the per-thread mode, keyed by the tid,
+    // call before deinit
+    std::vector<std::pair<int, std::vector<float>>> thread_metrics();
+    // Subtract the overhead of a start/sample pair from the core events,
+    // call before start: the first start of each group calibrates it by
+    // iter_num empty sessions, cf. XPMU::calibrate_cpu_overhead. It matters
+    // for the tiny kernels run a few times a sample. The uncore events and
+    // the interval mode are never subtracted.
+    void set_overhead_subtraction_enabled(bool enabled, size_t iter_num = 1000);
     int start(size_t group_id = 0);
-    int start_uncore(size_t evt_idx = 0);
+    // Count the uncore events, all of them in one run by default, or the
+    // evt_idx-th one. Each event is counted on every instance of its pmu(e.g.
+    // every imc channel of every socket) and their counts add up to it.
+    static constexpr size_t kAllUncoreEvents = static_cast<size_t>(-1);
+    int start_uncore(size_t evt_idx = kAllUncoreEvents);
+    // the counts of the instances of the uncore events by the last sample,
+    // per iteration, e.g. UNC_M_CAS_COUNT.RD[uncore_imc_3:cpu28], cf.
+    // uncore_instance_name. Empty if the pmus have one instance.
+    const std::vector<std::pair<std::string, float>>& uncore_instance_values()
+            const {
+        return m_uncore_instance_values;
+    }
     int sample(size_t iter_num);
     int sample_and_stop(size_t iter_num);
+    // Repeat start(group_id), workload and sample_and_stop(iter_num) until
+    // the count of every event of the group is stable(cf. Repeater), and
+    // take the medians without the outliers as the values of the group.
+    // The statistics of the events and of time_interval are stored in stats
+    // if it is not null. The per-thread values are of the last repetition.
+    int sample_repeated(
+            size_t group_id, size_t iter_num,
+            const std::function<void()>& workload,
+            std::vector<std::pair<std::string, SampleStats>>* stats = nullptr);
+    void set_repeat_options(const RepeatOptions& opts) {
+        m_repeat_options = opts;
+    }
+
+    // Interval mode, call after init: the workload runs once between
+    // start_interval and stop_interval on the calling thread, all the events
+    // are multiplexed by the kernel, and a background thread samples them
+    // every interval_ms to compute the metrics of each interval. The thread
+    // is created before the counters are opened, so it is not counted.
+    int start_interval(size_t interval_ms);
+    // called by the sampler thread with every interval as it ends, before
+    // start_interval
+    void set_interval_callback(
+            const std::function<void(const TMAInterval&)>& callback) {
+        m_interval_callback = callback;
+    }
+    // stop the sampler, returns the metrics of every interval(also printed
+    // by deinit).
+    const std::vector<TMAInterval>& stop_interval();
+
+    // Offline mode: save the raw counts sampled so far(of every group, or
+    // of every interval) with the micro-architecture and the metrics to a
+    // trace(cf. mperf/trace.h), call before deinit. The per-thread counts
+    // are not saved.
+    int save_record(const std::string& path);
+    // the micro-architecture of a record, to create the session loading it
+    static MPFXPUType record_xpu_type(const std::string& path);
+    // Evaluate a record of save_record on any host instead of sampling, e.g.
+    // a host built with MPERF_ENABLE_TMA_ALL_ARCHS for the records of a
+    // phone: the session is initialized as by init(metrics), empty metrics
+    // are the recorded ones, and deinit prints the results. The metrics
+    // depending on the events not in the record are NAN.
+    int load_record(const std::string& path,
+                    std::vector<std::string> metrics = {});
+    // the metrics of the counts sampled or loaded so far, in the order passed
+    // to init, NAN for the ones not collected in the drill-down mode. Call
+    // before deinit.
+    std::vector<float> metric_values();
+
     int deinit();
 
 private:
@@ -39,20 +171,81 @@ private:
     using time_point = clock::time_point;
     time_point m_start_point;
 
+    MPFTMA(MPFXPUType t, const CpuCorePmu* pmu);
+
     MPFXPUType m_xpu_type;
+    // the perf_event_attr.type the raw events are opened with
+    uint32_t m_pmu_type;
     ArchRatioSetup* m_ratio_setup;
+    X86EventMap* m_event_map;
     XPMU* m_xpmu;
     std::vector<std::string> m_metrics;
     std::set<EventAttr> m_events;
     std::set<EventAttr> m_uncore_events;
-    std::vector<std::pair<std::string, float>> m_duration;
+    // the events each metric depends on, and the groups they are counted in
+    std::vector<std::set<EventAttr>> m_metric_events;
+    std::vector<std::vector<EventAttr>> m_groups;
+    std::vector<size_t> m_metric_groups;
+    // the metrics collected, all of them unless in the drill-down mode
+    std::vector<bool> m_metric_active;
+    // the metrics and their events compiled at init, and the node of each
+    // metric
+    MetricDag* m_dag;
+    std::vector<size_t> m_metric_nodes;
+    // the sampled value of each event slot, a row per group, and the values
+    // merging all the groups. NAN if the event was not sampled.
+    std::vector<float> m_slot_values;
+    std::vector<float> m_merged_values;
+    // the sampled values of each thread in the per-thread mode, the values
+    // not sampled per thread(e.g. the uncore events) are taken from the ones
+    // of the process
+    struct ThreadValues {
+        std::vector<float> slot_values;
+        std::vector<float> merged_values;
+    };
+    std::map<int, ThreadValues> m_thread_values;
+    bool m_per_thread;
+    bool m_subtract_overhead;
+    RepeatOptions m_repeat_options;
+    size_t m_overhead_iter_num;
+
+    // the interval mode sampler
+    std::thread m_sampler;
+    std::mutex m_sampler_mutex;
+    std::condition_variable m_sampler_cv;
+    std::function<void(const TMAInterval&)> m_interval_callback;
+    bool m_sampler_stop;
+    // the counters of the intervals are running
+    bool m_sampler_started;
+    size_t m_interval_ms;
+    std::vector<TMAInterval> m_intervals;
+    // the groups of the current level are [m_group_base, m_group_base +
+    // m_group_num) of m_groups
     size_t m_group_num;
+    size_t m_group_base;
     size_t m_group_id;
+    int m_level;
+    bool m_drilldown;
     size_t m_uncore_events_num;
+    std::vector<std::pair<std::string, float>> m_uncore_instance_values;
+    bool m_multiplex;
     bool m_binit;
+    // the values are loaded from a record
+    bool m_offline;
 
-    float ev_collect(EventAttr event, int level);
-    float ev_query(EventAttr event, int level);
+    // the slot of an event of the formulas
+    size_t ev_collect(EventAttr event, int level);
+    void collect(const std::vector<std::string>& metrics);
+    // schedule the events of the metrics into the groups of a new level
+    void schedule(const std::vector<size_t>& metric_ids);
+    // record the sampled value of an event, of a thread if tv is given
+    void set_value(const std::string& name, float value,
+                   ThreadValues* tv = nullptr);
+    // evaluate the metrics from the sampled values
+    void evaluate(std::vector<float>& res);
+    void sampler_loop();
+    // release the counters and the state of init
+    void release();
     bool is_cpu() const;
 };
 
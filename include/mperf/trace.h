@@ -0,0 +1,186 @@
+/**
+ * \file include/mperf/trace.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "mperf/pmu_types.h"
+#include "mperf/utils.h"
+
+namespace mperf {
+// The binary trace of the counter time series, in the native byte order:
+//     TraceHeader
+//     TraceEventEntry and the name(padded to 8 bytes) of every counter
+//     the info text of the writer(padded to 8 bytes), if any
+//     blocks, each a TraceBlockHeader and its payload(padded to 8 bytes)
+// A record block holds `count` records column by column, so every column is
+// an array in the file:
+//     uint64_t timestamp_ns[count]  since the start of the trace
+//     uint32_t region[count]        padded to 8 bytes
+//     uint64_t counter_k[count]     for every counter k
+// A region block names the region ids, as `count` entries of {uint32_t id,
+// uint32_t size, char name[size]} padded to 8 bytes each. The blocks are
+// only appended, a trace cut short(e.g. by a crash) is read up to its last
+// complete block.
+constexpr char kTraceMagic[8] = {'M', 'P', 'F', 'T', 'R', 'A', 'C', 'E'};
+// bumped for the changes an older reader can not read
+constexpr uint32_t kTraceVersion = 1;
+constexpr uint32_t kTraceByteOrder = 0x01020304;
+// the region of the records outside of any region
+constexpr uint32_t kTraceNoRegion = UINT32_MAX;
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    // the offset of the first block
+    uint64_t header_size;
+    uint32_t num_counters;
+    // the size of the info text, 0 in the traces without one
+    uint32_t info_size;
+    // the CLOCK_REALTIME of the timestamp 0, in ns
+    uint64_t start_realtime_ns;
+};
+
+struct TraceEventEntry {
+    uint32_t type;
+    uint32_t name_size;
+    uint64_t config;
+    uint64_t config1;
+};
+
+enum TraceBlockType : uint32_t {
+    TRACE_BLOCK_RECORDS = 1,
+    TRACE_BLOCK_REGIONS = 2,
+};
+
+struct TraceBlockHeader {
+    uint32_t type;
+    uint32_t count;
+    // the size of the payload following the header
+    uint64_t size;
+};
+
+/** Append the counter time series to a trace file. */
+// The records are buffered column by column in memory, and written as a
+// block once block_records of them are appended, or by flush(). Appending a
+// record never allocates nor calls into the kernel otherwise. The info text
+// describes the trace to its readers, e.g. what the counters hold.
+class TraceWriter {
+public:
+    TraceWriter(const std::string& path, const std::vector<EventAttr>& counters,
+                size_t block_records = 4096,
+                const std::string& info = std::string());
+    ~TraceWriter();
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    // the ns since the trace was created, on the clock of the timestamps
+    uint64_t now_ns() const;
+
+    // counters holds a value for every counter of the trace
+    MPERF_ALWAYS_INLINE void append(uint64_t timestamp_ns, uint32_t region,
+                                    const uint64_t* counters) {
+        timestamps_[count_] = timestamp_ns;
+        regions_[count_] = region;
+        for (size_t k = 0; k < num_counters_; ++k) {
+            columns_[k * block_records_ + count_] = counters[k];
+        }
+        if (mperf_unlikely(++count_ == block_records_)) {
+            write_records();
+        }
+    }
+
+    // name a region id, written with the next block
+    void set_region_name(uint32_t region, const std::string& name);
+
+    // write the buffered records and region names
+    void flush();
+
+private:
+    void write(const void* data, size_t size);
+    void write_records();
+
+    int fd_{-1};
+    size_t num_counters_;
+    size_t block_records_;
+    uint64_t start_ns_;
+    size_t count_{0};
+    std::vector<uint64_t> timestamps_;
+    std::vector<uint32_t> regions_;
+    // the column of the k-th counter starts at k * block_records_
+    std::vector<uint64_t> columns_;
+    std::vector<std::pair<uint32_t, std::string>> pending_regions_;
+};
+
+/** Read a trace file in place, mapped into memory. */
+class TraceReader {
+public:
+    struct Event {
+        std::string name;
+        uint32_t type;
+        uint64_t config;
+        uint64_t config1;
+    };
+
+    explicit TraceReader(const std::string& path);
+    ~TraceReader();
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    const TraceHeader& header() const { return *header_; }
+    const std::vector<Event>& events() const { return events_; }
+    // the info text of the writer, empty if none
+    const std::string& info() const { return info_; }
+    // the index of a counter, -1 if it is not in the trace
+    int event_index(const std::string& name) const;
+    // the name of a region id, empty if it is not named
+    std::string region_name(uint32_t region) const;
+
+    size_t num_records() const { return num_records_; }
+    size_t num_blocks() const { return blocks_.size(); }
+    size_t block_size(size_t block) const { return blocks_[block].count; }
+    // the columns of a record block, pointing into the file
+    const uint64_t* timestamps(size_t block) const {
+        return reinterpret_cast<const uint64_t*>(blocks_[block].data);
+    }
+    const uint32_t* regions(size_t block) const {
+        return reinterpret_cast<const uint32_t*>(
+                blocks_[block].data + 8 * blocks_[block].count);
+    }
+    const uint64_t* counter(size_t block, size_t k) const {
+        const Block& b = blocks_[block];
+        return reinterpret_cast<const uint64_t*>(
+                b.data + 8 * b.count + region_column_size(b.count) +
+                8 * b.count * k);
+    }
+
+    static size_t region_column_size(size_t count) {
+        return (4 * count + 7) & ~size_t(7);
+    }
+
+private:
+    struct Block {
+        const uint8_t* data;
+        size_t count;
+    };
+
+    const uint8_t* base_{nullptr};
+    size_t size_{0};
+    const TraceHeader* header_{nullptr};
+    std::vector<Event> events_;
+    std::string info_;
+    std::vector<Block> blocks_;
+    std::vector<std::pair<uint32_t, std::string>> region_names_;
+    size_t num_records_{0};
+};
+
+}  // namespace mperf
@@ -0,0 +1,122 @@
+/**
+ * \file include/mperf/xpmu/background_sampler.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mperf/xpmu/cpu_profiler.h"
+#include "mperf/xpmu/spsc_ring.h"
+
+namespace mperf {
+class XPMU;
+class TraceWriter;
+
+// A record of BackgroundSampler, valid in the drain callback only.
+struct BackgroundSample {
+    // the end of the period, in ns since the sampler started
+    uint64_t timestamp_ns;
+    // the counts of the cpu events in the period, in the order of cpu_names()
+    CpuValues cpu;
+    // the gpu measurements of the period, in the order of gpu_names()
+    const double* gpu;
+    size_t gpu_size;
+};
+
+/** Snapshot the counters of a running XPMU at a fixed period. */
+// A thread of its own samples the cpu and gpu counters every period_us and
+// pushes the timestamped counts into a preallocated SpscRing, so the counted
+// threads only pay for the counting and the memory is bounded however long
+// it runs. The application drains the records with drain(), or a writer
+// thread drains them into a trace(cf. mperf/trace.h) by write_trace(). The
+// records the ring has no room for are dropped and counted by dropped().
+//
+// The sampler and writer threads are created with the sampler and wait for
+// start(), so it is created before the counters are opened, or they would
+// count the threads by inheritance(cf. XPMU::start_background_sampling). The
+// sampler owns the XPMU session from start() until stop(): call no
+// sample(), run() or stop() of the XPMU meanwhile. The counters are read by
+// read(), the user space reads only work on the counted thread.
+class BackgroundSampler {
+public:
+    // pin the sampler thread to the first core of the little cluster(cf.
+    // cpu_info_get_cluster_cpus), every core counts there if not hybrid
+    static constexpr int kHousekeepingCpu = -2;
+
+    // cpu -1 leaves the thread unpinned
+    BackgroundSampler(XPMU* xpmu, uint64_t period_us, size_t capacity = 65536,
+                      int cpu = kHousekeepingCpu);
+    ~BackgroundSampler();
+    BackgroundSampler(const BackgroundSampler&) = delete;
+    BackgroundSampler& operator=(const BackgroundSampler&) = delete;
+
+    // start sampling the running session of the XPMU, called by XPMU::run()
+    void start();
+
+    // Call fn for the records in the ring, at most max_records of them, from
+    // one thread at a time, and not with write_trace. Returns the number of
+    // records drained.
+    size_t drain(const std::function<void(const BackgroundSample&)>& fn,
+                 size_t max_records = SIZE_MAX);
+
+    // drain the records into the trace at path every drain_ms on the writer
+    // thread, the gpu measurements are rounded to integers. Call before
+    // start().
+    void write_trace(const std::string& path, uint32_t drain_ms = 100);
+
+    // stop sampling, after a last sample, and flush the trace of write_trace.
+    // The records left in the ring can still be drained.
+    void stop();
+
+    const std::vector<std::string>& cpu_names() const { return cpu_names_; }
+    const std::vector<std::string>& gpu_names() const { return gpu_names_; }
+    uint64_t period_us() const { return period_us_; }
+    // the records the ring was full for
+    uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // wait for start(), false if stopped before
+    bool wait_start();
+    void sampler_loop();
+    void writer_loop();
+    // sample the counters into the ring, false if it was full
+    bool push_sample(uint64_t timestamp_ns);
+
+    XPMU* xpmu_;
+    uint64_t period_us_;
+    size_t capacity_;
+    int cpu_;
+    uint64_t start_ns_;
+    std::vector<std::string> cpu_names_;
+    std::vector<std::string> gpu_names_;
+    std::unique_ptr<SpscRing> ring_;
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex start_mutex_;
+    std::condition_variable start_cv_;
+    bool started_{false};
+    std::thread sampler_;
+    std::atomic<bool> writer_stop_{false};
+    std::thread writer_;
+    std::string trace_path_;
+    uint32_t drain_ms_{100};
+    std::unique_ptr<TraceWriter> trace_;
+    // the trace record of the writer
+    std::vector<uint64_t> trace_counts_;
+};
+
+}  // namespace mperf
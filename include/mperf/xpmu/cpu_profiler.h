@@ -21,6 +21,43 @@ typedef std::string CpuCounterSet;
 #endif
 typedef std::vector<mperf::EventAttr> CpuCounterSet2;
 typedef std::vector<std::pair<std::string, uint64_t>> CpuMeasurements;
+// The fraction of the enabled time each event was counting on the pmu, in the
+// same order as CpuMeasurements. A ratio less than 1 means the event was
+// multiplexed and its measurement is a scaled estimate.
+typedef std::vector<float> CpuRunningRatios;
+// The measurements of each thread of the process, keyed by the tid, in the
+// order of the tids.
+typedef std::vector<std::pair<int, CpuMeasurements>> CpuThreadMeasurements;
+// The measurements of each cpu in the system-wide mode, keyed by the cpu id,
+// in the order of the cpu ids.
+typedef std::vector<std::pair<int, CpuMeasurements>> CpuCoreMeasurements;
+// The measurements summed over the cpus of each cluster(little, middle and
+// big) in the system-wide mode, the clusters without a counted cpu are left
+// out.
+typedef std::vector<std::pair<std::string, CpuMeasurements>>
+        CpuClusterMeasurements;
+// The counts of the enabled events indexed by the event id, i.e. the
+// position of the event in the enabled counters, cf. XPMU::cpu_event_id.
+struct CpuValues {
+    const uint64_t* data;
+    size_t size;
+
+    uint64_t operator[](size_t id) const { return data[id]; }
+    const uint64_t* begin() const { return data; }
+    const uint64_t* end() const { return data + size; }
+};
+// A function the samples of the sampled event fell into in the sampling mode.
+struct CpuHotspot {
+    std::string symbol;
+    // the mapped file of the function
+    std::string module;
+    // the samples taken in the function itself
+    uint64_t self_samples;
+    // the samples taken in the function or in its callees, by the callchains
+    uint64_t total_samples;
+};
+// The hotspots sorted by the self samples, most first.
+typedef std::vector<CpuHotspot> CpuHotspots;
 
 /** An interface for classes that collect CPU performance data. */
 class CpuProfiler {
@@ -35,6 +72,11 @@ public:
     virtual void set_enabled_counters(
             const std::vector<mperf::EventAttr>& event_attrs) = 0;
 
+    // Sets the max number of events opened in one group(0 means the default
+    // hardware counter number), the events of a group are always counted
+    // together. Takes effect the next time the counters are set.
+    virtual void set_counter_group_size(size_t group_size) = 0;
+
     // Starts a profiling session
     virtual MPERF_ALWAYS_INLINE void run() = 0;
 
@@ -43,10 +85,45 @@ public:
     // A profiling session must be running when sampling the counters.
     virtual MPERF_ALWAYS_INLINE const CpuMeasurements& sample() = 0;
 
+    // The fast path of sample(), which returns the counts only and copies no
+    // names. The running ratios are updated as well. The values are valid
+    // until the next sample.
+    virtual CpuValues sample_values() = 0;
+
+    // The running ratio of each measurement returned by the last sample()
+    virtual const CpuRunningRatios& running_ratios() const = 0;
+
+    // The measurements of each core pmu of a hybrid system returned by the
+    // last sample(), in the order of cpu_info_core_pmus(). sample() returns
+    // their sums. Empty if the counters are opened on one pmu.
+    virtual const std::vector<CpuMeasurements>& core_pmu_measurements()
+            const = 0;
+
+    // The measurements of each thread returned by the last sample() in the
+    // per-thread mode, whose sums sample() returns. Empty otherwise.
+    virtual const CpuThreadMeasurements& thread_measurements() const = 0;
+
+    // The measurements of each cpu and of each cluster returned by the last
+    // sample() in the system-wide mode, whose sums sample() returns. Empty
+    // otherwise.
+    virtual const CpuCoreMeasurements& core_measurements() const = 0;
+    virtual const CpuClusterMeasurements& cluster_measurements() const = 0;
+
+    // The hotspots of the sampled event since run() by the last sample() in
+    // the sampling mode, empty otherwise.
+    virtual const CpuHotspots& hotspots() const = 0;
+
     // Stops the active profiling session
     virtual MPERF_ALWAYS_INLINE void stop() = 0;
 
     virtual MPERF_ALWAYS_INLINE void set_uncore_event_enabled() = 0;
+
+    // Read the counters from user space(rdpmc on x86, PMEVCNTR<n>_EL0 on
+    // aarch64) instead of the read() syscall where the kernel allows it.
+    virtual void set_user_read_enabled(bool enabled) = 0;
+
+    // True iff the counters are currently read from user space.
+    virtual bool is_user_read() const = 0;
 };
 
 }  // namespace mperf
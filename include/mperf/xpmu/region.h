@@ -0,0 +1,105 @@
+/**
+ * \file include/mperf/xpmu/region.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "mperf/xpmu/cpu_profiler.h"
+
+// Mark the rest of the enclosing scope as a region, e.g.
+//     void conv3x3(...) {
+//         MPERF_REGION("conv3x3");
+//         ...
+//     }
+// A region costs a load and a branch while the regions are disabled, so the
+// markers can be left in the production builds and turned on at runtime by
+// mperf::region_enable().
+#define MPERF_REGION(name)                                              \
+    static const int MPERF_REGION_CAT(mperf_region_id_, __LINE__) =     \
+            ::mperf::region_register(name);                             \
+    ::mperf::RegionScope MPERF_REGION_CAT(mperf_region_scope_, __LINE__)( \
+            MPERF_REGION_CAT(mperf_region_id_, __LINE__))
+
+#define MPERF_REGION_CAT_(a, b) a##b
+#define MPERF_REGION_CAT(a, b) MPERF_REGION_CAT_(a, b)
+
+namespace mperf {
+// the limits of the preallocated region tables
+constexpr int kMaxRegions = 256;
+constexpr int kMaxRegionDepth = 64;
+constexpr int kMaxRegionEvents = 8;
+
+// Count the given cpu events(at most kMaxRegionEvents, opened in one group)
+// and the wall time in every region entered from now on. Each thread counts
+// itself, in a table allocated by the first region it enters after the call,
+// entering and leaving a region never allocates. The totals so far are
+// cleared, and the regions entered before are left uncounted. Dump the
+// regions at exit if dump_at_exit.
+void region_enable(const CpuCounterSet2& events, bool dump_at_exit = true);
+// stop counting the regions entered from now on, the totals are kept
+void region_disable();
+// clear the totals of every thread. A thread clears its own table as it
+// enters its next region, the reports leave the table out until then
+void region_reset();
+
+// the id of a region name, registered on the first call
+int region_register(const char* name);
+
+// The totals of a counter in a region, over every call on every thread.
+struct RegionCounter {
+    std::string name;
+    // the counts of the region, and of the region without its nested regions
+    uint64_t inclusive;
+    uint64_t exclusive;
+    // the inclusive counts of the cheapest and of the most expensive call
+    uint64_t min;
+    uint64_t max;
+};
+struct RegionReport {
+    std::string name;
+    uint64_t calls;
+    // the wall time in ns named "time(ns)" first, then the events
+    std::vector<RegionCounter> counters;
+};
+// The regions called so far in the order of registration. The calls still in
+// progress are not included, and the totals of a thread may be torn if it is
+// leaving a region meanwhile.
+std::vector<RegionReport> region_report();
+void region_dump(FILE* fp = stdout);
+
+namespace detail {
+extern std::atomic<bool> g_region_enabled;
+// return false if the region is not counted, e.g. too deeply nested
+bool region_enter(int id);
+void region_leave();
+}  // namespace detail
+
+/** Count the lifetime of the object as a region, cf. MPERF_REGION. */
+class RegionScope {
+public:
+    explicit RegionScope(int id)
+            : entered_(detail::g_region_enabled.load(
+                               std::memory_order_relaxed) &&
+                       detail::region_enter(id)) {}
+    ~RegionScope() {
+        if (entered_) {
+            detail::region_leave();
+        }
+    }
+    RegionScope(const RegionScope&) = delete;
+    RegionScope& operator=(const RegionScope&) = delete;
+
+private:
+    bool entered_;
+};
+
+}  // namespace mperf
@@ -0,0 +1,96 @@
+/**
+ * \file include/mperf/xpmu/spsc_ring.h
+ *
+ * This file is part of mperf.
+ *
+ * \copyright Copyright (c) 2022-2023 Megvii Inc. All rights reserved.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include "mperf/utils.h"
+
+namespace mperf {
+/** A bounded lock-free ring of fixed size records. */
+// One thread produces(acquire, then commit) and one thread consumes(front,
+// then pop), neither ever blocks or allocates: a full ring refuses the
+// record. A record is record_words uint64_t.
+class SpscRing {
+public:
+    // the capacity is rounded up to a power of 2
+    SpscRing(size_t capacity, size_t record_words)
+            : words_(record_words ? record_words : 1) {
+        size_t cap = 1;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        mask_ = cap - 1;
+        buf_.assign(cap * words_, 0);
+    }
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // producer: the slot of the next record, nullptr if the ring is full
+    MPERF_ALWAYS_INLINE uint64_t* acquire() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ > mask_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ > mask_) {
+                return nullptr;
+            }
+        }
+        return &buf_[(head & mask_) * words_];
+    }
+    // producer: publish the record of the last acquire
+    MPERF_ALWAYS_INLINE void commit() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+    }
+
+    // consumer: the oldest record, nullptr if the ring is empty
+    MPERF_ALWAYS_INLINE const uint64_t* front() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return nullptr;
+            }
+        }
+        return &buf_[(tail & mask_) * words_];
+    }
+    // consumer: release the record of the last front
+    MPERF_ALWAYS_INLINE void pop() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+    size_t record_words() const { return words_; }
+    // the records in the ring, exact only on a quiescent ring
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) -
+               tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    std::vector<uint64_t> buf_;
+    size_t words_;
+    size_t mask_;
+    // the producer and the consumer indices on cache lines of their own,
+    // each with the last index seen of the other side
+    char pad0_[kCacheLine];
+    std::atomic<size_t> head_{0};
+    size_t cached_tail_{0};
+    char pad1_[kCacheLine];
+    std::atomic<size_t> tail_{0};
+    size_t cached_head_{0};
+    char pad2_[kCacheLine];
+};
+
+}  // namespace mperf
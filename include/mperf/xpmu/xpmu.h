@@ -8,18 +8,41 @@
 
 #pragma once
 
+#include "mperf/xpmu/background_sampler.h"
 #include "mperf/xpmu/cpu_profiler.h"
 #include "mperf/xpmu/gpu_profiler.h"
 #include "mperf_build_config.h"
 
+#include <sys/types.h>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mperf {
 struct Measurements {
     const CpuMeasurements* cpu{nullptr};
     const GpuMeasurements* gpu{nullptr};
+    // the running ratio of each cpu measurement, less than 1 if the counter
+    // was multiplexed.
+    const CpuRunningRatios* cpu_ratios{nullptr};
+    // the cpu measurements of each core pmu on a hybrid system, whose sums
+    // are in cpu, empty otherwise.
+    const std::vector<CpuMeasurements>* cpu_parts{nullptr};
+    // the cpu measurements of each thread in the per-thread mode, whose sums
+    // are in cpu, empty otherwise.
+    const CpuThreadMeasurements* cpu_threads{nullptr};
+    // the cpu measurements of each cpu and of each cluster in the
+    // system-wide mode, whose sums are in cpu, empty otherwise.
+    const CpuCoreMeasurements* cpu_cores{nullptr};
+    const CpuClusterMeasurements* cpu_clusters{nullptr};
+    // the hotspots of the sampled cpu event in the sampling mode, empty
+    // otherwise.
+    const CpuHotspots* cpu_hotspots{nullptr};
+    // the calibrated overhead of each cpu counter, which is subtracted from
+    // cpu if the subtraction is enabled, empty if not calibrated.
+    const CpuMeasurements* cpu_overhead{nullptr};
 };
 
 /** A class that collects CPU/GPU performance data. */
@@ -45,6 +68,65 @@ public:
     // set the cpu uncore event enabled
     void set_cpu_uncore_event_enabled();
 
+    // read the cpu counters from user space instead of the read() syscall,
+    // falls back to read() when the kernel does not allow it. It applies to
+    // the counters enabled later as well. The calling thread mode then counts
+    // the calling thread only, not the threads it creates, as the kernel
+    // does not map the inherited counters
+    void set_cpu_user_read_enabled(bool enabled);
+
+    // the max number of cpu events counted together in one group, must be
+    // set before the counters it applies to
+    void set_cpu_counter_group_size(size_t group_size);
+
+    // count every thread of the process on its own instead of the calling
+    // thread and its children merged. A thread created after run() is
+    // counted with the thread which created it, and on its own from the next
+    // run() on. The uncore events are never per thread. Must be set before
+    // the counters it applies to.
+    void set_cpu_per_thread_enabled(bool enabled);
+
+    // count every task running on the given cpus(every online cpu if empty)
+    // instead of the calling thread, like `perf stat -a`, and report the
+    // counts of each cpu and of each cluster as well. It usually requires
+    // perf_event_paranoid <= 0 or CAP_PERFMON. The uncore events are never
+    // per cpu. Must be set before the counters it applies to, and it turns
+    // the per-thread mode off(and vice versa).
+    void set_cpu_system_wide_enabled(bool enabled,
+                                     const std::vector<int>& cpus = {});
+
+    // sample the ip and the callchain of the calling thread and its children
+    // on the first cpu event every period occurrences(or period times a
+    // second if freq), the other events are only counted. sample() reports
+    // the hotspots besides the counts, cf. Measurements::cpu_hotspots. Must
+    // be set before the counters it applies to, and it turns the other
+    // modes off(and vice versa).
+    void set_cpu_sampling_enabled(bool enabled, uint64_t period = 0,
+                                  bool freq = false);
+
+    // Measure the cpu counters of an empty session(a run() followed by a
+    // sample()) iter_num times, and keep the median of each counter as its
+    // overhead, cf. Measurements::cpu_overhead. It runs sessions of its own,
+    // so it must not be called in a session. Only the calling thread and the
+    // per-thread modes are calibrated.
+    const CpuMeasurements& calibrate_cpu_overhead(size_t iter_num = 1000);
+
+    // subtract the overhead from the cpu counts of sample() and
+    // sample_cpu_values()(clamped at 0), calibrating the counters enabled
+    // from now on by iter_num empty sessions the first time they are
+    // enabled. The counts of each thread, cpu and core pmu are kept as is.
+    void set_cpu_overhead_subtraction_enabled(bool enabled,
+                                              size_t iter_num = 1000);
+
+    // count the process pid(the calling one if 0) instead of the calling
+    // thread, e.g. to profile a binary that can not be rebuilt. Its threads
+    // are counted as in the per-thread mode, or if enable_on_exec, merged
+    // with the tasks it creates from its next exec on(the exec starts the
+    // counters instead of run()), for a forked child waiting to exec. Must
+    // be set before the counters it applies to, the sampling and the
+    // system-wide modes do not support it.
+    void set_cpu_target_pid(pid_t pid, bool enable_on_exec = false);
+
     // Starts a profiling session
     void run();
 
@@ -54,7 +136,32 @@ public:
     // enabled. A profiling session must be running when sampling the counters.
     Measurements sample();
 
-    // Stops the active profiling session
+    // The fast path of sample() for the cpu counters: the counts indexed by
+    // the event ids, valid until the next sample. No names are copied, the
+    // ids are resolved once by cpu_event_id() after the counters are set.
+    CpuValues sample_cpu_values();
+
+    // the id of an enabled cpu event in the values of sample_cpu_values(),
+    // i.e. its position in the enabled counters, -1 if it is not enabled
+    int cpu_event_id(const std::string& name) const;
+
+    // Sample the cpu and gpu counters every period_us on a thread of its own
+    // into a ring of capacity records, a time series instead of the totals of
+    // the session, cf. BackgroundSampler. Call before run(), which starts
+    // the sampling; the cpu counters are opened again so that the threads of
+    // the sampler are not counted. The session belongs to the sampler until
+    // stop_background_sampling().
+    BackgroundSampler& start_background_sampling(
+            uint64_t period_us, size_t capacity = 65536,
+            int cpu = BackgroundSampler::kHousekeepingCpu);
+    // stop the sampler, its records can still be drained
+    void stop_background_sampling();
+    // the sampler of start_background_sampling, nullptr if none
+    BackgroundSampler* background_sampler() {
+        return background_sampler_.get();
+    }
+
+    // Stops the active profiling session, and the background sampler
     void stop();
 
     CpuProfiler* cpu_profiler() { return cpu_profiler_.get(); }
@@ -63,11 +170,56 @@ public:
 private:
     std::unique_ptr<CpuProfiler> cpu_profiler_{};
     std::unique_ptr<GpuProfiler> gpu_profiler_{};
+    // destroyed before the profilers it samples
+    std::unique_ptr<BackgroundSampler> background_sampler_{};
+    // whose tasks the cpu counters count
+    enum class CpuMode { CALLING_THREAD, PER_THREAD, SYSTEM_WIDE, SAMPLING };
+
+    // the names of the enabled cpu events in the order of their ids
+    std::vector<std::string> cpu_event_names_;
+    // the enabled cpu events, empty if they were set by names
+    CpuCounterSet2 cpu_event_attrs_;
+    size_t cpu_group_size_{0};
+    bool cpu_user_read_{false};
+    CpuMode cpu_mode_{CpuMode::CALLING_THREAD};
+    std::vector<int> cpu_system_wide_cpus_;
+    uint64_t cpu_sample_period_{0};
+    bool cpu_sample_freq_{false};
+    // the mode of the current cpu profiler
+    CpuMode cpu_profiler_mode_{CpuMode::CALLING_THREAD};
+    std::vector<int> cpu_profiler_cpus_;
+    uint64_t cpu_profiler_sample_period_{0};
+    bool cpu_profiler_sample_freq_{false};
+    // the group size the cpu counters were opened with
+    size_t cpu_profiler_group_size_{0};
+    pid_t cpu_target_pid_{0};
+    bool cpu_target_exec_{false};
+    pid_t cpu_profiler_target_pid_{0};
+    bool cpu_profiler_target_exec_{false};
+
+    bool cpu_overhead_subtraction_{false};
+    size_t cpu_overhead_iter_num_{1000};
+    // the overhead of the enabled counters, empty if they are not calibrated
+    CpuMeasurements cpu_overhead_;
+    std::vector<uint64_t> cpu_overhead_values_;
+    // the calibrated overhead of each counter set enabled so far
+    std::map<std::string, CpuMeasurements> cpu_overhead_cache_;
+    // the counts with the overhead subtracted
+    CpuMeasurements cpu_adjusted_;
+    std::vector<uint64_t> cpu_adjusted_values_;
+
+    // the key of the enabled counters in cpu_overhead_cache_
+    std::string cpu_counters_key() const;
+    // pick the overhead of the enabled counters from the cache, calibrating
+    // them if the subtraction is enabled
+    void update_cpu_overhead();
 
 #if MPERF_WITH_PFM
     void create_profilers(CpuCounterSet enabled_cpu_counters,
                           GpuCounterSet enabled_gpu_counters);
 #endif
+    // the mode the given counters are counted in
+    CpuMode cpu_mode_of(const CpuCounterSet2& event_attrs) const;
     void create_profilers(GpuCounterSet enabled_gpu_counters);
     void create_profilers(CpuCounterSet2 enabled_cpu_counters);
 };
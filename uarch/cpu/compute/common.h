@@ -26,6 +26,7 @@
 #include <functional>
 #include <iostream>
 #include <string>
+#include "mperf/repeat.h"
 #include "mperf/timer.h"
 #include "mperf/utils.h"
 
@@ -61,15 +62,25 @@ constexpr static uint32_t RUNS = 800000;
  *       jne loop
  *
  */
+// the median ns of an instruction over the repeated runs of func, a run is
+// long enough for a few of them to do
+inline static float bench_ns(const std::function<int()>& func) {
+    mperf::RepeatOptions opts;
+    opts.min_reps = 3;
+    mperf::Repeater rep(opts);
+    while (rep.next()) {
+        mperf::Timer timer;
+        auto runs = func();
+        rep.record("ns", timer.get_nsecs() / runs);
+    }
+    return rep.stats("ns").median;
+}
+
 inline static void benchmark(std::function<int()> throughtput_func,
                              std::function<int()> latency_func,
                              const char* inst, size_t inst_simd = 4) {
-    mperf::Timer timer;
-    auto runs = throughtput_func();
-    float throuphput_used = timer.get_nsecs() / runs;
-    timer.reset();
-    runs = latency_func();
-    float latency_used = timer.get_nsecs() / runs;
+    float throuphput_used = bench_ns(throughtput_func);
+    float latency_used = bench_ns(latency_func);
     printf("%s throughput: %f ns %f GFlops latency: %f ns\n", inst,
            throuphput_used, 1.f / throuphput_used * inst_simd, latency_used);
 }
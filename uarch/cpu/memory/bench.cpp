@@ -10,7 +10,7 @@
 namespace mperf {
 double benchmp_simple(benchmp_f initialize, benchmp_f benchmark,
                       benchmp_f cleanup, int enough, int parallel, int warmup,
-                      int repetitions, void* cookie) {
+                      int repetitions, void* cookie, SampleStats* stats) {
     double cost = 0.0f;
     if (initialize)
         (*initialize)(0, cookie);
@@ -19,9 +19,17 @@ double benchmp_simple(benchmp_f initialize, benchmp_f benchmark,
         // warmup
         (*benchmark)(warmup, cookie);
         // execute
-        WallTimer t;
-        (*benchmark)(repetitions, cookie);
-        cost = t.get_msecs() / 1000 / repetitions;
+        Repeater rep;
+        while (rep.next()) {
+            WallTimer t;
+            (*benchmark)(repetitions, cookie);
+            rep.record("time", t.get_msecs() / 1000 / repetitions);
+        }
+        SampleStats s = rep.stats("time");
+        cost = s.median;
+        if (stats) {
+            *stats = s;
+        }
     }
 
     if (cleanup)
@@ -2,15 +2,20 @@
 
 #include "mperf/cpu_affinity.h"
 #include "mperf/cpu_march_probe.h"
+#include "mperf/repeat.h"
 #include "mperf/timer.h"
 
 namespace mperf {
 
 typedef void (*benchmp_f)(int iterations, void* cookie);
 
+// the median seconds of an iteration, the benchmark runs `repetitions`
+// iterations a sample until the samples are stable, cf. Repeater. The
+// statistics of the samples are stored in stats if it is not null.
 double benchmp_simple(benchmp_f initialize, benchmp_f benchmark,
                       benchmp_f cleanup, int enough, int parallel, int warmup,
-                      int repetitions, void* cookie);
+                      int repetitions, void* cookie,
+                      SampleStats* stats = nullptr);
 
 void keep_int(int result);
 void keep_pointer(void* result);